@@ -0,0 +1,148 @@
+#include "BenchData.h"
+#include <spdlog/spdlog.h>
+#include "BtcUtils.h"
+
+
+std::shared_ptr<spdlog::logger> &bs::bench::logger()
+{
+   static std::shared_ptr<spdlog::logger> logger;
+   return logger;
+}
+
+static BinaryData randomData(std::mt19937 &gen, size_t size)
+{
+   std::uniform_int_distribution<int> dist(0, 255);
+   BinaryData result(size);
+   for (size_t i = 0; i < size; ++i) {
+      result.getPtr()[i] = static_cast<uint8_t>(dist(gen));
+   }
+   return result;
+}
+
+std::vector<UTXO> bs::bench::makeUtxos(size_t count, size_t addrCount, uint32_t seed)
+{
+   std::mt19937 gen(seed);
+   std::vector<BinaryData> scripts;
+   scripts.reserve(addrCount);
+   for (size_t i = 0; i < std::max<size_t>(addrCount, 1); ++i) {
+      scripts.push_back(BtcUtils::getP2WPKHOutputScript(randomData(gen, 20)));
+   }
+
+   std::uniform_int_distribution<uint64_t> valueDist(1000, 100000000);
+   std::uniform_int_distribution<uint32_t> heightDist(1, 600000);
+   std::vector<UTXO> result;
+   result.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      UTXO utxo;
+      utxo.value_ = valueDist(gen);
+      utxo.txHash_ = randomData(gen, 32);
+      utxo.txOutIndex_ = static_cast<uint32_t>(i % 4);
+      utxo.txHeight_ = heightDist(gen);
+      utxo.script_ = scripts[i % scripts.size()];
+      result.emplace_back(std::move(utxo));
+   }
+   return result;
+}
+
+std::vector<bs::Address> bs::bench::makeAddresses(size_t count, uint32_t seed)
+{
+   std::mt19937 gen(seed);
+   std::vector<bs::Address> result;
+   result.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      BinaryData prefixed;
+      prefixed.append(SCRIPT_PREFIX_P2WPKH);
+      prefixed.append(randomData(gen, 20));
+      result.push_back(bs::Address::fromHash(prefixed));
+   }
+   return result;
+}
+
+std::vector<bs::TXEntry> bs::bench::makeLedgerEntries(size_t count, const std::string &walletId
+   , uint32_t seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_int_distribution<int64_t> valueDist(-50000000, 50000000);
+   std::vector<bs::TXEntry> result;
+   result.reserve(count);
+   const uint32_t startTime = 1500000000;
+   for (size_t i = 0; i < count; ++i) {
+      bs::TXEntry entry;
+      entry.txHash = randomData(gen, 32);
+      entry.walletIds = { walletId };
+      entry.value = valueDist(gen);
+      entry.blockNum = static_cast<uint32_t>(i / 4 + 1);
+      entry.txTime = startTime + static_cast<uint32_t>(i * 600);
+      entry.isRBF = ((i % 10) == 0);
+      result.emplace_back(std::move(entry));
+   }
+   return result;
+}
+
+const std::vector<std::string> &bs::bench::securities()
+{
+   static const std::vector<std::string> result = {
+      "EUR/GBP", "EUR/SEK", "EUR/USD", "GBP/SEK", "USD/SEK"
+      , "XBT/USD", "XBT/GBP", "XBT/EUR", "XBT/SEK"
+      , "BLK/XBT"
+   };
+   return result;
+}
+
+static bs::network::Asset::Type assetTypeForSecurity(const std::string &security)
+{
+   if (security == "BLK/XBT") {
+      return bs::network::Asset::PrivateMarket;
+   }
+   if (security.find("XBT") != std::string::npos) {
+      return bs::network::Asset::SpotXBT;
+   }
+   return bs::network::Asset::SpotFX;
+}
+
+std::vector<bs::network::QuoteReqNotification> bs::bench::makeQuoteRequests(size_t count
+   , uint32_t seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_int_distribution<size_t> secDist(0, securities().size() - 1);
+   std::uniform_real_distribution<double> qtyDist(0.01, 100);
+   std::vector<bs::network::QuoteReqNotification> result;
+   result.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      bs::network::QuoteReqNotification qrn;
+      qrn.quoteRequestId = "bench_rfq_" + std::to_string(i);
+      qrn.security = securities()[secDist(gen)];
+      qrn.assetType = assetTypeForSecurity(qrn.security);
+      qrn.product = qrn.security.substr(0, qrn.security.find('/'));
+      qrn.side = (i % 2) ? bs::network::Side::Buy : bs::network::Side::Sell;
+      qrn.quantity = qtyDist(gen);
+      qrn.status = bs::network::QuoteReqNotification::PendingAck;
+      result.emplace_back(std::move(qrn));
+   }
+   return result;
+}
+
+bs::network::MDFields bs::bench::makeMDFields(std::mt19937 &gen)
+{
+   std::uniform_real_distribution<double> pxDist(0.9, 1.1);
+   const double mid = 8000 * pxDist(gen);
+   return {
+      bs::network::MDField{ bs::network::MDField::PriceBid, mid * 0.999 },
+      bs::network::MDField{ bs::network::MDField::PriceOffer, mid * 1.001 },
+      bs::network::MDField{ bs::network::MDField::PriceLast, mid },
+      bs::network::MDField{ bs::network::MDField::DailyVolume, mid * 100 }
+   };
+}
+
+std::vector<std::string> bs::bench::makePayloads(size_t count, size_t minSize, size_t maxSize
+   , uint32_t seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_int_distribution<size_t> sizeDist(minSize, std::max(minSize, maxSize));
+   std::vector<std::string> result;
+   result.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      result.push_back(randomData(gen, sizeDist(gen)).toBinStr());
+   }
+   return result;
+}
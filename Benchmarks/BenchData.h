@@ -0,0 +1,47 @@
+#ifndef __BENCH_DATA_H__
+#define __BENCH_DATA_H__
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "BinaryData.h"
+#include "CommonTypes.h"
+#include "TxClasses.h"
+#include "Wallets/SyncWallet.h"
+
+namespace spdlog {
+   class logger;
+}
+
+// Synthetic data generators for terminal benchmarks. All generators are
+// deterministic for the same seed so that results are comparable between runs.
+namespace bs {
+   namespace bench {
+
+      std::shared_ptr<spdlog::logger> &logger();
+
+      // UTXOs with P2WPKH scripts spread over addrCount distinct addresses
+      std::vector<UTXO> makeUtxos(size_t count, size_t addrCount, uint32_t seed = 1);
+
+      // Distinct P2WPKH addresses
+      std::vector<bs::Address> makeAddresses(size_t count, uint32_t seed = 1);
+
+      // Ledger entries as returned by Armory history pages
+      std::vector<bs::TXEntry> makeLedgerEntries(size_t count, const std::string &walletId
+         , uint32_t seed = 1);
+
+      const std::vector<std::string> &securities();
+
+      std::vector<bs::network::QuoteReqNotification> makeQuoteRequests(size_t count
+         , uint32_t seed = 1);
+
+      bs::network::MDFields makeMDFields(std::mt19937 &);
+
+      std::vector<std::string> makePayloads(size_t count, size_t minSize, size_t maxSize
+         , uint32_t seed = 1);
+
+   }  // namespace bench
+}  // namespace bs
+
+#endif // __BENCH_DATA_H__
@@ -0,0 +1,460 @@
+#include <benchmark/benchmark.h>
+
+#include <QDir>
+#include <QStandardPaths>
+#include <spdlog/spdlog.h>
+
+#include "ApplicationSettings.h"
+#include "BenchData.h"
+#include "CelerClient.h"
+#include "ChatProtocol/ClientPartyModel.h"
+#include "ChatUI/ChatPartiesSortProxyModel.h"
+#include "CoinControlModel.h"
+#include "ConnectionManager.h"
+#include "MarketDataModel.h"
+#include "MockAssetMgr.h"
+#include "OtcClient.h"
+#include "QuoteRequestsModel.h"
+#include "QuoteRequestsWidget.h"
+#include "RfqReplayHarness.h"
+#include "SelectedTransactionInputs.h"
+#include "TransactionsSortFilterModel.h"
+#include "TransactionsViewModel.h"
+#include "UiUtils.h"
+
+namespace {
+
+   // Lazily constructed environment for the trading models. It is shared
+   // between benchmarks to keep settings and Celer setup out of measurements.
+   class TradingEnv
+   {
+   public:
+      static TradingEnv &instance()
+      {
+         static TradingEnv env;
+         return env;
+      }
+
+      std::unique_ptr<QuoteRequestsModel> createQuoteRequestsModel()
+      {
+         auto model = std::make_unique<QuoteRequestsModel>(statsCollector_, celerClient_
+            , appSettings_, nullptr);
+         model->SetAssetManager(assetMgr_);
+         model->setPriceUpdateInterval(0);   // apply every MD update immediately
+         return model;
+      }
+
+   private:
+      TradingEnv()
+      {
+         QStandardPaths::setTestModeEnabled(true);
+         appSettings_ = std::make_shared<ApplicationSettings>(QLatin1String("BS_benchmarks"));
+         appSettings_->set(ApplicationSettings::initialized, true);
+         assetMgr_ = std::make_shared<MockAssetManager>(bs::bench::logger());
+         assetMgr_->init();
+         connMgr_ = std::make_shared<ConnectionManager>(bs::bench::logger());
+         celerClient_ = std::make_shared<CelerClient>(connMgr_);
+         statsCollector_ = std::make_shared<bs::SecurityStatsCollector>(appSettings_
+            , ApplicationSettings::Filter_MD_QN_cnt);
+      }
+
+      ~TradingEnv()
+      {
+         QDir(appSettings_->GetHomeDir()).removeRecursively();
+      }
+
+   private:
+      std::shared_ptr<ApplicationSettings>   appSettings_;
+      std::shared_ptr<MockAssetManager>      assetMgr_;
+      std::shared_ptr<ConnectionManager>     connMgr_;
+      std::shared_ptr<BaseCelerClient>       celerClient_;
+      std::shared_ptr<bs::SecurityStatsCollector>  statsCollector_;
+   };
+
+   TransactionPtr makeViewItem(const bs::TXEntry &entry)
+   {
+      auto item = std::make_shared<TransactionsViewItem>();
+      item->txEntry = entry;
+      item->walletID = QString::fromStdString(*entry.walletIds.cbegin());
+      item->direction = (entry.value > 0) ? bs::sync::Transaction::Received
+         : bs::sync::Transaction::Sent;
+      item->amount = entry.value / BTCNumericTypes::BalanceDivider;
+      item->amountStr = UiUtils::displayAmount(item->amount);
+      item->mainAddress = QString::fromStdString(entry.txHash.toHexStr().substr(0, 40));
+      item->confirmations = 6;
+      item->updateFilterKeys();
+      item->initialized = true;
+      return item;
+   }
+
+   // Row check as it was done by TransactionsSortFilterModel before filter keys
+   // were added: QVariant per column and case-insensitive compare on each row
+   // (CC wallet branch is omitted as benchmark items have no wallets)
+   bool variantFilterAccepts(const TXNode &node, const QStringList &walletIds
+      , bs::sync::Transaction::Direction direction, uint32_t startDate, uint32_t endDate
+      , const QString &searchString)
+   {
+      using Columns = TransactionsViewModel::Columns;
+      const auto filterData = [&node](Columns col) {
+         return node.data(static_cast<int>(col), TransactionsViewModel::FilterRole);
+      };
+      if (!walletIds.isEmpty()) {
+         bool walletMatched = false;
+         for (const auto &walletId : walletIds) {
+            if (filterData(Columns::Wallet).toString() == walletId) {
+               walletMatched = true;
+            }
+         }
+         if (!walletMatched) {
+            return false;
+         }
+      }
+      if ((direction != bs::sync::Transaction::Unknown)
+         && (filterData(Columns::SendReceive).toInt() != direction)) {
+         return false;
+      }
+      if ((startDate > 0) && (endDate > 0)) {
+         const auto txDate = filterData(Columns::Date).toUInt();
+         if ((txDate < startDate) || (txDate >= endDate)) {
+            return false;
+         }
+      }
+      if (!searchString.isEmpty()) {
+         for (const auto col : { Columns::Comment, Columns::Address }) {
+            if (filterData(col).toString().contains(searchString, Qt::CaseInsensitive)) {
+               return true;
+            }
+         }
+         return false;
+      }
+      return true;
+   }
+
+}  // namespace
+
+
+// Page of ledger entries turned into view items and appended to the model
+// tree, followed by rendering of one screen of rows
+static void BM_TransactionsPageLoad(benchmark::State &state)
+{
+   const auto entries = bs::bench::makeLedgerEntries(state.range(0), "bench_wallet");
+   const int visibleRows = std::min<int>(50, static_cast<int>(entries.size()));
+   const int nbColumns = static_cast<int>(TransactionsViewModel::Columns::last) + 1;
+
+   for (auto _ : state) {
+      TXNode root;
+      for (const auto &entry : entries) {
+         root.add(new TXNode(makeViewItem(entry)));
+      }
+      for (int row = 0; row < visibleRows; ++row) {
+         const auto node = root.child(row);
+         for (int col = 0; col < nbColumns; ++col) {
+            benchmark::DoNotOptimize(node->data(col, Qt::DisplayRole));
+            benchmark::DoNotOptimize(node->data(col, Qt::TextColorRole));
+            benchmark::DoNotOptimize(node->data(col, Qt::FontRole));
+         }
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * entries.size());
+}
+BENCHMARK(BM_TransactionsPageLoad)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Lookup of incoming entries in already loaded tree (done for every ledger
+// page and every ZC notification)
+static void BM_TransactionsFind(benchmark::State &state)
+{
+   const auto entries = bs::bench::makeLedgerEntries(state.range(0), "bench_wallet");
+   TXNode root;
+   for (const auto &entry : entries) {
+      root.add(new TXNode(makeViewItem(entry)));
+   }
+   const auto lookups = bs::bench::makeLedgerEntries(100, "bench_wallet", 2);
+   size_t idx = 0;
+
+   for (auto _ : state) {
+      benchmark::DoNotOptimize(root.find(entries[idx % entries.size()]));
+      benchmark::DoNotOptimize(root.find(lookups[idx % lookups.size()]));
+      ++idx;
+   }
+   state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_TransactionsFind)->Arg(1000)->Arg(10000);
+
+// Full refilter of 100k ledger rows as done on each filter change.
+// First arg: 0 - QVariant-based check, 1 - typed filter keys
+// Second arg: 0 - wallet and direction, 1 - date range, 2 - search keystrokes
+static void BM_TransactionsFilter(benchmark::State &state)
+{
+   const bool typed = (state.range(0) != 0);
+   const auto scenario = state.range(1);
+   const auto entries = bs::bench::makeLedgerEntries(100000, "bench_wallet");
+   const QStringList walletIds = { QLatin1String("wallet_0"), QLatin1String("wallet_1")
+      , QLatin1String("wallet_2"), QLatin1String("wallet_3") };
+   TXNode root;
+   for (size_t i = 0; i < entries.size(); ++i) {
+      auto item = makeViewItem(entries[i]);
+      item->walletID = walletIds[i % walletIds.size()];
+      if ((i % 10) == 0) {
+         item->comment = QStringLiteral("Settlement %1 Comment").arg(i);
+      }
+      item->updateFilterKeys();
+      root.add(new TXNode(item));
+   }
+
+   QStringList filterWallets;
+   auto direction = bs::sync::Transaction::Unknown;
+   uint32_t startDate = 0, endDate = 0;
+   QStringList searches;
+   switch (scenario) {
+   case 0:
+      filterWallets = { walletIds[1], walletIds[3] };
+      direction = bs::sync::Transaction::Received;
+      searches << QString();
+      break;
+   case 1:
+      startDate = entries[entries.size() / 4].txTime;
+      endDate = entries[entries.size() / 2].txTime;
+      searches << QString();
+      break;
+   default:
+      searches << QLatin1String("s") << QLatin1String("se") << QLatin1String("set")
+         << QLatin1String("SETTLEMENT 4") << QLatin1String("ab");
+      break;
+   }
+
+   size_t idx = 0;
+   for (auto _ : state) {
+      const auto &search = searches[idx++ % searches.size()];
+      size_t accepted = 0;
+      if (typed) {
+         TransactionsFilter filter;
+         filter.walletIds = QSet<QString>::fromList(filterWallets);
+         filter.direction = direction;
+         filter.startDate = startDate;
+         filter.endDate = endDate;
+         filter.searchLower = search.toLower();
+         for (const auto node : root.children()) {
+            accepted += filter.accepts(*node->item()) ? 1 : 0;
+         }
+      }
+      else {
+         for (const auto node : root.children()) {
+            accepted += variantFilterAccepts(*node, filterWallets, direction
+               , startDate, endDate, search) ? 1 : 0;
+         }
+      }
+      benchmark::DoNotOptimize(accepted);
+   }
+   state.SetItemsProcessed(state.iterations() * entries.size());
+}
+BENCHMARK(BM_TransactionsFilter)->Args({ 0, 0 })->Args({ 1, 0 })->Args({ 0, 1 })->Args({ 1, 1 })
+   ->Args({ 0, 2 })->Args({ 1, 2 })->Unit(benchmark::kMillisecond);
+
+static void BM_QuoteRequestsInsert(benchmark::State &state)
+{
+   const auto qrns = bs::bench::makeQuoteRequests(state.range(0));
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      auto model = TradingEnv::instance().createQuoteRequestsModel();
+      state.ResumeTiming();
+
+      for (const auto &qrn : qrns) {
+         model->onQuoteReqNotifReceived(qrn);
+      }
+
+      state.PauseTiming();
+      model.reset();
+      state.ResumeTiming();
+   }
+   state.SetItemsProcessed(state.iterations() * qrns.size());
+}
+BENCHMARK(BM_QuoteRequestsInsert)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// Market data ticks applied to a model that already has RFQs for each security
+static void BM_QuoteRequestsMDUpdate(benchmark::State &state)
+{
+   auto model = TradingEnv::instance().createQuoteRequestsModel();
+   for (const auto &qrn : bs::bench::makeQuoteRequests(state.range(0))) {
+      model->onQuoteReqNotifReceived(qrn);
+   }
+   std::mt19937 gen(1);
+   std::vector<std::pair<QString, bs::network::MDFields>> ticks;
+   for (int i = 0; i < 1000; ++i) {
+      const auto &security = bs::bench::securities()[i % bs::bench::securities().size()];
+      ticks.push_back({ QString::fromStdString(security), bs::bench::makeMDFields(gen) });
+   }
+   size_t idx = 0;
+
+   for (auto _ : state) {
+      const auto &tick = ticks[idx++ % ticks.size()];
+      model->onSecurityMDUpdated(tick.first, tick.second);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuoteRequestsMDUpdate)->Arg(10)->Arg(100)->Arg(1000);
+
+// RFQ trace replayed through the dealer pipeline with AQ script replying to
+// each request, time is from the first event to the last reply
+static void BM_RfqReplay(benchmark::State &state)
+{
+   bs::bench::RfqReplayHarness harness(bs::bench::logger(), {});
+   if (!harness.init()) {
+      state.SkipWithError("failed to load AQ script");
+      return;
+   }
+   bs::bench::RfqTraceParams traceParams;
+   traceParams.requests = state.range(0);
+   traceParams.requestsPerSec = 1e6;     // no gaps - replayed at full speed anyway
+   const auto trace = bs::bench::makeRfqTrace(traceParams);
+
+   bs::bench::RfqReplayResult result;
+   for (auto _ : state) {
+      if (!harness.run(trace, result) || (result.replies != result.requests)) {
+         state.SkipWithError("not all requests were replied");
+         break;
+      }
+      state.SetIterationTime(result.durationSec);
+   }
+   state.SetItemsProcessed(state.iterations() * result.requests);
+   state.counters["p50_us"] = result.latencyP50us;
+   state.counters["p99_us"] = result.latencyP99us;
+}
+BENCHMARK(BM_RfqReplay)->Arg(100)->Arg(1000)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+static void BM_MarketDataModelUpdate(benchmark::State &state)
+{
+   MarketDataModel model;
+   std::mt19937 gen(1);
+   std::vector<std::pair<QString, bs::network::MDFields>> ticks;
+   for (int i = 0; i < state.range(0); ++i) {
+      const auto security = QStringLiteral("SEC%1/XBT").arg(i);
+      ticks.push_back({ security, bs::bench::makeMDFields(gen) });
+      model.onMDUpdated(bs::network::Asset::SpotXBT, security, ticks.back().second);
+   }
+   size_t idx = 0;
+
+   for (auto _ : state) {
+      const auto &tick = ticks[idx++ % ticks.size()];
+      model.onMDUpdated(bs::network::Asset::SpotXBT, tick.first, tick.second);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MarketDataModelUpdate)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_CoinControlLoadInputs(benchmark::State &state)
+{
+   const auto utxos = bs::bench::makeUtxos(state.range(0), std::max<size_t>(state.range(0) / 4, 1));
+   const auto inputs = std::make_shared<SelectedTransactionInputs>(utxos);
+
+   for (auto _ : state) {
+      CoinControlModel model(inputs);
+      benchmark::DoNotOptimize(model.rowCount());
+   }
+   state.SetItemsProcessed(state.iterations() * utxos.size());
+}
+BENCHMARK(BM_CoinControlLoadInputs)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Arg: 0 - QLocale based formatting, 1 - fixed-point formatter
+static void BM_FormatAmounts(benchmark::State &state)
+{
+   std::mt19937_64 gen(1);
+   std::vector<int64_t> amounts;
+   std::vector<double> prices;
+   for (int i = 0; i < 1024; ++i) {
+      amounts.push_back(static_cast<int64_t>(gen() % 2100000000000000ULL));
+      prices.push_back(static_cast<double>(gen() % 100000000) / 10000);
+   }
+   const bool fast = (state.range(0) != 0);
+   size_t idx = 0;
+
+   for (auto _ : state) {
+      const auto amount = amounts[idx % amounts.size()];
+      const auto price = prices[idx % prices.size()];
+      ++idx;
+      if (fast) {
+         benchmark::DoNotOptimize(UiUtils::displayAmount(amount));
+         benchmark::DoNotOptimize(UiUtils::displayPriceFX(price));
+         benchmark::DoNotOptimize(UiUtils::displayCurrencyAmount(price));
+      }
+      else {
+         benchmark::DoNotOptimize(UiUtils::UnifyValueString(QLocale().toString(UiUtils::amountToBtc(amount)
+            , 'f', UiUtils::GetAmountPrecisionXBT())));
+         benchmark::DoNotOptimize(UiUtils::UnifyValueString(QLocale().toString(price, 'f', 4)));
+         benchmark::DoNotOptimize(UiUtils::UnifyValueString(QLocale().toString(price
+            , 'f', UiUtils::GetAmountPrecisionFX())));
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK(BM_FormatAmounts)->Arg(0)->Arg(1);
+
+namespace {
+
+   // Party tree with nbParties private contacts in random display name order,
+   // half of them accepted and half of them contact requests
+   struct PartiesTree
+   {
+      explicit PartiesTree(int nbParties)
+         : partyModel(std::make_shared<Chat::ClientPartyModel>(bs::bench::logger()))
+         , otcClient(bs::bench::logger(), nullptr, nullptr, nullptr, nullptr, nullptr, OtcClientParams{})
+         , treeModel(std::make_shared<ChatPartiesTreeModel>(partyModel, &otcClient))
+         , proxyModel(treeModel)
+      {
+         std::mt19937 gen(1);
+         for (int i = 0; i < nbParties; ++i) {
+            auto party = std::make_shared<Chat::ClientParty>("party_" + std::to_string(i)
+               , Chat::PartyType::PRIVATE_DIRECT_MESSAGE, Chat::PartySubType::STANDARD
+               , (i % 2) ? Chat::PartyState::REQUESTED : Chat::PartyState::INITIALIZED);
+            party->setDisplayName("user_" + std::to_string(gen()));
+            partyModel->insertParty(party);
+         }
+         treeModel->onPartyModelChanged();
+         proxyModel.sort(0);
+      }
+
+      // Forces proxy to build mappings (sort and filter) of all sections
+      int visitAll() const
+      {
+         int count = 0;
+         for (int i = 0; i < proxyModel.rowCount(); ++i) {
+            count += proxyModel.rowCount(proxyModel.index(i, 0));
+         }
+         return count;
+      }
+
+      Chat::ClientPartyModelPtr  partyModel;
+      OtcClient                  otcClient;
+      ChatPartiesTreeModelPtr    treeModel;
+      ChatPartiesSortProxyModel  proxyModel;
+   };
+
+}  // namespace
+
+static void BM_ChatPartiesSortFilter(benchmark::State &state)
+{
+   PartiesTree tree(static_cast<int>(state.range(0)));
+
+   for (auto _ : state) {
+      tree.proxyModel.invalidate();
+      benchmark::DoNotOptimize(tree.visitAll());
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChatPartiesSortFilter)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+// Renamed contact is moved to its new place by dynamic sorting
+static void BM_ChatPartyRename(benchmark::State &state)
+{
+   PartiesTree tree(static_cast<int>(state.range(0)));
+   tree.visitAll();
+   int idx = 0;
+
+   for (auto _ : state) {
+      const auto partyId = "party_" + std::to_string(2 * (idx % (state.range(0) / 2)));
+      tree.partyModel->getClientPartyById(partyId)->setDisplayName("renamed_" + std::to_string(idx++));
+      tree.treeModel->onPartyDisplayNameChanged(partyId);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ChatPartyRename)->Arg(1000)->Arg(20000);
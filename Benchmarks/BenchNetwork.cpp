@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <spdlog/spdlog.h>
+
+#include "BenchData.h"
+#include "ZmqContext.h"
+#include "ZMQ_BIP15X_DataConnection.h"
+#include "ZMQ_BIP15X_ServerConnection.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+   class CountingServerListener : public ServerConnectionListener
+   {
+   public:
+      void OnDataFromClient(const std::string &, const std::string &data) override
+      {
+         bytesRecv_ += data.size();
+         std::unique_lock<std::mutex> lock(mutex_);
+         ++dataRecv_;
+         cv_.notify_all();
+      }
+      void onClientError(const std::string &, const std::string &) override {}
+      void OnClientConnected(const std::string &) override {}
+      void OnClientDisconnected(const std::string &) override {}
+
+      bool waitFor(uint64_t count)
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         return cv_.wait_for(lock, 30s, [this, count] { return dataRecv_ >= count; });
+      }
+
+      std::atomic<uint64_t>   bytesRecv_{};
+
+   private:
+      std::mutex              mutex_;
+      std::condition_variable cv_;
+      uint64_t                dataRecv_{};
+   };
+
+   class ConnectedClientListener : public DataConnectionListener
+   {
+   public:
+      void OnDataReceived(const std::string &) override {}
+      void OnConnected() override
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         connected_ = true;
+         cv_.notify_all();
+      }
+      void OnDisconnected() override {}
+      void OnError(DataConnectionError) override {}
+
+      bool waitConnected()
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         return cv_.wait_for(lock, 10s, [this] { return connected_; });
+      }
+
+   private:
+      std::mutex              mutex_;
+      std::condition_variable cv_;
+      bool                    connected_ = false;
+   };
+
+}  // namespace
+
+
+// Client -> server one-way throughput over an authenticated BIP15X link on
+// localhost. Arg is payload size in bytes.
+static void BM_ZmqBIP15XThroughput(benchmark::State &state)
+{
+   const auto logger = bs::bench::logger();
+   CountingServerListener srvLsn;
+   ConnectedClientListener clientLsn;
+
+   ZmqBIP15XDataConnectionParams params;
+   params.ephemeralPeers = true;
+   auto clientConn = std::make_unique<ZmqBIP15XDataConnection>(logger, params);
+   const auto zmqContext = std::make_shared<ZmqContext>(logger);
+   auto serverConn = std::make_unique<ZmqBIP15XServerConnection>(logger, zmqContext
+      , [] { return ZmqBIP15XPeers(); });
+
+   const std::string host = "127.0.0.1";
+   std::string port;
+   do {
+      port = std::to_string((rand() % 50000) + 10000);
+   } while (!serverConn->BindConnection(host, port, &srvLsn));
+
+   serverConn->addAuthPeer(ZmqBIP15XPeer("client", clientConn->getOwnPubKey()));
+   clientConn->addAuthPeer(ZmqBIP15XPeer(host + ":" + port, serverConn->getOwnPubKey()));
+   if (!clientConn->openConnection(host, port, &clientLsn) || !clientLsn.waitConnected()) {
+      state.SkipWithError("failed to connect");
+      return;
+   }
+
+   const size_t batchSize = 100;
+   const auto payloads = bs::bench::makePayloads(batchSize, state.range(0), state.range(0));
+   uint64_t sent = 0;
+
+   for (auto _ : state) {
+      for (const auto &payload : payloads) {
+         clientConn->send(payload);
+      }
+      sent += payloads.size();
+      if (!srvLsn.waitFor(sent)) {
+         state.SkipWithError("timed out waiting for data");
+         break;
+      }
+   }
+   state.SetItemsProcessed(sent);
+   state.SetBytesProcessed(srvLsn.bytesRecv_.load());
+
+   clientConn->closeConnection();
+}
+BENCHMARK(BM_ZmqBIP15XThroughput)->Arg(64)->Arg(1024)->Arg(16 * 1024)
+   ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,25 @@
+#ifndef __BENCH_STATS_H__
+#define __BENCH_STATS_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace bs {
+   namespace bench {
+
+      // Nearest-rank percentile (pct in 0..100) of already sorted samples
+      inline double percentile(const std::vector<uint64_t> &sorted, double pct)
+      {
+         if (sorted.empty()) {
+            return 0;
+         }
+         const auto rank = static_cast<size_t>(std::ceil(pct / 100.0 * sorted.size()));
+         return static_cast<double>(sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1]);
+      }
+
+   }  // namespace bench
+}  // namespace bs
+
+#endif // __BENCH_STATS_H__
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <set>
+
+#include "AddressOwnershipIndex.h"
+#include "BenchData.h"
+#include "WalletUtils.h"
+
+
+static void BM_SelectUtxoForAmount(benchmark::State &state)
+{
+   const auto utxos = bs::bench::makeUtxos(state.range(0), state.range(0));
+   uint64_t total = 0;
+   for (const auto &utxo : utxos) {
+      total += utxo.getValue();
+   }
+   // ask for about a third of the total to exercise multi-input selection
+   const uint64_t amount = total / 3;
+
+   for (auto _ : state) {
+      benchmark::DoNotOptimize(bs::selectUtxoForAmount(utxos, amount));
+   }
+   state.SetItemsProcessed(state.iterations() * utxos.size());
+}
+BENCHMARK(BM_SelectUtxoForAmount)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+
+// Wallets with 200 used addresses each and transaction with outputs spread
+// over our wallets (every third one) and counterparty addresses.
+// Scan asks every leaf about every output as signer tx review used to do.
+namespace {
+   const size_t kAddrPerWallet = 200;
+
+   struct OwnershipData
+   {
+      std::vector<std::vector<bs::Address>>  wallets;
+      std::vector<bs::Address>   outputs;
+   };
+
+   OwnershipData makeOwnershipData(size_t nbWallets, size_t nbOutputs)
+   {
+      OwnershipData result;
+      const auto addresses = bs::bench::makeAddresses(nbWallets * kAddrPerWallet + nbOutputs);
+      for (size_t i = 0; i < nbWallets; ++i) {
+         result.wallets.emplace_back(addresses.begin() + i * kAddrPerWallet
+            , addresses.begin() + (i + 1) * kAddrPerWallet);
+      }
+      for (size_t i = 0; i < nbOutputs; ++i) {
+         if (i % 3 == 0) {
+            result.outputs.push_back(addresses[(i * 7919) % (nbWallets * kAddrPerWallet)]);
+         }
+         else {
+            result.outputs.push_back(addresses[nbWallets * kAddrPerWallet + i]);
+         }
+      }
+      return result;
+   }
+}
+
+static void BM_AddressOwnershipScan(benchmark::State &state)
+{
+   const auto data = makeOwnershipData(state.range(0), state.range(1));
+   std::vector<std::set<bs::Address>> leaves;
+   for (const auto &wallet : data.wallets) {
+      leaves.emplace_back(wallet.begin(), wallet.end());
+   }
+
+   for (auto _ : state) {
+      size_t ours = 0;
+      for (const auto &addr : data.outputs) {
+         for (const auto &leaf : leaves) {
+            if (leaf.find(addr) != leaf.end()) {
+               ours++;
+               break;
+            }
+         }
+      }
+      benchmark::DoNotOptimize(ours);
+   }
+   state.SetItemsProcessed(state.iterations() * data.outputs.size());
+}
+BENCHMARK(BM_AddressOwnershipScan)->Args({ 10, 300 })->Args({ 100, 300 })->Args({ 500, 300 });
+
+static void BM_AddressOwnershipIndex(benchmark::State &state)
+{
+   const auto data = makeOwnershipData(state.range(0), state.range(1));
+   bs::sync::AddressOwnershipIndex index(nullptr);
+   for (size_t i = 0; i < data.wallets.size(); ++i) {
+      index.addAddresses({ "wallet" + std::to_string(i), {}, bs::core::wallet::Type::Bitcoin }
+         , data.wallets[i]);
+   }
+
+   for (auto _ : state) {
+      size_t ours = 0;
+      for (const auto &addr : data.outputs) {
+         if (index.contains(addr)) {
+            ours++;
+         }
+      }
+      benchmark::DoNotOptimize(ours);
+   }
+   state.SetItemsProcessed(state.iterations() * data.outputs.size());
+}
+BENCHMARK(BM_AddressOwnershipIndex)->Args({ 10, 300 })->Args({ 100, 300 })->Args({ 500, 300 });
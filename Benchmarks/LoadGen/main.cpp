@@ -0,0 +1,92 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <btc/ecc.h>
+#include <cxxopts.hpp>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "BIP150_151.h"
+#include "ZmqBIP15XLoadGen.h"
+
+int main(int argc, char** argv)
+{
+   auto logger = spdlog::stdout_color_mt("stdout logger");
+
+   bool help{};
+   std::string msgSizes;
+   unsigned int clients{};
+   unsigned int durationSec{};
+   unsigned int rekeyInterval{};
+   unsigned int window{};
+   std::string outFile;
+
+   cxxopts::Options options("zmq_bip15x_loadgen", "Load generator for ZMQ BIP15X connections on localhost");
+   options.add_options()
+      ("h,help", "Print help"
+         , cxxopts::value<bool>(help))
+      ("sizes", "Comma-separated payload sizes in bytes, used round-robin"
+         , cxxopts::value<std::string>(msgSizes)->default_value("1024"))
+      ("clients", "Number of concurrent client connections"
+         , cxxopts::value<unsigned int>(clients)->default_value("1"))
+      ("duration", "Test duration in seconds"
+         , cxxopts::value<unsigned int>(durationSec)->default_value("10"))
+      ("rekey", "Rekey each client after that many messages (0 - never)"
+         , cxxopts::value<unsigned int>(rekeyInterval)->default_value("0"))
+      ("window", "Max unanswered messages per client"
+         , cxxopts::value<unsigned int>(window)->default_value("20"))
+      ("out", "Output JSON file. Default is stdout"
+         , cxxopts::value<std::string>(outFile))
+   ;
+
+   bs::bench::ZmqLoadGenParams params;
+   try {
+      options.parse(argc, argv);
+
+      params.msgSizes.clear();
+      std::stringstream ss(msgSizes);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+         params.msgSizes.push_back(std::stoul(item));
+      }
+   }
+   catch (const std::exception &e) {
+      SPDLOG_LOGGER_CRITICAL(logger, "parsing args failed: {}", e.what());
+      exit(EXIT_FAILURE);
+   }
+
+   if (help) {
+      std::cout << options.help() << std::endl;
+      exit(EXIT_SUCCESS);
+   }
+
+   params.clients = clients;
+   params.duration = std::chrono::seconds(durationSec);
+   params.rekeyInterval = rekeyInterval;
+   params.window = window;
+
+   logger->set_pattern("[%D %H:%M:%S.%e] [%l](%t) %s:%#:%!: %v");
+   logger->set_level(spdlog::level::warn);
+
+   btc_ecc_start();
+   startupBIP151CTX();
+   startupBIP150CTX(4, true);
+   srand(time(0));
+
+   bs::bench::ZmqBIP15XLoadGen loadGen(logger, params);
+   bs::bench::ZmqLoadGenResult result;
+   if (!loadGen.run(result)) {
+      SPDLOG_LOGGER_CRITICAL(logger, "load test failed to start");
+      exit(EXIT_FAILURE);
+   }
+
+   const auto json = result.toJson(params);
+   if (outFile.empty()) {
+      std::cout << json;
+   }
+   else {
+      std::ofstream out(outFile);
+      out << json;
+   }
+   return (result.errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,145 @@
+#ifdef _MSC_VER
+#  include <winsock2.h>
+#endif
+
+#include <fstream>
+#include <iostream>
+#include <QApplication>
+#include <QtPlugin>
+#include <cxxopts.hpp>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "BinaryData.h"
+#include "RfqReplayHarness.h"
+#include "UiUtils.h"
+
+#ifdef WIN32
+Q_IMPORT_PLUGIN(QWindowsIntegrationPlugin)
+#elif __linux__
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+#elif __APPLE__
+Q_IMPORT_PLUGIN(QCocoaIntegrationPlugin)
+#endif
+
+Q_DECLARE_METATYPE(std::string)
+Q_DECLARE_METATYPE(std::vector<BinaryData>)
+Q_DECLARE_METATYPE(BinaryData)
+
+int main(int argc, char** argv)
+{
+#ifdef _MSC_VER
+   WSADATA wsaData;
+   WORD wVersion = MAKEWORD(2, 0);
+   WSAStartup(wVersion, &wsaData);
+#endif
+
+   auto logger = spdlog::stdout_color_mt("stdout logger");
+
+   bool help{};
+   unsigned int requests{};
+   double rate{};
+   unsigned int mdIntervalMs{};
+   uint32_t seed{};
+   std::string traceFile;
+   std::string saveTraceFile;
+   std::string scriptFile;
+   double speed{};
+   unsigned int timeoutMs{};
+   std::string outFile;
+
+   cxxopts::Options options("rfq_replay", "Replays RFQ and market data trace through the dealer pipeline and AQ script");
+   options.add_options()
+      ("h,help", "Print help"
+         , cxxopts::value<bool>(help))
+      ("requests", "Number of quote requests in generated trace"
+         , cxxopts::value<unsigned int>(requests)->default_value("1000"))
+      ("rate", "Mean quote requests per second in generated trace"
+         , cxxopts::value<double>(rate)->default_value("100"))
+      ("md-interval", "Market data tick interval in generated trace, ms (0 - snapshot only)"
+         , cxxopts::value<unsigned int>(mdIntervalMs)->default_value("50"))
+      ("seed", "Random seed for generated trace"
+         , cxxopts::value<uint32_t>(seed)->default_value("1"))
+      ("trace", "Replay trace from file instead of generating it"
+         , cxxopts::value<std::string>(traceFile))
+      ("save-trace", "Save replayed trace to file"
+         , cxxopts::value<std::string>(saveTraceFile))
+      ("script", "AQ script. Default is bundled script replying at indicative price"
+         , cxxopts::value<std::string>(scriptFile))
+      ("speed", "Trace time multiplier (0 - replay as fast as possible)"
+         , cxxopts::value<double>(speed)->default_value("0"))
+      ("timeout", "Time to wait for replies after the last event, ms"
+         , cxxopts::value<unsigned int>(timeoutMs)->default_value("30000"))
+      ("out", "Output JSON file. Default is stdout"
+         , cxxopts::value<std::string>(outFile))
+   ;
+
+   try {
+      options.parse(argc, argv);
+   }
+   catch (const std::exception &e) {
+      SPDLOG_LOGGER_CRITICAL(logger, "parsing args failed: {}", e.what());
+      exit(EXIT_FAILURE);
+   }
+
+   if (help) {
+      std::cout << options.help() << std::endl;
+      exit(EXIT_SUCCESS);
+   }
+
+   logger->set_pattern("[%D %H:%M:%S.%e] [%l](%t) %s:%#:%!: %v");
+   logger->set_level(spdlog::level::warn);
+
+   QApplication app(argc, argv);
+   UiUtils::SetupLocale();
+
+   qRegisterMetaType<std::string>();
+   qRegisterMetaType<std::vector<BinaryData>>();
+   qRegisterMetaType<BinaryData>();
+
+   bs::bench::RfqTrace trace;
+   if (traceFile.empty()) {
+      bs::bench::RfqTraceParams traceParams;
+      traceParams.requests = requests;
+      traceParams.requestsPerSec = rate;
+      traceParams.mdInterval = std::chrono::milliseconds(mdIntervalMs);
+      traceParams.seed = seed;
+      trace = bs::bench::makeRfqTrace(traceParams);
+   }
+   else {
+      std::string error;
+      if (!bs::bench::loadRfqTrace(traceFile, trace, error)) {
+         SPDLOG_LOGGER_CRITICAL(logger, "loading trace failed: {}", error);
+         exit(EXIT_FAILURE);
+      }
+   }
+   if (!saveTraceFile.empty() && !bs::bench::saveRfqTrace(saveTraceFile, trace)) {
+      SPDLOG_LOGGER_CRITICAL(logger, "saving trace to {} failed", saveTraceFile);
+      exit(EXIT_FAILURE);
+   }
+
+   bs::bench::RfqReplayParams params;
+   params.scriptFileName = scriptFile;
+   params.speed = speed;
+   params.timeout = std::chrono::milliseconds(timeoutMs);
+
+   bs::bench::RfqReplayHarness harness(logger, params);
+   if (!harness.init()) {
+      SPDLOG_LOGGER_CRITICAL(logger, "failed to load AQ script");
+      exit(EXIT_FAILURE);
+   }
+   bs::bench::RfqReplayResult result;
+   if (!harness.run(trace, result)) {
+      exit(EXIT_FAILURE);
+   }
+
+   const auto json = result.toJson(params);
+   if (outFile.empty()) {
+      std::cout << json;
+   }
+   else {
+      std::ofstream out(outFile);
+      out << json;
+   }
+   return (result.replies == result.requests) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
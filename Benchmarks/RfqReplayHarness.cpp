@@ -0,0 +1,447 @@
+#include "RfqReplayHarness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QEventLoop>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <spdlog/spdlog.h>
+
+#include "ApplicationSettings.h"
+#include "AutoSignQuoteProvider.h"
+#include "BenchStats.h"
+#include "CelerClient.h"
+#include "ConnectionManager.h"
+#include "MDCallbacksQt.h"
+#include "MockAssetMgr.h"
+#include "QuoteProvider.h"
+#include "QuoteRequestsModel.h"
+#include "QuoteRequestsWidget.h"
+#include "RFQDealerReply.h"
+#include "UserScriptRunner.h"
+#include "UtxoReservationManager.h"
+
+using namespace bs::bench;
+
+namespace {
+
+   // Securities known to MockAssetManager with their typical prices
+   const std::vector<std::pair<std::string, double>> kFxSecurities = {
+      { "EUR/GBP", 0.86 }, { "EUR/SEK", 10.5 }, { "EUR/USD", 1.1 }, { "GBP/SEK", 12.2 }, { "USD/SEK", 9.5 }
+   };
+
+   const auto kExpiration = std::chrono::seconds(120);
+
+   // Replies once per request as soon as all indicative prices are known, so that
+   // measured latency is the one of the pipeline rather than of quoting logic
+   const char kReplayScript[] = R"(import bs.terminal 1.0
+
+BSQuoteReqReply {
+    property bool replied: false
+
+    onStarted: {
+        if (replied)    return
+        var price = quoteReq.isBuy ? indicAsk : indicBid
+        if (price > 0) {
+            replied = true
+            sendQuoteReply(price)
+        }
+    }
+
+    onRecycled: {
+        replied = false
+    }
+}
+)";
+
+   bs::network::MDFields mdFields(double bid, double ask, double last)
+   {
+      return {
+         bs::network::MDField{ bs::network::MDField::PriceBid, bid },
+         bs::network::MDField{ bs::network::MDField::PriceOffer, ask },
+         bs::network::MDField{ bs::network::MDField::PriceLast, last }
+      };
+   }
+
+   std::vector<std::string> split(const std::string &line)
+   {
+      std::vector<std::string> result;
+      std::stringstream ss(line);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+         result.push_back(item);
+      }
+      return result;
+   }
+
+   uint64_t toMicroseconds(std::chrono::steady_clock::duration d)
+   {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+   }
+
+}  // namespace
+
+
+RfqTrace bs::bench::makeRfqTrace(const RfqTraceParams &params)
+{
+   std::mt19937 gen(params.seed);
+   std::uniform_int_distribution<size_t> secDist(0, kFxSecurities.size() - 1);
+   std::uniform_real_distribution<double> pxDist(0.995, 1.005);
+   std::uniform_real_distribution<double> qtyDist(1, 1000);
+   std::exponential_distribution<double> arrivalDist(std::max(params.requestsPerSec, 0.001) / 1e6);
+
+   RfqTrace result;
+   const auto addMD = [&result, &gen, &pxDist](std::chrono::microseconds at, size_t secIdx) {
+      RfqTraceEvent event;
+      event.at = at;
+      event.type = RfqTraceEvent::Type::MarketData;
+      event.security = kFxSecurities[secIdx].first;
+      const double mid = kFxSecurities[secIdx].second * pxDist(gen);
+      event.mdFields = mdFields(mid * 0.9995, mid * 1.0005, mid);
+      result.emplace_back(std::move(event));
+   };
+
+   for (size_t i = 0; i < kFxSecurities.size(); ++i) {
+      addMD({}, i);
+   }
+
+   std::chrono::microseconds at{};
+   std::chrono::microseconds nextMD = params.mdInterval;
+   for (size_t i = 0; i < params.requests; ++i) {
+      at += std::chrono::microseconds(static_cast<int64_t>(arrivalDist(gen)));
+      while ((params.mdInterval.count() > 0) && (nextMD <= at)) {
+         addMD(nextMD, secDist(gen));
+         nextMD += params.mdInterval;
+      }
+
+      RfqTraceEvent event;
+      event.at = at;
+      event.type = RfqTraceEvent::Type::QuoteRequest;
+      auto &qrn = event.qrn;
+      qrn.quoteRequestId = "replay_rfq_" + std::to_string(i);
+      qrn.security = kFxSecurities[secDist(gen)].first;
+      qrn.product = qrn.security.substr(0, qrn.security.find('/'));
+      qrn.assetType = bs::network::Asset::SpotFX;
+      qrn.side = (i % 2) ? bs::network::Side::Buy : bs::network::Side::Sell;
+      qrn.quantity = std::round(qtyDist(gen));
+      qrn.status = bs::network::QuoteReqNotification::PendingAck;
+      result.emplace_back(std::move(event));
+   }
+   return result;
+}
+
+bool bs::bench::saveRfqTrace(const std::string &fileName, const RfqTrace &trace)
+{
+   std::ofstream out(fileName);
+   if (!out.good()) {
+      return false;
+   }
+   out.precision(10);
+   out << "# offset_us,rfq,reqId,security,product,side,quantity\n"
+      << "# offset_us,md,security,bid,ask,last\n";
+   for (const auto &event : trace) {
+      out << event.at.count() << ',';
+      if (event.type == RfqTraceEvent::Type::QuoteRequest) {
+         out << "rfq," << event.qrn.quoteRequestId << ',' << event.qrn.security << ','
+            << event.qrn.product << ',' << (event.qrn.side == bs::network::Side::Buy ? "buy" : "sell")
+            << ',' << event.qrn.quantity << '\n';
+      }
+      else {
+         out << "md," << event.security
+            << ',' << bs::network::MDField::get(event.mdFields, bs::network::MDField::PriceBid).value
+            << ',' << bs::network::MDField::get(event.mdFields, bs::network::MDField::PriceOffer).value
+            << ',' << bs::network::MDField::get(event.mdFields, bs::network::MDField::PriceLast).value
+            << '\n';
+      }
+   }
+   return out.good();
+}
+
+bool bs::bench::loadRfqTrace(const std::string &fileName, RfqTrace &trace, std::string &error)
+{
+   std::ifstream in(fileName);
+   if (!in.good()) {
+      error = "failed to open " + fileName;
+      return false;
+   }
+   trace.clear();
+   std::string line;
+   for (size_t lineNo = 1; std::getline(in, line); ++lineNo) {
+      if (line.empty() || (line[0] == '#')) {
+         continue;
+      }
+      const auto fields = split(line);
+      try {
+         RfqTraceEvent event;
+         if ((fields.size() == 7) && (fields[1] == "rfq")) {
+            event.type = RfqTraceEvent::Type::QuoteRequest;
+            auto &qrn = event.qrn;
+            qrn.quoteRequestId = fields[2];
+            qrn.security = fields[3];
+            qrn.product = fields[4];
+            qrn.side = (fields[5] == "buy") ? bs::network::Side::Buy : bs::network::Side::Sell;
+            qrn.quantity = std::stod(fields[6]);
+            qrn.assetType = bs::network::Asset::SpotFX;
+            qrn.status = bs::network::QuoteReqNotification::PendingAck;
+         }
+         else if ((fields.size() == 6) && (fields[1] == "md")) {
+            event.type = RfqTraceEvent::Type::MarketData;
+            event.security = fields[2];
+            event.mdFields = mdFields(std::stod(fields[3]), std::stod(fields[4]), std::stod(fields[5]));
+         }
+         else {
+            error = "line " + std::to_string(lineNo) + ": unknown event";
+            return false;
+         }
+         event.at = std::chrono::microseconds(std::stoll(fields[0]));
+         trace.emplace_back(std::move(event));
+      }
+      catch (const std::exception &e) {
+         error = "line " + std::to_string(lineNo) + ": " + e.what();
+         return false;
+      }
+   }
+   std::stable_sort(trace.begin(), trace.end(), [](const RfqTraceEvent &a, const RfqTraceEvent &b) {
+      return a.at < b.at;
+   });
+   return true;
+}
+
+
+std::string RfqReplayResult::toJson(const RfqReplayParams &params) const
+{
+   std::ostringstream ss;
+   ss << "{\n  \"params\": {\n    \"script\": \"" << params.scriptFileName
+      << "\",\n    \"speed\": " << params.speed
+      << ",\n    \"timeout_ms\": " << params.timeout.count()
+      << "\n  },\n  \"requests\": " << requests
+      << ",\n  \"replies\": " << replies
+      << ",\n  \"md_updates\": " << mdUpdates
+      << ",\n  \"duration_sec\": " << durationSec
+      << ",\n  \"replies_per_sec\": " << repliesPerSec
+      << ",\n  \"latency_us\": {\n    \"p50\": " << latencyP50us
+      << ",\n    \"p90\": " << latencyP90us
+      << ",\n    \"p99\": " << latencyP99us
+      << ",\n    \"max\": " << latencyMaxUs
+      << "\n  }\n}\n";
+   return ss.str();
+}
+
+
+struct RfqReplayHarness::Pipeline
+{
+   QTemporaryDir  scriptDir;
+   std::shared_ptr<ApplicationSettings>   appSettings;
+   std::shared_ptr<MockAssetManager>      assetMgr;
+   std::shared_ptr<ConnectionManager>     connMgr;
+   std::shared_ptr<BaseCelerClient>       celerClient;
+   std::shared_ptr<QuoteProvider>         quoteProvider;
+   std::shared_ptr<MDCallbacksQt>         mdCallbacks;
+   std::shared_ptr<bs::SecurityStatsCollector>  statsCollector;
+   std::shared_ptr<bs::UTXOReservationManager>  utxoReservationMgr;
+   std::shared_ptr<AutoSignQuoteProvider> autoSignProvider;
+   std::unique_ptr<QuoteRequestsModel>    quoteRequestsModel;
+   std::unique_ptr<bs::ui::RFQDealerReply>   dealerReply;
+
+   // Set for the duration of run()
+   std::function<void(const bs::network::QuoteNotification &)>   onReply;
+
+   ~Pipeline()
+   {
+      dealerReply.reset();
+      quoteRequestsModel.reset();
+      autoSignProvider.reset();
+      if (appSettings) {
+         QDir(appSettings->GetHomeDir()).removeRecursively();
+      }
+   }
+};
+
+RfqReplayHarness::RfqReplayHarness(const std::shared_ptr<spdlog::logger> &logger
+   , const RfqReplayParams &params)
+   : logger_(logger), params_(params)
+{}
+
+RfqReplayHarness::~RfqReplayHarness() noexcept = default;
+
+bool RfqReplayHarness::init()
+{
+   QStandardPaths::setTestModeEnabled(true);
+   auto p = std::make_unique<Pipeline>();
+
+   auto scriptFileName = QString::fromStdString(params_.scriptFileName);
+   if (scriptFileName.isEmpty()) {
+      scriptFileName = p->scriptDir.filePath(QStringLiteral("ReplayAutoQuote.qml"));
+      QFile scriptFile(scriptFileName);
+      if (!scriptFile.open(QIODevice::WriteOnly) || (scriptFile.write(kReplayScript) < 0)) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to write replay script to {}", scriptFileName.toStdString());
+         return false;
+      }
+   }
+
+   p->appSettings = std::make_shared<ApplicationSettings>(QLatin1String("BS_rfq_replay"));
+   p->appSettings->set(ApplicationSettings::initialized, true);
+   p->assetMgr = std::make_shared<MockAssetManager>(logger_);
+   p->assetMgr->init();
+   p->connMgr = std::make_shared<ConnectionManager>(logger_);
+   p->celerClient = std::make_shared<CelerClient>(p->connMgr);
+   p->quoteProvider = std::make_shared<QuoteProvider>(p->assetMgr, logger_);
+   p->mdCallbacks = std::make_shared<MDCallbacksQt>();
+   p->statsCollector = std::make_shared<bs::SecurityStatsCollector>(p->appSettings
+      , ApplicationSettings::Filter_MD_QN_cnt);
+   p->utxoReservationMgr = std::make_shared<bs::UTXOReservationManager>(nullptr, nullptr, logger_);
+   p->autoSignProvider = std::make_shared<AutoSignQuoteProvider>(logger_, p->assetMgr, p->quoteProvider
+      , p->appSettings, nullptr, p->mdCallbacks, p->celerClient);
+
+   p->quoteRequestsModel = std::make_unique<QuoteRequestsModel>(p->statsCollector, p->celerClient
+      , p->appSettings, nullptr);
+   p->quoteRequestsModel->SetAssetManager(p->assetMgr);
+   p->quoteRequestsModel->setPriceUpdateInterval(0);
+
+   p->dealerReply = std::make_unique<bs::ui::RFQDealerReply>();
+   p->dealerReply->init(logger_, nullptr, p->assetMgr, p->quoteProvider, p->appSettings, p->connMgr
+      , nullptr, nullptr, p->autoSignProvider, p->utxoReservationMgr);
+
+   // The same wiring as in RFQReplyWidget and QuoteRequestsWidget
+   auto *pipeline = p.get();
+   p->dealerReply->setSubmitQuoteNotifCb([pipeline](const std::shared_ptr<bs::ui::SubmitQuoteReplyData> &data) {
+      pipeline->statsCollector->onQuoteSubmitted(data->qn);
+      pipeline->quoteRequestsModel->onQuoteReqNotifReplied(data->qn);
+      if (pipeline->onReply) {
+         pipeline->onReply(data->qn);
+      }
+   });
+   QObject::connect(p->quoteProvider.get(), &QuoteProvider::quoteReqNotifReceived
+      , p->quoteRequestsModel.get(), &QuoteRequestsModel::onQuoteReqNotifReceived);
+   QObject::connect(p->mdCallbacks.get(), &MDCallbacksQt::MDUpdate, p->quoteRequestsModel.get()
+      , [model = p->quoteRequestsModel.get()](bs::network::Asset::Type, const QString &security
+         , bs::network::MDFields fields) {
+      model->onSecurityMDUpdated(security, fields);
+   });
+   QObject::connect(p->mdCallbacks.get(), &MDCallbacksQt::MDUpdate
+      , p->dealerReply.get(), &bs::ui::RFQDealerReply::onMDUpdate);
+
+   bool loaded = false;
+   QEventLoop loop;
+   auto *runner = p->autoSignProvider->autoQuoter();
+   QObject::connect(runner, &UserScriptRunner::aqScriptLoaded, &loop, [&loop, &loaded] {
+      loaded = true;
+      loop.quit();
+   });
+   QObject::connect(runner, &UserScriptRunner::failedToLoad, &loop, [this, &loop](const QString &, const QString &error) {
+      SPDLOG_LOGGER_ERROR(logger_, "AQ script failed to load: {}", error.toStdString());
+      loop.quit();
+   });
+   QTimer::singleShot(params_.timeout, &loop, &QEventLoop::quit);
+   runner->enableAQ(scriptFileName);
+   loop.exec();
+   if (!loaded) {
+      return false;
+   }
+
+   pipeline_ = std::move(p);
+   return true;
+}
+
+bool RfqReplayHarness::run(const RfqTrace &trace, RfqReplayResult &result)
+{
+   if (!pipeline_) {
+      SPDLOG_LOGGER_ERROR(logger_, "harness is not initialized");
+      return false;
+   }
+   result = {};
+   const auto idSuffix = "#" + std::to_string(++runCount_);
+
+   using clock = std::chrono::steady_clock;
+   std::unordered_map<std::string, clock::time_point> sentTime;
+   std::vector<uint64_t> latencies;
+   for (const auto &event : trace) {
+      if (event.type == RfqTraceEvent::Type::QuoteRequest) {
+         ++result.requests;
+      }
+   }
+   latencies.reserve(result.requests);
+
+   QEventLoop loop;
+   bool allSent = false;
+   pipeline_->onReply = [&](const bs::network::QuoteNotification &qn) {
+      const auto it = sentTime.find(qn.quoteRequestId);
+      if (it == sentTime.end()) {
+         return;     // not ours or already replied
+      }
+      latencies.push_back(toMicroseconds(clock::now() - it->second));
+      sentTime.erase(it);
+      if (allSent && (latencies.size() == result.requests)) {
+         loop.quit();
+      }
+   };
+
+   // Events are dispatched from the event loop so that the AQ thread and queued
+   // replies are processed while the trace is being replayed
+   size_t next = 0;
+   QTimer driver;
+   driver.setInterval(0);
+   const auto start = clock::now();
+   QObject::connect(&driver, &QTimer::timeout, [&] {
+      const auto elapsed = clock::now() - start;
+      for (; next < trace.size(); ++next) {
+         const auto &event = trace[next];
+         if ((params_.speed > 0)
+            && (std::chrono::duration_cast<clock::duration>(event.at / params_.speed) > elapsed)) {
+            break;
+         }
+         if (event.type == RfqTraceEvent::Type::QuoteRequest) {
+            auto qrn = event.qrn;
+            qrn.quoteRequestId += idSuffix;
+            qrn.expirationTime = QDateTime::currentDateTime().addSecs(kExpiration.count());
+            sentTime[qrn.quoteRequestId] = clock::now();
+            emit pipeline_->quoteProvider->quoteReqNotifReceived(qrn);
+         }
+         else {
+            emit pipeline_->mdCallbacks->MDUpdate(bs::network::Asset::SpotFX
+               , QString::fromStdString(event.security), event.mdFields);
+            ++result.mdUpdates;
+         }
+      }
+      if (next >= trace.size()) {
+         driver.stop();
+         allSent = true;
+         if (latencies.size() == result.requests) {
+            loop.quit();
+         }
+         else {
+            QTimer::singleShot(params_.timeout, &loop, &QEventLoop::quit);
+         }
+      }
+   });
+   driver.start();
+   loop.exec();
+   const auto elapsed = clock::now() - start;
+   driver.stop();
+   pipeline_->onReply = nullptr;
+
+   std::sort(latencies.begin(), latencies.end());
+   result.replies = latencies.size();
+   result.durationSec = std::chrono::duration<double>(elapsed).count();
+   if (result.durationSec > 0) {
+      result.repliesPerSec = result.replies / result.durationSec;
+   }
+   result.latencyP50us = percentile(latencies, 50);
+   result.latencyP90us = percentile(latencies, 90);
+   result.latencyP99us = percentile(latencies, 99);
+   result.latencyMaxUs = latencies.empty() ? 0 : static_cast<double>(latencies.back());
+
+   if (result.replies < result.requests) {
+      SPDLOG_LOGGER_WARN(logger_, "{} of {} requests were not replied", result.requests - result.replies
+         , result.requests);
+   }
+   return true;
+}
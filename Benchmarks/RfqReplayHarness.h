@@ -0,0 +1,104 @@
+#ifndef __RFQ_REPLAY_HARNESS_H__
+#define __RFQ_REPLAY_HARNESS_H__
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CommonTypes.h"
+
+namespace spdlog {
+   class logger;
+}
+
+namespace bs {
+   namespace bench {
+
+      struct RfqTraceEvent
+      {
+         enum class Type
+         {
+            QuoteRequest,
+            MarketData
+         };
+
+         std::chrono::microseconds  at{};    // offset from the start of the trace
+         Type  type = Type::MarketData;
+         bs::network::QuoteReqNotification   qrn;     // QuoteRequest
+         std::string             security;            // MarketData
+         bs::network::MDFields   mdFields;
+      };
+      using RfqTrace = std::vector<RfqTraceEvent>;
+
+      struct RfqTraceParams
+      {
+         size_t   requests = 1000;
+         double   requestsPerSec = 100;   // mean rate of Poisson arrivals
+         std::chrono::milliseconds  mdInterval{ 50 };  // one MD tick per interval for a random security
+         uint32_t seed = 1;
+      };
+
+      // Synthetic SpotFX stream: MD snapshot for all securities at start, then
+      // RFQs and MD ticks interleaved. Only SpotFX is generated as XBT and CC
+      // replies need wallets and signer, which the harness doesn't have.
+      RfqTrace makeRfqTrace(const RfqTraceParams &);
+
+      // Text trace, one event per line (lines starting with '#' are skipped):
+      //    <offset_us>,rfq,<reqId>,<security>,<product>,<buy|sell>,<quantity>
+      //    <offset_us>,md,<security>,<bid>,<ask>,<last>
+      bool saveRfqTrace(const std::string &fileName, const RfqTrace &);
+      bool loadRfqTrace(const std::string &fileName, RfqTrace &, std::string &error);
+
+      struct RfqReplayParams
+      {
+         std::string scriptFileName;   // AQ script, bundled replay script is used if empty
+         double   speed = 0;           // trace time multiplier, 0 - replay as fast as possible
+         std::chrono::milliseconds  timeout{ 30000 };  // for replies after the last event
+      };
+
+      struct RfqReplayResult
+      {
+         uint64_t requests = 0;
+         uint64_t replies = 0;      // requests with at least one submitted reply
+         uint64_t mdUpdates = 0;
+         double   durationSec = 0;
+         double   repliesPerSec = 0;
+         double   latencyP50us = 0;
+         double   latencyP90us = 0;
+         double   latencyP99us = 0;
+         double   latencyMaxUs = 0;
+
+         std::string toJson(const RfqReplayParams &) const;
+      };
+
+      // Dealer side of RFQ trading without Celer connection: trace events are
+      // delivered the way QuoteProvider and MDCallbacksQt deliver them to
+      // QuoteRequestsModel, RFQDealerReply and UserScriptRunner (which runs
+      // the AQ script in its own thread). Latency is measured from quote request
+      // notification to the first quote reply reaching RFQDealerReply's submit
+      // callback. Must be used from the thread of QApplication.
+      class RfqReplayHarness
+      {
+      public:
+         RfqReplayHarness(const std::shared_ptr<spdlog::logger> &, const RfqReplayParams &);
+         ~RfqReplayHarness() noexcept;
+
+         // Loads AQ script, returns false on failure
+         bool init();
+
+         // Can be called several times - request ids are made unique for each run
+         bool run(const RfqTrace &, RfqReplayResult &);
+
+      private:
+         struct Pipeline;
+
+         std::shared_ptr<spdlog::logger>  logger_;
+         const RfqReplayParams            params_;
+         std::unique_ptr<Pipeline>        pipeline_;
+         unsigned int   runCount_ = 0;
+      };
+
+   }  // namespace bench
+}  // namespace bs
+
+#endif // __RFQ_REPLAY_HARNESS_H__
@@ -0,0 +1,292 @@
+#include "ZmqBIP15XLoadGen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+#include "EncryptionUtils.h"
+#include "ZmqContext.h"
+#include "ZMQ_BIP15X_DataConnection.h"
+#include "ZMQ_BIP15X_ServerConnection.h"
+
+using namespace bs::bench;
+
+namespace {
+
+   const size_t kHeaderSize = 2 * sizeof(uint64_t);   // send timestamp + sequence number
+
+   uint64_t nowNs()
+   {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count());
+   }
+
+   class EchoServerListener : public ServerConnectionListener
+   {
+   public:
+      EchoServerListener(const std::shared_ptr<spdlog::logger> &logger, unsigned int rekeyInterval)
+         : logger_(logger), rekeyInterval_(rekeyInterval) {}
+      ~EchoServerListener() noexcept override = default;
+
+      void OnDataFromClient(const std::string &clientId, const std::string &data) override
+      {
+         if (!server_) {
+            return;
+         }
+         server_->SendDataToClient(clientId, data);
+         if (rekeyInterval_ && ((++msgCount_[clientId] % rekeyInterval_) == 0)) {
+            server_->rekey(clientId);
+            ++rekeys_;
+         }
+      }
+      void onClientError(const std::string &clientId, const std::string &errStr) override
+      {
+         ++errors_;
+         logger_->warn("[EchoServerListener] client {} error: {}"
+            , BinaryData::fromString(clientId).toHexStr(), errStr);
+      }
+      void OnClientConnected(const std::string &) override {}
+      void OnClientDisconnected(const std::string &) override {}
+
+      ZmqBIP15XServerConnection *server_{};
+      std::atomic<uint64_t>   rekeys_{};
+      std::atomic<uint64_t>   errors_{};
+
+   private:
+      std::shared_ptr<spdlog::logger>  logger_;
+      const unsigned int      rekeyInterval_;
+      std::unordered_map<std::string, uint64_t> msgCount_;  // accessed from server thread only
+   };
+
+   class LoadClient : public DataConnectionListener
+   {
+   public:
+      LoadClient(const std::shared_ptr<spdlog::logger> &logger, const ZmqLoadGenParams &params
+         , const std::vector<std::string> &payloads)
+         : logger_(logger), params_(params), payloads_(payloads)
+      {
+         ZmqBIP15XDataConnectionParams connParams;
+         connParams.ephemeralPeers = true;
+         conn_ = std::make_unique<ZmqBIP15XDataConnection>(logger, connParams);
+      }
+
+      void OnDataReceived(const std::string &data) override
+      {
+         if (data.size() < kHeaderSize) {
+            return;
+         }
+         uint64_t sendTs = 0;
+         memcpy(&sendTs, data.data(), sizeof(sendTs));
+         const auto rtt = nowNs() - sendTs;
+
+         std::unique_lock<std::mutex> lock(mutex_);
+         latencies_.push_back(rtt);
+         bytesRecv_ += data.size();
+         --inFlight_;
+         cv_.notify_all();
+      }
+      void OnConnected() override
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         connected_ = true;
+         cv_.notify_all();
+      }
+      void OnDisconnected() override {}
+      void OnError(DataConnectionError errorCode) override
+      {
+         logger_->warn("[LoadClient] connection error {}", int(errorCode));
+         std::unique_lock<std::mutex> lock(mutex_);
+         ++errors_;
+         failed_ = true;
+         cv_.notify_all();
+      }
+
+      ZmqBIP15XDataConnection *connection() const { return conn_.get(); }
+
+      bool waitConnected()
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         return cv_.wait_for(lock, std::chrono::seconds(10), [this] {
+            return connected_ || failed_;
+         }) && connected_;
+      }
+
+      void start(std::chrono::steady_clock::time_point deadline)
+      {
+         sender_ = std::thread([this, deadline] { sendLoop(deadline); });
+      }
+
+      void join()
+      {
+         if (sender_.joinable()) {
+            sender_.join();
+         }
+      }
+
+      std::vector<uint64_t>   latencies_;
+      uint64_t                bytesSent_ = 0;
+      uint64_t                bytesRecv_ = 0;
+      uint64_t                errors_ = 0;
+
+   private:
+      void sendLoop(std::chrono::steady_clock::time_point deadline)
+      {
+         uint64_t seqNo = 0;
+         while (std::chrono::steady_clock::now() < deadline) {
+            {
+               std::unique_lock<std::mutex> lock(mutex_);
+               cv_.wait_for(lock, std::chrono::milliseconds(100), [this] {
+                  return (inFlight_ < params_.window) || failed_;
+               });
+               if (failed_) {
+                  break;
+               }
+               if (inFlight_ >= params_.window) {
+                  continue;
+               }
+               ++inFlight_;
+            }
+            auto payload = payloads_[seqNo % payloads_.size()];
+            const auto sendTs = nowNs();
+            memcpy(&payload[0], &sendTs, sizeof(sendTs));
+            memcpy(&payload[sizeof(sendTs)], &seqNo, sizeof(seqNo));
+            ++seqNo;
+            bytesSent_ += payload.size();
+            conn_->send(payload);
+         }
+
+         // drain replies for messages which are still in flight
+         std::unique_lock<std::mutex> lock(mutex_);
+         cv_.wait_for(lock, std::chrono::seconds(5), [this] {
+            return (inFlight_ == 0) || failed_;
+         });
+      }
+
+   private:
+      std::shared_ptr<spdlog::logger>  logger_;
+      const ZmqLoadGenParams           &params_;
+      const std::vector<std::string>   &payloads_;
+      std::unique_ptr<ZmqBIP15XDataConnection>  conn_;
+      std::thread             sender_;
+      std::mutex              mutex_;
+      std::condition_variable cv_;
+      unsigned int            inFlight_ = 0;
+      bool                    connected_ = false;
+      bool                    failed_ = false;
+   };
+
+}  // namespace
+
+
+std::string ZmqLoadGenResult::toJson(const ZmqLoadGenParams &params) const
+{
+   std::ostringstream ss;
+   ss << "{\n  \"params\": {\n    \"msg_sizes\": [";
+   for (size_t i = 0; i < params.msgSizes.size(); ++i) {
+      ss << (i ? ", " : "") << params.msgSizes[i];
+   }
+   ss << "],\n    \"clients\": " << params.clients
+      << ",\n    \"duration_ms\": " << params.duration.count()
+      << ",\n    \"rekey_interval\": " << params.rekeyInterval
+      << ",\n    \"window\": " << params.window
+      << "\n  },\n  \"messages\": " << messages
+      << ",\n  \"bytes\": " << bytes
+      << ",\n  \"rekeys\": " << rekeys
+      << ",\n  \"errors\": " << errors
+      << ",\n  \"duration_sec\": " << durationSec
+      << ",\n  \"msg_per_sec\": " << msgPerSec
+      << ",\n  \"mb_per_sec\": " << mbPerSec
+      << ",\n  \"latency_us\": {\n    \"p50\": " << latencyP50us
+      << ",\n    \"p99\": " << latencyP99us
+      << ",\n    \"p999\": " << latencyP999us
+      << ",\n    \"max\": " << latencyMaxUs
+      << "\n  }\n}\n";
+   return ss.str();
+}
+
+
+ZmqBIP15XLoadGen::ZmqBIP15XLoadGen(const std::shared_ptr<spdlog::logger> &logger
+   , const ZmqLoadGenParams &params)
+   : logger_(logger), params_(params)
+{}
+
+ZmqBIP15XLoadGen::~ZmqBIP15XLoadGen() noexcept = default;
+
+bool ZmqBIP15XLoadGen::run(ZmqLoadGenResult &result)
+{
+   if (params_.msgSizes.empty() || !params_.clients || !params_.window) {
+      logger_->error("[ZmqBIP15XLoadGen::run] invalid parameters");
+      return false;
+   }
+   std::vector<std::string> payloads;
+   for (const auto size : params_.msgSizes) {
+      payloads.push_back(CryptoPRNG::generateRandom(std::max(size, kHeaderSize)).toBinStr());
+   }
+
+   EchoServerListener srvLsn(logger_, params_.rekeyInterval);
+   const auto zmqContext = std::make_shared<ZmqContext>(logger_);
+   auto serverConn = std::make_unique<ZmqBIP15XServerConnection>(logger_, zmqContext
+      , [] { return ZmqBIP15XPeers(); });
+   srvLsn.server_ = serverConn.get();
+
+   std::string port;
+   do {
+      port = std::to_string((rand() % 50000) + 10000);
+   } while (!serverConn->BindConnection(params_.host, port, &srvLsn));
+
+   std::vector<std::unique_ptr<LoadClient>> clients;
+   for (unsigned int i = 0; i < params_.clients; ++i) {
+      auto client = std::make_unique<LoadClient>(logger_, params_, payloads);
+      serverConn->addAuthPeer(ZmqBIP15XPeer("client" + std::to_string(i)
+         , client->connection()->getOwnPubKey()));
+      client->connection()->addAuthPeer(ZmqBIP15XPeer(params_.host + ":" + port
+         , serverConn->getOwnPubKey()));
+      if (!client->connection()->openConnection(params_.host, port, client.get())
+         || !client->waitConnected()) {
+         logger_->error("[ZmqBIP15XLoadGen::run] client #{} failed to connect", i);
+         return false;
+      }
+      clients.emplace_back(std::move(client));
+   }
+
+   const auto start = std::chrono::steady_clock::now();
+   const auto deadline = start + params_.duration;
+   for (auto &client : clients) {
+      client->start(deadline);
+   }
+   for (auto &client : clients) {
+      client->join();
+   }
+   const auto elapsed = std::chrono::steady_clock::now() - start;
+
+   std::vector<uint64_t> latencies;
+   result = {};
+   for (auto &client : clients) {
+      client->connection()->closeConnection();
+      latencies.insert(latencies.end(), client->latencies_.cbegin(), client->latencies_.cend());
+      result.bytes += client->bytesSent_ + client->bytesRecv_;
+      result.errors += client->errors_;
+   }
+   std::sort(latencies.begin(), latencies.end());
+
+   result.messages = latencies.size();
+   result.rekeys = srvLsn.rekeys_;
+   result.errors += srvLsn.errors_;
+   result.durationSec = std::chrono::duration<double>(elapsed).count();
+   if (result.durationSec > 0) {
+      result.msgPerSec = result.messages / result.durationSec;
+      result.mbPerSec = result.bytes / result.durationSec / 1e6;
+   }
+   result.latencyP50us = percentile(latencies, 50) / 1000;
+   result.latencyP99us = percentile(latencies, 99) / 1000;
+   result.latencyP999us = percentile(latencies, 99.9) / 1000;
+   result.latencyMaxUs = latencies.empty() ? 0 : latencies.back() / 1000.0;
+   return true;
+}
@@ -0,0 +1,65 @@
+#ifndef __ZMQ_BIP15X_LOAD_GEN_H__
+#define __ZMQ_BIP15X_LOAD_GEN_H__
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BenchStats.h"
+
+namespace spdlog {
+   class logger;
+}
+
+namespace bs {
+   namespace bench {
+
+      struct ZmqLoadGenParams
+      {
+         std::vector<size_t>  msgSizes{ 1024 };    // payload sizes are used round-robin
+         unsigned int   clients = 1;
+         std::chrono::milliseconds  duration{ 10000 };
+         unsigned int   rekeyInterval = 0;   // server rekeys client after that many messages, 0 - never
+         unsigned int   window = 20;         // max number of unanswered messages per client
+         std::string    host = "127.0.0.1";
+      };
+
+      struct ZmqLoadGenResult
+      {
+         uint64_t messages = 0;     // round-trips completed
+         uint64_t bytes = 0;        // payload bytes in both directions
+         uint64_t rekeys = 0;
+         uint64_t errors = 0;
+         double   durationSec = 0;
+         double   msgPerSec = 0;
+         double   mbPerSec = 0;
+         double   latencyP50us = 0;
+         double   latencyP99us = 0;
+         double   latencyP999us = 0;
+         double   latencyMaxUs = 0;
+
+         std::string toJson(const ZmqLoadGenParams &) const;
+      };
+
+      // Closed-loop load generator for ZmqBIP15XDataConnection/ZmqBIP15XServerConnection.
+      // Each client keeps up to `window` messages in flight, server echoes every
+      // message back and round-trip latency is measured on client side.
+      // Runs entirely on localhost and stops after params.duration.
+      class ZmqBIP15XLoadGen
+      {
+      public:
+         ZmqBIP15XLoadGen(const std::shared_ptr<spdlog::logger> &, const ZmqLoadGenParams &);
+         ~ZmqBIP15XLoadGen() noexcept;
+
+         // returns false if connection could not be established
+         bool run(ZmqLoadGenResult &);
+
+      private:
+         std::shared_ptr<spdlog::logger>  logger_;
+         const ZmqLoadGenParams           params_;
+      };
+
+   }  // namespace bench
+}  // namespace bs
+
+#endif // __ZMQ_BIP15X_LOAD_GEN_H__
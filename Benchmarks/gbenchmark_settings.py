@@ -0,0 +1,82 @@
+import multiprocessing
+import os
+import subprocess
+
+from component_configurator import Configurator
+
+
+class GBenchmarkSettings(Configurator):
+   def __init__(self, settings):
+      Configurator.__init__(self, settings)
+      self._version = '1.5.0'
+      self._package_name = 'benchmark-' + self._version
+      self._package_url = 'https://github.com/google/benchmark/archive/v' + self._version + '.tar.gz'
+      self._script_revision = '1'
+
+   def get_package_name(self):
+      return self._package_name
+
+   def get_revision_string(self):
+      return self._version + '-' + self._script_revision
+
+   def get_url(self):
+      return self._package_url
+
+   def get_install_dir(self):
+      return os.path.join(self._project_settings.get_common_build_dir(), 'GBenchmark')
+
+   def is_archive(self):
+      return True
+
+   def get_unpacked_sources_dir(self):
+      return os.path.join(self._project_settings.get_sources_dir(), self._package_name)
+
+   def get_build_config(self):
+      if self._project_settings.get_build_mode() == 'release':
+         return 'Release'
+      else:
+         return 'Debug'
+
+   def config(self):
+      command = ['cmake',
+                 self.get_unpacked_sources_dir(),
+                 '-G',
+                 self._project_settings.get_cmake_generator(),
+                 '-DCMAKE_BUILD_TYPE=' + self.get_build_config(),
+                 '-DCMAKE_INSTALL_PREFIX=' + self.get_install_dir(),
+                 '-DBENCHMARK_ENABLE_TESTING=OFF',
+                 '-DBENCHMARK_ENABLE_INSTALL=ON',
+                 '-DBENCHMARK_ENABLE_GTEST_TESTS=OFF',
+                 '-DBUILD_SHARED_LIBS=OFF']
+
+      # CMakeLists.txt expects benchmarkd.lib for debug and static CRT like the rest of 3rd party libs
+      if self._project_settings._is_windows:
+         command.append('-DCMAKE_DEBUG_POSTFIX=d')
+         if self._project_settings.get_link_mode() != 'shared':
+            command.append('-DCMAKE_CXX_FLAGS_DEBUG=/MTd /Zi /Ob0 /Od /RTC1')
+            command.append('-DCMAKE_CXX_FLAGS_RELEASE=/MT /O2 /Ob2 /DNDEBUG')
+
+      result = subprocess.call(command)
+      return result == 0
+
+   def make_windows(self):
+      return self.build_target(None)
+
+   def make_x(self):
+      return self.build_target(None)
+
+   def install_win(self):
+      return self.build_target('install')
+
+   def install_x(self):
+      return self.build_target('install')
+
+   def build_target(self, target):
+      command = ['cmake', '--build', '.', '--config', self.get_build_config()]
+      if target:
+         command += ['--target', target]
+      if not self._project_settings._is_windows:
+         command += ['--', '-j', str(multiprocessing.cpu_count())]
+
+      result = subprocess.call(command)
+      return result == 0
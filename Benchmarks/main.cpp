@@ -0,0 +1,90 @@
+#ifdef _MSC_VER
+#  include <winsock2.h>
+#endif
+
+#include <string>
+#include <vector>
+
+#include <QApplication>
+#include <QtPlugin>
+
+#include <benchmark/benchmark.h>
+#include <btc/ecc.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include "BenchData.h"
+#include "BinaryData.h"
+#include "BIP150_151.h"
+#include "BlockDataManagerConfig.h"
+#include "UiUtils.h"
+
+#ifdef WIN32
+Q_IMPORT_PLUGIN(QWindowsIntegrationPlugin)
+#elif __linux__
+Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+#elif __APPLE__
+Q_IMPORT_PLUGIN(QCocoaIntegrationPlugin)
+#endif
+
+Q_DECLARE_METATYPE(std::string)
+Q_DECLARE_METATYPE(std::vector<BinaryData>)
+Q_DECLARE_METATYPE(BinaryData)
+
+namespace {
+   const std::string kOutOption = "--benchmark_out=";
+   const std::string kDefaultOutput = "terminal_benchmarks.json";
+}
+
+int main(int argc, char** argv)
+{
+#ifdef _MSC_VER
+   WSADATA wsaData;
+   WORD wVersion = MAKEWORD(2, 0);
+   WSAStartup(wVersion, &wsaData);
+#endif
+
+   bs::bench::logger() = spdlog::basic_logger_mt("terminal_benchmarks", "terminal_benchmarks.log");
+   bs::bench::logger()->set_pattern("[%D %H:%M:%S.%e] [%l](%t) %s:%#:%!: %v");
+   bs::bench::logger()->set_level(spdlog::level::info);
+
+   btc_ecc_start();
+   startupBIP151CTX();
+   startupBIP150CTX(4, true);
+   NetworkConfig::selectNetwork(NETWORK_MODE_TESTNET);
+
+   // Results are always written as JSON so that they can be compared between
+   // releases - unless the caller has chosen a different output explicitly.
+   std::vector<std::string> extraArgs;
+   bool hasOutput = false;
+   for (int i = 1; i < argc; ++i) {
+      if (std::string(argv[i]).compare(0, kOutOption.size(), kOutOption) == 0) {
+         hasOutput = true;
+         break;
+      }
+   }
+   if (!hasOutput) {
+      extraArgs.push_back(kOutOption + kDefaultOutput);
+      extraArgs.push_back("--benchmark_out_format=json");
+   }
+   std::vector<char *> args(argv, argv + argc);
+   for (auto &arg : extraArgs) {
+      args.push_back(&arg[0]);
+   }
+   int benchArgc = static_cast<int>(args.size());
+   args.push_back(nullptr);
+
+   QApplication app(benchArgc, args.data());
+   UiUtils::SetupLocale();
+
+   qRegisterMetaType<std::string>();
+   qRegisterMetaType<std::vector<BinaryData>>();
+   qRegisterMetaType<BinaryData>();
+
+   benchmark::Initialize(&benchArgc, args.data());
+   if (benchmark::ReportUnrecognizedArguments(benchArgc, args.data())) {
+      return 1;
+   }
+   benchmark::RunSpecifiedBenchmarks();
+   return 0;
+}
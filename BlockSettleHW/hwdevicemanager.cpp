@@ -28,6 +28,8 @@ HwDeviceManager::HwDeviceManager(const std::shared_ptr<ConnectionManager>& conne
    ledgerClient_ = std::make_unique<LedgerClient>(connectionManager->GetLogger(), walletManager, testNet);
 
    model_ = new HwDeviceModel(this);
+
+   connect(ledgerClient_.get(), &LedgerClient::devicesChanged, this, &HwDeviceManager::onLedgerDevicesChanged);
 }
 
 HwDeviceManager::~HwDeviceManager() = default;
@@ -116,6 +118,15 @@ void HwDeviceManager::prepareHwDeviceForSign(QString walletId)
    // #TREZOR_INTEGRATION:  bad way to distinguish device type
    // we need better here
    if (deviceId == kDeviceLedgerId) {
+      // Device initialized before and not unplugged since then is used without rescan
+      for (const auto &key : ledgerClient_->deviceKeys()) {
+         if (key.walletId_ == walletId) {
+            model_->resetModel({ key });
+            emit deviceReady(QString::fromStdString(deviceId));
+            return;
+         }
+      }
+
       ledgerClient_->scanDevices([caller = QPointer<HwDeviceManager>(this), deviceId, walletId]() {
          if (!caller) {
             return;
@@ -262,6 +273,26 @@ void HwDeviceManager::scanningDone()
    emit devicesChanged();
 }
 
+void HwDeviceManager::onLedgerDevicesChanged()
+{
+   if (isScanning_) {
+      return;  // model is reset when scanning is done
+   }
+
+   // Remove unplugged devices from the list
+   QVector<DeviceKey> keys;
+   for (int i = 0; i < model_->rowCount(); ++i) {
+      auto key = model_->getDevice(i);
+      if (getDevice(key)) {
+         keys.push_back(std::move(key));
+      }
+   }
+   if (keys.size() != model_->rowCount()) {
+      model_->resetModel(std::move(keys));
+      emit devicesChanged();
+   }
+}
+
 QPointer<HwDeviceInterface> HwDeviceManager::getDevice(DeviceKey key)
 {
    switch (key.type_)
@@ -79,6 +79,7 @@ private:
    void setScanningFlag(bool isScanning);
    void releaseConnection(AsyncCallBack&& cb = nullptr);
    void scanningDone();
+   void onLedgerDevicesChanged();
 
    QPointer<HwDeviceInterface> getDevice(DeviceKey key);
 
@@ -16,7 +16,8 @@
 
 #include "ledger/ledgerClient.h"
 #include "ledger/ledgerDevice.h"
-#include "ledger/hidapi/hidapi.h"
+#include "ledger/ledgerDeviceWatcher.h"
+#include "ledger/ledgerHidBackend.h"
 #include <spdlog/logger.h>
 #include "Wallets/SyncWalletsManager.h"
 
@@ -24,29 +25,22 @@
 #include <QByteArray>
 
 
-namespace {
-   HidDeviceInfo fromHidOriginal(hid_device_info* info) {
-      return {
-         QString::fromUtf8(info->path),
-         info->vendor_id, 
-         info->product_id,
-         QString::fromWCharArray(info->serial_number),
-         info->release_number,
-         QString::fromWCharArray(info->manufacturer_string),
-         QString::fromWCharArray(info->product_string),
-         info->usage_page,
-         info->usage,
-         info->interface_number,
-      };
-   }
-}
-
-LedgerClient::LedgerClient(std::shared_ptr<spdlog::logger> logger, std::shared_ptr<bs::sync::WalletsManager> walletManager, bool testNet, QObject *parent /*= nullptr*/)
+LedgerClient::LedgerClient(std::shared_ptr<spdlog::logger> logger, std::shared_ptr<bs::sync::WalletsManager> walletManager, bool testNet, QObject *parent /*= nullptr*/
+   , const std::shared_ptr<LedgerHidBackend> &backend /*= nullptr*/)
    : QObject(parent)
    , logger_(logger)
    , testNet_(testNet)
    , walletManager_(walletManager)
 {
+   watcher_ = new LedgerDeviceWatcher(backend ? backend : std::make_shared<HidApiBackend>()
+      , std::chrono::seconds(2), this);
+   connect(watcher_, &LedgerDeviceWatcher::devicesChanged, this, &LedgerClient::onDevicesChanged);
+   watcher_->start();
+}
+
+LedgerClient::~LedgerClient()
+{
+   watcher_->stop();
 }
 
 QVector<DeviceKey> LedgerClient::deviceKeys() const
@@ -54,7 +48,7 @@ QVector<DeviceKey> LedgerClient::deviceKeys() const
    QVector<DeviceKey> keys;
    keys.reserve(availableDevices_.size());
    for (const auto device : availableDevices_) {
-      if (device->inited()) {
+      if (device && device->inited()) {
          keys.push_back(device->key());
       }      
    }
@@ -64,7 +58,7 @@ QVector<DeviceKey> LedgerClient::deviceKeys() const
 QPointer<LedgerDevice> LedgerClient::getDevice(const QString& deviceId)
 {
    for (auto device : availableDevices_) {
-      if (device->key().deviceId_ == deviceId) {
+      if (device && device->key().deviceId_ == deviceId) {
          return device;
       }
    }
@@ -79,46 +73,77 @@ QString LedgerClient::lastScanError() const
 
 void LedgerClient::scanDevices(AsyncCallBack&& cb)
 {
-   availableDevices_.clear();
-
-   hid_device_info* info = hid_enumerate(0, 0);
-   for (; info; info = info->next) {
-      if (info->vendor_id == Ledger::HID_VENDOR_ID &&
-         (info->interface_number == Ledger::HID_INTERFACE_NUMBER
-            || info->usage_page == Ledger::HID_USAGE_PAGE)) {
-
-         auto device = new LedgerDevice{ fromHidOriginal(info), testNet_, walletManager_, logger_, this };
-         availableDevices_.push_back({ device });
+   watcher_->scan([caller = QPointer<LedgerClient>(this), cbCopy = std::move(cb)]
+      (const QVector<HidDeviceInfo> &devices) {
+      if (!caller) {
+         return;
       }
-   }
+      caller->updateDevices(devices);
 
-   if (availableDevices_.empty()) {
-      logger_->error(
-         "[LedgerClient] scanDevices - No ledger device available");
-   }
-   else {
-      logger_->info(
+      if (caller->availableDevices_.empty()) {
+         caller->logger_->error(
+            "[LedgerClient] scanDevices - No ledger device available");
+         if (cbCopy) {
+            cbCopy();
+         }
+         return;
+      }
+      caller->logger_->info(
          "[LedgerClient] scanDevices - Enumerate request succeeded. Total device available : "
-         + QString::number(availableDevices_.size()).toUtf8() + ".");
-   }
-
-   hid_exit();
+         + QString::number(caller->availableDevices_.size()).toUtf8() + ".");
 
-   // Init first one
-   if (availableDevices_.empty()) {
-      if (cb) {
-         cb();
+      // Init first one, unless it's ready since previous scan
+      const auto device = caller->availableDevices_[0];
+      if (device->inited()) {
+         caller->lastScanError_.clear();
+         if (cbCopy) {
+            cbCopy();
+         }
+         return;
       }
-   }
-   else {
-      auto cbSaveScanError = [caller = QPointer<LedgerClient>(this), cbCopy = std::move(cb)]() {
-         caller->lastScanError_ = caller->availableDevices_[0]->lastError();
+
+      auto cbSaveScanError = [caller, device, cbCopy]() {
+         if (!caller) {
+            return;
+         }
+         if (device) {
+            caller->lastScanError_ = device->lastError();
+         }
 
          if (cbCopy) {
             cbCopy();
          }
       };
 
-      availableDevices_[0]->init(std::move(cbSaveScanError));
+      device->init(std::move(cbSaveScanError));
+   });
+}
+
+void LedgerClient::onDevicesChanged()
+{
+   updateDevices(watcher_->devices());
+   emit devicesChanged();
+}
+
+void LedgerClient::updateDevices(const QVector<HidDeviceInfo> &hidDevices)
+{
+   QVector<QPointer<LedgerDevice>> devices;
+   devices.reserve(hidDevices.size());
+   for (const auto &info : hidDevices) {
+      QPointer<LedgerDevice> device;
+      for (const auto &existing : availableDevices_) {
+         if (existing && (existing->path() == info.path_)) {
+            device = existing;
+            break;
+         }
+      }
+      if (!device) {
+         device = new LedgerDevice{ HidDeviceInfo(info), testNet_, walletManager_, logger_, this };
+      }
+      devices.push_back(device);
    }
+
+   // Unplugged devices are only dropped from the list: command thread could be
+   // still running for them, they are released together with the client
+   availableDevices_ = std::move(devices);
 }
@@ -13,9 +13,12 @@
 
 #include "ledgerStructure.h"
 
+#include <memory>
 #include <QVector>
 
 class LedgerDevice;
+class LedgerDeviceWatcher;
+class LedgerHidBackend;
 namespace spdlog {
    class logger;
 }
@@ -29,9 +32,12 @@ class LedgerClient : public QObject
 {
    Q_OBJECT
 public:
-   LedgerClient(std::shared_ptr<spdlog::logger> logger, std::shared_ptr<bs::sync::WalletsManager> walletManager, bool testNet, QObject *parent = nullptr);
-   ~LedgerClient() override = default;
+   LedgerClient(std::shared_ptr<spdlog::logger> logger, std::shared_ptr<bs::sync::WalletsManager> walletManager, bool testNet, QObject *parent = nullptr
+      , const std::shared_ptr<LedgerHidBackend> &backend = nullptr);
+   ~LedgerClient() override;
 
+   // Enumeration runs in watcher thread, then the first device is initialized
+   // unless it was initialized already (devices are kept until unplugged)
    void scanDevices(AsyncCallBack&& cb);
 
    QVector<DeviceKey> deviceKeys() const;
@@ -40,6 +46,14 @@ public:
 
    QString lastScanError() const;
 
+signals:
+   // Device plugged or unplugged
+   void devicesChanged();
+
+private:
+   void onDevicesChanged();
+   void updateDevices(const QVector<HidDeviceInfo> &);
+
 private:
    QVector<QPointer<LedgerDevice>> availableDevices_;
    bool testNet_;
@@ -47,6 +61,7 @@ private:
 
    std::shared_ptr<spdlog::logger> logger_;
    std::shared_ptr<bs::sync::WalletsManager> walletManager_;
+   LedgerDeviceWatcher *watcher_{};
 
 };
 
@@ -11,6 +11,7 @@
 #include "spdlog/logger.h"
 #include "ledger/ledgerDevice.h"
 #include "ledger/ledgerClient.h"
+#include "ledger/ledgerHidBackend.h"
 #include "Assets.h"
 #include "ProtobufHeadlessUtils.h"
 #include "CoreWallet.h"
@@ -1117,6 +1118,7 @@ void LedgerCommandThread::debugPrintLegacyResult(const QByteArray& responseSigne
 
 bool LedgerCommandThread::initDevice()
 {
+   std::lock_guard<std::mutex> lock(hidApiMutex());
    if (hid_init() < 0) {
       logger_->info(
          "[LedgerCommandThread] getPublicKey - Cannot init hid.");
@@ -1135,6 +1137,7 @@ bool LedgerCommandThread::initDevice()
 void LedgerCommandThread::releaseDevice()
 {
    if (dongle_) {
+      std::lock_guard<std::mutex> lock(hidApiMutex());
       hid_close(dongle_);
       hid_exit();
       dongle_ = nullptr;
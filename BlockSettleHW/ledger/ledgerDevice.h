@@ -58,6 +58,10 @@ public:
       return !xpubRoot_.empty();
    }
 
+   QString path() const {
+      return hidDeviceInfo_.path_;
+   }
+
    bool isBlocked() override {
       return isBlocked_;
    }
@@ -0,0 +1,121 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "ledger/ledgerDeviceWatcher.h"
+#include "ledger/ledgerHidBackend.h"
+
+#include <QSet>
+
+namespace {
+   QSet<QString> devicePaths(const QVector<HidDeviceInfo> &devices)
+   {
+      QSet<QString> result;
+      for (const auto &device : devices) {
+         result.insert(device.path_);
+      }
+      return result;
+   }
+}
+
+LedgerDeviceWatcher::LedgerDeviceWatcher(const std::shared_ptr<LedgerHidBackend> &backend
+   , std::chrono::milliseconds pollInterval, QObject *parent)
+   : QObject(parent)
+   , backend_(backend)
+   , pollInterval_(pollInterval)
+{}
+
+LedgerDeviceWatcher::~LedgerDeviceWatcher()
+{
+   stop();
+}
+
+void LedgerDeviceWatcher::start()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   if (!stopped_) {
+      return;
+   }
+   stopped_ = false;
+   thread_ = std::thread(&LedgerDeviceWatcher::run, this);
+}
+
+void LedgerDeviceWatcher::stop()
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopped_) {
+         return;
+      }
+      stopped_ = true;
+   }
+   cv_.notify_one();
+   if (thread_.joinable()) {
+      thread_.join();
+   }
+}
+
+void LedgerDeviceWatcher::scan(ScanCb &&cb)
+{
+   bool stopped = false;
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      scanCallbacks_.push_back(std::move(cb));
+      stopped = stopped_;
+   }
+   if (stopped) {
+      start();
+   }
+   else {
+      cv_.notify_one();
+   }
+}
+
+void LedgerDeviceWatcher::run()
+{
+   bool firstRun = true;
+   while (true) {
+      std::vector<ScanCb> callbacks;
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         if (!firstRun) {
+            cv_.wait_for(lock, pollInterval_, [this] {
+               return stopped_ || !scanCallbacks_.empty();
+            });
+         }
+         if (stopped_) {
+            break;
+         }
+         callbacks.swap(scanCallbacks_);
+      }
+      firstRun = false;
+
+      const auto devices = backend_->enumerate();
+      QMetaObject::invokeMethod(this, [this, devices, callbacks] {
+         onEnumerated(devices, callbacks);
+      });
+   }
+}
+
+void LedgerDeviceWatcher::onEnumerated(const QVector<HidDeviceInfo> &devices
+   , const std::vector<ScanCb> &callbacks)
+{
+   const bool changed = !enumerated_ || (devicePaths(devices) != devicePaths(devices_));
+   enumerated_ = true;
+   devices_ = devices;
+   if (changed) {
+      emit devicesChanged();
+   }
+
+   for (const auto &cb : callbacks) {
+      if (cb) {
+         cb(devices_);
+      }
+   }
+}
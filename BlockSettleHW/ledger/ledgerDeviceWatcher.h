@@ -0,0 +1,72 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef LEDGERDEVICEWATCHER_H
+#define LEDGERDEVICEWATCHER_H
+
+#include "ledger/ledgerStructure.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QObject>
+#include <QVector>
+
+class LedgerHidBackend;
+
+// Enumerates HID devices in a worker thread. hidapi has no portable hotplug
+// events, so the list is polled and devicesChanged() is emitted in the owner
+// thread only when a device was plugged or unplugged.
+class LedgerDeviceWatcher : public QObject
+{
+   Q_OBJECT
+public:
+   using ScanCb = std::function<void(const QVector<HidDeviceInfo> &)>;
+
+   LedgerDeviceWatcher(const std::shared_ptr<LedgerHidBackend> &
+      , std::chrono::milliseconds pollInterval = std::chrono::seconds(2)
+      , QObject *parent = nullptr);
+   ~LedgerDeviceWatcher() override;
+
+   void start();
+   void stop();
+
+   // Requests enumeration without waiting for poll interval (starts polling
+   // if it's stopped), callback is invoked in the owner thread
+   void scan(ScanCb &&);
+
+   // Last enumerated devices
+   QVector<HidDeviceInfo> devices() const { return devices_; }
+
+signals:
+   void devicesChanged();
+
+private:
+   void run();
+   void onEnumerated(const QVector<HidDeviceInfo> &, const std::vector<ScanCb> &);
+
+private:
+   std::shared_ptr<LedgerHidBackend>   backend_;
+   const std::chrono::milliseconds     pollInterval_;
+   QVector<HidDeviceInfo>  devices_;
+   bool  enumerated_{ false };
+
+   std::thread thread_;
+   std::mutex  mutex_;
+   std::condition_variable cv_;
+   std::vector<ScanCb>  scanCallbacks_;
+   bool  stopped_{ true };
+};
+
+#endif // LEDGERDEVICEWATCHER_H
@@ -0,0 +1,53 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "ledger/ledgerHidBackend.h"
+#include "ledger/hidapi/hidapi.h"
+
+namespace {
+   HidDeviceInfo fromHidOriginal(hid_device_info* info) {
+      return {
+         QString::fromUtf8(info->path),
+         info->vendor_id,
+         info->product_id,
+         QString::fromWCharArray(info->serial_number),
+         info->release_number,
+         QString::fromWCharArray(info->manufacturer_string),
+         QString::fromWCharArray(info->product_string),
+         info->usage_page,
+         info->usage,
+         info->interface_number,
+      };
+   }
+}
+
+std::mutex &hidApiMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+QVector<HidDeviceInfo> HidApiBackend::enumerate()
+{
+   QVector<HidDeviceInfo> result;
+
+   std::lock_guard<std::mutex> lock(hidApiMutex());
+   hid_device_info* devices = hid_enumerate(Ledger::HID_VENDOR_ID, 0);
+   for (auto info = devices; info; info = info->next) {
+      if (info->vendor_id == Ledger::HID_VENDOR_ID &&
+         (info->interface_number == Ledger::HID_INTERFACE_NUMBER
+            || info->usage_page == Ledger::HID_USAGE_PAGE)) {
+         result.push_back(fromHidOriginal(info));
+      }
+   }
+   hid_free_enumeration(devices);
+
+   return result;
+}
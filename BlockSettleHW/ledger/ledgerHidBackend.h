@@ -0,0 +1,39 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef LEDGERHIDBACKEND_H
+#define LEDGERHIDBACKEND_H
+
+#include "ledger/ledgerStructure.h"
+
+#include <mutex>
+#include <QVector>
+
+// Source of connected Ledger HID interfaces. Called from device watcher thread,
+// tests substitute it to simulate devices plugging in and out.
+class LedgerHidBackend
+{
+public:
+   virtual ~LedgerHidBackend() = default;
+
+   virtual QVector<HidDeviceInfo> enumerate() = 0;
+};
+
+class HidApiBackend : public LedgerHidBackend
+{
+public:
+   QVector<HidDeviceInfo> enumerate() override;
+};
+
+// hidapi keeps global state: hid_init/hid_exit must not interleave with
+// enumeration running in another thread
+std::mutex &hidApiMutex();
+
+#endif // LEDGERHIDBACKEND_H
@@ -27,6 +27,7 @@
 #include "SignerAdapterListener.h"
 #include "SignerVersion.h"
 #include "SystemFileUtils.h"
+#include "UnixSocketConnection.h"
 #include "ZmqContext.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
 
@@ -45,6 +46,52 @@ HeadlessAppObj::HeadlessAppObj(const std::shared_ptr<spdlog::logger> &logger
 
    walletsMgr_ = std::make_shared<bs::core::WalletsManager>(logger);
 
+   // Preferred transport is tried first, the other one is a fallback
+   bool bound = false;
+   if (settings_->interfaceUnixSocket()) {
+      bound = bindGuiUnixSocket();
+      if (!bound) {
+         logger_->warn("Unix socket adapter connection unavailable, falling back to ZMQ");
+         bound = bindGuiZmq();
+      }
+   }
+   else {
+      bound = bindGuiZmq() || bindGuiUnixSocket();
+   }
+   if (!bound) {
+      throw std::runtime_error("failed to bind adapter socket");
+   }
+
+   logger_->info("BS Signer {} started", SIGNER_VERSION_STRING);
+
+   terminalListener_ = std::make_unique<HeadlessContainerListener>(logger_
+      , walletsMgr_, queue_, settings_->getWalletsDir(), settings_->netType());
+   terminalListener_->setCallbacks(guiListener_->callbacks());
+}
+
+bool HeadlessAppObj::bindGuiUnixSocket()
+{
+#ifndef WIN32
+   const auto socketPath = SystemFilePaths::appDataLocation() + "/signer_ui_"
+      + std::to_string(getpid()) + ".sock";
+   auto connection = std::make_unique<UnixSocketServerConnection>(logger_);
+   auto listener = std::make_unique<SignerAdapterListener>(this, connection.get()
+      , logger_, walletsMgr_, queue_, settings_);
+   if (!connection->BindConnection(socketPath, {}, listener.get())) {
+      logger_->error("Failed to bind adapter connection to {}", socketPath);
+      return false;
+   }
+   settings_->setInterfaceSocketPath(socketPath);
+   guiListener_ = std::move(listener);
+   guiConnection_ = std::move(connection);
+   return true;
+#else
+   return false;
+#endif
+}
+
+bool HeadlessAppObj::bindGuiZmq()
+{
    // Only the SignerListener's cookie will be trusted. Supply an empty set of
    // non-cookie trusted clients.
    const auto &cbTrustedClientsSL = [] {
@@ -56,38 +103,35 @@ HeadlessAppObj::HeadlessAppObj(const std::shared_ptr<spdlog::logger> &logger
    const std::string absCookiePath = SystemFilePaths::appDataLocation() + "/adapterClientID";
 
    const auto zmqContext = std::make_shared<ZmqContext>(logger_);
-   guiConnection_ = std::make_unique<ZmqBIP15XServerConnection>(logger_
+   auto zmqConnection = std::make_unique<ZmqBIP15XServerConnection>(logger_
       , zmqContext, cbTrustedClientsSL, "", ""
       , makeServerCookie, readClientCookie, absCookiePath);
-   guiListener_ = std::make_unique<SignerAdapterListener>(this, guiConnection_.get()
-      , logger_, walletsMgr_, queue_, params);
+   auto listener = std::make_unique<SignerAdapterListener>(this, zmqConnection.get()
+      , logger_, walletsMgr_, queue_, settings_);
 
-   settings_->setServerIdKey(guiListener_->getServerConn()->getOwnPubKey());
-
-   guiConnection_->setLocalHeartbeatInterval();
+   zmqConnection->setLocalHeartbeatInterval();
 
    int port = 0;
    bool success = false;
    int count = 0;
    while (count < 3 && !success) {
       port = 10000 + rand() % 50000;
-      success = guiConnection_->BindConnection("127.0.0.1", std::to_string(port)
-         , guiListener_.get());
+      success = zmqConnection->BindConnection("127.0.0.1", std::to_string(port)
+         , listener.get());
       count += 1;
    }
 
    if (!success) {
       logger_->error("Failed to bind adapter connection");
-      throw std::runtime_error("failed to bind adapter socket");
+      return false;
    }
 
+   settings_->setServerIdKey(zmqConnection->getOwnPubKey());
    settings_->setInterfacePort(port);
-
-   logger_->info("BS Signer {} started", SIGNER_VERSION_STRING);
-
-   terminalListener_ = std::make_unique<HeadlessContainerListener>(logger_
-      , walletsMgr_, queue_, settings_->getWalletsDir(), settings_->netType());
-   terminalListener_->setCallbacks(guiListener_->callbacks());
+   settings_->setInterfaceSocketPath({});
+   guiListener_ = std::move(listener);
+   guiConnection_ = std::move(zmqConnection);
+   return true;
 }
 
 HeadlessAppObj::~HeadlessAppObj() noexcept = default;
@@ -282,26 +326,36 @@ void HeadlessAppObj::startTerminalsProcessing()
       return retKeys;
    };
 
-   // This would stop old server if any
-   terminalConnection_ = std::make_unique<ZmqBIP15XServerConnection>(logger_, zmqContext
-      , getClientIDKeys, ourKeyFileDir, ourKeyFileName, makeServerCookie, false
-      , absTermCookiePath);
-
-   terminalConnection_->setLocalHeartbeatInterval();
-   if (!settings_->acceptFrom().empty()) {
-      terminalConnection_->setListenFrom({settings_->acceptFrom()});
-   }
    terminalListener_->SetLimits(settings_->limits());
 
-   terminalListener_->resetConnection(terminalConnection_.get());
+   // Local terminal may be served over Unix domain socket, ZMQ is a fallback
+   bool result = false;
+   if (!settings_->terminalSocketPath().empty()) {
+      result = bindTerminalUnixSocket();
+   }
+   if (!result) {
+      auto zmqConnection = std::make_unique<ZmqBIP15XServerConnection>(logger_, zmqContext
+         , getClientIDKeys, ourKeyFileDir, ourKeyFileName, makeServerCookie, false
+         , absTermCookiePath);
+      zmqConnection->setLocalHeartbeatInterval();
+      if (!settings_->acceptFrom().empty()) {
+         zmqConnection->setListenFrom({settings_->acceptFrom()});
+      }
+      terminalListener_->resetConnection(zmqConnection.get());
 
-   bool result = terminalConnection_->BindConnection(settings_->listenAddress()
-      , std::to_string(settings_->listenPort()), terminalListener_.get());
+      result = zmqConnection->BindConnection(settings_->listenAddress()
+         , std::to_string(settings_->listenPort()), terminalListener_.get());
+      if (result) {
+         terminalConnection_ = std::move(zmqConnection);
+      }
+      else {
+         terminalListener_->resetConnection(nullptr);
+         logger_->error("Failed to bind to {}:{}"
+            , settings_->listenAddress(), settings_->listenPort());
+      }
+   }
 
    if (!result) {
-      logger_->error("Failed to bind to {}:{}"
-         , settings_->listenAddress(), settings_->listenPort());
-
       // Abort only if litegui used, fullgui should just show error message instead
       if (settings_->runMode() == bs::signer::RunMode::litegui) {
          throw std::runtime_error("failed to bind listening socket");
@@ -311,6 +365,26 @@ void HeadlessAppObj::startTerminalsProcessing()
    signerBindStatus_ = result ? bs::signer::BindStatus::Succeed : bs::signer::BindStatus::Failed;
 }
 
+bool HeadlessAppObj::bindTerminalUnixSocket()
+{
+#ifndef WIN32
+   const auto socketPath = settings_->terminalSocketPath();
+   auto connection = std::make_unique<UnixSocketServerConnection>(logger_);
+   terminalListener_->resetConnection(connection.get());
+   if (!connection->BindConnection(socketPath, {}, terminalListener_.get())) {
+      terminalListener_->resetConnection(nullptr);
+      logger_->error("Failed to bind terminal connection to {}, falling back to ZMQ"
+         , socketPath);
+      return false;
+   }
+   logger_->debug("Using terminal socket {}", socketPath);
+   terminalConnection_ = std::move(connection);
+   return true;
+#else
+   return false;
+#endif
+}
+
 void HeadlessAppObj::stopTerminalsProcessing()
 {
    if (!terminalListener_) {
@@ -383,7 +457,7 @@ bs::error::ErrorCode HeadlessAppObj::changeControlPassword(const SecureBinaryDat
 
 ZmqBIP15XServerConnection *HeadlessAppObj::connection() const
 {
-   return terminalConnection_.get();
+   return dynamic_cast<ZmqBIP15XServerConnection *>(terminalConnection_.get());
 }
 
 BinaryData HeadlessAppObj::signerPubKey() const
@@ -37,6 +37,7 @@ namespace Blocksettle {
 class HeadlessContainerListener;
 class SignerAdapterListener;
 class HeadlessSettings;
+class ServerConnection;
 class ZmqBIP15XServerConnection;
 class DispatchQueue;
 
@@ -76,7 +77,10 @@ public:
    bs::error::ErrorCode changeControlPassword(const SecureBinaryData &controlPasswordOld, const SecureBinaryData &controlPasswordNew);
 
 private:
+   bool bindGuiUnixSocket();
+   bool bindGuiZmq();
    void startTerminalsProcessing();
+   bool bindTerminalUnixSocket();
    void stopTerminalsProcessing();
    void applyNewControlPassword(const SecureBinaryData &controlPassword, bool notifyGui);
 
@@ -90,8 +94,8 @@ private:
    std::unique_ptr<HeadlessContainerListener>   terminalListener_;
    std::unique_ptr<SignerAdapterListener>       guiListener_;
 
-   std::unique_ptr<ZmqBIP15XServerConnection>   terminalConnection_;
-   std::unique_ptr<ZmqBIP15XServerConnection>   guiConnection_;
+   std::unique_ptr<ServerConnection>            terminalConnection_;
+   std::unique_ptr<ServerConnection>            guiConnection_;
 
    std::atomic<bs::signer::BindStatus> signerBindStatus_{bs::signer::BindStatus::Inactive};
 
@@ -12,8 +12,11 @@
 #include <spdlog/spdlog.h>
 #include <QDataStream>
 #include <QFile>
+#include "AddressOwnershipIndex.h"
+#include "DataConnection.h"
 #include "SignContainer.h"
 #include "SystemFileUtils.h"
+#include "UnixSocketConnection.h"
 #include "Wallets/SyncWalletsManager.h"
 #include "ZmqContext.h"
 #include "ZMQ_BIP15X_DataConnection.h"
@@ -31,37 +34,51 @@ using namespace Blocksettle::Communication;
 
 SignerAdapter::SignerAdapter(const std::shared_ptr<spdlog::logger> &logger
    , const std::shared_ptr<QmlBridge> &qmlBridge
-   , const NetworkType netType, int signerPort, const BinaryData* inSrvIDKey)
+   , const NetworkType netType, int signerPort, const BinaryData* inSrvIDKey
+   , const std::string &socketPath)
    : QObject(nullptr)
    ,logger_(logger)
    , netType_(netType)
    , qmlBridge_(qmlBridge)
 {
-   ZmqBIP15XDataConnectionParams params;
-   params.ephemeralPeers = true;
-   params.setLocalHeartbeatInterval();
-
-   // When creating the client connection, we need to generate a cookie for the
-   // server connection in order to enable verification. We also need to add
-   // the key we got on the command line to the list of trusted keys.
-   params.cookie = BIP15XCookie::MakeClient;
-   params.cookiePath = SystemFilePaths::appDataLocation() + "/" + "adapterClientID";
-
-   auto adapterConn = std::make_shared<ZmqBIP15XDataConnection>(logger, params);
-   if (inSrvIDKey) {
-      std::string connectAddr = kLocalAddrV4 + ":" + std::to_string(signerPort);
-      adapterConn->addAuthPeer(ZmqBIP15XPeer(connectAddr, *inSrvIDKey));
-
-      // Temporary (?) kludge: Sometimes, the key gets checked with "_1" at the
-      // end of the checked key name. This should be checked and corrected
-      // elsewhere, but for now, add a kludge to keep the code happy.
-      connectAddr = kLocalAddrV4 + ":" + std::to_string(signerPort) + "_1";
-      adapterConn->addAuthPeer(ZmqBIP15XPeer(connectAddr, *inSrvIDKey));
+   std::shared_ptr<DataConnection> adapterConn;
+   std::string connectHost = kLocalAddrV4;
+   std::string connectPort = std::to_string(signerPort);
+#ifndef WIN32
+   if (!socketPath.empty()) {
+      adapterConn = std::make_shared<UnixSocketDataConnection>(logger);
+      connectHost = socketPath;
+      connectPort.clear();
+   }
+#endif
+
+   if (!adapterConn) {
+      ZmqBIP15XDataConnectionParams params;
+      params.ephemeralPeers = true;
+      params.setLocalHeartbeatInterval();
+
+      // When creating the client connection, we need to generate a cookie for the
+      // server connection in order to enable verification. We also need to add
+      // the key we got on the command line to the list of trusted keys.
+      params.cookie = BIP15XCookie::MakeClient;
+      params.cookiePath = SystemFilePaths::appDataLocation() + "/" + "adapterClientID";
+
+      auto zmqConn = std::make_shared<ZmqBIP15XDataConnection>(logger, params);
+      if (inSrvIDKey) {
+         std::string connectAddr = kLocalAddrV4 + ":" + std::to_string(signerPort);
+         zmqConn->addAuthPeer(ZmqBIP15XPeer(connectAddr, *inSrvIDKey));
+
+         // Temporary (?) kludge: Sometimes, the key gets checked with "_1" at the
+         // end of the checked key name. This should be checked and corrected
+         // elsewhere, but for now, add a kludge to keep the code happy.
+         connectAddr = kLocalAddrV4 + ":" + std::to_string(signerPort) + "_1";
+         zmqConn->addAuthPeer(ZmqBIP15XPeer(connectAddr, *inSrvIDKey));
+      }
+      adapterConn = zmqConn;
    }
 
    listener_ = std::make_shared<SignerInterfaceListener>(logger, qmlBridge_, adapterConn, this);
-   if (!adapterConn->openConnection(kLocalAddrV4, std::to_string(signerPort)
-      , listener_.get())) {
+   if (!adapterConn->openConnection(connectHost, connectPort, listener_.get())) {
       throw std::runtime_error("adapter connection failed");
    }
 
@@ -82,6 +99,8 @@ std::shared_ptr<bs::sync::WalletsManager> SignerAdapter::getWalletsManager()
       walletsMgr_ = std::make_shared<bs::sync::WalletsManager>(logger_, nullptr, nullptr);
       signContainer_->Start();
       walletsMgr_->setSignContainer(signContainer_);
+      // created before other subscribers, so that index is up to date when they are notified
+      addrIndex_ = std::make_shared<bs::sync::AddressOwnershipIndex>(walletsMgr_);
 
       connect(walletsMgr_.get(), &bs::sync::WalletsManager::walletsSynchronizationStarted
          , listener_.get(), &SignerInterfaceListener::onWalletsSynchronizationStarted);
@@ -91,6 +110,12 @@ std::shared_ptr<bs::sync::WalletsManager> SignerAdapter::getWalletsManager()
    return walletsMgr_;
 }
 
+std::shared_ptr<bs::sync::AddressOwnershipIndex> SignerAdapter::getAddressIndex()
+{
+   getWalletsManager();
+   return addrIndex_;
+}
+
 void SignerAdapter::signOfflineTxRequest(const bs::core::wallet::TXSignRequest &txReq
    , const SecureBinaryData &password, const std::function<void(bs::error::ErrorCode result, const BinaryData &)> &cb)
 {
@@ -120,15 +145,14 @@ void SignerAdapter::updateWallet(const std::string &walletId)
    if (!walletsMgr_) {
       return;
    }
-   const auto wallet = walletsMgr_->getWalletById(walletId);
-   if (!wallet) {
+   // index is refreshed once sync is done - new addresses are not announced otherwise
+   const bool known = addrIndex_->synchronizeWallet(walletId, [this, walletId] {
+      logger_->debug("[SignerAdapter::updateWallet] wallet {} was re-synchronized", walletId);
+   });
+   if (!known) {
       logger_->debug("[{}] looks like a new wallet was added - syncing all of them");
       walletsListUpdated();
-      return;
    }
-   wallet->synchronize([this, walletId] {
-      logger_->debug("[SignerAdapter::updateWallet] wallet {} was re-synchronized", walletId);
-   });
 }
 
 void SignerAdapter::setLimits(bs::signer::Limits limits)
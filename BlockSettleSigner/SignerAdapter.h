@@ -26,6 +26,7 @@
 
 namespace bs {
    namespace sync {
+      class AddressOwnershipIndex;
       class WalletsManager;
    }
 }
@@ -51,7 +52,8 @@ class SignerAdapter : public QObject
 public:
    SignerAdapter(const std::shared_ptr<spdlog::logger> &logger
       , const std::shared_ptr<QmlBridge> &qmlBridge
-      , const NetworkType netType, int signerPort, const BinaryData* inSrvIDKey = nullptr);
+      , const NetworkType netType, int signerPort, const BinaryData* inSrvIDKey = nullptr
+      , const std::string &socketPath = {});
    ~SignerAdapter() override;
 
    SignerAdapter(const SignerAdapter&) = delete;
@@ -60,6 +62,7 @@ public:
    SignerAdapter& operator = (SignerAdapter&&) = delete;
 
    std::shared_ptr<bs::sync::WalletsManager> getWalletsManager();
+   std::shared_ptr<bs::sync::AddressOwnershipIndex> getAddressIndex();
    void updateWallet(const std::string &walletId);
 
    void setLimits(bs::signer::Limits);
@@ -141,6 +144,7 @@ private:
 
    std::shared_ptr<SignAdapterContainer>     signContainer_;
    std::shared_ptr<bs::sync::WalletsManager> walletsMgr_;
+   std::shared_ptr<bs::sync::AddressOwnershipIndex>   addrIndex_;
    std::shared_ptr<QmlFactory>               qmlFactory_;
    std::shared_ptr<SignerInterfaceListener>  listener_;
    std::shared_ptr<QmlBridge>                qmlBridge_;
@@ -23,6 +23,7 @@
 #include "ServerConnection.h"
 #include "StringUtils.h"
 #include "SystemFileUtils.h"
+#include "Tracer.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
 
 using namespace Blocksettle::Communication;
@@ -140,7 +141,7 @@ public:
 };
 
 SignerAdapterListener::SignerAdapterListener(HeadlessAppObj *app
-   , ZmqBIP15XServerConnection *connection
+   , ServerConnection *connection
    , const std::shared_ptr<spdlog::logger> &logger
    , const std::shared_ptr<bs::core::WalletsManager> &walletsMgr
    , const std::shared_ptr<DispatchQueue> &queue
@@ -191,6 +192,7 @@ void SignerAdapterListener::processData(const std::string &clientId, const std::
       logger_->error("[SignerAdapterListener::{}] failed to parse request packet", __func__);
       return;
    }
+   BS_TRACE_SPAN("signer", "SignerAdapterListener::processData", "type", packet.type());
    bool rc = false;
    switch (packet.type()) {
    case::signer::HeadlessReadyType:
@@ -35,20 +35,20 @@ class HeadlessAppObj;
 class HeadlessContainerCallbacks;
 class HeadlessContainerCallbacksImpl;
 class HeadlessSettings;
-class ZmqBIP15XServerConnection;
+class ServerConnection;
 
 class SignerAdapterListener : public ServerConnectionListener
 {
 public:
    SignerAdapterListener(HeadlessAppObj *app
-      , ZmqBIP15XServerConnection *connection
+      , ServerConnection *connection
       , const std::shared_ptr<spdlog::logger> &logger
       , const std::shared_ptr<bs::core::WalletsManager> &walletsMgr
       , const std::shared_ptr<DispatchQueue> &queue
       , const std::shared_ptr<HeadlessSettings> &settings);
    ~SignerAdapterListener() noexcept override;
 
-   ZmqBIP15XServerConnection *getServerConn() const { return connection_; }
+   ServerConnection *getServerConn() const { return connection_; }
 
    // Sent to GUI status update message
    void sendStatusUpdate();
@@ -103,7 +103,7 @@ private:
    friend class HeadlessContainerCallbacksImpl;
 
    HeadlessAppObj *  app_;
-   ZmqBIP15XServerConnection *connection_{};
+   ServerConnection *connection_{};
    std::shared_ptr<spdlog::logger>     logger_;
    std::shared_ptr<bs::core::WalletsManager>    walletsMgr_;
    std::shared_ptr<DispatchQueue> queue_;
@@ -32,7 +32,7 @@ using namespace bs::signer;
 
 SignerInterfaceListener::SignerInterfaceListener(const std::shared_ptr<spdlog::logger> &logger
    , const std::shared_ptr<QmlBridge> &qmlBridge
-   , const std::shared_ptr<ZmqBIP15XDataConnection> &conn
+   , const std::shared_ptr<DataConnection> &conn
    , SignerAdapter *parent)
    : logger_(logger)
    , connection_(conn)
@@ -223,7 +223,8 @@ void SignerInterfaceListener::onDecryptWalletRequested(const std::string &data)
    bs::sync::PasswordDialogData *dialogData = new bs::sync::PasswordDialogData(request.passworddialogdata());
    QQmlEngine::setObjectOwnership(dialogData, QQmlEngine::JavaScriptOwnership);
 
-   bs::wallet::TXInfo *txInfo = new bs::wallet::TXInfo(txRequest, parent_->walletsMgr_, logger_);
+   bs::wallet::TXInfo *txInfo = new bs::wallet::TXInfo(txRequest, parent_->walletsMgr_
+      , parent_->addrIndex_, logger_);
    QQmlEngine::setObjectOwnership(txInfo, QQmlEngine::JavaScriptOwnership);
 
    // wallet id may be stored either in tx or in dialog data
@@ -31,7 +31,7 @@ namespace spdlog {
    class logger;
 }
 
-class ZmqBIP15XDataConnection;
+class DataConnection;
 class SignerAdapter;
 class QmlBridge;
 class QmlFactory;
@@ -46,7 +46,7 @@ class SignerInterfaceListener : public QObject, public DataConnectionListener
 public:
    SignerInterfaceListener(const std::shared_ptr<spdlog::logger> &logger
       , const std::shared_ptr<QmlBridge> &qmlBridge
-      , const std::shared_ptr<ZmqBIP15XDataConnection> &conn, SignerAdapter *parent);
+      , const std::shared_ptr<DataConnection> &conn, SignerAdapter *parent);
 
    void OnDataReceived(const std::string &) override;
    void OnConnected() override;
@@ -54,7 +54,7 @@ public:
    void OnError(DataConnectionError errorCode) override;
 
    bs::signer::RequestId send(signer::PacketType pt, const std::string &data);
-   std::shared_ptr<ZmqBIP15XDataConnection> getDataConnection() { return connection_; }
+   std::shared_ptr<DataConnection> getDataConnection() { return connection_; }
 
    void setTxSignCb(bs::signer::RequestId reqId, const std::function<void(bs::error::ErrorCode result, const BinaryData &)> &cb) {
       cbSignReqs_[reqId] = cb;
@@ -145,7 +145,7 @@ protected:
 
 private:
    std::shared_ptr<spdlog::logger>           logger_;
-   std::shared_ptr<ZmqBIP15XDataConnection>  connection_;
+   std::shared_ptr<DataConnection>  connection_;
    std::shared_ptr<QmlFactory>               qmlFactory_;
    SignerAdapter                             * parent_;
 
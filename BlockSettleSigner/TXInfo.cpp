@@ -10,6 +10,7 @@
 */
 #include "TXInfo.h"
 
+#include "AddressOwnershipIndex.h"
 #include "CheckRecipSigner.h"
 #include "OfflineSigner.h"
 #include "TxClasses.h"
@@ -22,21 +23,23 @@ using namespace bs::wallet;
 using namespace Blocksettle::Communication;
 
 TXInfo::TXInfo(const bs::core::wallet::TXSignRequest &txReq, const std::shared_ptr<bs::sync::WalletsManager> &walletsMgr
+   , const std::shared_ptr<bs::sync::AddressOwnershipIndex> &addrIndex
    , const std::shared_ptr<spdlog::logger> &logger)
-   : QObject(), txReq_(txReq), walletsMgr_(walletsMgr), logger_(logger)
+   : QObject(), txReq_(txReq), walletsMgr_(walletsMgr), addrIndex_(addrIndex), logger_(logger)
 {
    init();
 }
 
 TXInfo::TXInfo(const headless::SignTxRequest &txRequest, const std::shared_ptr<bs::sync::WalletsManager> &walletsMgr
+   , const std::shared_ptr<bs::sync::AddressOwnershipIndex> &addrIndex
    , const std::shared_ptr<spdlog::logger> &logger)
-   : QObject(), txReq_(bs::signer::pbTxRequestToCore(txRequest)), walletsMgr_(walletsMgr), logger_(logger)
+   : QObject(), txReq_(bs::signer::pbTxRequestToCore(txRequest)), walletsMgr_(walletsMgr), addrIndex_(addrIndex), logger_(logger)
 {
    init();
 }
 
 TXInfo::TXInfo(const TXInfo &src)
-   : QObject(), txReq_(src.txReq_), walletsMgr_(src.walletsMgr_), logger_(src.logger_)
+   : QObject(), txReq_(src.txReq_), walletsMgr_(src.walletsMgr_), addrIndex_(src.addrIndex_), logger_(src.logger_)
 {
    init();
 }
@@ -46,30 +49,79 @@ void TXInfo::init()
    txId_ = QString::fromStdString(txReq_.serializeState().toBinStr());
 }
 
-bool TXInfo::containsAddressImpl(const bs::Address &address, bs::core::wallet::Type walletType) const
+bool TXInfo::containsThisAddressImpl(const bs::Address &address) const
 {
-   for (const auto &leaf : walletsMgr_->getAllWallets()) {
-      if (leaf->type() == walletType && leaf->containsAddress(address)) {
+   const auto owner = addrIndex_ ? addrIndex_->find(address) : nullptr;
+   if (!owner) {
+      return walletsContainThisAddress(address);
+   }
+   // request wallet ids could be either leaf or HD wallet ids
+   for (const auto &walletId : txReq_.walletIds) {
+      if ((walletId == owner->walletId) || (walletId == owner->rootId)) {
          return true;
       }
    }
-
    return false;
 }
 
+bool TXInfo::containsAddressImpl(const bs::Address &address, bs::core::wallet::Type walletType) const
+{
+   const auto owner = addrIndex_ ? addrIndex_->find(address) : nullptr;
+   if (!owner) {
+      const auto leaf = walletOwningAddress(address);
+      return (leaf && (leaf->type() == walletType));
+   }
+   return (owner->type == walletType);
+}
+
 bool TXInfo::notContainsAddressImpl(const bs::Address &address) const
 {
-   // not equal to !containsAddressImpl()
-   bool contains = false;
+   // not equal to !containsAddressImpl() - address shouldn't belong to any our leaf
+   if (addrIndex_ && addrIndex_->contains(address)) {
+      return false;
+   }
+   return (walletOwningAddress(address) == nullptr);
+}
 
+// Index could miss an address generated after the last wallet sync, so
+// misses are checked against the wallets as before
+std::shared_ptr<bs::sync::Wallet> TXInfo::walletOwningAddress(const bs::Address &address) const
+{
+   if (!walletsMgr_) {
+      return nullptr;
+   }
    for (const auto &leaf : walletsMgr_->getAllWallets()) {
       if (leaf->containsAddress(address)) {
-         contains = true;
-         break;
+         return leaf;
       }
    }
+   return nullptr;
+}
 
-   return !contains;
+bool TXInfo::walletsContainThisAddress(const bs::Address &address) const
+{
+   if (!walletsMgr_) {
+      return false;
+   }
+   for (const auto &walletId : txReq_.walletIds) {
+      const auto &wallet = walletsMgr_->getWalletById(walletId);
+      if (wallet) {
+         if (wallet->containsAddress(address)) {
+            return true;
+         }
+         continue;
+      }
+
+      const auto &hdWallet = walletsMgr_->getHDWalletById(walletId);
+      if (hdWallet) {
+         for (auto leaf : hdWallet->getLeaves()) {
+            if (leaf->containsAddress(address)) {
+               return true;
+            }
+         }
+      }
+   }
+   return false;
 }
 
 void TXInfo::setTxId(const QString &txId)
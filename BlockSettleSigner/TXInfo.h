@@ -23,6 +23,9 @@
 #include <QStringList>
 
 namespace bs {
+namespace sync {
+   class AddressOwnershipIndex;
+}
 namespace wallet {
 
 // wrapper on bs::wallet::TXSignRequest
@@ -56,8 +59,10 @@ class TXInfo : public QObject
 public:
    TXInfo() : QObject(), txReq_() {}
    TXInfo(const bs::core::wallet::TXSignRequest &txReq, const std::shared_ptr<bs::sync::WalletsManager> &walletsMgr
+      , const std::shared_ptr<bs::sync::AddressOwnershipIndex> &addrIndex
       , const std::shared_ptr<spdlog::logger> &logger);
    TXInfo(const Blocksettle::Communication::headless::SignTxRequest &txRequest, const std::shared_ptr<bs::sync::WalletsManager> &walletsMgr
+      , const std::shared_ptr<bs::sync::AddressOwnershipIndex> &addrIndex
       , const std::shared_ptr<spdlog::logger> &logger);
    TXInfo(const TXInfo &src);
 
@@ -109,30 +114,12 @@ private:
    QString  txId_;
 
    std::shared_ptr<bs::sync::WalletsManager> walletsMgr_ = nullptr; // nullptr init required for default constructor
+   std::shared_ptr<bs::sync::AddressOwnershipIndex> addrIndex_ = nullptr;
    std::shared_ptr<spdlog::logger> logger_ = nullptr;
 
    using ContainsAddressCb = const std::function<bool(const bs::Address &)>;
    ContainsAddressCb containsThisAddressCb_ = [this](const bs::Address &address){
-      for (const auto &walletId : txReq_.walletIds) {
-         const auto &wallet = walletsMgr_->getWalletById(walletId);
-         if (wallet) {
-            if (wallet->containsAddress(address)) {
-               return true;
-            }
-            continue;
-         }
-
-         const auto &hdWallet = walletsMgr_->getHDWalletById(walletId);
-         if (hdWallet) {
-            for (auto leaf : hdWallet->getLeaves()) {
-               if (leaf->containsAddress(address)) {
-                  return true;
-               }
-            }
-         }
-      }
-
-      return false;
+      return containsThisAddressImpl(address);
    };
 
    ContainsAddressCb containsAnyOurXbtAddressCb_ = [this](const bs::Address &address){
@@ -147,8 +134,11 @@ private:
       return notContainsAddressImpl(address);
    };
 
+   bool containsThisAddressImpl(const bs::Address &address) const;
    bool containsAddressImpl(const bs::Address &address, core::wallet::Type walletType) const;
    bool notContainsAddressImpl(const bs::Address &address) const;
+   std::shared_ptr<bs::sync::Wallet> walletOwningAddress(const bs::Address &address) const;
+   bool walletsContainThisAddress(const bs::Address &address) const;
 };
 
 }  //namespace wallet
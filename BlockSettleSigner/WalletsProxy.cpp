@@ -556,7 +556,8 @@ void WalletsProxy::signOfflineTx(const QString &fileName, const QJSValue &jsCall
 
 
          // TODO: send to qml list of txInfo
-         bs::wallet::TXInfo *txInfo = new bs::wallet::TXInfo(reqs.requests[0], walletsMgr_, logger_);
+         bs::wallet::TXInfo *txInfo = new bs::wallet::TXInfo(reqs.requests[0], walletsMgr_
+            , adapter_->getAddressIndex(), logger_);
          QQmlEngine::setObjectOwnership(txInfo, QQmlEngine::JavaScriptOwnership);
 
          bs::sync::PasswordDialogData *dialogData = new bs::sync::PasswordDialogData();
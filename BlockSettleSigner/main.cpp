@@ -41,6 +41,7 @@
 #include "SignerAdapter.h"
 #include "Settings/SignerSettings.h"
 #include "SystemFileUtils.h"
+#include "Tracer.h"
 
 #include "QMLApp.h"
 #include "QmlBridge.h"
@@ -276,12 +277,14 @@ static int QMLApp(int argc, char **argv
 
    try {
       BinaryData srvIDKey(BIP151PUBKEYSIZE);
-      if (!(settings->getSrvIDKeyBin(srvIDKey))) {
+      // Unix socket connection is authenticated with peer credentials and needs no key
+      if (settings->signerSocketPath().empty() && !(settings->getSrvIDKeyBin(srvIDKey))) {
          logger->error("[{}] Unable to obtain server identity key from the "
             "command line. Functionality may be limited.", __func__);
       }
 
-      SignerAdapter adapter(logger, qmlBridge, settings->netType(), settings->signerPort(), &srvIDKey);
+      SignerAdapter adapter(logger, qmlBridge, settings->netType(), settings->signerPort(), &srvIDKey
+         , settings->signerSocketPath());
       adapter.setCloseHeadless(settings->closeHeadless());
 
       QMLAppObj qmlAppObj(&adapter, logger, settings, splashScreen, engine.rootContext());
@@ -378,5 +381,8 @@ int main(int argc, char** argv)
    logger->info("Starting BS Signer...");
    bs::signer::Queue queue(logger, settings);
 
-   return QMLApp(argc, argv, settings, queue);
+   bs::trace::initFromEnv(logger);
+   const int rc = QMLApp(argc, argv, settings, queue);
+   bs::trace::dump(logger);
+   return rc;
 }
@@ -0,0 +1,121 @@
+#include "TrackerStateStore.h"
+
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace {
+   const std::string kSnapshotHeader = "bs_tracker_state 1";
+}
+
+TrackerStateStore::TrackerStateStore(const std::shared_ptr<spdlog::logger> &logger
+   , const std::string &stateDir, unsigned int compactInterval)
+   : logger_(logger)
+   , snapshotPath_(stateDir + "/tracker.snapshot")
+   , journalPath_(stateDir + "/tracker.journal")
+   , compactInterval_(compactInterval)
+{}
+
+TrackerStateStore::~TrackerStateStore() noexcept
+{
+   try {
+      compact();
+   }
+   catch (...) {}
+}
+
+bool TrackerStateStore::load()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   bool found = false;
+   {
+      std::ifstream snapshot(snapshotPath_);
+      std::string header;
+      if (snapshot && std::getline(snapshot, header)) {
+         if (header != kSnapshotHeader) {
+            SPDLOG_LOGGER_ERROR(logger_, "unsupported snapshot format in {}", snapshotPath_);
+            return false;
+         }
+         snapshot >> lastHeight_;
+         found = true;
+      }
+   }
+
+   std::ifstream journal(journalPath_);
+   unsigned int height = 0;
+   journalEntries_ = 0;
+   while (journal >> height) {
+      if (height > lastHeight_) {
+         lastHeight_ = height;
+      }
+      ++journalEntries_;
+      found = true;
+   }
+   SPDLOG_LOGGER_INFO(logger_, "loaded tracker state: height {}, {} journal entries"
+      , lastHeight_, journalEntries_);
+   return found;
+}
+
+void TrackerStateStore::onBlockProcessed(unsigned int height)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (height <= lastHeight_ && journalEntries_) {
+         SPDLOG_LOGGER_WARN(logger_, "height {} is not above last processed {} - reorg?"
+            , height, lastHeight_);
+      }
+      lastHeight_ = height;
+
+      std::ofstream journal(journalPath_, std::ios::app);
+      journal << height << '\n';
+      if (!journal) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to append to {}", journalPath_);
+         return;
+      }
+      if (++journalEntries_ < compactInterval_) {
+         return;
+      }
+   }
+   compact();
+}
+
+void TrackerStateStore::compact()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   if (!journalEntries_) {
+      return;
+   }
+   if (!writeSnapshot(lastHeight_)) {
+      return;
+   }
+   std::ofstream journal(journalPath_, std::ios::trunc);
+   journalEntries_ = 0;
+}
+
+unsigned int TrackerStateStore::lastHeight() const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   return lastHeight_;
+}
+
+bool TrackerStateStore::writeSnapshot(unsigned int height)
+{
+   // write to temporary file first so that crash never leaves truncated snapshot
+   const auto tmpPath = snapshotPath_ + ".tmp";
+   {
+      std::ofstream out(tmpPath, std::ios::trunc);
+      out << kSnapshotHeader << '\n' << height << '\n';
+      if (!out) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to write {}", tmpPath);
+         return false;
+      }
+   }
+#ifdef WIN32
+   std::remove(snapshotPath_.c_str());
+#endif
+   if (std::rename(tmpPath.c_str(), snapshotPath_.c_str()) != 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to rename {} to {}", tmpPath, snapshotPath_);
+      return false;
+   }
+   return true;
+}
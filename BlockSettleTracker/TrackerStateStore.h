@@ -0,0 +1,47 @@
+#ifndef __TRACKER_STATE_STORE_H__
+#define __TRACKER_STATE_STORE_H__
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace spdlog {
+   class logger;
+}
+
+// Persistent tracker progress: compact snapshot with the last processed block
+// height plus append-only journal of heights processed since the snapshot.
+// Journal is folded into snapshot every `compactInterval` entries.
+class TrackerStateStore
+{
+public:
+   TrackerStateStore(const std::shared_ptr<spdlog::logger> &, const std::string &stateDir
+      , unsigned int compactInterval = 144);
+   ~TrackerStateStore() noexcept;
+
+   TrackerStateStore(const TrackerStateStore&) = delete;
+   TrackerStateStore& operator = (const TrackerStateStore&) = delete;
+
+   // Reads snapshot and replays journal, returns false if no state was stored before
+   bool load();
+
+   void onBlockProcessed(unsigned int height);
+   void compact();
+
+   unsigned int lastHeight() const;
+
+private:
+   bool writeSnapshot(unsigned int height);
+
+private:
+   std::shared_ptr<spdlog::logger>  logger_;
+   const std::string    snapshotPath_;
+   const std::string    journalPath_;
+   const unsigned int   compactInterval_;
+
+   mutable std::mutex   mutex_;
+   unsigned int         lastHeight_ = 0;
+   unsigned int         journalEntries_ = 0;
+};
+
+#endif // __TRACKER_STATE_STORE_H__
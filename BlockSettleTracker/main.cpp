@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <btc/ecc.h>
 #include <cxxopts.hpp>
 #include <spdlog/sinks/daily_file_sink.h>
@@ -7,8 +9,99 @@
 #include "ArmoryConnection.h"
 #include "BsTrackerVersion.h"
 #include "ColoredCoinServer.h"
+#include "TrackerStateStore.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
 
+namespace {
+
+   const auto kConnectTimeout = std::chrono::seconds(60);
+   const auto kMaxReconnectDelay = std::chrono::seconds(60);
+
+   class TrackerACT : public ArmoryCallbackTarget
+   {
+   public:
+      TrackerACT(ArmoryConnection *armory, TrackerStateStore *store)
+         : store_(store)
+      {
+         init(armory);
+      }
+      ~TrackerACT() override { cleanup(); }
+      void onNewBlock(unsigned int height, unsigned int) override {
+         ++blocks_;
+         if (store_) {
+            store_->onBlockProcessed(height);
+         }
+      }
+      void onZCReceived(const std::vector<bs::TXEntry> &zcs) override {
+         zcEntries_ += zcs.size();
+      }
+
+      std::atomic<uint64_t>   blocks_{};
+      std::atomic<uint64_t>   zcEntries_{};
+
+   private:
+      TrackerStateStore *store_;
+   };
+
+   // Counters are cumulative, rates are computed over the last reporting interval.
+   // Only Armory-side load is covered. Request dispatch, per-client send queues
+   // and update fan-out are all internal to CcTrackerServer (common submodule),
+   // which owns its server connection, so worker pool, bounded send queues,
+   // shared broadcast payloads and request throughput/latency metrics are out
+   // of scope for the tracker binary and belong to CcTrackerServer itself.
+   class TrackerMetrics
+   {
+   public:
+      TrackerMetrics(const std::shared_ptr<spdlog::logger> &logger, std::chrono::seconds interval)
+         : logger_(logger), interval_(interval)
+         , start_(std::chrono::steady_clock::now()), lastReport_(start_) {}
+
+      void onReconnect(std::chrono::steady_clock::duration downtime)
+      {
+         ++reconnects_;
+         downtime_ += downtime;
+      }
+
+      void report(const TrackerACT &act, const std::shared_ptr<ArmoryConnection> &armory)
+      {
+         const auto now = std::chrono::steady_clock::now();
+         if ((interval_.count() <= 0) || (now - lastReport_ < interval_)) {
+            return;
+         }
+         const double elapsed = std::chrono::duration<double>(now - lastReport_).count();
+         const uint64_t zcEntries = act.zcEntries_;
+         SPDLOG_LOGGER_INFO(logger_, "metrics: uptime {} s, armory state {}, height {}"
+            ", blocks {}, ZC entries {} ({:.1f}/s), reconnects {}, downtime {} s"
+            , std::chrono::duration_cast<std::chrono::seconds>(now - start_).count()
+            , static_cast<int>(armory->state()), armory->topBlock(), act.blocks_.load(), zcEntries
+            , (zcEntries - lastZcEntries_) / elapsed, reconnects_
+            , std::chrono::duration_cast<std::chrono::seconds>(downtime_).count());
+         lastZcEntries_ = zcEntries;
+         lastReport_ = now;
+      }
+
+   private:
+      std::shared_ptr<spdlog::logger>  logger_;
+      const std::chrono::seconds       interval_;
+      const std::chrono::steady_clock::time_point start_;
+      std::chrono::steady_clock::time_point  lastReport_;
+      std::chrono::steady_clock::duration    downtime_{};
+      uint64_t reconnects_ = 0;
+      uint64_t lastZcEntries_ = 0;
+   };
+
+   bool waitForState(const std::shared_ptr<ArmoryConnection> &armory, ArmoryState state
+      , std::chrono::seconds timeout)
+   {
+      const auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < timeout && armory->state() != state) {
+         std::this_thread::sleep_for(std::chrono::seconds(1));
+      }
+      return armory->state() == state;
+   }
+
+}  // namespace
+
 int main(int argc, char** argv) {
    auto logger = spdlog::stdout_color_mt("stdout logger");
 
@@ -27,6 +120,9 @@ int main(int argc, char** argv) {
    std::string armoryKey;
    BinaryData armoryKeyParsed;
 
+   unsigned int metricsInterval{};
+   std::string stateDir;
+
    cxxopts::Options options("blocksettle_tracker", "Caching tracker server for ArmoryDB");
    options.add_options()
       ("h,help", "Print help"
@@ -49,6 +145,10 @@ int main(int argc, char** argv) {
          , cxxopts::value<std::string>(armoryKey))
       ("testnet", "Set bitcoin network type to testnet (default mainnet)."
          , cxxopts::value<bool>(testnet))
+      ("metrics_interval", "Interval in seconds to log tracker metrics (0 - disabled)"
+         , cxxopts::value<unsigned int>(metricsInterval)->default_value("60"))
+      ("state_dir", "Directory to keep tracker state between restarts. Default is own_key_path"
+         , cxxopts::value<std::string>(stateDir))
    ;
 
    try {
@@ -103,6 +203,17 @@ int main(int argc, char** argv) {
    }
    SPDLOG_LOGGER_INFO(logger, "own key: {}", ownKey.toHexStr());
 
+   if (stateDir.empty()) {
+      stateDir = ownKeyPath;
+   }
+   auto stateStore = std::make_unique<TrackerStateStore>(logger, stateDir);
+   if (stateStore->load()) {
+      SPDLOG_LOGGER_INFO(logger, "warm restart, last processed height: {}", stateStore->lastHeight());
+   }
+   else {
+      SPDLOG_LOGGER_INFO(logger, "no saved tracker state found in {}", stateDir);
+   }
+
    auto armory = std::make_shared<ArmoryConnection>(logger);
 
    auto armoryKeyCb = [logger, armoryKey, armoryKeyParsed](const BinaryData &key, const std::string &name) -> bool {
@@ -115,36 +226,81 @@ int main(int argc, char** argv) {
       return validKey;
    };
 
-   armory->setupConnection(testnet ? NetworkType::TestNet : NetworkType::MainNet, armoryHost, std::to_string(armoryPort), ownKeyPath, {}, {}, armoryKeyCb);
-   auto now = std::chrono::steady_clock::now();
-   while (std::chrono::steady_clock::now() - now < std::chrono::seconds(60) && armory->state() != ArmoryState::Connected) {
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-   }
+   const auto connectArmory = [&] {
+      armory->setupConnection(testnet ? NetworkType::TestNet : NetworkType::MainNet, armoryHost, std::to_string(armoryPort), ownKeyPath, {}, {}, armoryKeyCb);
+      if (!waitForState(armory, ArmoryState::Connected, kConnectTimeout)) {
+         SPDLOG_LOGGER_ERROR(logger, "can't connect to armory");
+         return false;
+      }
+      if (!armory->goOnline()) {
+         SPDLOG_LOGGER_ERROR(logger, "ArmoryConnection::goOnline call failed");
+         return false;
+      }
+      return true;
+   };
 
-   if (armory->state() != ArmoryState::Connected) {
-      SPDLOG_LOGGER_CRITICAL(logger, "can't connect to armory, quit now");
-      exit(EXIT_FAILURE);
-   }
+   const auto zmqContext = std::make_shared<ZmqContext>(logger);
+   const auto startServer = [&]() -> std::unique_ptr<CcTrackerServer> {
+      auto server = std::make_unique<CcTrackerServer>(logger, armory);
+      if (!server->startServer(listenAddress, std::to_string(listenPort), zmqContext, ownKeyPath, ownKeyName)) {
+         SPDLOG_LOGGER_ERROR(logger, "starting server on {}:{} failed", listenAddress, listenPort);
+         return nullptr;
+      }
+      SPDLOG_LOGGER_INFO(logger, "listening on {}:{}", listenAddress, listenPort);
+      return server;
+   };
 
-   bool result = armory->goOnline();
-   if (!result) {
-      SPDLOG_LOGGER_CRITICAL(logger, "ArmoryConnection::goOnline call failed");
-      exit(EXIT_FAILURE);
-   }
+   auto act = std::make_unique<TrackerACT>(armory.get(), stateStore.get());
 
-   auto server = std::make_unique<CcTrackerServer>(logger, armory);
-   result = server->startServer(listenAddress, std::to_string(listenPort), std::make_shared<ZmqContext>(logger), ownKeyPath, ownKeyName);
-   if (!result) {
-      SPDLOG_LOGGER_CRITICAL(logger, "starting server failed");
-      exit(EXIT_FAILURE);
-   }
+   // Clients are accepted right away, Armory connection is (re)established
+   // in background with exponential backoff. Server (and its clients) stays
+   // the same for the whole process lifetime, failed bind is retried.
+   auto server = startServer();
+   auto bindDelay = std::chrono::seconds(1);
+   auto nextBindAttempt = std::chrono::steady_clock::now() + bindDelay;
 
+   TrackerMetrics metrics(logger, std::chrono::seconds(metricsInterval));
+   auto reconnectDelay = std::chrono::seconds(1);
+   bool wasOnline = false;
+   std::chrono::steady_clock::time_point disconnectedAt;
    while (true) {
       std::this_thread::sleep_for(std::chrono::seconds(1));
+      metrics.report(*act, armory);
 
-      if (armory->state() != ArmoryState::Ready && armory->state() != ArmoryState::Connected) {
-         SPDLOG_LOGGER_CRITICAL(logger, "connection to armory closed unexpectedly");
-         exit(EXIT_FAILURE);
+      if (!server && (std::chrono::steady_clock::now() >= nextBindAttempt)) {
+         server = startServer();
+         if (!server) {
+            bindDelay = std::min(bindDelay * 2, kMaxReconnectDelay);
+            SPDLOG_LOGGER_INFO(logger, "next bind attempt in {} s", bindDelay.count());
+            nextBindAttempt = std::chrono::steady_clock::now() + bindDelay;
+         }
+      }
+
+      if (armory->state() == ArmoryState::Ready || armory->state() == ArmoryState::Connected) {
+         continue;
+      }
+      if (wasOnline && (reconnectDelay == std::chrono::seconds(1))) {
+         disconnectedAt = std::chrono::steady_clock::now();
+         SPDLOG_LOGGER_ERROR(logger, "connection to armory closed unexpectedly");
+         stateStore->compact();
+      }
+
+      if (!connectArmory()) {
+         SPDLOG_LOGGER_INFO(logger, "next armory connection attempt in {} s", reconnectDelay.count());
+         std::this_thread::sleep_for(reconnectDelay);
+         reconnectDelay = std::min(reconnectDelay * 2, kMaxReconnectDelay);
+         continue;
+      }
+      reconnectDelay = std::chrono::seconds(1);
+
+      // Server is kept, so that clients stay connected. Its trackers are
+      // callback targets of the same ArmoryConnection and register their
+      // addresses again when it becomes ready.
+      if (wasOnline) {
+         metrics.onReconnect(std::chrono::steady_clock::now() - disconnectedAt);
       }
+      SPDLOG_LOGGER_INFO(logger, "{} armory, resuming from height {} (top block {})"
+         , wasOnline ? "reconnected to" : "connected to", stateStore->lastHeight(), armory->topBlock());
+      wasOnline = true;
    }
 }
@@ -11,7 +11,10 @@
 #include "AddressDetailsWidget.h"
 #include "ui_AddressDetailsWidget.h"
 
+#include <set>
 #include <QDateTime>
+#include <QHeaderView>
+#include <QScrollBar>
 
 #include "AddressVerificator.h"
 #include "CheckRecipSigner.h"
@@ -24,6 +27,7 @@
 namespace {
 
    const uint64_t kAuthAddrValue = 1000;
+   const size_t kDefaultTxCacheCapacity = 1000;
 
 }
 
@@ -31,6 +35,7 @@ namespace {
 AddressDetailsWidget::AddressDetailsWidget(QWidget *parent)
    : QWidget(parent)
    , ui_(new Ui::AddressDetailsWidget)
+   , txCacheCapacity_(kDefaultTxCacheCapacity)
 {
    ui_->setupUi(this);
 
@@ -44,6 +49,13 @@ AddressDetailsWidget::AddressDetailsWidget(QWidget *parent)
 
    connect(ui_->treeAddressTransactions, &QTreeWidget::itemClicked,
            this, &AddressDetailsWidget::onTxClicked);
+
+   // TX details are loaded only for visible rows
+   const auto scrollBar = ui_->treeAddressTransactions->verticalScrollBar();
+   connect(scrollBar, &QScrollBar::valueChanged, this, &AddressDetailsWidget::loadVisibleTxs);
+   connect(scrollBar, &QScrollBar::rangeChanged, this, &AddressDetailsWidget::loadVisibleTxs);
+   connect(ui_->treeAddressTransactions->header(), &QHeaderView::sortIndicatorChanged
+      , this, &AddressDetailsWidget::loadVisibleTxs);
 }
 
 AddressDetailsWidget::~AddressDetailsWidget() = default;
@@ -137,8 +149,12 @@ void AddressDetailsWidget::updateFields()
    ui_->addressId->setText(QString::fromStdString(currentAddrStr_));
 }
 
+// Genesis address is detected without TXs
 void AddressDetailsWidget::searchForCC()
 {
+   if (!ccResolver_) {
+      return;
+   }
    for (const auto &ccSecurity : ccResolver_->securities()) {
       const auto &genesisAddr = ccResolver_->genesisAddrFor(ccSecurity);
       if (currentAddr_ == genesisAddr) {
@@ -148,29 +164,34 @@ void AddressDetailsWidget::searchForCC()
          return;
       }
    }
+}
 
-   // If currentAddr_ was a valid CC address then it must been a valid CC outpoint at least once.
-   // Collect possible candidates here.
-   std::map<BinaryData, uint32_t> outPoints;
-   for (const auto &txPair : txMap_) {
-      const auto &tx = txPair.second;
-      if (!tx || !tx->isInitialized()) {
-         continue;
-      }
+// If currentAddr_ is a valid CC address then it must been a valid CC outpoint
+// at least once. Check each loaded TX until CC is found.
+void AddressDetailsWidget::searchForCC(const Tx &tx)
+{
+   if (!ccFound_.security.empty() || !ccResolver_ || !walletsMgr_) {
+      return;
+   }
 
-      for (size_t i = 0; i < tx->getNumTxOut(); ++i) {
-         const auto &txOut = tx->getTxOutCopy(int(i));
-         try {
-            const auto &addr = bs::Address::fromTxOut(txOut);
-            if (addr == currentAddr_) {
-               // Only first outputs could be CC
-               outPoints[tx->getThisHash()] = uint32_t(i);
-               break;
-            }
-         } catch (...) {
+   bool outPointFound = false;
+   uint32_t outIndex = 0;
+   for (size_t i = 0; i < tx.getNumTxOut(); ++i) {
+      const auto &txOut = tx.getTxOutCopy(int(i));
+      try {
+         const auto &addr = bs::Address::fromTxOut(txOut);
+         if (addr == currentAddr_) {
+            // Only first outputs could be CC
+            outPointFound = true;
+            outIndex = uint32_t(i);
+            break;
          }
+      } catch (...) {
       }
    }
+   if (!outPointFound) {
+      return;
+   }
 
    for (const auto &ccSecurity : ccResolver_->securities()) {
       const auto &tracker = walletsMgr_->tracker(ccSecurity);
@@ -179,19 +200,78 @@ void AddressDetailsWidget::searchForCC()
          continue;
       }
 
-      for (const auto &outPoint : outPoints) {
-         const bool isValid = tracker->isTxHashValidHistory(outPoint.first, outPoint.second);
-         if (isValid) {
-            ccFound_.tracker = tracker;
-            ccFound_.security = ccSecurity;
-            ccFound_.lotSize = ccResolver_->lotSizeFor(ccSecurity);
-            ccFound_.isGenesisAddr = false;
-            return;
+      if (tracker->isTxHashValidHistory(tx.getThisHash(), outIndex)) {
+         ccFound_.tracker = tracker;
+         ccFound_.security = ccSecurity;
+         ccFound_.lotSize = ccResolver_->lotSizeFor(ccSecurity);
+         ccFound_.isGenesisAddr = false;
+
+         // Amounts and totals of already loaded rows should be in CC units
+         updateAmounts();
+         for (auto &row : rows_) {
+            countRow(row);
          }
+         updateTotals();
+         updateFields();
+         return;
       }
    }
 }
 
+// Only TXs already known to CC trackers could create CC outpoints for
+// currentAddr_, so they're fetched and checked before the page is displayed.
+std::set<BinaryData> AddressDetailsWidget::ccCandidates(
+   const std::vector<ClientClasses::LedgerEntry> &entries)
+{
+   std::set<BinaryData> result;
+   if (!ccFound_.security.empty() || !ccResolver_ || !walletsMgr_) {
+      return result;
+   }
+   std::vector<std::shared_ptr<ColoredCoinTrackerClient>> trackers;
+   for (const auto &ccSecurity : ccResolver_->securities()) {
+      const auto &tracker = walletsMgr_->tracker(ccSecurity);
+      if (tracker) {
+         trackers.push_back(tracker);
+      }
+   }
+   if (trackers.empty()) {
+      return result;
+   }
+
+   for (const auto &ledgerEntry : entries) {
+      if (ledgerEntry.getValue() <= 0) {
+         continue;
+      }
+      const auto &txHash = ledgerEntry.getTxHash();
+      for (const auto &tracker : trackers) {
+         if (!tracker->isTxHashValidHistory(txHash)) {
+            continue;
+         }
+         const auto tx = cachedTx(txHash);
+         if (tx) {
+            searchForCC(*tx);
+            if (!ccFound_.security.empty()) {
+               return {};
+            }
+         }
+         else {
+            result.insert(txHash);
+         }
+         break;
+      }
+   }
+   return result;
+}
+
+bool AddressDetailsWidget::isCcTx(const bs::TXEntry &entry) const
+{
+   if (ccFound_.security.empty()) {
+      return false;
+   }
+   // isTxHashValidHistory is not absolutly accurate to detect invalid CC transactions but should be good enough
+   return ccFound_.isGenesisAddr || (ccFound_.tracker && ccFound_.tracker->isTxHashValidHistory(entry.txHash));
+}
+
 void AddressDetailsWidget::searchForAuth()
 {
    if (!addrVerify_) {
@@ -202,119 +282,192 @@ void AddressDetailsWidget::searchForAuth()
    addrVerify_->startAddressVerification();
 }
 
-// The function that gathers all the data to place in the UI.
-void AddressDetailsWidget::loadTransactions()
+// Detect if this is an auth address
+void AddressDetailsWidget::searchForAuth(const bs::TXEntry &entry, const Tx &tx)
 {
-   CustomTreeWidget *tree = ui_->treeAddressTransactions;
-   tree->clear();
-
-   uint64_t totCount = 0;
-
-   searchForCC();
-   const bool isCcAddress = !ccFound_.security.empty();
-
-   // Go through each TXEntry object and calculate all required UI data.
-   for (const auto &curTXEntry : txEntryHashSet_) {
-      QTreeWidgetItem *item = new QTreeWidgetItem(tree);
-
-      auto tx = txMap_[curTXEntry.first];
-      if (!tx || !tx->isInitialized()) {
-         SPDLOG_LOGGER_WARN(logger_, "TX with hash {} is not found or not inited"
-            , curTXEntry.first.toHexStr(true));
-         continue;
+   if (isAuthAddr_ || (entry.value != kAuthAddrValue)) {
+      return;
+   }
+   for (size_t i = 0; i < tx.getNumTxOut(); ++i) {
+      const auto &txOut = tx.getTxOutCopy(static_cast<int>(i));
+      try {
+         const auto addr = bs::Address::fromTxOut(txOut);
+         if (bsAuthAddrs_.find(addr.display()) != bsAuthAddrs_.end()) {
+            isAuthAddr_ = true;
+            searchForAuth();
+            updateFields();
+            break;
+         }
+      } catch (const std::exception &e) {
+         SPDLOG_LOGGER_ERROR(logger_, "auth address detection failed: {}", e.what());
       }
+   }
+}
+
+// CC detection is done before rows are displayed so that amounts and totals
+// are never shown in XBT for CC address.
+void AddressDetailsWidget::addPage(uint32_t pageId
+   , const std::vector<ClientClasses::LedgerEntry> &entries)
+{
+   const auto ccTxHashes = ccCandidates(entries);
+   if (ccTxHashes.empty()) {
+      renderPage(pageId, entries);
+      return;
+   }
 
-      // Get fees & fee/byte by looping through the prev Tx set and calculating.
-      uint64_t totIn = 0;
-      for (size_t r = 0; r < tx->getNumTxIn(); ++r) {
-         TxIn in = tx->getTxInCopy(r);
-         OutPoint op = in.getOutPoint();
-         const auto &prevTx = txMap_[op.getTxHash()];
-         if (prevTx->isInitialized()) {
-            TxOut prevOut = prevTx->getTxOutCopy(op.getTxOutIndex());
-            totIn += prevOut.getValue();
+   const auto loadId = loadId_;
+   const auto &cbCcTXs = [this, loadId, pageId, entries]
+      (const AsyncClient::TxBatchResult &txs, std::exception_ptr)
+   {
+      QMetaObject::invokeMethod(this, [this, loadId, pageId, entries, txs] {
+         if (loadId != loadId_) {
+            return;
          }
-         else {
-            SPDLOG_LOGGER_WARN(logger_, "prev TX with hash {} is not found or is notinitialized"
-               , op.getTxHash().toHexStr(true));
+         for (const auto &tx : txs) {
+            if (!tx.second || !tx.second->isInitialized()) {
+               continue;
+            }
+            cacheTx(tx.first, tx.second);
+            searchForCC(*tx.second);
          }
+         renderPage(pageId, entries);
+      });
+   };
+   if (!armory_->getTXsByHash(ccTxHashes, cbCcTXs, true)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to request {} CC candidate TXs", ccTxHashes.size());
+      renderPage(pageId, entries);
+   }
+}
+
+// Adds rows for the ledger page. Only data from ledger entries is displayed
+// here, the rest is set when TX is loaded.
+void AddressDetailsWidget::renderPage(uint32_t pageId
+   , const std::vector<ClientClasses::LedgerEntry> &entries)
+{
+   CustomTreeWidget *tree = ui_->treeAddressTransactions;
+   QList<QTreeWidgetItem *> items;
+   std::vector<size_t> authCandidates;
+
+   for (const auto &ledgerEntry : entries) {
+      const auto entry = bs::TXEntry::fromLedgerEntry(ledgerEntry);
+      const auto itRow = rowByHash_.find(entry.txHash);
+      if (itRow != rowByHash_.end()) {
+         // Wallet was refreshed, update block-related data only
+         auto &row = rows_[itRow->second];
+         row.entry = entry;
+         countRow(row);
+         row.item->setData(colConfs, Qt::DisplayRole, armory_->getConfirmationsNumber(entry.blockNum));
+         setConfirmationColor(row.item);
+         continue;
       }
-      uint64_t fees = totIn - tx->getSumOfOutputs();
-      double feePerByte = (double)fees / (double)tx->getTxWeight();
 
-      // Populate the transaction entries.
+      QTreeWidgetItem *item = new QTreeWidgetItem();
       item->setText(colDate,
-                    UiUtils::displayDateTime(QDateTime::fromTime_t(curTXEntry.second.txTime)));
+                    UiUtils::displayDateTime(QDateTime::fromTime_t(entry.txTime)));
       item->setText(colTxId, // Flip Armory's TXID byte order: internal -> RPC
-                    QString::fromStdString(curTXEntry.first.toHexStr(true)));
-      item->setData(colConfs, Qt::DisplayRole, armory_->getConfirmationsNumber(curTXEntry.second.blockNum));
-      item->setText(colInputsNum, QString::number(tx->getNumTxIn()));
-      item->setText(colOutputsNum, QString::number(tx->getNumTxOut()));
-      item->setText(colFees, UiUtils::displayAmount(fees));
-      item->setText(colFeePerByte, QString::number(std::nearbyint(feePerByte)));
-      item->setText(colTxSize, QString::number(tx->getSize()));
-
-      // isTxHashValidHistory is not absolutly accurate to detect invalid CC transactions but should be good enough
-      const bool isCcTx = isCcAddress && (ccFound_.isGenesisAddr || (ccFound_.tracker && ccFound_.tracker->isTxHashValidHistory(curTXEntry.second.txHash)));
-
-      if (!isCcTx) {
-         item->setText(colOutputAmt, UiUtils::displayAmount(curTXEntry.second.value));
-      } else {
-         const auto ccAmount = curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         item->setText(colOutputAmt, tr("%1 %2").arg(QString::number(ccAmount)).arg(QString::fromStdString(ccFound_.security)));
-      }
+                    QString::fromStdString(entry.txHash.toHexStr(true)));
+      item->setData(colTxId, Qt::UserRole, static_cast<qulonglong>(rows_.size()));
+      item->setData(colConfs, Qt::DisplayRole, armory_->getConfirmationsNumber(entry.blockNum));
       item->setTextAlignment(colOutputAmt, Qt::AlignRight);
 
       QFont font = item->font(colOutputAmt);
       font.setBold(true);
       item->setFont(colOutputAmt, font);
+      setConfirmationColor(item);
 
-      if (isCcAddress && !isCcTx) {
-         // Mark invalid CC transactions
-         item->setTextColor(colOutputAmt, Qt::red);
+      if ((entry.value == kAuthAddrValue) && !isAuthAddr_ && !bsAuthAddrs_.empty()) {
+         authCandidates.push_back(rows_.size());
       }
+      rowByHash_[entry.txHash] = rows_.size();
+      rows_.push_back({ entry, item });
+      updateAmount(rows_.back());
+      countRow(rows_.back());
+      items.append(item);
+   }
+   tree->addTopLevelItems(items);
 
-      // Check the total received or sent.
-      // Account only valid TXs for CC address.
-      if (!isCcAddress) {
-         if (curTXEntry.second.value > 0) {
-            totalReceived_ += curTXEntry.second.value;
-         }
-         else {
-            totalSpent_ -= curTXEntry.second.value; // Negative, so fake that out.
-         }
-      } else if (isCcTx) {
-         if (curTXEntry.second.value > 0) {
-            totalReceived_ += curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         }
-         else {
-            totalSpent_ -= curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         }
-      }
-      totCount++;
-
-      // Detect if this is an auth address
-      if (curTXEntry.second.value == kAuthAddrValue) {
-         for (size_t i = 0; i < tx->getNumTxOut(); ++i) {
-            const auto &txOut = tx->getTxOutCopy(static_cast<int>(i));
-            try {
-               const auto addr = bs::Address::fromTxOut(txOut);
-               if (bsAuthAddrs_.find(addr.display()) != bsAuthAddrs_.end()) {
-                  isAuthAddr_ = true;
-                  AddressDetailsWidget::searchForAuth();
-                  break;
-               }
-            } catch (const std::exception &e) {
-               SPDLOG_LOGGER_ERROR(logger_, "auth address detection failed: {}", e.what());
-            }
-         }
-      }
+   ++pagesLoaded_;
+   updateTotals();
+   updateFields();
+   if (pagesLoaded_ == 1) {
+      tree->resizeColumns();
+   }
 
-      setConfirmationColor(item);
-      tree->addTopLevelItem(item);
+   requestTxs(authCandidates);
+   loadVisibleTxs();
+
+   if (pageId + 1 < pagesTotal_) {
+      requestPage(pageId + 1);
+   }
+
+   // Signal handlers may start a new query, so nothing should follow except
+   // for completion notification of the current one
+   const auto loadId = loadId_;
+   emit pageLoaded(int(pagesLoaded_), int(pagesTotal_));
+   if ((loadId == loadId_) && (pagesLoaded_ >= pagesTotal_)) {
+      emit finished();
+   }
+}
+
+void AddressDetailsWidget::updateAmount(const Row &row)
+{
+   const bool isCcAddress = !ccFound_.security.empty();
+   const bool isCcTx = AddressDetailsWidget::isCcTx(row.entry);
+
+   if (!isCcTx) {
+      row.item->setText(colOutputAmt, UiUtils::displayAmount(row.entry.value));
+   } else {
+      const auto ccAmount = row.entry.value / int64_t(ccFound_.lotSize);
+      row.item->setText(colOutputAmt, tr("%1 %2").arg(QString::number(ccAmount)).arg(QString::fromStdString(ccFound_.security)));
    }
 
-   if (!isCcAddress) {
+   if (isCcAddress && !isCcTx) {
+      // Mark invalid CC transactions
+      row.item->setTextColor(colOutputAmt, Qt::red);
+   }
+}
+
+void AddressDetailsWidget::updateAmounts()
+{
+   for (const auto &row : rows_) {
+      updateAmount(row);
+   }
+}
+
+// Returns row value accounted in totals: valid TXs only for CC address
+int64_t AddressDetailsWidget::totalsValue(const bs::TXEntry &entry) const
+{
+   if (ccFound_.security.empty()) {
+      return entry.value;
+   }
+   if (!isCcTx(entry)) {
+      return 0;
+   }
+   return entry.value / int64_t(ccFound_.lotSize);
+}
+
+// Replaces previous row contribution to totals with the current one
+void AddressDetailsWidget::countRow(Row &row)
+{
+   if (row.counted > 0) {
+      totalReceived_ -= row.counted;
+   }
+   else {
+      totalSpent_ += row.counted;
+   }
+
+   row.counted = totalsValue(row.entry);
+   if (row.counted > 0) {
+      totalReceived_ += row.counted;
+   }
+   else {
+      totalSpent_ -= row.counted; // Negative, so fake that out.
+   }
+}
+
+void AddressDetailsWidget::updateTotals()
+{
+   if (ccFound_.security.empty()) {
       ui_->totalReceived->setText(UiUtils::displayAmount(totalReceived_));
       ui_->totalSent->setText(UiUtils::displayAmount(totalSpent_));
       ui_->balance->setText(UiUtils::displayAmount(totalReceived_ - totalSpent_));
@@ -324,14 +477,259 @@ void AddressDetailsWidget::loadTransactions()
       ui_->balance->setText(QString::number(totalReceived_ - totalSpent_));
    }
 
-   emit finished();
-
    // Set up the display for total rcv'd/spent.
-   ui_->transactionCount->setText(QString::number(totCount));
+   ui_->transactionCount->setText(QString::number(rows_.size()));
+}
 
-   updateFields();
+// Requests TXs for rows currently visible in the tree (called on each page,
+// scrolling, sorting and resizing)
+void AddressDetailsWidget::loadVisibleTxs()
+{
+   CustomTreeWidget *tree = ui_->treeAddressTransactions;
+   const int height = tree->viewport()->height();
+   std::vector<size_t> rows;
 
-   tree->resizeColumns();
+   for (auto item = tree->itemAt(0, 0); item; item = tree->itemBelow(item)) {
+      if (tree->visualItemRect(item).top() >= height) {
+         break;
+      }
+      rows.push_back(item->data(colTxId, Qt::UserRole).toULongLong());
+   }
+   requestTxs(rows);
+}
+
+void AddressDetailsWidget::requestTxs(const std::vector<size_t> &rows)
+{
+   std::set<BinaryData> txHashes;
+   AsyncClient::TxBatchResult cachedTxs;
+
+   for (const auto row : rows) {
+      auto &rowData = rows_[row];
+      if (rowData.state != TxState::None) {
+         continue;
+      }
+      rowData.state = TxState::Requested;
+      const auto tx = cachedTx(rowData.entry.txHash);
+      if (tx) {
+         cachedTxs[rowData.entry.txHash] = tx;
+      }
+      else {
+         txHashes.insert(rowData.entry.txHash);
+      }
+   }
+
+   if (!cachedTxs.empty()) {
+      onTxsReceived(cachedTxs, {});
+   }
+   if (txHashes.empty()) {
+      return;
+   }
+
+   const auto loadId = loadId_;
+   const auto &cbTXs = [this, loadId, txHashes](const AsyncClient::TxBatchResult &txs
+      , std::exception_ptr exPtr)
+   {
+      // Process TXs on main thread because this callback is called from background
+      QMetaObject::invokeMethod(this, [this, loadId, txHashes, txs, exPtr] {
+         if (loadId != loadId_) {
+            return;
+         }
+         if (exPtr) {
+            // Allow retry when rows become visible again
+            SPDLOG_LOGGER_ERROR(logger_, "failed to get {} TXs", txHashes.size());
+            resetTxState(txHashes, TxState::None);
+            return;
+         }
+         onTxsReceived(txs, txHashes);
+      });
+   };
+   if (!armory_->getTXsByHash(txHashes, cbTXs, true)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to request {} TXs", txHashes.size());
+      resetTxState(txHashes, TxState::None);
+   }
+}
+
+void AddressDetailsWidget::resetTxState(const std::set<BinaryData> &txHashes, TxState state)
+{
+   for (const auto &txHash : txHashes) {
+      const auto itRow = rowByHash_.find(txHash);
+      if ((itRow != rowByHash_.end()) && (rows_[itRow->second].state == TxState::Requested)) {
+         rows_[itRow->second].state = state;
+      }
+   }
+}
+
+// Tx objects are processed here. We need to get the prev Tx with the UTXO
+// being spent to calculate fees.
+void AddressDetailsWidget::onTxsReceived(const AsyncClient::TxBatchResult &txs
+   , const std::set<BinaryData> &requested)
+{
+   std::vector<size_t> rows;
+   std::set<BinaryData> prevTxHashSet;
+
+   // Armory may omit unknown hashes from reply, don't request them again
+   std::set<BinaryData> missing;
+   for (const auto &txHash : requested) {
+      if (txs.find(txHash) == txs.end()) {
+         missing.insert(txHash);
+      }
+   }
+   if (!missing.empty()) {
+      SPDLOG_LOGGER_WARN(logger_, "{} TXs are missing in reply", missing.size());
+      resetTxState(missing, TxState::Loaded);
+   }
+
+   for (const auto &tx : txs) {
+      const auto itRow = rowByHash_.find(tx.first);
+      if (itRow == rowByHash_.end()) {
+         continue;
+      }
+      if (!tx.second || !tx.second->isInitialized()) {
+         SPDLOG_LOGGER_WARN(logger_, "TX with hash {} is not found or not inited"
+            , tx.first.toHexStr(true));
+         rows_[itRow->second].state = TxState::Loaded;
+         continue;
+      }
+      cacheTx(tx.first, tx.second);
+      searchForCC(*tx.second);
+      searchForAuth(rows_[itRow->second].entry, *tx.second);
+
+      for (size_t i = 0; i < tx.second->getNumTxIn(); i++) {
+         TxIn in = tx.second->getTxInCopy(i);
+         if (in.isCoinbase()) {
+            continue;
+         }
+         const auto &prevTxHash = in.getOutPoint().getTxHash();
+         if ((txs.find(prevTxHash) == txs.end()) && !cachedTx(prevTxHash)) {
+            prevTxHashSet.insert(prevTxHash);
+         }
+      }
+      rows.push_back(itRow->second);
+   }
+
+   if (prevTxHashSet.empty()) {
+      onPrevTxsReceived(rows, txs, {});
+      return;
+   }
+
+   const auto loadId = loadId_;
+   const auto &cbPrevTXs = [this, loadId, rows, txs]
+      (const AsyncClient::TxBatchResult &prevTxs, std::exception_ptr)
+   {
+      QMetaObject::invokeMethod(this, [this, loadId, rows, txs, prevTxs] {
+         if (loadId == loadId_) {
+            onPrevTxsReceived(rows, txs, prevTxs);
+         }
+      });
+   };
+   if (!armory_->getTXsByHash(prevTxHashSet, cbPrevTXs, true)) {
+      SPDLOG_LOGGER_WARN(logger_, "failed to get previous TXs");
+      onPrevTxsReceived(rows, txs, {});
+   }
+}
+
+void AddressDetailsWidget::onPrevTxsReceived(const std::vector<size_t> &rows
+   , const AsyncClient::TxBatchResult &txs, const AsyncClient::TxBatchResult &prevTxs)
+{
+   // Don't rely on cache only as it could be smaller than batch
+   const auto &lookup = [this, &txs, &prevTxs](const BinaryData &txHash) -> TxPtr {
+      auto it = prevTxs.find(txHash);
+      if (it != prevTxs.end()) {
+         return it->second;
+      }
+      it = txs.find(txHash);
+      if (it != txs.end()) {
+         return it->second;
+      }
+      return cachedTx(txHash);
+   };
+   for (const auto row : rows) {
+      setTxDetails(row, lookup);
+   }
+
+   for (const auto &prevTx : prevTxs) {
+      if (prevTx.second && prevTx.second->isInitialized()) {
+         cacheTx(prevTx.first, prevTx.second);
+      }
+   }
+}
+
+void AddressDetailsWidget::setTxDetails(size_t row, const TxLookup &lookup)
+{
+   auto &rowData = rows_[row];
+   rowData.state = TxState::Loaded;
+   const auto tx = lookup(rowData.entry.txHash);
+   if (!tx) {
+      return;
+   }
+
+   // Get fees & fee/byte by looping through the prev Tx set and calculating.
+   uint64_t totIn = 0;
+   bool isCoinbase = false;
+   for (size_t r = 0; r < tx->getNumTxIn(); ++r) {
+      TxIn in = tx->getTxInCopy(r);
+      if (in.isCoinbase()) {
+         isCoinbase = true;
+         continue;
+      }
+      OutPoint op = in.getOutPoint();
+      const auto &prevTx = lookup(op.getTxHash());
+      if (prevTx && prevTx->isInitialized()) {
+         TxOut prevOut = prevTx->getTxOutCopy(op.getTxOutIndex());
+         totIn += prevOut.getValue();
+      }
+      else {
+         SPDLOG_LOGGER_WARN(logger_, "prev TX with hash {} is not found or is notinitialized"
+            , op.getTxHash().toHexStr(true));
+      }
+   }
+   const uint64_t totOut = tx->getSumOfOutputs();
+   const uint64_t fees = (isCoinbase || (totIn < totOut)) ? 0 : totIn - totOut;
+   double feePerByte = (double)fees / (double)tx->getTxWeight();
+
+   auto item = rowData.item;
+   item->setText(colInputsNum, QString::number(tx->getNumTxIn()));
+   item->setText(colOutputsNum, QString::number(tx->getNumTxOut()));
+   item->setText(colFees, UiUtils::displayAmount(fees));
+   item->setText(colFeePerByte, QString::number(std::nearbyint(feePerByte)));
+   item->setText(colTxSize, QString::number(tx->getSize()));
+}
+
+AddressDetailsWidget::TxPtr AddressDetailsWidget::cachedTx(const BinaryData &txHash)
+{
+   const auto it = txCacheIndex_.find(txHash);
+   if (it == txCacheIndex_.end()) {
+      return nullptr;
+   }
+   txCache_.splice(txCache_.begin(), txCache_, it->second);
+   return it->second->second;
+}
+
+void AddressDetailsWidget::cacheTx(const BinaryData &txHash, const TxPtr &tx)
+{
+   if (txCacheCapacity_ == 0) {
+      return;
+   }
+   const auto it = txCacheIndex_.find(txHash);
+   if (it != txCacheIndex_.end()) {
+      txCache_.splice(txCache_.begin(), txCache_, it->second);
+      return;
+   }
+   txCache_.emplace_front(txHash, tx);
+   txCacheIndex_[txHash] = txCache_.begin();
+   if (txCache_.size() > txCacheCapacity_) {
+      txCacheIndex_.erase(txCache_.back().first);
+      txCache_.pop_back();
+   }
+}
+
+void AddressDetailsWidget::setTxCacheCapacity(size_t capacity)
+{
+   txCacheCapacity_ = capacity;
+   while (txCache_.size() > txCacheCapacity_) {
+      txCacheIndex_.erase(txCache_.back().first);
+      txCache_.pop_back();
+   }
 }
 
 // This function sets the confirmation column to the correct color based
@@ -361,55 +759,51 @@ void AddressDetailsWidget::onTxClicked(QTreeWidgetItem *item, int column)
    }
 }
 
-// Used in refresh. The callback used when getting a ledger delegate (pages)
-// from Armory. Processes the data as needed.
+// Used in refresh. Starts loading ledger pages from the delegate one by one.
 void AddressDetailsWidget::getTxData(const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate)
 {
-   // The callback that handles previous Tx objects attached to the TxIn objects
-   // and processes them. Once done, the UI can be changed.
-   const auto &cbCollectPrevTXs = [this]
-      (const AsyncClient::TxBatchResult &prevTxs, std::exception_ptr)
-   {
-      txMap_.insert(prevTxs.cbegin(), prevTxs.cend());
-      // We're finally ready to display all the transactions.
-      loadTransactions();
-   };
+   delegate_ = delegate;
+   pagesTotal_ = 0;
+   pagesLoaded_ = 0;
+   searchForCC();
 
-   // Callback used to process Tx objects obtained from Armory. Used primarily
-   // to obtain Tx entries for the TxIn objects we're checking.
-   const auto &cbCollectTXs = [this, cbCollectPrevTXs]
-      (const AsyncClient::TxBatchResult &txs, std::exception_ptr)
-   {
-      std::set<BinaryData> prevTxHashSet; // Prev Tx hashes for an addr (fee calc).
-      for (const auto &tx : txs) {
-         if (!tx.second) {
-            continue;
-         }
-         txMap_[tx.first] = tx.second;
-
-         // While here, we need to get the prev Tx with the UTXO being spent.
-         // This is done so that we can calculate fees later.
-         for (size_t i = 0; i < tx.second->getNumTxIn(); i++) {
-            TxIn in = tx.second->getTxInCopy(i);
-            OutPoint op = in.getOutPoint();
-            const auto &itTX = txMap_.find(op.getTxHash());
-            if (itTX == txMap_.end()) {
-               prevTxHashSet.insert(op.getTxHash());
-            }
-         }
-      }
-      if (prevTxHashSet.empty()) {
-         SPDLOG_LOGGER_WARN(logger_, "failed to get previous TXs");
-         loadTransactions();
+   const auto loadId = loadId_;
+   const auto &cbPageCnt = [this, loadId, delegate] (ReturnMessage<uint64_t> pageCnt) {
+      uint64_t inPageCnt = 0;
+      try {
+         inPageCnt = pageCnt.get();
       }
-      else {
-         armory_->getTXsByHash(prevTxHashSet, cbCollectPrevTXs, true);
+      catch (const std::exception &e) {
+         SPDLOG_LOGGER_ERROR(logger_, "Return data error (getPageCount) - {}", e.what());
+         return;
       }
+
+      QMetaObject::invokeMethod(this, [this, loadId, delegate, inPageCnt] {
+         if ((loadId != loadId_) || (delegate != delegate_)) {
+            return;
+         }
+         pagesTotal_ = static_cast<uint32_t>(inPageCnt);
+         if (pagesTotal_ == 0) {
+            SPDLOG_LOGGER_INFO(logger_, "address participates in no TXs");
+            updateTotals();
+            updateFields();
+            emit pageLoaded(0, 0);
+            emit finished();
+            return;
+         }
+         requestPage(0);
+      });
    };
+   delegate->getPageCount(cbPageCnt);
+}
 
-   // Callback to process ledger entries (pages) from the ledger delegate. Gets
-   // Tx entries from Armory.
-   const auto &cbLedger = [this, cbCollectTXs]
+// Next page is requested only when the previous one is displayed, so that
+// new query (or refresh) doesn't have to wait for the rest of old pages.
+void AddressDetailsWidget::requestPage(uint32_t pageId)
+{
+   const auto loadId = loadId_;
+   const auto delegate = delegate_;
+   const auto &cbLedger = [this, loadId, delegate, pageId]
       (ReturnMessage<std::vector<ClientClasses::LedgerEntry>> entries)
    {
       auto result = std::make_shared<std::vector<ClientClasses::LedgerEntry>>();
@@ -417,44 +811,19 @@ void AddressDetailsWidget::getTxData(const std::shared_ptr<AsyncClient::LedgerDe
          *result = entries.get();
       }
       catch (const std::exception &e) {
-         SPDLOG_LOGGER_ERROR(logger_, "Return data error - {}", e.what());
+         SPDLOG_LOGGER_ERROR(logger_, "Return data error (page {}) - {}", pageId, e.what());
          return;
       }
 
       // Process entries on main thread because this callback is called from background
-      QMetaObject::invokeMethod(this, [this, cbCollectTXs, result] {
-         std::set<BinaryData> txHashSet; // Hashes assoc'd with a given address.
-
-         // Get the hash and TXEntry object for each relevant Tx hash.
-         for (const auto &entry : *result) {
-            BinaryData searchHash(entry.getTxHash());
-            const auto &itTX = txMap_.find(searchHash);
-            if (itTX == txMap_.end()) {
-               txHashSet.insert(searchHash);
-               txEntryHashSet_[searchHash] = bs::TXEntry::fromLedgerEntry(entry);
-            }
-         }
-         if (txHashSet.empty()) {
-            SPDLOG_LOGGER_INFO(logger_, "address participates in no TXs");
-            cbCollectTXs({}, nullptr);
-         } else {
-            armory_->getTXsByHash(txHashSet, cbCollectTXs, true);
+      QMetaObject::invokeMethod(this, [this, loadId, delegate, pageId, result] {
+         if ((loadId != loadId_) || (delegate != delegate_)) {
+            return;
          }
+         addPage(pageId, *result);
       });
    };
-
-   const auto &cbPageCnt = [this, delegate, cbLedger] (ReturnMessage<uint64_t> pageCnt) {
-      try {
-         uint64_t inPageCnt = pageCnt.get();
-         for(uint64_t i = 0; i < inPageCnt; i++) {
-            delegate->getHistoryPage(uint32_t(i), cbLedger);
-         }
-      }
-      catch (const std::exception &e) {
-         SPDLOG_LOGGER_ERROR(logger_, "Return data error (getPageCount) - {}", e.what());
-      }
-   };
-   delegate->getPageCount(cbPageCnt);
+   delegate->getHistoryPage(pageId, cbLedger);
 }
 
 // Function that grabs the TX data for the address. Used in callback.
@@ -468,8 +837,13 @@ void AddressDetailsWidget::refresh(const std::shared_ptr<bs::sync::PlainWallet>
    }
 
    // Process TX data for the "first" (i.e., only) address in the wallet.
-   const auto &cbLedgerDelegate = [this](const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate) {
-      getTxData(delegate);
+   const auto loadId = loadId_;
+   const auto &cbLedgerDelegate = [this, loadId](const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate) {
+      QMetaObject::invokeMethod(this, [this, loadId, delegate] {
+         if (loadId == loadId_) {
+            getTxData(delegate);
+         }
+      });
    };
    const auto addr = wallet->getUsedAddressList().at(0);
    if (!wallet->getLedgerDelegateForAddress(addr, cbLedgerDelegate)) {
@@ -498,14 +872,22 @@ void AddressDetailsWidget::OnRefresh(std::vector<BinaryData> ids, bool online)
 // Clear out all address details.
 void AddressDetailsWidget::clear()
 {
+   // Drop replies for requests in flight
+   ++loadId_;
+   delegate_.reset();
+   pagesTotal_ = 0;
+   pagesLoaded_ = 0;
+
    for (const auto &dummyWallet : dummyWallets_) {
       dummyWallet.second->unregisterWallet();
    }
    totalReceived_ = 0;
    totalSpent_ = 0;
    dummyWallets_.clear();
-   txMap_.clear();
-   txEntryHashSet_.clear();
+   rows_.clear();
+   rowByHash_.clear();
+   txCache_.clear();
+   txCacheIndex_.clear();
    ccFound_ = {};
    isAuthAddr_ = false;
    authAddrStates_.clear();
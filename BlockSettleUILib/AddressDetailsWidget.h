@@ -15,6 +15,9 @@
 #include "AuthAddress.h"
 #include "ArmoryConnection.h"
 
+#include <functional>
+#include <list>
+#include <set>
 #include <QWidget>
 #include <QItemSelection>
 
@@ -49,6 +52,10 @@ public:
    void setBSAuthAddrs(const std::unordered_set<std::string> &bsAuthAddrs);
    void clear();
 
+   // Max number of Tx objects kept for rows details (fees, inputs/outputs)
+   void setTxCacheCapacity(size_t);
+   size_t txCacheSize() const { return txCache_.size(); }
+
    enum AddressTreeColumns {
       colDate,
       colTxId,
@@ -64,29 +71,67 @@ public:
 signals:
    void transactionClicked(QString txId);
    void finished() const;
+   void pageLoaded(int pagesLoaded, int pagesTotal);
 
 private slots:
    void onTxClicked(QTreeWidgetItem *item, int column);
    void OnRefresh(std::vector<BinaryData> ids, bool online);
    void updateFields();
+   void loadVisibleTxs();
 
 private:
+   using TxPtr = AsyncClient::TxBatchResult::mapped_type;
+   using TxLookup = std::function<TxPtr(const BinaryData &)>;
+
+   enum class TxState {
+      None,
+      Requested,
+      Loaded
+   };
+   struct Row
+   {
+      bs::TXEntry       entry;
+      QTreeWidgetItem * item{};
+      TxState           state{ TxState::None };
+      int64_t           counted{};  // contribution to totals
+   };
+
    void setConfirmationColor(QTreeWidgetItem *item);
    void getTxData(const std::shared_ptr<AsyncClient::LedgerDelegate> &);
    void refresh(const std::shared_ptr<bs::sync::PlainWallet> &);
-   void loadTransactions();
+   void requestPage(uint32_t pageId);
+   void addPage(uint32_t pageId, const std::vector<ClientClasses::LedgerEntry> &);
+   void renderPage(uint32_t pageId, const std::vector<ClientClasses::LedgerEntry> &);
+   void requestTxs(const std::vector<size_t> &rows);
+   void resetTxState(const std::set<BinaryData> &txHashes, TxState);
+   void onTxsReceived(const AsyncClient::TxBatchResult &, const std::set<BinaryData> &requested);
+   void onPrevTxsReceived(const std::vector<size_t> &rows, const AsyncClient::TxBatchResult &txs
+      , const AsyncClient::TxBatchResult &prevTxs);
+   void setTxDetails(size_t row, const TxLookup &);
+   void updateAmount(const Row &);
+   void updateAmounts();
+   int64_t totalsValue(const bs::TXEntry &) const;
+   void countRow(Row &);
+   void updateTotals();
    void searchForCC();
+   void searchForCC(const Tx &);
+   std::set<BinaryData> ccCandidates(const std::vector<ClientClasses::LedgerEntry> &);
+   bool isCcTx(const bs::TXEntry &) const;
+   void searchForAuth(const bs::TXEntry &, const Tx &);
    void searchForAuth();
 
+   TxPtr cachedTx(const BinaryData &txHash);
+   void cacheTx(const BinaryData &txHash, const TxPtr &);
+
 private:
-   // NB: Right now, the code is slightly inefficient. There are two maps with
-   // hashes for keys. One has transactions (Armory), and TXEntry objects (BS).
+   // NB: There are two containers with hashes for keys. One has transactions
+   // (Armory Tx cache), and the other has TXEntry objects (BS rows).
    // This is due to the manner in which we retrieve data from Armory. Pages are
    // returned for addresses, and we then retrieve the appropriate Tx objects
    // from Armory. (Tx searches go directly to Tx object retrieval.) The thing
    // is that the pages are what have data related to # of confs and other
    // block-related data. The Tx objects from Armory don't have block-related
-   // data that we need. So, we need two maps, at least for now.
+   // data that we need. So, we need both, at least for now.
    //
    // In addition, note that the TX hashes returned by Armory are in "internal"
    // byte order, whereas the displayed values need to be in "RPC" byte order.
@@ -110,8 +155,23 @@ private:
    std::int64_t totalSpent_{};
    std::int64_t totalReceived_{};
    std::unordered_map<std::string, std::shared_ptr<bs::sync::PlainWallet>> dummyWallets_;
-   AsyncClient::TxBatchResult txMap_; // A wallet's Tx hash / Tx map.
-   std::map<BinaryData, bs::TXEntry> txEntryHashSet_; // A wallet's Tx hash / Tx entry map.
+
+   // Ledger pages are requested one by one and rendered as they arrive.
+   // Tx objects are requested only for visible rows (and possible auth
+   // funding TXs) and are kept in bounded LRU cache: once row details are
+   // set, Tx is needed only for rows of TXs spending it.
+   std::vector<Row>  rows_;
+   std::map<BinaryData, size_t>  rowByHash_;
+
+   std::shared_ptr<AsyncClient::LedgerDelegate> delegate_;
+   uint32_t pagesTotal_{};
+   uint32_t pagesLoaded_{};
+   // Incremented on each new query, replies for previous ones are dropped
+   uint64_t loadId_{};
+
+   std::list<std::pair<BinaryData, TxPtr>>   txCache_;   // most recently used at front
+   std::map<BinaryData, std::list<std::pair<BinaryData, TxPtr>>::iterator> txCacheIndex_;
+   size_t   txCacheCapacity_;
 
    std::shared_ptr<ArmoryConnection>   armory_;
    std::shared_ptr<spdlog::logger>     logger_;
@@ -0,0 +1,164 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "AddressOwnershipIndex.h"
+
+#include <QCoreApplication>
+#include "Wallets/SyncHDWallet.h"
+#include "Wallets/SyncWalletsManager.h"
+
+using namespace bs::sync;
+
+AddressOwnershipIndex::AddressOwnershipIndex(const std::shared_ptr<WalletsManager> &walletsMgr
+   , QObject *parent)
+   : QObject(parent)
+   , walletsMgr_(walletsMgr)
+{
+   if (!walletsMgr_) {
+      return;
+   }
+   connect(walletsMgr_.get(), &WalletsManager::walletsSynchronized, this, &AddressOwnershipIndex::rebuild);
+   connect(walletsMgr_.get(), &WalletsManager::walletsReady, this, &AddressOwnershipIndex::rebuild);
+   connect(walletsMgr_.get(), &WalletsManager::walletAdded, this, &AddressOwnershipIndex::updateWallet);
+   connect(walletsMgr_.get(), &WalletsManager::walletChanged, this, &AddressOwnershipIndex::updateWallet);
+   connect(walletsMgr_.get(), &WalletsManager::walletDeleted, this, &AddressOwnershipIndex::removeWallet);
+   rebuild();
+}
+
+AddressOwnershipIndex::~AddressOwnershipIndex() = default;
+
+const AddressOwnershipIndex::Owner *AddressOwnershipIndex::find(const bs::Address &addr) const
+{
+   const auto it = owners_.find(key(addr));
+   if (it == owners_.end()) {
+      return nullptr;
+   }
+   return it->second;
+}
+
+bool AddressOwnershipIndex::contains(const bs::Address &addr, bs::core::wallet::Type type) const
+{
+   const auto owner = find(addr);
+   return (owner && (owner->type == type));
+}
+
+void AddressOwnershipIndex::rebuild()
+{
+   owners_.clear();
+   wallets_.clear();
+   if (!walletsMgr_) {
+      return;
+   }
+   for (const auto &leaf : walletsMgr_->getAllWallets()) {
+      addLeaf(leaf);
+   }
+}
+
+void AddressOwnershipIndex::updateWallet(const std::string &walletId)
+{
+   if (!walletsMgr_) {
+      return;
+   }
+   const auto leaf = walletsMgr_->getWalletById(walletId);
+   if (leaf) {
+      addLeaf(leaf);
+      return;
+   }
+   const auto hdWallet = walletsMgr_->getHDWalletById(walletId);
+   if (hdWallet) {
+      for (const auto &hdLeaf : hdWallet->getLeaves()) {
+         addLeaf(hdLeaf);
+      }
+      return;
+   }
+   removeWallet(walletId);
+}
+
+void AddressOwnershipIndex::removeWallet(const std::string &walletId)
+{
+   const auto eraseEntry = [this](std::unordered_map<std::string, WalletEntry>::iterator it) {
+      for (const auto &addrKey : it->second.keys) {
+         const auto itOwner = owners_.find(addrKey);
+         if ((itOwner != owners_.end()) && (itOwner->second == &it->second.owner)) {
+            owners_.erase(itOwner);
+         }
+      }
+      return wallets_.erase(it);
+   };
+
+   const auto itWallet = wallets_.find(walletId);
+   if (itWallet != wallets_.end()) {
+      eraseEntry(itWallet);
+      return;
+   }
+   // HD wallet id - drop all its leaves
+   for (auto it = wallets_.begin(); it != wallets_.end(); ) {
+      if (it->second.owner.rootId == walletId) {
+         it = eraseEntry(it);
+      }
+      else {
+         ++it;
+      }
+   }
+}
+
+bool AddressOwnershipIndex::synchronizeWallet(const std::string &walletId
+   , const std::function<void()> &cbDone)
+{
+   if (!walletsMgr_) {
+      return false;
+   }
+   const auto wallet = walletsMgr_->getWalletById(walletId);
+   if (!wallet) {
+      return false;
+   }
+   wallet->synchronize([this, walletId, cbDone, handle = validityFlag_.handle()] {
+      QMetaObject::invokeMethod(qApp, [this, walletId, cbDone, handle] {
+         if (!handle.isValid()) {
+            return;
+         }
+         updateWallet(walletId);
+         if (cbDone) {
+            cbDone();
+         }
+      });
+   });
+   return true;
+}
+
+void AddressOwnershipIndex::addAddresses(const Owner &owner, const std::vector<bs::Address> &addresses)
+{
+   auto &entry = wallets_[owner.walletId];
+   entry.owner = owner;
+   entry.keys.reserve(entry.keys.size() + addresses.size());
+   owners_.reserve(owners_.size() + addresses.size());
+   for (const auto &addr : addresses) {
+      auto addrKey = key(addr);
+      // Addresses already indexed are skipped, so re-adding the same leaf is cheap
+      if (owners_.emplace(addrKey, &entry.owner).second) {
+         entry.keys.emplace_back(std::move(addrKey));
+      }
+   }
+}
+
+void AddressOwnershipIndex::addLeaf(const std::shared_ptr<Wallet> &leaf)
+{
+   if (!leaf) {
+      return;
+   }
+   Owner owner;
+   owner.walletId = leaf->walletId();
+   owner.type = leaf->type();
+   const auto hdRoot = walletsMgr_->getHDRootForLeaf(owner.walletId);
+   if (hdRoot) {
+      owner.rootId = hdRoot->walletId();
+   }
+   addAddresses(owner, leaf->getUsedAddressList());
+}
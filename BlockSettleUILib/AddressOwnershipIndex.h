@@ -0,0 +1,90 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef ADDRESS_OWNERSHIP_INDEX_H
+#define ADDRESS_OWNERSHIP_INDEX_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include "Address.h"
+#include "CoreWallet.h"
+#include "ValidityFlag.h"
+
+namespace bs {
+   namespace sync {
+      class Wallet;
+      class WalletsManager;
+
+      // Maps each address handed out by wallets of WalletsManager to its owning
+      // leaf, so that checking all outputs of a transaction doesn't need to ask
+      // every leaf about every address. Follows WalletsManager signals: rebuilt
+      // on sync, and leaf addresses are re-read when wallet reports a change
+      // (e.g. new address was generated).
+      class AddressOwnershipIndex : public QObject
+      {
+         Q_OBJECT
+      public:
+         struct Owner
+         {
+            std::string walletId;   // leaf
+            std::string rootId;     // HD wallet the leaf belongs to (if any)
+            bs::core::wallet::Type  type;
+         };
+
+         AddressOwnershipIndex(const std::shared_ptr<WalletsManager> &
+            , QObject *parent = nullptr);
+         ~AddressOwnershipIndex() override;
+
+         const Owner *find(const bs::Address &) const;
+         bool contains(const bs::Address &addr) const { return (find(addr) != nullptr); }
+         bool contains(const bs::Address &, bs::core::wallet::Type) const;
+
+         size_t size() const { return owners_.size(); }
+         size_t walletsCount() const { return wallets_.size(); }
+
+         void rebuild();
+         // Accepts both leaf and HD wallet ids, unknown ids are dropped from index
+         void updateWallet(const std::string &walletId);
+         void removeWallet(const std::string &walletId);
+         // Re-synchronizes leaf from signer and re-reads its addresses once done,
+         // as wallet sync doesn't emit walletChanged. cbDone is called on the
+         // index thread. Returns false if the wallet is unknown.
+         bool synchronizeWallet(const std::string &walletId
+            , const std::function<void()> &cbDone = nullptr);
+         // Adds addresses of a wallet not necessarily known to WalletsManager
+         void addAddresses(const Owner &, const std::vector<bs::Address> &);
+
+      private:
+         void addLeaf(const std::shared_ptr<Wallet> &);
+
+         static std::string key(const bs::Address &addr) { return addr.prefixed().toBinStr(); }
+
+      private:
+         struct WalletEntry
+         {
+            Owner owner;
+            std::vector<std::string>   keys;
+         };
+
+         std::shared_ptr<WalletsManager>  walletsMgr_;
+         std::unordered_map<std::string, WalletEntry> wallets_;
+         // Points to owners stored in wallets_ (nodes of unordered_map are stable)
+         std::unordered_map<std::string, const Owner *>  owners_;
+         ValidityFlag   validityFlag_;
+      };
+
+   }  // namespace sync
+}  // namespace bs
+
+#endif // ADDRESS_OWNERSHIP_INDEX_H
@@ -30,7 +30,8 @@
 AuthAddressDialog::AuthAddressDialog(const std::shared_ptr<spdlog::logger> &logger
    , const std::shared_ptr<AuthAddressManager> &authAddressManager
    , const std::shared_ptr<AssetManager> &assetMgr
-   , const std::shared_ptr<ApplicationSettings> &settings, QWidget* parent)
+   , const std::shared_ptr<ApplicationSettings> &settings
+   , const std::shared_ptr<AuthAddressVerificationCache> &verificationCache, QWidget* parent)
    : QDialog(parent)
    , ui_(new Ui::AuthAddressDialog())
    , logger_(logger)
@@ -40,7 +41,7 @@ AuthAddressDialog::AuthAddressDialog(const std::shared_ptr<spdlog::logger> &logg
 {
    ui_->setupUi(this);
 
-   auto *originModel = new AuthAddressViewModel(authAddressManager_, ui_->treeViewAuthAdress);
+   auto *originModel = new AuthAddressViewModel(authAddressManager_, verificationCache, ui_->treeViewAuthAdress);
    model_ = new AuthAdressControlProxyModel(originModel, this);
    model_->setVisibleRowsCount(settings_->get<int>(ApplicationSettings::numberOfAuthAddressVisible));
    ui_->treeViewAuthAdress->setModel(model_);
@@ -50,7 +51,7 @@ AuthAddressDialog::AuthAddressDialog(const std::shared_ptr<spdlog::logger> &logg
    connect(ui_->treeViewAuthAdress->selectionModel(), &QItemSelectionModel::selectionChanged
       , this, &AuthAddressDialog::adressSelected);
    connect(model_, &AuthAdressControlProxyModel::modelReset, this, &AuthAddressDialog::onModelReset);
-   connect(originModel, &AuthAddressViewModel::updateSelectionAfterReset, this, &AuthAddressDialog::onUpdateSelection);
+   connect(originModel, &AuthAddressViewModel::addressesUpdated, this, &AuthAddressDialog::onModelReset);
 
    connect(authAddressManager_.get(), &AuthAddressManager::AddrVerifiedOrRevoked, this, &AuthAddressDialog::onAddressStateChanged, Qt::QueuedConnection);
    connect(authAddressManager_.get(), &AuthAddressManager::Error, this, &AuthAddressDialog::onAuthMgrError, Qt::QueuedConnection);
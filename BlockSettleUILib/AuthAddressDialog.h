@@ -20,6 +20,7 @@
 #include <QPointer>
 
 class AssetManager;
+class AuthAddressVerificationCache;
 class AuthAdressControlProxyModel;
 class QItemSelection;
 
@@ -40,7 +41,8 @@ public:
    AuthAddressDialog(const std::shared_ptr<spdlog::logger> &logger
       , const std::shared_ptr<AuthAddressManager>& authAddressManager
       , const std::shared_ptr<AssetManager> &
-      , const std::shared_ptr<ApplicationSettings> &, QWidget* parent = nullptr);
+      , const std::shared_ptr<ApplicationSettings> &
+      , const std::shared_ptr<AuthAddressVerificationCache> &, QWidget* parent = nullptr);
    ~AuthAddressDialog() override;
 
    void setAddressToVerify(const QString &addr);
@@ -0,0 +1,501 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "AuthAddressVerificationCache.h"
+
+#include <algorithm>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <spdlog/spdlog.h>
+#include "AuthAddressManager.h"
+
+namespace {
+   const quint32 kCacheMagic = 0x42534143;   // "BSAC"
+   const quint32 kCacheVersion = 2;
+
+   bool isCacheable(AddressVerificationState state)
+   {
+      switch (state) {
+      case AddressVerificationState::Verified:
+      case AddressVerificationState::Revoked:
+      case AddressVerificationState::RevokedByBS:
+         return true;
+      default:
+         return false;
+      }
+   }
+
+   bool isTransient(AddressVerificationState state)
+   {
+      return (state == AddressVerificationState::InProgress)
+         || (state == AddressVerificationState::VerificationFailed);
+   }
+
+   void writeBinary(QDataStream &out, const BinaryData &data)
+   {
+      out << QByteArray(reinterpret_cast<const char *>(data.getPtr()), int(data.getSize()));
+   }
+
+   BinaryData readBinary(QDataStream &in)
+   {
+      QByteArray data;
+      in >> data;
+      return BinaryData(reinterpret_cast<const uint8_t *>(data.constData()), size_t(data.size()));
+   }
+}  // namespace
+
+
+AuthAddressVerificationCache::AuthAddressVerificationCache(const std::shared_ptr<spdlog::logger> &logger
+   , const std::shared_ptr<ArmoryConnection> &armory, const QString &fileName)
+   : logger_(logger)
+   , fileName_(fileName)
+{
+   init(armory.get());
+}
+
+AuthAddressVerificationCache::~AuthAddressVerificationCache() noexcept
+{
+   cleanup();
+}
+
+bool AuthAddressVerificationCache::load()
+{
+   QFile file(fileName_);
+   if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+   }
+   QDataStream in(&file);
+   in.setVersion(QDataStream::Qt_5_6);
+
+   quint32 magic = 0, version = 0, heightCutoff = 0, nbEntries = 0;
+   in >> magic >> version;
+   if ((magic != kCacheMagic) || (version != kCacheVersion)) {
+      SPDLOG_LOGGER_INFO(logger_, "unsupported cache format in {}", fileName_.toStdString());
+      return false;
+   }
+   in >> heightCutoff >> nbEntries;
+
+   std::map<BinaryData, Entry> entries;
+   for (quint32 i = 0; (i < nbEntries) && (in.status() == QDataStream::Ok); ++i) {
+      const auto prefixed = readBinary(in);
+      qint32 state = 0;
+      quint32 nbHashes = 0;
+      in >> state >> nbHashes;
+      Entry entry{ static_cast<AddressVerificationState>(state), {}, {} };
+      for (quint32 j = 0; (j < nbHashes) && (in.status() == QDataStream::Ok); ++j) {
+         entry.txHashes.insert(readBinary(in));
+      }
+      quint32 nbOutpoints = 0;
+      in >> nbOutpoints;
+      for (quint32 j = 0; (j < nbOutpoints) && (in.status() == QDataStream::Ok); ++j) {
+         ValidationOutpoint outpoint;
+         outpoint.address = readBinary(in);
+         outpoint.txHash = readBinary(in);
+         quint32 txOutIndex = 0;
+         in >> txOutIndex;
+         outpoint.txOutIndex = txOutIndex;
+         entry.validationOutpoints.push_back(std::move(outpoint));
+      }
+      entries[prefixed] = std::move(entry);
+   }
+   if (in.status() != QDataStream::Ok) {
+      SPDLOG_LOGGER_WARN(logger_, "{} is corrupted", fileName_.toStdString());
+      return false;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_ = std::move(entries);
+      heightCutoff_ = heightCutoff;
+   }
+   SPDLOG_LOGGER_DEBUG(logger_, "{} auth addresses loaded, checked up to block {}"
+      , nbEntries, heightCutoff);
+   emit updated();
+   return true;
+}
+
+bool AuthAddressVerificationCache::get(const bs::Address &addr, AddressVerificationState &state) const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   const auto it = entries_.find(addr.prefixed());
+   if (it == entries_.end()) {
+      return false;
+   }
+   state = it->second.state;
+   return true;
+}
+
+size_t AuthAddressVerificationCache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   return entries_.size();
+}
+
+std::vector<bs::Address> AuthAddressVerificationCache::verifiedAddresses(
+   const std::shared_ptr<AuthAddressManager> &authManager) const
+{
+   std::vector<bs::Address> result;
+   for (size_t i = 0; i < authManager->GetAddressCount(); ++i) {
+      const auto address = authManager->GetAddress(i);
+      auto state = authManager->GetState(address);
+      if (state == AddressVerificationState::InProgress) {
+         get(address, state);
+      }
+      if (state == AddressVerificationState::Verified) {
+         result.push_back(address);
+      }
+   }
+   return result;
+}
+
+void AuthAddressVerificationCache::update(const std::shared_ptr<AuthAddressManager> &authManager)
+{
+   for (size_t i = 0; i < authManager->GetAddressCount(); ++i) {
+      const auto address = authManager->GetAddress(i);
+      put(address, authManager->GetState(address));
+   }
+}
+
+void AuthAddressVerificationCache::put(const bs::Address &addr, AddressVerificationState state)
+{
+   if (isTransient(state)) {
+      return;
+   }
+   const auto prefixed = addr.prefixed();
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto it = entries_.find(prefixed);
+      if (!isCacheable(state)) {
+         if (it != entries_.end()) {
+            entries_.erase(it);
+            save();
+         }
+         return;
+      }
+      if ((it != entries_.end()) && (it->second.state == state)) {
+         return;
+      }
+   }
+
+   // TXs are requested with ZCs, so that a ZC which gets mined later doesn't
+   // invalidate the entry
+   const auto cbOutpoints = [this, handle = validityFlag_.handle(), prefixed, state]
+      (const OutpointBatch &batch, std::exception_ptr eptr) mutable
+   {
+      ValidityGuard lock(handle);
+      if (!handle.isValid()) {
+         return;
+      }
+      if (eptr) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to get outpoints for {}"
+            , bs::Address::fromHash(prefixed).display());
+         return;
+      }
+      Entry entry{ state, {}, {} };
+      BinaryData vettingTxHash;
+      unsigned int vettingTxHeight = UINT32_MAX;
+      const auto itOutpoints = batch.outpoints_.find(prefixed);
+      if (itOutpoints != batch.outpoints_.end()) {
+         for (const auto &outpoint : itOutpoints->second) {
+            entry.txHashes.insert(outpoint.txHash_);
+            if (outpoint.isSpent_ && !outpoint.spenderHash_.empty()) {
+               entry.txHashes.insert(outpoint.spenderHash_);
+            }
+            // The first TX funding user address is the vetting one
+            if (vettingTxHash.empty() || (outpoint.txHeight_ < vettingTxHeight)) {
+               vettingTxHash = outpoint.txHash_;
+               vettingTxHeight = outpoint.txHeight_;
+            }
+         }
+      }
+      {
+         std::lock_guard<std::mutex> lockEntries(mutex_);
+         if (!heightCutoff_) {
+            heightCutoff_ = batch.heightCutoff_;
+         }
+      }
+      if (vettingTxHash.empty()) {
+         store(prefixed, std::move(entry));
+         return;
+      }
+      addValidationOutpoints(prefixed, std::move(entry), vettingTxHash);
+   };
+   if (!armory_ || !armory_->getOutpointsForAddresses({ prefixed }, cbOutpoints)) {
+      SPDLOG_LOGGER_DEBUG(logger_, "Armory is not available - {} is not cached", addr.display());
+   }
+}
+
+// Validation address (the one funding vetting TX) can be revoked too, so the
+// entry also watches its first outpoint - spending it revokes all user
+// addresses vetted from it. Validation addresses are resolved from inputs of
+// the vetting TX.
+void AuthAddressVerificationCache::addValidationOutpoints(const BinaryData &prefixed, Entry entry
+   , const BinaryData &vettingTxHash)
+{
+   const auto cbVettingTX = [this, handle = validityFlag_.handle(), prefixed, entry]
+      (const AsyncClient::TxBatchResult &txs, std::exception_ptr eptr) mutable
+   {
+      ValidityGuard lock(handle);
+      if (!handle.isValid()) {
+         return;
+      }
+      if (eptr || txs.empty() || !txs.begin()->second || !txs.begin()->second->isInitialized()) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to get vetting TX for {}"
+            , bs::Address::fromHash(prefixed).display());
+         return;
+      }
+      const auto &vettingTx = txs.begin()->second;
+      std::map<BinaryData, std::set<uint32_t>> spentOutpoints;
+      for (size_t i = 0; i < vettingTx->getNumTxIn(); ++i) {
+         const auto txIn = vettingTx->getTxInCopy(int(i));
+         if (!txIn.isCoinbase()) {
+            const auto outpoint = txIn.getOutPoint();
+            spentOutpoints[outpoint.getTxHash()].insert(outpoint.getTxOutIndex());
+         }
+      }
+      std::set<BinaryData> prevTxHashes;
+      for (const auto &spent : spentOutpoints) {
+         prevTxHashes.insert(spent.first);
+      }
+
+      const auto cbPrevTXs = [this, handle, prefixed, entry, spentOutpoints]
+         (const AsyncClient::TxBatchResult &prevTxs, std::exception_ptr eptr) mutable
+      {
+         ValidityGuard lock(handle);
+         if (!handle.isValid()) {
+            return;
+         }
+         if (eptr) {
+            SPDLOG_LOGGER_ERROR(logger_, "failed to get vetting inputs for {}"
+               , bs::Address::fromHash(prefixed).display());
+            return;
+         }
+         std::set<BinaryData> validationAddrs;
+         for (const auto &spent : spentOutpoints) {
+            const auto itPrevTx = prevTxs.find(spent.first);
+            if ((itPrevTx == prevTxs.end()) || !itPrevTx->second
+               || !itPrevTx->second->isInitialized()) {
+               SPDLOG_LOGGER_ERROR(logger_, "vetting input {} for {} is not found"
+                  , spent.first.toHexStr(true), bs::Address::fromHash(prefixed).display());
+               return;
+            }
+            for (const auto txOutIndex : spent.second) {
+               try {
+                  const auto addr = bs::Address::fromTxOut(itPrevTx->second->getTxOutCopy(int(txOutIndex)));
+                  validationAddrs.insert(addr.prefixed());
+               }
+               catch (const std::exception &e) {
+                  SPDLOG_LOGGER_WARN(logger_, "unsupported vetting input: {}", e.what());
+               }
+            }
+         }
+         watchValidationAddresses(prefixed, std::move(entry), validationAddrs);
+      };
+      if (prevTxHashes.empty() || !armory_->getTXsByHash(prevTxHashes, cbPrevTXs, true)) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to request vetting inputs for {}"
+            , bs::Address::fromHash(prefixed).display());
+      }
+   };
+   if (!armory_->getTXsByHash({ vettingTxHash }, cbVettingTX, true)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to request vetting TX for {}"
+         , bs::Address::fromHash(prefixed).display());
+   }
+}
+
+void AuthAddressVerificationCache::watchValidationAddresses(const BinaryData &prefixed, Entry entry
+   , const std::set<BinaryData> &validationAddrs)
+{
+   if (validationAddrs.empty()) {
+      store(prefixed, std::move(entry));
+      return;
+   }
+   const auto cbOutpoints = [this, handle = validityFlag_.handle(), prefixed, entry]
+      (const OutpointBatch &batch, std::exception_ptr eptr) mutable
+   {
+      ValidityGuard lock(handle);
+      if (!handle.isValid()) {
+         return;
+      }
+      if (eptr) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to get validation outpoints for {}"
+            , bs::Address::fromHash(prefixed).display());
+         return;
+      }
+      for (const auto &addrOutpoints : batch.outpoints_) {
+         const OutpointData *first = nullptr;
+         for (const auto &outpoint : addrOutpoints.second) {
+            if (!first || (outpoint.txHeight_ < first->txHeight_)) {
+               first = &outpoint;
+            }
+         }
+         // Already spent one means revoked validation address - nothing could change
+         if (first && !first->isSpent_) {
+            entry.validationOutpoints.push_back({ addrOutpoints.first, first->txHash_, first->txOutIndex_ });
+         }
+      }
+      store(prefixed, std::move(entry));
+   };
+   if (!armory_->getOutpointsForAddresses(validationAddrs, cbOutpoints)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to request validation outpoints for {}"
+         , bs::Address::fromHash(prefixed).display());
+   }
+}
+
+void AuthAddressVerificationCache::store(const BinaryData &prefixed, Entry entry)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_[prefixed] = std::move(entry);
+      save();
+   }
+   emit updated();
+}
+
+void AuthAddressVerificationCache::checkNewBlocks()
+{
+   std::set<BinaryData> addresses;
+   unsigned int heightCutoff = 0;
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entries_.empty() || checkInProgress_) {
+         return;
+      }
+      for (const auto &entry : entries_) {
+         addresses.insert(entry.first);
+         for (const auto &outpoint : entry.second.validationOutpoints) {
+            addresses.insert(outpoint.address);
+         }
+      }
+      heightCutoff = heightCutoff_;
+      checkInProgress_ = true;
+   }
+
+   // Only mined TXs are requested (ZC index cutoff is out of range)
+   const auto cbOutpoints = [this, handle = validityFlag_.handle()]
+      (const OutpointBatch &batch, std::exception_ptr eptr) mutable
+   {
+      ValidityGuard lock(handle);
+      if (!handle.isValid()) {
+         return;
+      }
+      std::vector<BinaryData> invalidated;
+      {
+         std::lock_guard<std::mutex> lockEntries(mutex_);
+         checkInProgress_ = false;
+         if (eptr) {
+            SPDLOG_LOGGER_ERROR(logger_, "failed to get outpoints for cached addresses");
+            return;
+         }
+         // Validation address revocation spends its first outpoint
+         for (const auto &addrOutpoints : batch.outpoints_) {
+            for (const auto &outpoint : addrOutpoints.second) {
+               if (!outpoint.isSpent_) {
+                  continue;
+               }
+               for (auto itEntry = entries_.begin(); itEntry != entries_.end(); ) {
+                  const auto &watched = itEntry->second.validationOutpoints;
+                  const auto itWatched = std::find_if(watched.cbegin(), watched.cend()
+                     , [&addrOutpoints, &outpoint](const ValidationOutpoint &validation) {
+                     return (validation.address == addrOutpoints.first)
+                        && (validation.txHash == outpoint.txHash_)
+                        && (validation.txOutIndex == outpoint.txOutIndex_);
+                  });
+                  if (itWatched != watched.cend()) {
+                     invalidated.push_back(itEntry->first);
+                     itEntry = entries_.erase(itEntry);
+                  }
+                  else {
+                     ++itEntry;
+                  }
+               }
+            }
+         }
+
+         for (const auto &addrOutpoints : batch.outpoints_) {
+            const auto itEntry = entries_.find(addrOutpoints.first);
+            if (itEntry == entries_.end()) {
+               continue;
+            }
+            const auto &txHashes = itEntry->second.txHashes;
+            for (const auto &outpoint : addrOutpoints.second) {
+               if ((txHashes.find(outpoint.txHash_) == txHashes.end())
+                  || (outpoint.isSpent_ && !outpoint.spenderHash_.empty()
+                     && (txHashes.find(outpoint.spenderHash_) == txHashes.end()))) {
+                  invalidated.push_back(addrOutpoints.first);
+                  entries_.erase(itEntry);
+                  break;
+               }
+            }
+         }
+         heightCutoff_ = batch.heightCutoff_;
+         save();
+      }
+      for (const auto &prefixed : invalidated) {
+         SPDLOG_LOGGER_DEBUG(logger_, "{} is touched by new block - invalidated"
+            , bs::Address::fromHash(prefixed).display());
+      }
+      if (!invalidated.empty()) {
+         emit updated();
+      }
+   };
+   if (!armory_ || !armory_->getOutpointsForAddresses(addresses, cbOutpoints, heightCutoff, UINT32_MAX)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      checkInProgress_ = false;
+   }
+}
+
+void AuthAddressVerificationCache::onNewBlock(unsigned int, unsigned int branchHeight)
+{
+   if (branchHeight) {     // reorg - blocks above branch point are checked again
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (branchHeight < heightCutoff_) {
+         heightCutoff_ = branchHeight;
+      }
+   }
+   checkNewBlocks();
+}
+
+void AuthAddressVerificationCache::onStateChanged(ArmoryState state)
+{
+   if (state == ArmoryState::Ready) {
+      checkNewBlocks();
+   }
+}
+
+bool AuthAddressVerificationCache::save() const
+{
+   QSaveFile file(fileName_);
+   if (!file.open(QIODevice::WriteOnly)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to open {}", fileName_.toStdString());
+      return false;
+   }
+   QDataStream out(&file);
+   out.setVersion(QDataStream::Qt_5_6);
+   out << kCacheMagic << kCacheVersion << quint32(heightCutoff_) << quint32(entries_.size());
+   for (const auto &entry : entries_) {
+      writeBinary(out, entry.first);
+      out << qint32(entry.second.state) << quint32(entry.second.txHashes.size());
+      for (const auto &txHash : entry.second.txHashes) {
+         writeBinary(out, txHash);
+      }
+      out << quint32(entry.second.validationOutpoints.size());
+      for (const auto &outpoint : entry.second.validationOutpoints) {
+         writeBinary(out, outpoint.address);
+         writeBinary(out, outpoint.txHash);
+         out << quint32(outpoint.txOutIndex);
+      }
+   }
+   if ((out.status() != QDataStream::Ok) || !file.commit()) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to write {}", fileName_.toStdString());
+      return false;
+   }
+   return true;
+}
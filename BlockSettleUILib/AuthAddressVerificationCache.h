@@ -0,0 +1,111 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __AUTH_ADDRESS_VERIFICATION_CACHE_H__
+#define __AUTH_ADDRESS_VERIFICATION_CACHE_H__
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+#include <QObject>
+#include <QString>
+
+#include "Address.h"
+#include "ArmoryConnection.h"
+#include "AuthAddress.h"
+#include "BinaryData.h"
+#include "ValidityFlag.h"
+
+namespace spdlog {
+   class logger;
+}
+class AuthAddressManager;
+
+// Persistent auth address verification results, so that auth state is known
+// right after start, before AuthAddressManager re-validates addresses.
+// Each entry keeps hashes of TXs funding and spending address outputs at the
+// time of verification, and the first outpoint of each validation address
+// which vetted it. Entry is dropped only when a new block brings another TX
+// for the address or spends the watched validation outpoint (validation
+// address revocation) - all cached and validation addresses are checked with
+// one Armory request per block (or per reconnect, for blocks mined while offline).
+class AuthAddressVerificationCache : public QObject, public ArmoryCallbackTarget
+{
+   Q_OBJECT
+public:
+   AuthAddressVerificationCache(const std::shared_ptr<spdlog::logger> &
+      , const std::shared_ptr<ArmoryConnection> &, const QString &fileName);
+   ~AuthAddressVerificationCache() noexcept override;
+
+   AuthAddressVerificationCache(const AuthAddressVerificationCache&) = delete;
+   AuthAddressVerificationCache& operator = (const AuthAddressVerificationCache&) = delete;
+
+   bool load();
+
+   // Returns false if address is not in cache
+   bool get(const bs::Address &, AddressVerificationState &) const;
+   size_t size() const;
+
+   // Verified addresses of AuthAddressManager (in its order), including those
+   // still being validated by it but cached as Verified
+   std::vector<bs::Address> verifiedAddresses(const std::shared_ptr<AuthAddressManager> &) const;
+
+   // Only states derived from blockchain (Verified, Revoked, RevokedByBS) are
+   // cached. Other final states remove the entry, while InProgress and
+   // VerificationFailed leave it as is.
+   void put(const bs::Address &, AddressVerificationState);
+   // Puts current states of all AuthAddressManager addresses
+   void update(const std::shared_ptr<AuthAddressManager> &);
+
+   // Checks cached addresses against blocks mined since the last check
+   void checkNewBlocks();
+
+signals:
+   void updated();      // entry was added or invalidated
+
+private:
+   void onNewBlock(unsigned int height, unsigned int branchHeight) override;
+   void onStateChanged(ArmoryState) override;
+
+private:
+   struct ValidationOutpoint
+   {
+      BinaryData  address;    // prefixed
+      BinaryData  txHash;
+      uint32_t    txOutIndex{};
+   };
+
+   struct Entry
+   {
+      AddressVerificationState   state;
+      std::set<BinaryData>       txHashes;
+      std::vector<ValidationOutpoint>  validationOutpoints;
+   };
+
+   void addValidationOutpoints(const BinaryData &prefixed, Entry, const BinaryData &vettingTxHash);
+   void watchValidationAddresses(const BinaryData &prefixed, Entry, const std::set<BinaryData> &validationAddrs);
+   void store(const BinaryData &prefixed, Entry);
+
+   bool save() const;   // must be called with mutex_ locked
+
+   std::shared_ptr<spdlog::logger>  logger_;
+   const QString  fileName_;
+
+   mutable std::mutex   mutex_;
+   std::map<BinaryData, Entry>   entries_;   // by prefixed address
+   unsigned int   heightCutoff_ = 0;         // blocks below are already checked
+   bool           checkInProgress_ = false;
+
+   ValidityFlag   validityFlag_;
+};
+
+#endif // __AUTH_ADDRESS_VERIFICATION_CACHE_H__
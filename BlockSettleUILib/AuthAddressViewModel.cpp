@@ -9,18 +9,26 @@
 
 */
 #include <QFont>
-#include <QTreeView>
 #include "AuthAddressViewModel.h"
+#include "AuthAddressVerificationCache.h"
 #include "EncryptionUtils.h"
+#include "KeyedDiff.h"
 
 
-AuthAddressViewModel::AuthAddressViewModel(const std::shared_ptr<AuthAddressManager>& authManager, QObject *parent)
+AuthAddressViewModel::AuthAddressViewModel(const std::shared_ptr<AuthAddressManager>& authManager
+   , const std::shared_ptr<AuthAddressVerificationCache> &verificationCache, QObject *parent)
    : QAbstractItemModel(parent)
    , authManager_(authManager)
+   , verificationCache_(verificationCache)
    , defaultAddr_(authManager->getDefault())
 {
    connect(authManager_.get(), &AuthAddressManager::AddressListUpdated, this, &AuthAddressViewModel::onAddressListUpdated, Qt::QueuedConnection);
    connect(authManager_.get(), &AuthAddressManager::AuthWalletChanged, this, &AuthAddressViewModel::onAddressListUpdated, Qt::QueuedConnection);
+   // rows keep address state, so they need to be refreshed on each state change
+   connect(authManager_.get(), &AuthAddressManager::AddrStateChanged, this, &AuthAddressViewModel::onAddressListUpdated, Qt::QueuedConnection);
+   if (verificationCache_) {
+      connect(verificationCache_.get(), &AuthAddressVerificationCache::updated, this, &AuthAddressViewModel::onAddressListUpdated, Qt::QueuedConnection);
+   }
 }
 
 AuthAddressViewModel::~AuthAddressViewModel() noexcept = default;
@@ -41,14 +49,14 @@ QVariant AuthAddressViewModel::data(const QModelIndex &index, int role) const
       return {};
    }
 
-   const auto address = addresses_[index.row()];
+   const auto &address = addresses_[index.row()].address;
 
    if (role == Qt::DisplayRole) {
       switch(static_cast<AuthAddressViewColumns>(index.column())) {
       case AuthAddressViewColumns::ColumnName:
          return QString::fromStdString(address.display());
       case AuthAddressViewColumns::ColumnState:
-         switch (authManager_->GetState(address)) {
+         switch (addresses_[index.row()].state) {
          case AddressVerificationState::VerificationFailed:
             return tr("State loading failed");
          case AddressVerificationState::InProgress:
@@ -123,7 +131,7 @@ bs::Address AuthAddressViewModel::getAddress(const QModelIndex& index) const
       return {};
    }
 
-   return addresses_[index.row()];
+   return addresses_[index.row()].address;
 }
 
 bool AuthAddressViewModel::isAddressNotSubmitted(int row) const
@@ -132,15 +140,15 @@ bool AuthAddressViewModel::isAddressNotSubmitted(int row) const
       return false;
    }
 
-   const auto address = addresses_[row];
-   return authManager_->GetState(address) == AddressVerificationState::NotSubmitted || authManager_->GetState(address) == AddressVerificationState::InProgress;
+   const auto state = addresses_[row].state;
+   return state == AddressVerificationState::NotSubmitted || state == AddressVerificationState::InProgress;
 }
 
 void AuthAddressViewModel::setDefaultAddr(const bs::Address &addr)
 {
    defaultAddr_ = addr;
    for (int i = 0; i < addresses_.size(); ++i) {
-      if (addresses_[i].prefixed() == defaultAddr_.prefixed()) {
+      if (addresses_[i].address.prefixed() == defaultAddr_.prefixed()) {
          emit dataChanged(index(i, 0), index(i, 0), { Qt::FontRole });
          return;
       }
@@ -149,32 +157,25 @@ void AuthAddressViewModel::setDefaultAddr(const bs::Address &addr)
 
 void AuthAddressViewModel::onAddressListUpdated()
 {
-   // store selection
-   const auto treeView = qobject_cast<QTreeView *>(QObject::parent());
-   std::pair<int, std::string> selectedRowToName;
-   if (treeView && treeView->selectionModel() && treeView->selectionModel()->hasSelection()) {
-      selectedRowToName.first = treeView->selectionModel()->selectedRows()[0].row();
-      selectedRowToName.second = getAddress(index(selectedRowToName.first,
-         static_cast<int>(AuthAddressViewColumns::ColumnName))).display();
-   }
-
-   // do actual update
-   const int sizeBeforeReset = addresses_.size();
-   emit beginResetModel();
-   addresses_.clear();
+   // Rows are updated in place (no reset), so view keeps its selection
+   std::vector<AddressRow> newAddresses;
    const int total = authManager_->GetAddressCount();
-   addresses_.reserve(total);
+   newAddresses.reserve(total);
    for (int i = 0; i < total; ++i) {
-      addresses_.push_back(authManager_->GetAddress(i));
-   }   
-   emit endResetModel();
-
-   // restore selection if needed
-   if (sizeBeforeReset >= addresses_.size()
-      && selectedRowToName.first < addresses_.size()
-      && selectedRowToName.second == addresses_[selectedRowToName.first].display()) {
-      emit updateSelectionAfterReset(selectedRowToName.first);
+      const auto address = authManager_->GetAddress(i);
+      auto state = authManager_->GetState(address);
+      // cache is fed by main window, here it only fills the gap until validation is done
+      if (verificationCache_ && (state == AddressVerificationState::InProgress)) {
+         verificationCache_->get(address, state);
+      }
+      newAddresses.push_back({ address, state });
    }
+
+   bs::ui::applyKeyedDiff(this, addresses_, std::move(newAddresses)
+      , [](const AddressRow &row) { return row.address; }
+      , [](const AddressRow &lhs, const AddressRow &rhs) { return lhs.state == rhs.state; });
+
+   emit addressesUpdated();
 }
 
 AuthAdressControlProxyModel::AuthAdressControlProxyModel(AuthAddressViewModel *sourceModel, QWidget *parent)
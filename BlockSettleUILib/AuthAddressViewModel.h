@@ -21,11 +21,17 @@
 #include "AuthAddressManager.h"
 #include "BinaryData.h"
 
+class AuthAddressVerificationCache;
+
 class AuthAddressViewModel : public QAbstractItemModel
 {
    Q_OBJECT
 public:
-   AuthAddressViewModel(const std::shared_ptr<AuthAddressManager>& authManager, QObject *parent = nullptr);
+   // Cached state is shown for addresses which are still being verified
+   // by AuthAddressManager, which in turn updates the cache
+   AuthAddressViewModel(const std::shared_ptr<AuthAddressManager>& authManager
+      , const std::shared_ptr<AuthAddressVerificationCache> &verificationCache = nullptr
+      , QObject *parent = nullptr);
    ~AuthAddressViewModel() noexcept override;
 
    AuthAddressViewModel(const AuthAddressViewModel&) = delete;
@@ -51,10 +57,12 @@ private slots :
    void onAddressListUpdated();
 
 signals:
-   void updateSelectionAfterReset(int row);
+   // Emitted after rows were synchronized with AuthAddressManager
+   void addressesUpdated();
 
 private:
    std::shared_ptr<AuthAddressManager> authManager_;
+   std::shared_ptr<AuthAddressVerificationCache> verificationCache_;
 
 private:
    enum AuthAddressViewColumns : int
@@ -63,8 +71,14 @@ private:
       ColumnState,
       ColumnsCount
    };
+   struct AddressRow
+   {
+      bs::Address address;
+      AddressVerificationState state;
+   };
+
    bs::Address  defaultAddr_;
-   std::vector<bs::Address> addresses_;
+   std::vector<AddressRow> addresses_;
 };
 
 class AuthAdressControlProxyModel : public QSortFilterProxyModel {
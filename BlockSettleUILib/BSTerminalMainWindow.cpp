@@ -26,6 +26,7 @@
 #include "AssetManager.h"
 #include "AuthAddressDialog.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "AutheIDClient.h"
 #include "BSMarketDataProvider.h"
 #include "BSMessageBox.h"
@@ -48,6 +49,7 @@
 #include "InfoDialogs/MDAgreementDialog.h"
 #include "InfoDialogs/StartupDialog.h"
 #include "InfoDialogs/SupportDialog.h"
+#include "LazyTabInitializer.h"
 #include "LoginWindow.h"
 #include "MDCallbacksQt.h"
 #include "MarketDataProvider.h"
@@ -62,9 +64,11 @@
 #include "SelectWalletDialog.h"
 #include "Settings/ConfigDialog.h"
 #include "SignersProvider.h"
+#include "StartupPipeline.h"
 #include "StatusBarView.h"
 #include "SystemFileUtils.h"
 #include "TabWithShortcut.h"
+#include "Tracer.h"
 #include "TransactionsViewModel.h"
 #include "TransactionsWidget.h"
 #include "UiUtils.h"
@@ -108,6 +112,7 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
    logMgr_->add(applicationSettings_->GetLogsConfig());
 
    logMgr_->logger()->debug("Settings loaded from {}", applicationSettings_->GetSettingsPath().toStdString());
+   bs::trace::initFromEnv(logMgr_->logger());
 
    bs::UtxoReservation::init(logMgr_->logger());
 
@@ -151,13 +156,10 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
 
    ui_->widgetTransactions->setEnabled(false);
 
-   connectSigner();
-   connectArmory();
-   connectCcClient();
-
-   InitChartsView();
+   initStartupPipeline();
 
    ui_->tabWidget->setCurrentIndex(settings->get<int>(ApplicationSettings::GUI_main_tab));
+   initLazyTabs();
 
    ui_->widgetTransactions->setAppSettings(applicationSettings_);
 
@@ -302,10 +304,16 @@ BSTerminalMainWindow::~BSTerminalMainWindow()
    applicationSettings_->SaveSettings();
 
    NotificationCenter::destroyInstance();
+   if (logMgr_) {
+      bs::trace::dump(logMgr_->logger());
+   }
    if (signContainer_) {
       signContainer_->Stop();
       signContainer_.reset();
    }
+   if (transactionsModel_) {
+      transactionsModel_->saveSnapshot(transactionsSnapshotPath());
+   }
    walletsMgr_.reset();
    assetManager_.reset();
 }
@@ -432,7 +440,10 @@ void BSTerminalMainWindow::LoadWallets()
    });
    connect(walletsMgr_.get(), &bs::sync::WalletsManager::walletsSynchronized, this, [this] {
       walletsSynched_ = true;
+      bs::trace::asyncEnd("wallets", "syncWallets", 0);
       updateControlEnabledState();
+      startupPipeline_->stageCompleted("wallets");
+      loadTransactionsSnapshot();
       CompleteDBConnection();
       act_->onRefresh({}, true);
       tryGetChatKeys();
@@ -475,9 +486,21 @@ void BSTerminalMainWindow::InitAuthManager()
    authManager_ = std::make_shared<AuthAddressManager>(logMgr_->logger(), armory_);
    authManager_->init(applicationSettings_, walletsMgr_, signContainer_);
 
-   connect(authManager_.get(), &AuthAddressManager::AddrVerifiedOrRevoked, this, [](const QString &addr, const QString &state) {
+   if (!authAddrCache_) {
+      const bool testnet = applicationSettings_->get<NetworkType>(ApplicationSettings::netType) == NetworkType::TestNet;
+      authAddrCache_ = std::make_shared<AuthAddressVerificationCache>(logMgr_->logger(), armory_
+         , applicationSettings_->GetHomeDir() + (testnet ? QLatin1String("/authaddr_cache_testnet.dat")
+            : QLatin1String("/authaddr_cache.dat")));
+      authAddrCache_->load();
+   }
+
+   connect(authManager_.get(), &AuthAddressManager::AddrVerifiedOrRevoked, this, [this](const QString &addr, const QString &state) {
       NotificationCenter::notify(bs::ui::NotifyType::AuthAddress, { addr, state });
+      authAddrCache_->update(authManager_);
    });
+   connect(authManager_.get(), &AuthAddressManager::AddrStateChanged, this, [this] {
+      authAddrCache_->update(authManager_);
+   }, Qt::QueuedConnection);
    connect(authManager_.get(), &AuthAddressManager::AddrStateChanged, this, &BSTerminalMainWindow::onAddrStateChanged, Qt::QueuedConnection);
    connect(authManager_.get(), &AuthAddressManager::AuthWalletCreated, this, [this](const QString &walletId) {
       if (authAddrDlg_ && walletId.isEmpty()) {
@@ -626,6 +649,7 @@ bool BSTerminalMainWindow::InitSigningContainer()
 void BSTerminalMainWindow::SignerReady()
 {
    updateControlEnabledState();
+   startupPipeline_->stageCompleted("signer");
 
    LoadWallets();
 
@@ -855,10 +879,51 @@ void BSTerminalMainWindow::InitChartsView()
       , connectionManager_, logMgr_->logger("ui"));
 }
 
+void BSTerminalMainWindow::InitExplorerView()
+{
+   ui_->widgetExplorer->init(armory_, logMgr_->logger(), walletsMgr_, ccFileManager_, authManager_);
+}
+
+void BSTerminalMainWindow::initStartupPipeline()
+{
+   startupPipeline_ = std::make_unique<StartupPipeline>(logMgr_->logger());
+
+   // Armory, signer and CC tracker connections are independent and run concurrently.
+   // Wallets are synced from signer as soon as it's ready, without waiting for Armory;
+   // only wallets registration needs both.
+   startupPipeline_->addStage("armory", {}, [this] {
+      connectArmory();
+   });
+   startupPipeline_->addStage("signer", {}, [this] {
+      connectSigner();
+      if (!signContainer_) {
+         startupPipeline_->stageCompleted("signer");
+      }
+   });
+   startupPipeline_->addStage("cc_tracker", {}, [this] {
+      connectCcClient();
+      startupPipeline_->stageCompleted("cc_tracker");
+   });
+   // started from SignerReady()
+   startupPipeline_->addStage("wallets", { "signer" });
+   startupPipeline_->addStage("registration", { "wallets", "armory" }, [this] {
+      CompleteDBConnection();
+   });
+   startupPipeline_->start();
+}
+
+void BSTerminalMainWindow::initLazyTabs()
+{
+   // Chart and explorer subscribe to MD/Armory on init, which is not needed
+   // until the user opens them
+   lazyTabs_ = new LazyTabInitializer(ui_->tabWidget, this);
+   lazyTabs_->add(ui_->widgetChart, [this] { InitChartsView(); });
+   lazyTabs_->add(ui_->widgetExplorer, [this] { InitExplorerView(); });
+}
+
 // Initialize widgets related to transactions.
 void BSTerminalMainWindow::InitTransactionsView()
 {
-   ui_->widgetExplorer->init(armory_, logMgr_->logger(), walletsMgr_, ccFileManager_, authManager_);
    ui_->widgetTransactions->init(walletsMgr_, armory_, utxoReservationMgr_, signContainer_,
                                 logMgr_->logger("ui"));
    ui_->widgetTransactions->setEnabled(true);
@@ -869,10 +934,12 @@ void BSTerminalMainWindow::InitTransactionsView()
 
 void BSTerminalMainWindow::MainWinACT::onStateChanged(ArmoryState state)
 {
+   BS_TRACE_SPAN("armory", "MainWinACT::onStateChanged", "state", static_cast<int64_t>(state));
    switch (state) {
    case ArmoryState::Ready:
       QMetaObject::invokeMethod(parent_, [this] {
          parent_->isArmoryReady_ = true;
+         parent_->startupPipeline_->stageCompleted("armory");
          parent_->CompleteDBConnection();
          parent_->CompleteUIOnlineView();
          parent_->walletsMgr_->goOnline();
@@ -902,16 +969,37 @@ void BSTerminalMainWindow::MainWinACT::onStateChanged(ArmoryState state)
 
 void BSTerminalMainWindow::CompleteUIOnlineView()
 {
+   // Model created from snapshot is reconciled on Armory's Ready state by itself
    if (!transactionsModel_) {
-      transactionsModel_ = std::make_shared<TransactionsViewModel>(armory_
-         , walletsMgr_, logMgr_->logger("ui"), this);
-
-      InitTransactionsView();
+      createTransactionsModel();
       transactionsModel_->loadAllWallets();
    }
    updateControlEnabledState();
 }
 
+void BSTerminalMainWindow::createTransactionsModel()
+{
+   transactionsModel_ = std::make_shared<TransactionsViewModel>(armory_
+      , walletsMgr_, logMgr_->logger("ui"), this);
+   InitTransactionsView();
+}
+
+void BSTerminalMainWindow::loadTransactionsSnapshot()
+{
+   if (transactionsModel_ || isArmoryReady_) {
+      return;
+   }
+   createTransactionsModel();
+   transactionsModel_->loadSnapshot(transactionsSnapshotPath());
+}
+
+QString BSTerminalMainWindow::transactionsSnapshotPath() const
+{
+   const bool testnet = applicationSettings_->get<NetworkType>(ApplicationSettings::netType) == NetworkType::TestNet;
+   return applicationSettings_->GetHomeDir() + (testnet ? QLatin1String("/transactions_testnet.snapshot")
+      : QLatin1String("/transactions.snapshot"));
+}
+
 void BSTerminalMainWindow::CompleteDBConnection()
 {
    if (!wasWalletsRegistered_ && walletsSynched_ && isArmoryReady_) {
@@ -919,6 +1007,7 @@ void BSTerminalMainWindow::CompleteDBConnection()
       // Otherwise BDMAction_Refresh might come before BDMAction_Ready causing a lot of problems.
       walletsMgr_->registerWallets();
       wasWalletsRegistered_ = true;
+      startupPipeline_->stageCompleted("registration");
    }
 }
 
@@ -1038,6 +1127,7 @@ void BSTerminalMainWindow::MainWinACT::onTxBroadcastError(const BinaryData &txHa
 
 void BSTerminalMainWindow::MainWinACT::onNodeStatus(NodeStatus nodeStatus, bool isSegWitEnabled, RpcStatus rpcStatus)
 {
+   BS_TRACE_SPAN("armory", "MainWinACT::onNodeStatus");
    QMetaObject::invokeMethod(parent_, [parent = parent_, nodeStatus, isSegWitEnabled, rpcStatus] {
       parent->onNodeStatus(nodeStatus, isSegWitEnabled, rpcStatus);
    });
@@ -1045,6 +1135,7 @@ void BSTerminalMainWindow::MainWinACT::onNodeStatus(NodeStatus nodeStatus, bool
 
 void BSTerminalMainWindow::MainWinACT::onZCReceived(const std::vector<bs::TXEntry> &zcs)
 {
+   BS_TRACE_SPAN("armory", "MainWinACT::onZCReceived", "entries", static_cast<int64_t>(zcs.size()));
    QMetaObject::invokeMethod(parent_, [this, zcs] { parent_->onZCreceived(zcs); });
 }
 
@@ -1533,7 +1624,13 @@ void BSTerminalMainWindow::onLogout()
    if (chatClientServicePtr_) {
       chatClientServicePtr_->LogoutFromServer();
    }
-   ui_->widgetChart->disconnect();
+   if (lazyTabs_->isInitialized(ui_->widgetChart)) {
+      ui_->widgetChart->disconnect();
+   }
+   else {
+      mdProvider_->UnsubscribeFromMD();
+      mdProvider_->DisconnectFromMDSource();
+   }
 
    if (celerConnection_->IsConnected()) {
       celerConnection_->CloseConnection();
@@ -1879,6 +1976,13 @@ void BSTerminalMainWindow::setupShortcuts()
    addShotcut("Alt+S", TabWithShortcut::ShortcutType::Alt_S);
    addShotcut("Alt+B", TabWithShortcut::ShortcutType::Alt_B);
    addShotcut("Alt+P", TabWithShortcut::ShortcutType::Alt_P);
+
+   // Writes collected trace spans on demand (only when started with BS_TRACE_FILE set)
+   auto traceDumpShortcut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+F12")), this);
+   traceDumpShortcut->setContext(Qt::ApplicationShortcut);
+   connect(traceDumpShortcut, &QShortcut::activated, [this] {
+      bs::trace::dump(logMgr_->logger());
+   });
 }
 
 void BSTerminalMainWindow::onButtonUserClicked() {
@@ -1990,6 +2094,7 @@ void BSTerminalMainWindow::onSyncWallets()
    };
 
    walletsMgr_->reset();
+   bs::trace::asyncBegin("wallets", "syncWallets", 0);
    walletsMgr_->syncWallets(progressDelegate);
    updateControlEnabledState();
 }
@@ -2002,11 +2107,15 @@ void BSTerminalMainWindow::onSignerVisibleChanged()
 void BSTerminalMainWindow::InitWidgets()
 {
    authAddrDlg_ = std::make_shared<AuthAddressDialog>(logMgr_->logger(), authManager_
-      , assetManager_, applicationSettings_, this);
+      , assetManager_, applicationSettings_, authAddrCache_, this);
 
    InitWalletsView();
    InitPortfolioView();
 
+   ui_->widgetRFQ->setAuthAddressCache(authAddrCache_);
+   ui_->widgetRFQReply->setAuthAddressCache(authAddrCache_);
+   ui_->widgetChat->setAuthAddressCache(authAddrCache_);
+
    ui_->widgetRFQ->initWidgets(mdProvider_, mdCallbacks_, applicationSettings_);
 
    auto quoteProvider = std::make_shared<QuoteProvider>(assetManager_, logMgr_->logger("message"));
@@ -49,6 +49,7 @@ class ArmoryServersProvider;
 class AssetManager;
 class AuthAddressDialog;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class AutheIDClient;
 class AutoSignQuoteProvider;
 class BSMarketDataProvider;
@@ -58,6 +59,7 @@ class CCFileManager;
 class CCPortfolioModel;
 class CcTrackerClient;
 class ConnectionManager;
+class LazyTabInitializer;
 class LoginWindow;
 class MDCallbacksQt;
 class NetworkSettingsLoader;
@@ -65,6 +67,7 @@ class OrderListModel;
 class QSystemTrayIcon;
 class RequestReplyCommand;
 class SignersProvider;
+class StartupPipeline;
 class StatusBarView;
 class StatusViewBlockListener;
 class TransactionsViewModel;
@@ -115,6 +118,13 @@ private:
    void InitPortfolioView();
    void InitWalletsView();
    void InitChartsView();
+   void InitExplorerView();
+   void createTransactionsModel();
+   void loadTransactionsSnapshot();
+   QString transactionsSnapshotPath() const;
+
+   void initStartupPipeline();
+   void initLazyTabs();
 
    void tryInitChatView();
    void tryLoginIntoChat();
@@ -172,6 +182,7 @@ private:
    std::shared_ptr<ArmoryServersProvider> armoryServersProvider_;
    std::shared_ptr<SignersProvider>       signersProvider_;
    std::shared_ptr<AuthAddressManager>    authManager_;
+   std::shared_ptr<AuthAddressVerificationCache>   authAddrCache_;
    std::shared_ptr<ArmoryObject>          armory_;
    std::shared_ptr<CcTrackerClient>       trackerClient_;
 
@@ -300,6 +311,10 @@ private:
    bool walletsSynched_ = false;
    bool isArmoryReady_ = false;
 
+   // Tracks initial startup stages only, reconnects are handled by the usual handlers
+   std::unique_ptr<StartupPipeline> startupPipeline_;
+   LazyTabInitializer   *lazyTabs_{};
+
    std::unique_ptr<NetworkSettingsLoader> networkSettingsLoader_;
 
    SignContainer::ConnectionError lastSignerError_{};
@@ -132,6 +132,11 @@ void ChartWidget::init(const std::shared_ptr<ApplicationSettings>& appSettings
    connect(mdCallbacks.get(), &MDCallbacksQt::Disconnecting, this, &ChartWidget::OnMDDisconnecting);
    connect(mdCallbacks.get(), &MDCallbacksQt::Disconnected, this, &ChartWidget::OnMDDisconnected);
 
+   // widget is initialized on first show and may miss Connected signal
+   if (mdProvider_->IsConnectionActive()) {
+      OnMDConnected();
+   }
+
    // initialize charts
    InitializeCustomPlot();
 
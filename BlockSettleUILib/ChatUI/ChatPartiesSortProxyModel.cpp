@@ -77,10 +77,10 @@ bool ChatPartiesSortProxyModel::filterAcceptsRow(int row, const QModelIndex& par
       return false;
    }
 
-   switch (item->modelType()) {
-   case UI::ElementType::Party:
+   switch (item->filterCategory()) {
+   case PartyTreeItem::FilterCategory::Visible:
       return true;
-   case UI::ElementType::Container:
+   case PartyTreeItem::FilterCategory::VisibleIfNotEmpty:
       return item->childCount() > 0;
    default:
       return false;
@@ -102,9 +102,7 @@ bool ChatPartiesSortProxyModel::lessThan(const QModelIndex &left, const QModelIn
 
    if (itemLeft->modelType() == itemRight->modelType()) {
       if (itemLeft->modelType() == UI::ElementType::Party) {
-         Chat::ClientPartyPtr leftParty = itemLeft->data().value<Chat::ClientPartyPtr>();
-         Chat::ClientPartyPtr rightParty = itemRight->data().value<Chat::ClientPartyPtr>();
-         return leftParty->displayName() < rightParty->displayName();
+         return itemLeft->sortKey() < itemRight->sortKey();
       }
       else if (itemLeft->modelType() == UI::ElementType::Container) {
          return itemLeft->childNumber() < itemRight->childNumber();
@@ -18,9 +18,9 @@ namespace {
    const auto kTogglingIntervalMs = std::chrono::milliseconds(250);
 }
 
-ChatPartiesTreeModel::ChatPartiesTreeModel(const Chat::ChatClientServicePtr& chatClientServicePtr, OtcClient *otcClient, QObject* parent)
+ChatPartiesTreeModel::ChatPartiesTreeModel(const Chat::ClientPartyModelPtr& clientPartyModelPtr, OtcClient *otcClient, QObject* parent)
    : QAbstractItemModel(parent)
-   , chatClientServicePtr_(chatClientServicePtr)
+   , clientPartyModelPtr_(clientPartyModelPtr)
    , otcClient_(otcClient)
 {
    rootItem_ = new PartyTreeItem({}, UI::ElementType::Root);
@@ -35,72 +35,95 @@ ChatPartiesTreeModel::~ChatPartiesTreeModel() = default;
 
 void ChatPartiesTreeModel::onPartyModelChanged()
 {
-   Chat::ClientPartyModelPtr clientPartyModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
-   
-   // Save unseen state first
-   const auto reusableItemData = collectReusableData(rootItem_);
-
-   beginResetModel();
-
-   rootItem_->removeAll();
-   otcWatchIndx_.clear();
+   if (!globalSection_) {
+      beginResetModel();
+      createSections();
+      endResetModel();
+   }
 
-   std::unique_ptr<PartyTreeItem> globalSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabGlobal, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> otcGlobalSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabOTCIdentifier, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> privateSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabPrivate, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> requestSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabContactRequest, UI::ElementType::Container, rootItem_);
+   const auto idPartyList = clientPartyModelPtr_->getIdPartyList();
+   const auto clientPartyPtrList = clientPartyModelPtr_->getClientPartyListFromIdPartyList(idPartyList);
 
-   auto insertChild = [](PartyTreeItem* section, QVariant stored) -> PartyTreeItem* {
-      std::unique_ptr<PartyTreeItem> partyTreeItem = std::make_unique<PartyTreeItem>(stored, UI::ElementType::Party, section);
-      PartyTreeItem* pTreeItem = partyTreeItem.get();
-      section->insertChildren(std::move(partyTreeItem));
-      return pTreeItem;
+   struct NewItem
+   {
+      Chat::ClientPartyPtr clientPartyPtr;
+      ReusableItemData reusableData;
+      bool hasReusableData;
    };
-
-   const auto idPartyList = clientPartyModelPtr->getIdPartyList();
-   const auto clientPartyPtrList = clientPartyModelPtr->getClientPartyListFromIdPartyList(idPartyList);
+   std::map<PartyTreeItem*, std::vector<NewItem>> itemsToInsert;
+   std::map<PartyTreeItem*, std::unordered_set<const PartyTreeItem*>> itemsToRemove;
+   std::vector<PartyTreeItem*> changedItems;
+   std::unordered_set<std::string> partyIds;
 
    for (const auto& clientPartyPtr : clientPartyPtrList) {
       assert(clientPartyPtr);
 
-      QVariant stored;
-      stored.setValue(clientPartyPtr);
-
-      if (clientPartyPtr->isGlobalOTC()) {
-         insertChild(otcGlobalSection.get(), stored);
+      PartyTreeItem* section = sectionForParty(clientPartyPtr);
+      if (!section) {
+         continue;
       }
-      else if (clientPartyPtr->isGlobal()) {
-         insertChild(globalSection.get(), stored);
+      partyIds.insert(clientPartyPtr->id());
+
+      auto it = partyItems_.find(clientPartyPtr->id());
+      if (it == partyItems_.end()) {
+         itemsToInsert[section].push_back({ clientPartyPtr, {}, false });
+         continue;
       }
-      else if (clientPartyPtr->isPrivateStandard()) {
-         if (clientPartyPtr->partyState() == Chat::PartyState::REJECTED) {
-            continue;
+
+      PartyTreeItem* item = it->second;
+      if (item->parent() == section) {
+         if (item->data().value<Chat::ClientPartyPtr>() != clientPartyPtr) {
+            QVariant stored;
+            stored.setValue(clientPartyPtr);
+            item->setData(stored);
+            changedItems.push_back(item);
+         }
+         else if (item->refreshSortKey()) {
+            changedItems.push_back(item);
          }
+         continue;
+      }
 
-         PartyTreeItem* parentSection = clientPartyPtr->partyState() == Chat::PartyState::INITIALIZED ? privateSection.get() : requestSection.get();
-         PartyTreeItem* newChild = insertChild(parentSection, stored);
+      // Party moved to other section (contact request accepted for example)
+      itemsToRemove[item->parent()].insert(item);
+      itemsToInsert[section].push_back({ clientPartyPtr, item->generateReusableData(), true });
+   }
 
-         assert(newChild);
-         auto it = reusableItemData.find(clientPartyPtr->id());
-         if (it != reusableItemData.end()) {
-            newChild->applyReusableData(it.value());
-         }
+   for (const auto& item : partyItems_) {
+      if (partyIds.find(item.first) == partyIds.end()) {
+         itemsToRemove[item.second->parent()].insert(item.second);
       }
    }
 
-   rootItem_->insertChildren(std::move(globalSection));
-   rootItem_->insertChildren(std::move(otcGlobalSection));
-   rootItem_->insertChildren(std::move(privateSection));
-   rootItem_->insertChildren(std::move(requestSection));
+   for (const auto& section : itemsToRemove) {
+      removeItems(section.first, section.second);
+   }
 
-   endResetModel();
-   emit restoreSelectedIndex();
+   for (auto& section : itemsToInsert) {
+      PartyTreeItem* sectionItem = section.first;
+      const int first = sectionItem->childCount();
+      beginInsertRows(itemIndex(sectionItem), first, first + int(section.second.size()) - 1);
+      for (const auto& newItem : section.second) {
+         QVariant stored;
+         stored.setValue(newItem.clientPartyPtr);
+         auto partyTreeItem = std::make_unique<PartyTreeItem>(stored, UI::ElementType::Party, sectionItem);
+         if (newItem.hasReusableData) {
+            partyTreeItem->applyReusableData(newItem.reusableData);
+         }
+         partyItems_[newItem.clientPartyPtr->id()] = partyTreeItem.get();
+         sectionItem->insertChildren(std::move(partyTreeItem));
+      }
+      endInsertRows();
+   }
 
-   if (!reusableItemData.isEmpty()) {
-      resetOTCUnseen({});
+   for (PartyTreeItem* item : changedItems) {
+      const QModelIndex partyIndex = itemIndex(item);
+      emit dataChanged(partyIndex, partyIndex);
    }
 
-   onGlobalOTCChanged(reusableItemData);
+   emit restoreSelectedIndex();
+
+   onGlobalOTCChanged();
 }
 
 void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData> reusableItemData /* = {} */)
@@ -118,13 +141,13 @@ void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData
    resetOTCUnseen(otcGlobalModelIndex, false, false);
    if (otcParty->childCount() > 0) {
       beginRemoveRows(otcGlobalModelIndex, 0, otcParty->childCount() - 1);
+      unindexChildren(otcParty);
       otcParty->removeAll();
       endRemoveRows();
    }
 
    auto fAddOtcParty = [this, &reusableItemData](const bs::network::otc::Peer* peer, std::unique_ptr<PartyTreeItem>& section, otc::PeerType peerType) {
-      Chat::ClientPartyModelPtr clientPartyModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
-      Chat::ClientPartyPtr otcPartyPtr = clientPartyModelPtr->getOtcPartyForUsers(currentUser(), peer->contactId);
+      Chat::ClientPartyPtr otcPartyPtr = clientPartyModelPtr_->getOtcPartyForUsers(currentUser(), peer->contactId);
       if (!otcPartyPtr) {
          return;
       }
@@ -139,6 +162,7 @@ void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData
          otcItem->applyReusableData(it.value());
       }
 
+      otcItems_.emplace(otcPartyPtr->id(), otcItem.get());
       section->insertChildren(std::move(otcItem));
    };
 
@@ -171,6 +195,13 @@ void ChatPartiesTreeModel::onCleanModel()
 {
    beginResetModel();
    rootItem_->removeAll();
+   globalSection_ = nullptr;
+   otcGlobalSection_ = nullptr;
+   privateSection_ = nullptr;
+   requestSection_ = nullptr;
+   partyItems_.clear();
+   otcItems_.clear();
+   otcWatchIndx_.clear();
    endResetModel();
 }
 
@@ -183,6 +214,17 @@ void ChatPartiesTreeModel::onPartyStatusChanged(const Chat::ClientPartyPtr& clie
    }
 }
 
+void ChatPartiesTreeModel::onPartyDisplayNameChanged(const std::string& partyId)
+{
+   PartyTreeItem* item = findItem(partyId);
+   if (!item || !item->refreshSortKey()) {
+      return;
+   }
+
+   const QModelIndex partyIndex = itemIndex(item);
+   emit dataChanged(partyIndex, partyIndex);
+}
+
 void ChatPartiesTreeModel::onIncreaseUnseenCounter(const std::string& partyId, int newMessageCount, bool isUnseenOTCMessage /* = false */)
 {
    const QModelIndex partyIndex = getPartyIndexById(partyId);
@@ -234,68 +276,156 @@ void ChatPartiesTreeModel::onUpdateOTCAwaitingColor()
 
 const QModelIndex ChatPartiesTreeModel::getPartyIndexById(const std::string& partyId, const QModelIndex parent) const
 {
-   PartyTreeItem* parentItem = nullptr;
+   PartyTreeItem* item = findItem(partyId);
+   if (!item) {
+      return {};
+   }
+
    if (parent.isValid()) {
-      parentItem = static_cast<PartyTreeItem*>(parent.internalPointer());
-   } 
-   else {
-      parentItem = rootItem_;
+      const PartyTreeItem* parentItem = static_cast<PartyTreeItem*>(parent.internalPointer());
+      PartyTreeItem* ancestor = item->parent();
+      while (ancestor && ancestor != parentItem) {
+         ancestor = ancestor->parent();
+      }
+      if (!ancestor) {
+         return {};
+      }
    }
-   Q_ASSERT(parentItem);
 
-   QList<QPair<QModelIndex, PartyTreeItem*>> itemsToCheck;
-   itemsToCheck.push_back({ parent , parentItem });
+   return itemIndex(item);
+}
 
-   QPair<QModelIndex, PartyTreeItem*> currentPair;
-   while (!itemsToCheck.isEmpty()) {
-      currentPair = itemsToCheck[0];
-      itemsToCheck.pop_front();
+PartyTreeItem* ChatPartiesTreeModel::getItem(const QModelIndex& index) const
+{
+   if (index.isValid()) {
+      PartyTreeItem* item = static_cast<PartyTreeItem*>(index.internalPointer());
+      if (item) {
+         return item;
+      }
+   }
 
-      QModelIndex iterModelIndex = currentPair.first;
-      PartyTreeItem* iterItem= currentPair.second;
+   return rootItem_;
+}
 
+QModelIndex ChatPartiesTreeModel::itemIndex(PartyTreeItem* item) const
+{
+   if (!item || item == rootItem_) {
+      return {};
+   }
+   return createIndex(item->childNumber(), 0, item);
+}
 
-      for (int iChild = 0; iChild < iterItem->childCount(); ++iChild) {
-         auto* child = iterItem->child(iChild);
+PartyTreeItem* ChatPartiesTreeModel::findItem(const std::string& partyId) const
+{
+   auto it = partyItems_.find(partyId);
+   if (it != partyItems_.end()) {
+      return it->second;
+   }
 
-         auto childIndex = index(iChild, 0, iterModelIndex);
-         if (child->modelType() == UI::ElementType::Container && child->data().canConvert<QString>()) {
-            if (child->data().toString().toStdString() == partyId) {
-               return childIndex;
-            }
-         }
-         else if (child->modelType() == UI::ElementType::Party && child->data().canConvert<Chat::ClientPartyPtr>()) {
-            const Chat::ClientPartyPtr clientPtr = child->data().value<Chat::ClientPartyPtr>();
-            
-            if (!clientPtr) {
-               return {};
-            }
+   it = otcItems_.find(partyId);
+   if (it != otcItems_.end()) {
+      return it->second;
+   }
 
-            if (clientPtr->id() == partyId) {
-               return childIndex;
-            }
+   // Containers: sections and OTC sub-sections (there are only few of them)
+   const auto fFindContainer = [&partyId](PartyTreeItem* parent) -> PartyTreeItem* {
+      for (int iChild = 0; iChild < parent->childCount(); ++iChild) {
+         auto* child = parent->child(iChild);
+         if (child->modelType() == UI::ElementType::Container && child->data().toString().toStdString() == partyId) {
+            return child;
          }
+      }
+      return nullptr;
+   };
 
-         if (child->childCount() != 0) {
-            itemsToCheck.push_back({ childIndex , child });
-         }
+   PartyTreeItem* container = fFindContainer(rootItem_);
+   if (!container && otcGlobalSection_) {
+      for (int iChild = 0; iChild < otcGlobalSection_->childCount() && !container; ++iChild) {
+         container = fFindContainer(otcGlobalSection_->child(iChild));
       }
+   }
+   return container;
+}
 
+PartyTreeItem* ChatPartiesTreeModel::sectionForParty(const Chat::ClientPartyPtr& clientPartyPtr) const
+{
+   if (clientPartyPtr->isGlobalOTC()) {
+      return otcGlobalSection_;
+   }
+   if (clientPartyPtr->isGlobal()) {
+      return globalSection_;
+   }
+   if (clientPartyPtr->isPrivateStandard()) {
+      switch (clientPartyPtr->partyState()) {
+         case Chat::PartyState::REJECTED:
+            return nullptr;
+         case Chat::PartyState::INITIALIZED:
+            return privateSection_;
+         default:
+            return requestSection_;
+      }
    }
+   return nullptr;
+}
 
-   return {};
+void ChatPartiesTreeModel::createSections()
+{
+   auto fAddSection = [this](const QString& name) -> PartyTreeItem* {
+      auto section = std::make_unique<PartyTreeItem>(name, UI::ElementType::Container, rootItem_);
+      PartyTreeItem* sectionPtr = section.get();
+      rootItem_->insertChildren(std::move(section));
+      return sectionPtr;
+   };
+
+   globalSection_ = fAddSection(ChatModelNames::ContainerTabGlobal);
+   otcGlobalSection_ = fAddSection(ChatModelNames::ContainerTabOTCIdentifier);
+   privateSection_ = fAddSection(ChatModelNames::ContainerTabPrivate);
+   requestSection_ = fAddSection(ChatModelNames::ContainerTabContactRequest);
 }
 
-PartyTreeItem* ChatPartiesTreeModel::getItem(const QModelIndex& index) const
+void ChatPartiesTreeModel::removeItems(PartyTreeItem* section, const std::unordered_set<const PartyTreeItem*>& items)
 {
-   if (index.isValid()) {
-      PartyTreeItem* item = static_cast<PartyTreeItem*>(index.internalPointer());
-      if (item) {
-         return item;
+   // Remove contiguous ranges starting from the end so rows of remaining ranges stay valid
+   const QModelIndex sectionIndex = itemIndex(section);
+   int row = section->childCount() - 1;
+   while (row >= 0) {
+      if (items.find(section->child(row)) == items.end()) {
+         --row;
+         continue;
       }
+      const int last = row;
+      while (row > 0 && items.find(section->child(row - 1)) != items.end()) {
+         --row;
+      }
+
+      beginRemoveRows(sectionIndex, row, last);
+      for (int i = row; i <= last; ++i) {
+         PartyTreeItem* item = section->child(i);
+         unindexChildren(item);
+         const auto clientPartyPtr = item->data().value<Chat::ClientPartyPtr>();
+         auto it = partyItems_.find(clientPartyPtr->id());
+         if (it != partyItems_.end() && it->second == item) {
+            partyItems_.erase(it);
+         }
+      }
+      section->removeChildren(row, last - row + 1);
+      endRemoveRows();
+      --row;
    }
+}
 
-   return rootItem_;
+void ChatPartiesTreeModel::unindexChildren(PartyTreeItem* parent)
+{
+   forAllPartiesInModel(parent, [this, parent](const PartyTreeItem* item) {
+      if (item == parent || item->modelType() != UI::ElementType::Party) {
+         return;
+      }
+      const auto clientPartyPtr = item->data().value<Chat::ClientPartyPtr>();
+      auto it = otcItems_.find(clientPartyPtr->id());
+      if (it != otcItems_.end() && it->second == item) {
+         otcItems_.erase(it);
+      }
+   });
 }
 
 void ChatPartiesTreeModel::forAllPartiesInModel(PartyTreeItem* parent,
@@ -505,6 +635,5 @@ int ChatPartiesTreeModel::columnCount(const QModelIndex& parent) const
 
 const std::string& ChatPartiesTreeModel::currentUser() const
 {
-   const auto chatModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
-   return chatModelPtr->ownUserName();
+   return clientPartyModelPtr_->ownUserName();
 }
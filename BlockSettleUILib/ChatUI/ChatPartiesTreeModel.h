@@ -12,7 +12,10 @@
 #define CHATPARTYLISTMODEL_H
 
 #include <QAbstractItemModel>
-#include "ChatProtocol/ChatClientService.h"
+#include <QTimer>
+#include <unordered_map>
+#include <unordered_set>
+#include "ChatProtocol/ClientPartyModel.h"
 #include "PartyTreeItem.h"
 
 class OtcClient;
@@ -20,7 +23,7 @@ class ChatPartiesTreeModel : public QAbstractItemModel
 {
    Q_OBJECT
 public:
-   ChatPartiesTreeModel(const Chat::ChatClientServicePtr& chatClientServicePtr, OtcClient *otcClient
+   ChatPartiesTreeModel(const Chat::ClientPartyModelPtr& clientPartyModelPtr, OtcClient *otcClient
       , QObject* parent = nullptr);
    ~ChatPartiesTreeModel() override;
 
@@ -38,10 +41,14 @@ signals:
    void restoreSelectedIndex();
 
 public slots:
+   // Applies difference with the party model as row inserts/removes and dataChanged,
+   // whole model is reset only when it's built for the first time
    void onPartyModelChanged();
    void onGlobalOTCChanged(QMap<std::string, ReusableItemData> reusableItemData = {});
    void onCleanModel();
    void onPartyStatusChanged(const Chat::ClientPartyPtr& clientPartyPtr);
+   // Party is re-sorted only if its display name has actually changed
+   void onPartyDisplayNameChanged(const std::string& partyId);
    void onIncreaseUnseenCounter(const std::string& partyId, int newMessageCount, bool isUnseenOTCMessage = false);
    void onDecreaseUnseenCounter(const std::string& partyId, int seenMessageCount);
 
@@ -50,14 +57,29 @@ private slots:
 
 private:
    PartyTreeItem* getItem(const QModelIndex& index) const;
+   QModelIndex itemIndex(PartyTreeItem* item) const;
+   PartyTreeItem* findItem(const std::string& partyId) const;
+   PartyTreeItem* sectionForParty(const Chat::ClientPartyPtr& clientPartyPtr) const;
+   void createSections();
+   void removeItems(PartyTreeItem* section, const std::unordered_set<const PartyTreeItem*>& items);
+   void unindexChildren(PartyTreeItem* parent);
    void forAllPartiesInModel(PartyTreeItem* parent, std::function<void(const PartyTreeItem*)>&& applyFunc) const;
    void forAllIndexesInModel(const QModelIndex& parent, std::function<void(const QModelIndex&)>&& applyFunc) const;
    QMap<std::string, ReusableItemData> collectReusableData(PartyTreeItem* parent);
    void resetOTCUnseen(const QModelIndex& parentIndex, bool isAddChildren = true, bool isClearAll = true);
 
    PartyTreeItem* rootItem_{};
+   PartyTreeItem* globalSection_{};
+   PartyTreeItem* otcGlobalSection_{};
+   PartyTreeItem* privateSection_{};
+   PartyTreeItem* requestSection_{};
 
-   Chat::ChatClientServicePtr chatClientServicePtr_;
+   // Party ID -> item in one of the sections above
+   std::unordered_map<std::string, PartyTreeItem*> partyItems_;
+   // Party ID -> item under global OTC party
+   std::unordered_map<std::string, PartyTreeItem*> otcItems_;
+
+   Chat::ClientPartyModelPtr clientPartyModelPtr_;
    OtcClient* otcClient_{};
 
    QSet<QPersistentModelIndex> otcWatchIndx_;
@@ -179,6 +179,17 @@ void ChatUserListTreeView::onExpandGlobalOTC()
    expand(otcGlobalIndex.child(1, 0));
 }
 
+void ChatUserListTreeView::rowsInserted(const QModelIndex& parent, int start, int end)
+{
+   QTreeView::rowsInserted(parent, start, end);
+
+   // Party model is updated incrementally, expand container when it gets its first items
+   PartyTreeItem* item = internalPartyTreeItem(parent);
+   if (item && item->modelType() == UI::ElementType::Container && model()->rowCount(parent) == end - start + 1) {
+      expand(parent);
+   }
+}
+
 PartyTreeItem* ChatUserListTreeView::internalPartyTreeItem(const QModelIndex& index)
 {
    if (!index.isValid()) {
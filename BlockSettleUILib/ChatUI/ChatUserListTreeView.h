@@ -44,6 +44,7 @@ signals:
 
 protected slots:
    void currentChanged(const QModelIndex& current, const QModelIndex& previous) override;
+   void rowsInserted(const QModelIndex& parent, int start, int end) override;
 
 private slots:
    void onClicked(const QModelIndex &);
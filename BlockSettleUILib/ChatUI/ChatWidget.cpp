@@ -38,6 +38,7 @@
 #include "OTCRequestViewModel.h"
 #include "OTCShieldWidgets/OTCWindowsManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "MDCallbacksQt.h"
 #include "AssetManager.h"
 #include "ui_ChatWidget.h"
@@ -92,6 +93,12 @@ ChatWidget::~ChatWidget()
    stateCurrent_.reset();
 }
 
+void ChatWidget::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   otcWindowsManager_->setAuthAddressCache(cache);
+   ui_->widgetOTCShield->setAuthAddressCache(cache);
+}
+
 void ChatWidget::init(const std::shared_ptr<ConnectionManager>& connectionManager
    , bs::network::otc::Env env
    , const Chat::ChatClientServicePtr& chatClientServicePtr
@@ -123,7 +130,7 @@ void ChatWidget::init(const std::shared_ptr<ConnectionManager>& connectionManage
    connect(ui_->searchWidget, &SearchWidget::contactFriendRequest, this, &ChatWidget::onContactFriendRequest);
    connect(ui_->searchWidget, &SearchWidget::emailHashRequested, this, &ChatWidget::emailHashRequested);
 
-   chatPartiesTreeModel_ = std::make_shared<ChatPartiesTreeModel>(chatClientServicePtr_, otcHelper_->client());
+   chatPartiesTreeModel_ = std::make_shared<ChatPartiesTreeModel>(chatClientServicePtr_->getClientPartyModelPtr(), otcHelper_->client());
 
    ChatPartiesSortProxyModelPtr charTreeSortModel = std::make_shared<ChatPartiesSortProxyModel>(chatPartiesTreeModel_);
    ui_->treeViewUsers->setModel(charTreeSortModel.get());
@@ -188,7 +195,9 @@ void ChatWidget::init(const std::shared_ptr<ConnectionManager>& connectionManage
    connect(otcHelper_->client(), &OtcClient::sendPublicMessage, this, &ChatWidget::onSendOtcPublicMessage);
    connect(otcHelper_->client(), &OtcClient::peerUpdated, this, &ChatWidget::onOtcUpdated);
    connect(otcHelper_->client(), &OtcClient::publicUpdated, this, &ChatWidget::onOtcPublicUpdated);
-   connect(otcHelper_->client(), &OtcClient::publicUpdated, otcRequestViewModel_, &OTCRequestViewModel::onRequestsUpdated);
+   connect(otcHelper_->client(), &OtcClient::publicRequestAdded, otcRequestViewModel_, &OTCRequestViewModel::onRequestAdded);
+   connect(otcHelper_->client(), &OtcClient::publicRequestUpdated, otcRequestViewModel_, &OTCRequestViewModel::onRequestUpdated);
+   connect(otcHelper_->client(), &OtcClient::publicRequestRemoved, otcRequestViewModel_, &OTCRequestViewModel::onRequestRemoved);
    connect(otcHelper_->client(), &OtcClient::peerError, this, &ChatWidget::onOTCPeerError);
 
 
@@ -218,12 +227,13 @@ otc::Peer *ChatWidget::currentPeer() const
 
    if (clientPartyPtr->isGlobalOTC()) {
       const auto &currentIndex = ui_->treeViewOTCRequests->selectionModel()->currentIndex();
-      if (!currentIndex.isValid() || currentIndex.row() < 0 || currentIndex.row() >= int(otcHelper_->client()->requests().size())) {
+      const auto peer = otcRequestViewModel_->peer(currentIndex);
+      if (!peer) {
          // Show by default own request (if available)
          return otcHelper_->client()->ownRequest();
       }
 
-      return otcHelper_->client()->requests().at(size_t(currentIndex.row()));
+      return peer;
    }
 
    return otcHelper_->client()->peer(clientPartyPtr->userHash(), partyTreeItem->peerType);
@@ -297,9 +307,12 @@ void ChatWidget::onEmailHashReceived(const std::string &email, const std::string
 
 void ChatWidget::onPartyModelChanged()
 {
+   // Tree is updated incrementally, so keep expanding state unless it was just built
+   const bool isInitialBuild = (chatPartiesTreeModel_->rowCount() == 0);
    stateCurrent_->onResetPartyModel();
-   // #new_logic : save expanding state
-   ui_->treeViewUsers->expandAll();
+   if (isInitialBuild) {
+      ui_->treeViewUsers->expandAll();
+   }
 }
 
 void ChatWidget::onLogin()
@@ -678,8 +691,9 @@ void ChatWidget::onOtcRequestCurrentChanged(const QModelIndex &current, const QM
 
    QDateTime selectedPeerTimeStamp;
    if (currentPartyId_ == Chat::OtcRoomName) {
-      if (current.isValid() && current.row() >= 0 && current.row() < int(otcHelper_->client()->requests().size())) {
-         selectedPeerTimeStamp = otcHelper_->client()->requests().at(size_t(current.row()))->request.timestamp;
+      const auto peer = otcRequestViewModel_->peer(current);
+      if (peer) {
+         selectedPeerTimeStamp = peer->request.timestamp;
       }
    }
 
@@ -23,6 +23,7 @@
 class QItemSelection;
 
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class ArmoryConnection;
 class AssetManager;
 class ChatPartiesTreeModel;
@@ -75,6 +76,9 @@ public:
       , const std::shared_ptr<bs::UTXOReservationManager> &
    );
 
+   // Must be set before init
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
+
    bs::network::otc::Peer *currentPeer() const;
 
    void setUserType(bs::network::UserType userType);
@@ -199,6 +199,7 @@ void AbstractChatWidgetState::onUpdateDisplayName(const std::string& partyId, co
    Chat::ClientPartyModelPtr clientPartyModelPtr = chat_->chatClientServicePtr_->getClientPartyModelPtr();
    Chat::ClientPartyPtr clientPartyPtr = clientPartyModelPtr->getClientPartyById(partyId);
    clientPartyPtr->setDisplayName(contactName);
+   chat_->chatPartiesTreeModel_->onPartyDisplayNameChanged(partyId);
 
    if (clientPartyPtr->isGlobalStandard() || (clientPartyPtr->isPrivateStandard() && chat_->currentPartyId_ == partyId)) {
       chat_->ui_->textEditMessages->onUpdatePartyName(partyId);
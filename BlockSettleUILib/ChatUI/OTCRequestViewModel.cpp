@@ -37,6 +37,8 @@ OTCRequestViewModel::OTCRequestViewModel(OtcClient *otcClient, QObject* parent)
 
    updateDurationTimer_.setInterval(kUpdateTimerInterval);
    updateDurationTimer_.start();
+
+   onRequestsUpdated();
 }
 
 int OTCRequestViewModel::rowCount(const QModelIndex &parent) const
@@ -102,26 +104,88 @@ QVariant OTCRequestViewModel::headerData(int section, Qt::Orientation orientatio
 
 QModelIndex OTCRequestViewModel::getIndexByTimestamp(QDateTime timeStamp)
 {
-   for (int iReq = 0; iReq < request_.size(); ++iReq) {
-      if (timeStamp == request_[iReq].request_.timestamp) {
-         return index(iReq, 0);
-      }
+   const auto itId = idByTimestamp_.find(timeStamp.toMSecsSinceEpoch());
+   if (itId == idByTimestamp_.end()) {
+      return {};
    }
+   const auto itRow = rowById_.find(itId->second);
+   if (itRow == rowById_.end()) {
+      return {};
+   }
+   return index(itRow->second, 0);
+}
 
-   return {};
+otc::Peer *OTCRequestViewModel::peer(const QModelIndex &index) const
+{
+   if (!index.isValid() || index.row() >= rowCount()) {
+      return nullptr;
+   }
+   const auto &requestData = request_.at(size_t(index.row()));
+   if (requestData.isOwnRequest_) {
+      return otcClient_->ownRequest();
+   }
+   return otcClient_->request(requestData.contactId_);
 }
 
 void OTCRequestViewModel::onRequestsUpdated()
 {
    beginResetModel();
    request_.clear();
+   rowById_.clear();
+   idByTimestamp_.clear();
    for (const auto &peer : otcClient_->requests()) {
-      request_.push_back({ peer->request, peer->isOwnRequest });
+      request_.push_back({ peer->contactId, peer->request, peer->isOwnRequest });
+      idByTimestamp_[peer->request.timestamp.toMSecsSinceEpoch()] = peer->contactId;
    }
+   reindex(0);
    endResetModel();
    emit restoreSelectedIndex();
 }
 
+void OTCRequestViewModel::onRequestAdded(const otc::Peer *peer)
+{
+   if (rowById_.find(peer->contactId) != rowById_.end()) {
+      onRequestUpdated(peer);
+      return;
+   }
+
+   // Own request is always on top (the same order as in OtcClient::requests)
+   const int row = peer->isOwnRequest ? 0 : rowCount();
+   beginInsertRows({}, row, row);
+   request_.insert(request_.begin() + row, { peer->contactId, peer->request, peer->isOwnRequest });
+   idByTimestamp_[peer->request.timestamp.toMSecsSinceEpoch()] = peer->contactId;
+   reindex(row);
+   endInsertRows();
+}
+
+void OTCRequestViewModel::onRequestUpdated(const otc::Peer *peer)
+{
+   const auto it = rowById_.find(peer->contactId);
+   if (it == rowById_.end()) {
+      onRequestAdded(peer);
+      return;
+   }
+
+   const int row = it->second;
+   auto &requestData = request_[size_t(row)];
+   eraseTimestamp(requestData);
+   requestData.request_ = peer->request;
+   requestData.isOwnRequest_ = peer->isOwnRequest;
+   idByTimestamp_[requestData.request_.timestamp.toMSecsSinceEpoch()] = requestData.contactId_;
+
+   emit dataChanged(index(row, 0), index(row, static_cast<int>(Columns::Latest)));
+}
+
+void OTCRequestViewModel::onRequestRemoved(const std::string &contactId)
+{
+   const auto it = rowById_.find(contactId);
+   if (it == rowById_.end()) {
+      return;
+   }
+   const int row = it->second;
+   removeRequestRows(row, row);
+}
+
 void OTCRequestViewModel::onUpdateDuration()
 {
    if (rowCount() == 0) {
@@ -131,17 +195,54 @@ void OTCRequestViewModel::onUpdateDuration()
    const qint64 timeout = QDateTime::currentDateTime().toSecsSinceEpoch() - std::chrono::duration_cast<std::chrono::seconds>(
       bs::network::otc::publicRequestTimeout()).count();
 
-   auto it = std::remove_if(request_.begin(), request_.end(), [&](const OTCRequest& req) {
-      return req.request_.timestamp.toSecsSinceEpoch() < timeout;
-   });
+   // Remove expired requests range by range (from the end so row numbers stay valid)
+   int row = rowCount() - 1;
+   while (row >= 0) {
+      if (request_[size_t(row)].request_.timestamp.toSecsSinceEpoch() >= timeout) {
+         --row;
+         continue;
+      }
+      const int last = row;
+      while (row > 0 && request_[size_t(row - 1)].request_.timestamp.toSecsSinceEpoch() < timeout) {
+         --row;
+      }
+      removeRequestRows(row, last);
+      --row;
+   }
 
-   if (it != request_.end()) {
-      const int startIndex = std::distance(request_.begin(), it);
-      beginRemoveRows({}, startIndex, request_.size() - 1);
-      request_.erase(it, request_.end());
-      endRemoveRows();
+   if (rowCount() == 0) {
+      return;
    }
 
    emit dataChanged(index(0, static_cast<int>(Columns::Duration)),
       index(rowCount() - 1, static_cast<int>(Columns::Duration)), { Qt::DisplayRole });
 }
+
+void OTCRequestViewModel::removeRequestRows(int first, int last)
+{
+   beginRemoveRows({}, first, last);
+   for (int row = first; row <= last; ++row) {
+      const auto &requestData = request_[size_t(row)];
+      eraseTimestamp(requestData);
+      rowById_.erase(requestData.contactId_);
+   }
+   request_.erase(request_.begin() + first, request_.begin() + last + 1);
+   reindex(first);
+   endRemoveRows();
+}
+
+void OTCRequestViewModel::reindex(int fromRow)
+{
+   for (int row = fromRow; row < rowCount(); ++row) {
+      rowById_[request_[size_t(row)].contactId_] = row;
+   }
+}
+
+void OTCRequestViewModel::eraseTimestamp(const OTCRequest &requestData)
+{
+   // Do not drop the entry if some other request has the same timestamp
+   const auto it = idByTimestamp_.find(requestData.request_.timestamp.toMSecsSinceEpoch());
+   if (it != idByTimestamp_.end() && it->second == requestData.contactId_) {
+      idByTimestamp_.erase(it);
+   }
+}
@@ -13,6 +13,7 @@
 
 #include <QAbstractTableModel>
 #include <QTimer>
+#include <unordered_map>
 
 #include "OtcTypes.h"
 
@@ -38,6 +39,8 @@ public:
    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
 
    QModelIndex getIndexByTimestamp(QDateTime timeStamp);
+   // Returns request peer for the row (null if the row is invalid or request is gone)
+   bs::network::otc::Peer *peer(const QModelIndex &index) const;
 
    enum class Columns
    {
@@ -52,8 +55,13 @@ public:
    };
 
 public slots:
+   // Full resync with OtcClient::requests()
    void onRequestsUpdated();
 
+   void onRequestAdded(const bs::network::otc::Peer *peer);
+   void onRequestUpdated(const bs::network::otc::Peer *peer);
+   void onRequestRemoved(const std::string &contactId);
+
 private slots:
    void onUpdateDuration();
 
@@ -63,10 +71,19 @@ signals:
 private:
    struct OTCRequest
    {
+      std::string contactId_;
       bs::network::otc::QuoteRequest request_;
       bool isOwnRequest_;
    };
+
+   void removeRequestRows(int first, int last);
+   void reindex(int fromRow);
+   void eraseTimestamp(const OTCRequest &requestData);
+
    std::vector<OTCRequest> request_;
+   // contactId -> row and request timestamp (msecs) -> contactId
+   std::unordered_map<std::string, int> rowById_;
+   std::unordered_map<qint64, std::string> idByTimestamp_;
 
    OtcClient *otcClient_{};
    QTimer updateDurationTimer_;
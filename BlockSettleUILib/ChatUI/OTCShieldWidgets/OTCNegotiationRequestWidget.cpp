@@ -139,7 +139,7 @@ void OTCNegotiationRequestWidget::onSyncInterface()
    ui_->comboBoxXBTWallets->setCurrentIndex(index);
    onCurrentWalletChanged();
 
-   UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, getAuthManager());
+   UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, getAuthManager(), getAuthAddressCache());
    ui_->widgetButtons->setEnabled(ui_->authenticationAddressComboBox->isEnabled());
 }
 
@@ -338,5 +338,5 @@ void OTCNegotiationRequestWidget::onMaxQuantityClicked()
          ui_->quantitySpinBox->setValue(spendableQuantity);
          });
    };
-   otcManager_->getArmory()->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
+   getUtxoManager()->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
 }
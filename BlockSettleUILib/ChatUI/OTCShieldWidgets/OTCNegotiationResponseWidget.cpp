@@ -146,7 +146,7 @@ void OTCNegotiationResponseWidget::onSyncInterface()
    ui_->comboBoxXBTWallets->setCurrentIndex(index);
    onCurrentWalletChanged();
 
-   UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, getAuthManager());
+   UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, getAuthManager(), getAuthAddressCache());
    ui_->widgetButtons->setEnabled(ui_->authenticationAddressComboBox->isEnabled());
 }
 
@@ -67,6 +67,11 @@ std::shared_ptr<AuthAddressManager> OTCWindowsAdapterBase::getAuthManager() cons
    return otcManager_->getAuthManager();
 }
 
+std::shared_ptr<AuthAddressVerificationCache> OTCWindowsAdapterBase::getAuthAddressCache() const
+{
+   return otcManager_->getAuthAddressCache();
+}
+
 std::shared_ptr<AssetManager> OTCWindowsAdapterBase::getAssetManager() const
 {
    return otcManager_->getAssetManager();
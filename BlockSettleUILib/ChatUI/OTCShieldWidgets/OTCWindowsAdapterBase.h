@@ -24,6 +24,7 @@
 class QComboBox;
 class OTCWindowsManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class AssetManager;
 class QLabel;
 class QProgressBar;
@@ -61,6 +62,7 @@ public:
    void setChatOTCManager(const std::shared_ptr<OTCWindowsManager>& otcManager);
    std::shared_ptr<bs::sync::WalletsManager> getWalletManager() const;
    std::shared_ptr<AuthAddressManager> getAuthManager() const;
+   std::shared_ptr<AuthAddressVerificationCache> getAuthAddressCache() const;
    std::shared_ptr<AssetManager> getAssetManager() const;
    std::shared_ptr<bs::UTXOReservationManager> getUtxoManager() const;
 
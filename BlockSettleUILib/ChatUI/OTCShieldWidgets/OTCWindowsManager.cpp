@@ -11,6 +11,7 @@
 #include "OTCWindowsManager.h"
 #include "Wallets/SyncWalletsManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "MDCallbacksQt.h"
 #include "AssetManager.h"
 #include "UtxoReservationManager.h"
@@ -66,6 +67,19 @@ std::shared_ptr<AuthAddressManager> OTCWindowsManager::getAuthManager() const
    return authManager_;
 }
 
+void OTCWindowsManager::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   authAddrCache_ = cache;
+   if (authAddrCache_) {
+      connect(authAddrCache_.get(), &AuthAddressVerificationCache::updated, this, &OTCWindowsManager::syncInterfaceRequired);
+   }
+}
+
+std::shared_ptr<AuthAddressVerificationCache> OTCWindowsManager::getAuthAddressCache() const
+{
+   return authAddrCache_;
+}
+
 std::shared_ptr<AssetManager> OTCWindowsManager::getAssetManager() const
 {
    return assetManager_;
@@ -23,6 +23,7 @@ namespace bs {
 class ArmoryConnection;
 class AssetManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class MDCallbacksQt;
 
 namespace bs {
@@ -47,6 +48,9 @@ public:
    std::shared_ptr<ArmoryConnection> getArmory() const;
    std::shared_ptr<bs::UTXOReservationManager> getUtxoManager() const;
 
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
+   std::shared_ptr<AuthAddressVerificationCache> getAuthAddressCache() const;
+
 signals:
    void syncInterfaceRequired();
    void updateMDDataRequired(bs::network::Asset::Type, const QString &, const bs::network::MDFields&);
@@ -55,6 +59,7 @@ signals:
 protected:
    std::shared_ptr<bs::sync::WalletsManager> walletsMgr_;
    std::shared_ptr<AuthAddressManager> authManager_;
+   std::shared_ptr<AuthAddressVerificationCache> authAddrCache_;
    std::shared_ptr<AssetManager> assetManager_;
    std::shared_ptr<ArmoryConnection> armory_;
    std::shared_ptr<bs::UTXOReservationManager> utxoReservationManager_;
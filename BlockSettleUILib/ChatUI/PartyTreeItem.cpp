@@ -10,11 +10,25 @@
 */
 #include "PartyTreeItem.h"
 
+#include "ChatProtocol/ClientParty.h"
+
 PartyTreeItem::PartyTreeItem(const QVariant& data, UI::ElementType modelType, PartyTreeItem* parent /*= nullptr*/)
    : itemData_(data)
    , modelType_(modelType)
    , parentItem_(parent)
 {
+   switch (modelType_) {
+   case UI::ElementType::Party:
+      filterCategory_ = FilterCategory::Visible;
+      break;
+   case UI::ElementType::Container:
+      filterCategory_ = FilterCategory::VisibleIfNotEmpty;
+      break;
+   default:
+      filterCategory_ = FilterCategory::Hidden;
+      break;
+   }
+   refreshSortKey();
 }
 
 PartyTreeItem::~PartyTreeItem()
@@ -58,6 +72,12 @@ void PartyTreeItem::removeAll()
    childItems_.clear();
 }
 
+void PartyTreeItem::removeChildren(int first, int count)
+{
+   Q_ASSERT(first >= 0 && count >= 0 && first + count <= childItems_.size());
+   childItems_.erase(childItems_.begin() + first, childItems_.begin() + first + count);
+}
+
 int PartyTreeItem::childNumber() const
 {
    if (parentItem_) {
@@ -77,6 +97,7 @@ int PartyTreeItem::childNumber() const
 bool PartyTreeItem::setData(const QVariant& value)
 {
    itemData_ = value;
+   refreshSortKey();
    return true;
 }
 
@@ -85,6 +106,30 @@ UI::ElementType PartyTreeItem::modelType() const
    return modelType_;
 }
 
+const std::string& PartyTreeItem::sortKey() const
+{
+   return sortKey_;
+}
+
+PartyTreeItem::FilterCategory PartyTreeItem::filterCategory() const
+{
+   return filterCategory_;
+}
+
+bool PartyTreeItem::refreshSortKey()
+{
+   if (modelType_ != UI::ElementType::Party) {
+      return false;
+   }
+
+   const auto clientPartyPtr = itemData_.value<Chat::ClientPartyPtr>();
+   if (!clientPartyPtr || clientPartyPtr->displayName() == sortKey_) {
+      return false;
+   }
+   sortKey_ = clientPartyPtr->displayName();
+   return true;
+}
+
 void PartyTreeItem::increaseUnseenCounter(int newMessageCount)
 {
    Q_ASSERT(newMessageCount > 0);
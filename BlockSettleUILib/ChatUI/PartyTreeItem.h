@@ -44,6 +44,13 @@ struct ReusableItemData
 class PartyTreeItem
 {
 public:
+   enum class FilterCategory
+   {
+      Hidden,
+      Visible,
+      VisibleIfNotEmpty
+   };
+
    PartyTreeItem(const QVariant& data, UI::ElementType modelType, PartyTreeItem* parent = nullptr);
    ~PartyTreeItem();
 
@@ -57,11 +64,19 @@ public:
    bool insertChildren(std::unique_ptr<PartyTreeItem>&& item);
    PartyTreeItem* parent();
    void removeAll();
+   void removeChildren(int first, int count);
    int childNumber() const;
    bool setData(const QVariant& value);
 
    UI::ElementType modelType() const;
 
+   // Sort key (party display name) and filter category are cached for
+   // ChatPartiesSortProxyModel which uses them on each comparison
+   const std::string& sortKey() const;
+   FilterCategory filterCategory() const;
+   // Re-reads party display name, returns true if sort key has changed
+   bool refreshSortKey();
+
    void increaseUnseenCounter(int newMessageCount);
    void decreaseUnseenCounter(int seenMessageCount);
    bool hasNewMessages() const;
@@ -83,6 +98,8 @@ private:
    QVariant itemData_;
    PartyTreeItem* parentItem_;
    UI::ElementType modelType_;
+   std::string sortKey_;
+   FilterCategory filterCategory_{};
    int unseenCounter_{};
 
    // OTC toggling
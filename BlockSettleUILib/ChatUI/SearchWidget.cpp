@@ -11,11 +11,11 @@
 #include <QTimer>
 #include <QMenu>
 #include <QKeyEvent>
-#include <QUuid>
 
 #include "SearchWidget.h"
 #include "ui_SearchWidget.h"
 #include "UserSearchModel.h"
+#include "UserSearchRequester.h"
 #include "ChatUI/ChatSearchListViewItemStyle.h"
 
 #include "chat.pb.h"
@@ -89,6 +89,11 @@ void SearchWidget::init(const Chat::ChatClientServicePtr& chatClientServicePtr)
    chatClientServicePtr_ = chatClientServicePtr;
    connect(chatClientServicePtr_.get(), &Chat::ChatClientService::searchUserReply, this, &SearchWidget::onSearchUserReply);
 
+   searchRequester_ = new UserSearchRequester([this](const std::string &text, const std::string &searchId) {
+      chatClientServicePtr_->SearchUser(text, searchId);
+   }, this);
+   connect(searchRequester_, &UserSearchRequester::resultsReady, this, &SearchWidget::onSearchResults);
+
    //chatClient_ = chatClient;
    //ui_->chatSearchLineEdit->setActionsHandler(chatClient);
    userSearchModel_->setItemStyle(std::make_shared<ChatSearchListViewItemStyle>());
@@ -118,6 +123,11 @@ void SearchWidget::init(const Chat::ChatClientServicePtr& chatClientServicePtr)
    });
 }
 
+void SearchWidget::setSearchDebounceInterval(std::chrono::milliseconds interval)
+{
+   searchRequester_->setDebounceInterval(interval);
+}
+
 bool SearchWidget::isLineEditEnabled() const
 {
    return ui_->chatSearchLineEdit->isEnabled();
@@ -264,6 +274,7 @@ void SearchWidget::onSearchUserTextEdited()
    std::string userToAdd = searchText().toStdString();
 
    if (userToAdd.empty() || userToAdd.length() < 3) {
+      searchRequester_->cancel();
       onSetListVisible(false);
       userSearchModel_->setUsers({});
       return;
@@ -271,21 +282,22 @@ void SearchWidget::onSearchUserTextEdited()
 
    QRegularExpressionMatch match = emailRegex_.match(QString::fromStdString(userToAdd));
    if (match.hasMatch()) {
+      searchRequester_->cancel();
       emit emailHashRequested(userToAdd);
       return;
    }
 
-   // ! Feature: Think how to prevent spamming server
-
-   sendSearchRequest(userToAdd);
+   // Debounced and answered from recent results when possible
+   searchRequester_->search(userToAdd);
 }
 
 void SearchWidget::onSearchUserReply(const Chat::SearchUserReplyList& userHashList, const std::string& searchId)
 {
-   if (searchId != lastSearchId_) {
-      return;
-   }
+   searchRequester_->onSearchReply(UserSearchRequester::Results(userHashList.begin(), userHashList.end()), searchId);
+}
 
+void SearchWidget::onSearchResults(const std::string& text, const std::vector<std::string>& userHashList)
+{
    Chat::ClientPartyModelPtr clientPartyModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
    std::vector<UserSearchModel::UserInfo> userInfoList;
 
@@ -331,12 +343,5 @@ void SearchWidget::onEmailHashReceived(const std::string &email, const std::stri
       return;
    }
 
-   sendSearchRequest(hash);
-}
-
-void SearchWidget::sendSearchRequest(const std::string &text)
-{
-   QUuid uid = QUuid::createUuid();
-   lastSearchId_ = uid.toString(QUuid::WithoutBraces).toStdString();
-   chatClientServicePtr_->SearchUser(text, lastSearchId_);
+   searchRequester_->searchNow(hash);
 }
@@ -11,7 +11,9 @@
 #ifndef SEARCHWIDGET_H
 #define SEARCHWIDGET_H
 
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #include <QRegularExpression>
 #include <QWidget>
@@ -22,6 +24,7 @@ class QAbstractItemModel;
 class ChatClient;
 class ChatSearchActionsHandler;
 class UserSearchModel;
+class UserSearchRequester;
 
 namespace Ui {
    class SearchWidget;
@@ -74,6 +77,7 @@ public:
    bool eventFilter(QObject *watched, QEvent *event) override;
 
    void init(const Chat::ChatClientServicePtr& chatClientServicePtr);
+   void setSearchDebounceInterval(std::chrono::milliseconds interval);
 
 public slots:
    void onClearLineEdit();
@@ -91,19 +95,18 @@ private slots:
    void onLeaveAndCloseSearchResults();
    void onInputTextChanged(const QString &text);
    void onSearchUserTextEdited();
+   void onSearchResults(const std::string& text, const std::vector<std::string>& userHashList);
 
 signals:
    void contactFriendRequest(const QString &userID);
    void showUserRoom(const QString &userID);
 
 private:
-   void sendSearchRequest(const std::string &text);
-
    QScopedPointer<Ui::SearchWidget> ui_;
    QScopedPointer<QTimer>           listVisibleTimer_;
    QScopedPointer<UserSearchModel>  userSearchModel_;
    Chat::ChatClientServicePtr       chatClientServicePtr_;
-   std::string                      lastSearchId_;
+   UserSearchRequester              *searchRequester_{};
 
    QRegularExpression emailRegex_;
 
@@ -0,0 +1,187 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "UserSearchRequester.h"
+
+#include <QUuid>
+
+namespace {
+
+   const auto kDefaultDebounceInterval = std::chrono::milliseconds(300);
+   const size_t kDefaultCacheSize = 32;
+
+} // namespace
+
+UserSearchRequester::UserSearchRequester(const SendFunc &sendFunc, QObject *parent)
+   : QObject(parent)
+   , sendFunc_(sendFunc)
+   , cacheSize_(kDefaultCacheSize)
+{
+   debounceTimer_.setSingleShot(true);
+   debounceTimer_.setInterval(kDefaultDebounceInterval);
+   connect(&debounceTimer_, &QTimer::timeout, this, &UserSearchRequester::onDebounceTimeout);
+}
+
+UserSearchRequester::~UserSearchRequester() = default;
+
+void UserSearchRequester::setDebounceInterval(std::chrono::milliseconds interval)
+{
+   debounceTimer_.setInterval(interval);
+}
+
+void UserSearchRequester::setCacheSize(size_t cacheSize)
+{
+   cacheSize_ = cacheSize;
+   while (cache_.size() > cacheSize_) {
+      cacheIndex_.erase(cache_.back().first);
+      cache_.pop_back();
+   }
+}
+
+void UserSearchRequester::search(const std::string &text)
+{
+   currentText_ = text;
+   waitingResults_ = true;
+
+   if (tryResolveLocally(text)) {
+      return;
+   }
+
+   debounceTimer_.start();
+}
+
+void UserSearchRequester::searchNow(const std::string &text)
+{
+   currentText_ = text;
+   waitingResults_ = true;
+   debounceTimer_.stop();
+
+   if (tryResolveLocally(text)) {
+      return;
+   }
+
+   send(text);
+}
+
+void UserSearchRequester::flush()
+{
+   if (!debounceTimer_.isActive()) {
+      return;
+   }
+   debounceTimer_.stop();
+   onDebounceTimeout();
+}
+
+void UserSearchRequester::cancel()
+{
+   debounceTimer_.stop();
+   waitingResults_ = false;
+   currentText_.clear();
+   inFlight_.clear();
+}
+
+void UserSearchRequester::onSearchReply(const Results &users, const std::string &searchId)
+{
+   const auto it = inFlight_.find(searchId);
+   if (it == inFlight_.end()) {
+      // Cancelled or not ours
+      return;
+   }
+   const auto text = std::move(it->second);
+   inFlight_.erase(it);
+
+   addToCache(text, users);
+
+   if (!waitingResults_ || debounceTimer_.isActive()) {
+      // User is still typing, results will be checked when debounce timer fires
+      return;
+   }
+
+   if (tryResolveLocally(currentText_)) {
+      return;
+   }
+
+   // Reply for outdated text
+   onDebounceTimeout();
+}
+
+void UserSearchRequester::onDebounceTimeout()
+{
+   if (!waitingResults_) {
+      return;
+   }
+
+   if (tryResolveLocally(currentText_)) {
+      return;
+   }
+
+   // Reply for in-flight search of the same text is reported when it arrives
+   for (const auto &request : inFlight_) {
+      if (request.second == currentText_) {
+         return;
+      }
+   }
+
+   send(currentText_);
+}
+
+bool UserSearchRequester::tryResolveLocally(const std::string &text)
+{
+   Results users;
+   if (!findCached(text, users)) {
+      return false;
+   }
+
+   debounceTimer_.stop();
+   waitingResults_ = false;
+   emit resultsReady(text, users);
+   return true;
+}
+
+bool UserSearchRequester::findCached(const std::string &text, Results &users)
+{
+   const auto it = cacheIndex_.find(text);
+   if (it == cacheIndex_.end()) {
+      return false;
+   }
+   cache_.splice(cache_.begin(), cache_, it->second);
+   users = it->second->second;
+   return true;
+}
+
+void UserSearchRequester::addToCache(const std::string &text, const Results &users)
+{
+   if (cacheSize_ == 0) {
+      return;
+   }
+
+   auto it = cacheIndex_.find(text);
+   if (it != cacheIndex_.end()) {
+      it->second->second = users;
+      cache_.splice(cache_.begin(), cache_, it->second);
+      return;
+   }
+
+   cache_.emplace_front(text, users);
+   cacheIndex_[text] = cache_.begin();
+
+   if (cache_.size() > cacheSize_) {
+      cacheIndex_.erase(cache_.back().first);
+      cache_.pop_back();
+   }
+}
+
+void UserSearchRequester::send(const std::string &text)
+{
+   const auto searchId = QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString();
+   inFlight_[searchId] = text;
+   ++requestsSent_;
+   sendFunc_(text, searchId);
+}
@@ -0,0 +1,90 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef USER_SEARCH_REQUESTER_H
+#define USER_SEARCH_REQUESTER_H
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+
+// Throttles user search requests sent to chat server.
+// Requests are sent only after text is not edited for debounce interval,
+// replies for outdated text are not reported.
+// Recent replies are kept in LRU cache, so repeated searches of the same text
+// are answered locally. Other texts always go to server: search reply doesn't
+// tell how server matched users or whether the list was complete, so results
+// for one text can't be derived from another.
+class UserSearchRequester : public QObject
+{
+   Q_OBJECT
+
+public:
+   using Results = std::vector<std::string>;
+   using SendFunc = std::function<void(const std::string &text, const std::string &searchId)>;
+
+   UserSearchRequester(const SendFunc &sendFunc, QObject *parent = nullptr);
+   ~UserSearchRequester() override;
+
+   void setDebounceInterval(std::chrono::milliseconds interval);
+   void setCacheSize(size_t cacheSize);
+
+   // Debounced search
+   void search(const std::string &text);
+   // Search without debounce (when text is not typed by user)
+   void searchNow(const std::string &text);
+   // Sends pending debounced search right away
+   void flush();
+   // Drops pending search and ignores replies for searches in flight
+   void cancel();
+
+   size_t requestsSent() const { return requestsSent_; }
+
+public slots:
+   void onSearchReply(const Results &users, const std::string &searchId);
+
+signals:
+   void resultsReady(const std::string &text, const Results &users);
+
+private slots:
+   void onDebounceTimeout();
+
+private:
+   bool tryResolveLocally(const std::string &text);
+   bool findCached(const std::string &text, Results &users);
+   void addToCache(const std::string &text, const Results &users);
+   void send(const std::string &text);
+
+private:
+   SendFunc sendFunc_;
+   QTimer   debounceTimer_;
+   size_t   cacheSize_;
+
+   // Text that user currently waits results for
+   std::string currentText_;
+   bool     waitingResults_{};
+
+   // searchId -> text for requests sent but not replied yet
+   std::unordered_map<std::string, std::string> inFlight_;
+
+   // Most recently used at front
+   std::list<std::pair<std::string, Results>> cache_;
+   std::unordered_map<std::string, std::list<std::pair<std::string, Results>>::iterator> cacheIndex_;
+
+   size_t   requestsSent_{};
+};
+
+#endif // USER_SEARCH_REQUESTER_H
@@ -28,6 +28,7 @@
 #include "Address.h"
 #include "ArmoryConnection.h"
 #include "BSMessageBox.h"
+#include "FeeEstimateCache.h"
 #include "OfflineSigner.h"
 #include "SignContainer.h"
 #include "TransactionData.h"
@@ -83,11 +84,7 @@ CreateTransactionDialog::~CreateTransactionDialog() noexcept
 void CreateTransactionDialog::init()
 {
    if (!transactionData_) {
-      transactionData_ = std::make_shared<TransactionData>([this]() {
-         QMetaObject::invokeMethod(this, [this] {
-            onTransactionUpdated();
-         });
-      }, logger_);
+      transactionData_ = std::make_shared<TransactionData>(transactionDataCallback(), logger_);
    }
    else {
       const auto recipients = transactionData_->allRecipientIds();
@@ -95,12 +92,7 @@ void CreateTransactionDialog::init()
          transactionData_->RemoveRecipient(recipId);
       }
       onTransactionUpdated();
-      transactionData_->SetCallback([this] {
-         QMetaObject::invokeMethod(this, [this] {
-            // Call on main thread because GUI is updated here
-            onTransactionUpdated();
-         });
-      });
+      transactionData_->SetCallback(transactionDataCallback());
    }
 
    xbtValidator_ = new XbtAmountValidator(this);
@@ -233,6 +225,8 @@ void CreateTransactionDialog::loadFees()
    for (const auto &feeLevel : feeLevels) {
       result->levels.insert(feeLevel.first);
    }
+   // Shared estimates avoid duplicate queries when trading widgets ask for the same target
+   const auto feeEstimates = bs::FeeEstimateCache::instance(logger_, armory_);
    for (const auto &feeLevel : feeLevels) {
       const auto &cbFee = [this, result, level=feeLevel.first](float fee) {
          result->levels.erase(level);
@@ -243,7 +237,14 @@ void CreateTransactionDialog::loadFees()
             emit feeLoadingCompleted(result->values);
          }
       };
-      walletsManager_->estimatedFeePerByte(feeLevel.first, cbFee, this);
+      const auto &cbArmoryFee = [this, cbFee](float fee) {
+         QMetaObject::invokeMethod(this, [cbFee, fee] {
+            cbFee((fee < std::numeric_limits<float>::infinity()) ? ArmoryConnection::toFeePerByte(fee) : fee);
+         });
+      };
+      if (!feeEstimates->estimateFee(feeLevel.first, cbArmoryFee)) {
+         cbFee(std::numeric_limits<float>::infinity());
+      }
    }
 /*   const auto &cbFees = [this](const std::map<unsigned int, float> &feeMap) {
       emit feeLoadingCompleted(feeMap);
@@ -313,6 +314,16 @@ void CreateTransactionDialog::selectedWalletChanged(int, bool resetInputs, const
    }
 }
 
+std::function<void()> CreateTransactionDialog::transactionDataCallback()
+{
+   return [this] {
+      QMetaObject::invokeMethod(this, [this] {
+         // Call on main thread because GUI is updated here
+         onTransactionUpdated();
+      });
+   };
+}
+
 void CreateTransactionDialog::onTransactionUpdated()
 {
    const auto &summary = transactionData_->GetTransactionSummary();
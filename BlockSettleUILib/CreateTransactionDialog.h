@@ -97,6 +97,8 @@ protected:
    virtual void getChangeAddress(AddressCb) const = 0;
 
    virtual void onTransactionUpdated();
+   // TransactionData change callback - schedules onTransactionUpdated on main thread
+   std::function<void()> transactionDataCallback();
 
    virtual bool HaveSignedImportedTransaction() const { return false; }
 
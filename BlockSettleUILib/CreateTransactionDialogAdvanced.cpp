@@ -16,6 +16,7 @@
 #include "BSMessageBox.h"
 #include "CoinControlDialog.h"
 #include "CreateTransactionDialogSimple.h"
+#include "RecipientsImport.h"
 #include "SelectAddressDialog.h"
 #include "SelectedTransactionInputs.h"
 #include "SignContainer.h"
@@ -80,6 +81,7 @@ std::shared_ptr<CreateTransactionDialogAdvanced> CreateTransactionDialogAdvanced
    dlg->ui_->checkBoxRBF->setChecked(true);
    dlg->ui_->checkBoxRBF->setEnabled(false);
    dlg->ui_->pushButtonImport->setEnabled(false);
+   dlg->ui_->pushButtonImportRecipients->setEnabled(false);
    dlg->ui_->pushButtonShowSimple->setEnabled(false);
 
    dlg->setRBFinputs(tx);
@@ -103,6 +105,7 @@ std::shared_ptr<CreateTransactionDialogAdvanced> CreateTransactionDialogAdvanced
 
    dlg->setWindowTitle(tr("Child-Pays-For-Parent"));
    dlg->ui_->pushButtonImport->setEnabled(false);
+   dlg->ui_->pushButtonImportRecipients->setEnabled(false);
    dlg->ui_->pushButtonShowSimple->setEnabled(false);
 
    dlg->setCPFPinputs(tx, wallet);
@@ -444,6 +447,7 @@ void CreateTransactionDialogAdvanced::initUI()
    connect(ui_->pushButtonAddOutput, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::onAddOutput);
    connect(ui_->pushButtonCreate, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::onCreatePressed);
    connect(ui_->pushButtonImport, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::onImportPressed);
+   connect(ui_->pushButtonImportRecipients, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::onImportRecipientsPressed);
    connect(ui_->pushButtonCancel, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::reject);
    connect(ui_->pushButtonShowSimple, &QPushButton::clicked, this, &CreateTransactionDialogAdvanced::onSimpleDialogRequested);
 
@@ -649,8 +653,11 @@ void CreateTransactionDialogAdvanced::onOutputRemoved(int rowNumber)
       }
    }
 
-   for (const auto &recipId : transactionData_->allRecipientIds()) {
-      UpdateRecipientAmount(recipId, transactionData_->GetRecipientAmount(recipId), false);
+   {
+      const bs::ui::TransactionDataBatch batch(transactionData_, transactionDataCallback());
+      for (const auto &recipId : transactionData_->allRecipientIds()) {
+         UpdateRecipientAmount(recipId, transactionData_->GetRecipientAmount(recipId), false);
+      }
    }
    transactionData_->setTotalFee(0, false);
    setTxFees();
@@ -848,6 +855,20 @@ void CreateTransactionDialogAdvanced::AddRecipients(const std::vector<std::tuple
    QMetaObject::invokeMethod(outputsModel_, [this, modelRecips] { outputsModel_->AddRecipients(modelRecips); });
 }
 
+void CreateTransactionDialogAdvanced::ImportRecipients(const std::vector<bs::ui::ImportedRecipient> &recipients)
+{
+   SPDLOG_LOGGER_DEBUG(logger_, "importing {} recipients", recipients.size());
+   // fee and max amount are recalculated once for the whole batch
+   bs::ui::addRecipients(transactionData_, outputsModel_, recipients, transactionDataCallback());
+
+   if (FixRecipientsAmount()) {
+      enableFeeChanging(false);
+   }
+   outputRow_ = -1;
+   ui_->treeViewOutputs->clearSelection();
+   validateAddOutputButton();
+}
+
 void CreateTransactionDialogAdvanced::onMaxPressed()
 {
    CreateTransactionDialog::onMaxPressed();
@@ -899,6 +920,7 @@ bool CreateTransactionDialogAdvanced::FixRecipientsAmount()
          , this);
       if (question.exec() == QDialog::Accepted) {
          transactionData_->setTotalFee(newTotalFee * BTCNumericTypes::BalanceDivider, false);
+         const bs::ui::TransactionDataBatch batch(transactionData_, transactionDataCallback());
          for (const auto &recipId : transactionData_->allRecipientIds()) {
             UpdateRecipientAmount(recipId, transactionData_->GetRecipientAmount(recipId), true);
          }
@@ -906,6 +928,7 @@ bool CreateTransactionDialogAdvanced::FixRecipientsAmount()
       }
    }
    else if (diffMax < 0.00000001) {   // if diff is less than 1 satoshi (which can be caused by maxAmount calc tolerance)
+      const bs::ui::TransactionDataBatch batch(transactionData_, transactionDataCallback());
       for (const auto &recipId : transactionData_->allRecipientIds()) {
          UpdateRecipientAmount(recipId, transactionData_->GetRecipientAmount(recipId), true);
       }
@@ -1310,6 +1333,41 @@ void CreateTransactionDialogAdvanced::onImportPressed()
    SetImportedTransactions(transactions);
 }
 
+void CreateTransactionDialogAdvanced::onImportRecipientsPressed()
+{
+   const QString fileName = QFileDialog::getOpenFileName(this, tr("Select recipients file"), {}
+      , tr("CSV files (*.csv);;All files (*)"));
+   if (fileName.isEmpty()) {
+      return;
+   }
+
+   const auto title = tr("Recipients import");
+   QFile f(fileName);
+   if (!f.open(QIODevice::ReadOnly)) {
+      BSMessageBox(BSMessageBox::critical, title, tr("Failed to open %1 for reading").arg(fileName)
+         , this).exec();
+      return;
+   }
+
+   QStringList errors;
+   const auto recipients = bs::ui::parseRecipientsCsv(f.readAll(), &errors);
+   if (recipients.empty()) {
+      BSMessageBox(BSMessageBox::critical, title, tr("No valid recipients found in %1").arg(fileName)
+         , QString(), errors.join(QLatin1Char('\n')), this).exec();
+      return;
+   }
+   if (!errors.isEmpty()) {
+      BSMessageBox question(BSMessageBox::question, title
+         , tr("%1 line(s) of %2 are invalid").arg(errors.size()).arg(fileName)
+         , tr("Import %1 valid recipient(s)?").arg(recipients.size())
+         , errors.join(QLatin1Char('\n')), this);
+      if (question.exec() != QDialog::Accepted) {
+         return;
+      }
+   }
+   ImportRecipients(recipients);
+}
+
 void CreateTransactionDialogAdvanced::onNewAddressSelectedForChange()
 {
    selectedChangeAddress_ = bs::Address{};
@@ -25,6 +25,9 @@ namespace bs {
       class Wallet;
       class WalletsManager;
    }
+   namespace ui {
+      struct ImportedRecipient;
+   }
 }
 
 
@@ -114,6 +117,7 @@ protected slots:
    void onAddOutput();
    void onCreatePressed();
    void onImportPressed();
+   void onImportRecipientsPressed();
    void onMaxPressed() override;
 
    void feeSelectionChanged(int currentIndex) override;
@@ -145,6 +149,7 @@ private:
 
    unsigned int AddRecipient(const bs::Address &, double amount, bool isMax = false);
    void AddRecipients(const std::vector<std::tuple<bs::Address, double, bool>> &);
+   void ImportRecipients(const std::vector<bs::ui::ImportedRecipient> &);
    void UpdateRecipientAmount(unsigned int recipId, double amount, bool isMax = false);
    bool FixRecipientsAmount();
    void onOutputRemoved(int rowNumber);
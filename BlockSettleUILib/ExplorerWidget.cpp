@@ -41,6 +41,12 @@ ExplorerWidget::ExplorerWidget(QWidget *parent) :
    connect(expTimer_.get(), &QTimer::timeout, this, &ExplorerWidget::onExpTimeout);
    connect(ui_->Transaction, &TransactionDetailsWidget::finished, expTimer_.get(), &QTimer::stop);
    connect(ui_->Address, &AddressDetailsWidget::finished, expTimer_.get(), &QTimer::stop);
+   // address is loaded page by page - don't time out while pages keep coming
+   connect(ui_->Address, &AddressDetailsWidget::pageLoaded, this, [this] {
+      if (expTimer_->isActive()) {
+         expTimer_->start();
+      }
+   });
 
    // connection to handle enter key being pressed inside the search box
    connect(ui_->searchBox, &QLineEdit::returnPressed,
@@ -82,6 +88,8 @@ void ExplorerWidget::init(const std::shared_ptr<ArmoryConnection> &armory
    connect(authMgr_.get(), &AuthAddressManager::gotBsAddressList, [this] {
       ui_->Address->setBSAuthAddrs(authMgr_->GetBSAddresses());
    });
+   // may be initialized after the list was received
+   ui_->Address->setBSAuthAddrs(authMgr_->GetBSAddresses());
 
    // With Armory and the logger set, we can start accepting text input.
    ui_->searchBox->setReadOnly(false);
@@ -0,0 +1,146 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "FeeEstimateCache.h"
+
+#include <limits>
+#include <spdlog/spdlog.h>
+
+using namespace bs;
+
+FeeEstimateCache::FeeEstimateCache(const std::shared_ptr<spdlog::logger> &logger
+   , const std::shared_ptr<ArmoryConnection> &armory, std::chrono::milliseconds ttl)
+   : logger_(logger)
+   , armory_(armory)
+   , state_(std::make_shared<State>())
+{
+   state_->ttl = ttl;
+   if (armory_) {
+      init(armory_.get());
+   }
+}
+
+FeeEstimateCache::~FeeEstimateCache()
+{
+   cleanup();
+}
+
+bool FeeEstimateCache::estimateFee(unsigned int nbBlocks, const FeeCb &cb)
+{
+   if (!armory_) {
+      return false;
+   }
+   uint64_t generation = 0;
+   {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      const auto itEstimate = state_->estimates.find(nbBlocks);
+      if (itEstimate != state_->estimates.end()) {
+         if (std::chrono::steady_clock::now() - itEstimate->second.timestamp < state_->ttl) {
+            const auto value = itEstimate->second.value;
+            lock.unlock();
+            cb(value);
+            return true;
+         }
+         state_->estimates.erase(itEstimate);
+      }
+
+      auto &callbacks = state_->pending[nbBlocks];
+      callbacks.push_back(cb);
+      if (callbacks.size() > 1) {
+         return true;   // will be served by the query already sent
+      }
+      generation = state_->generation;
+      state_->queriesSent++;
+   }
+
+   const auto &cbFee = [state = state_, nbBlocks, generation](float fee) {
+      onEstimate(state, nbBlocks, generation, fee);
+   };
+   if (!armory_->estimateFee(nbBlocks, cbFee)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to request fee estimate for {} blocks", nbBlocks);
+      // Callers joined after the request was started still expect a reply
+      std::vector<FeeCb> callbacks;
+      {
+         std::lock_guard<std::mutex> lock(state_->mutex);
+         const auto itPending = state_->pending.find(nbBlocks);
+         if (itPending != state_->pending.end()) {
+            callbacks = std::move(itPending->second);
+            state_->pending.erase(itPending);
+         }
+      }
+      // The first one is the caller of this function and gets false instead
+      for (size_t i = 1; i < callbacks.size(); ++i) {
+         callbacks[i](std::numeric_limits<float>::infinity());
+      }
+      return false;
+   }
+   return true;
+}
+
+std::shared_ptr<FeeEstimateCache> FeeEstimateCache::instance(const std::shared_ptr<spdlog::logger> &logger
+   , const std::shared_ptr<ArmoryConnection> &armory)
+{
+   static std::mutex mutex;
+   static std::map<const ArmoryConnection *, std::weak_ptr<FeeEstimateCache>> instances;
+
+   std::lock_guard<std::mutex> lock(mutex);
+   auto &weakCache = instances[armory.get()];
+   auto cache = weakCache.lock();
+   if (!cache) {
+      cache = std::make_shared<FeeEstimateCache>(logger, armory);
+      weakCache = cache;
+   }
+   return cache;
+}
+
+void FeeEstimateCache::onEstimate(const std::shared_ptr<State> &state, unsigned int nbBlocks
+   , uint64_t generation, float fee)
+{
+   std::vector<FeeCb> callbacks;
+   {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      const auto itPending = state->pending.find(nbBlocks);
+      if (itPending != state->pending.end()) {
+         callbacks = std::move(itPending->second);
+         state->pending.erase(itPending);
+      }
+      // Failed estimates are not cached, as well as the ones requested before new block
+      if ((generation == state->generation) && (fee < std::numeric_limits<float>::infinity())) {
+         state->estimates[nbBlocks] = { fee, std::chrono::steady_clock::now() };
+      }
+   }
+   for (const auto &cb : callbacks) {
+      cb(fee);
+   }
+}
+
+void FeeEstimateCache::setTtl(std::chrono::milliseconds ttl)
+{
+   std::lock_guard<std::mutex> lock(state_->mutex);
+   state_->ttl = ttl;
+}
+
+void FeeEstimateCache::invalidate()
+{
+   std::lock_guard<std::mutex> lock(state_->mutex);
+   state_->estimates.clear();
+   state_->generation++;
+}
+
+size_t FeeEstimateCache::queriesSent() const
+{
+   std::lock_guard<std::mutex> lock(state_->mutex);
+   return state_->queriesSent;
+}
+
+void FeeEstimateCache::onNewBlock(unsigned int, unsigned int)
+{
+   invalidate();
+}
@@ -0,0 +1,94 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef FEE_ESTIMATE_CACHE_H
+#define FEE_ESTIMATE_CACHE_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ArmoryConnection.h"
+
+namespace spdlog {
+   class logger;
+}
+
+namespace bs {
+
+   // Fee estimates shared by all users of the same Armory connection.
+   // Concurrent requests for the same target block count are served by a single
+   // Armory query. Results are kept until the next new block or until TTL expires.
+   class FeeEstimateCache : public ArmoryCallbackTarget
+   {
+   public:
+      using FeeCb = std::function<void(float)>;
+
+      FeeEstimateCache(const std::shared_ptr<spdlog::logger> &
+         , const std::shared_ptr<ArmoryConnection> &
+         , std::chrono::milliseconds ttl = std::chrono::minutes(2));
+      ~FeeEstimateCache() override;
+
+      FeeEstimateCache(const FeeEstimateCache &) = delete;
+      FeeEstimateCache &operator=(const FeeEstimateCache &) = delete;
+
+      // Returns the cache shared by all users of the same Armory connection,
+      // it's created on first use and destroyed with its last user.
+      static std::shared_ptr<FeeEstimateCache> instance(const std::shared_ptr<spdlog::logger> &
+         , const std::shared_ptr<ArmoryConnection> &);
+
+      // Same value and units as ArmoryConnection::estimateFee returns.
+      // Cached value is passed to callback immediately, otherwise callback is
+      // invoked from Armory thread once estimate arrives. If the query can't be
+      // sent, false is returned and callbacks of joined callers get infinity.
+      bool estimateFee(unsigned int nbBlocks, const FeeCb &);
+
+      void setTtl(std::chrono::milliseconds);
+      // Drops cached estimates. Queries in flight are still shared by new requests,
+      // but their results are not cached.
+      void invalidate();
+
+      size_t queriesSent() const;
+
+      void onNewBlock(unsigned int height, unsigned int branchHeight) override;
+
+   private:
+      struct Estimate
+      {
+         float value;
+         std::chrono::steady_clock::time_point timestamp;
+      };
+
+      // Shared with Armory callbacks, so late replies don't touch destroyed object
+      struct State
+      {
+         mutable std::mutex   mutex;
+         std::chrono::milliseconds  ttl;
+         std::map<unsigned int, Estimate>             estimates;
+         std::map<unsigned int, std::vector<FeeCb>>   pending;
+         // Incremented on invalidation - replies for older queries are not cached
+         uint64_t generation{};
+         size_t   queriesSent{};
+      };
+
+      static void onEstimate(const std::shared_ptr<State> &, unsigned int nbBlocks
+         , uint64_t generation, float fee);
+
+   private:
+      std::shared_ptr<spdlog::logger>     logger_;
+      std::shared_ptr<ArmoryConnection>   armory_;
+      std::shared_ptr<State>  state_;
+   };
+
+}  // namespace bs
+
+#endif // FEE_ESTIMATE_CACHE_H
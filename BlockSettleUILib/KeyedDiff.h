@@ -0,0 +1,218 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __KEYED_DIFF_H__
+#define __KEYED_DIFF_H__
+
+#include <algorithm>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <QAbstractItemModel>
+
+namespace bs {
+   namespace ui {
+
+      struct KeyedDiffStats
+      {
+         int removed{};
+         int inserted{};
+         int moved{};
+         int changed{};
+         bool reset{};
+      };
+
+      namespace detail {
+
+         // Row change notifications are protected in QAbstractItemModel,
+         // member pointers taken through the derived class are callable
+         // on any model instance.
+         class ModelRowsAccess : public QAbstractItemModel
+         {
+         public:
+            using QAbstractItemModel::beginInsertRows;
+            using QAbstractItemModel::endInsertRows;
+            using QAbstractItemModel::beginRemoveRows;
+            using QAbstractItemModel::endRemoveRows;
+            using QAbstractItemModel::beginMoveRows;
+            using QAbstractItemModel::endMoveRows;
+            using QAbstractItemModel::beginResetModel;
+            using QAbstractItemModel::endResetModel;
+         };
+
+         // Returns values of the longest strictly increasing subsequence
+         inline std::vector<int> longestIncreasingSubsequence(const std::vector<int> &values)
+         {
+            std::vector<int> tails;       // indices in values
+            std::vector<int> prev(values.size(), -1);
+            for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+               const auto it = std::lower_bound(tails.begin(), tails.end(), values[i]
+                  , [&values](int idx, int value) { return values[idx] < value; });
+               if (it != tails.begin()) {
+                  prev[i] = *(it - 1);
+               }
+               if (it == tails.end()) {
+                  tails.push_back(i);
+               }
+               else {
+                  *it = i;
+               }
+            }
+            std::vector<int> result(tails.size());
+            for (int i = tails.empty() ? -1 : tails.back(), j = static_cast<int>(tails.size()) - 1
+               ; i >= 0; i = prev[i], --j) {
+               result[j] = values[i];
+            }
+            return result;
+         }
+
+      }  // namespace detail
+
+      // Brings rows of a flat model to newRows with granular notifications
+      // instead of model reset, so that views keep selection, scroll position
+      // and expanded editors. Rows are matched by keyOf() (keys should be
+      // unique in both lists, otherwise model is reset), rows not present in
+      // newRows are removed, rows kept in place are moved with minimal number
+      // of moves (all but the longest run already in the right order), new
+      // rows are inserted and kept rows for which isEqual() fails are
+      // reported with dataChanged(). rows must be the storage the model reads.
+      template <typename T, typename KeyFn, typename EqualFn>
+      KeyedDiffStats applyKeyedDiff(QAbstractItemModel *model, std::vector<T> &rows
+         , std::vector<T> newRows, const KeyFn &keyOf, const EqualFn &isEqual)
+      {
+         using Key = typename std::decay<decltype(keyOf(std::declval<const T &>()))>::type;
+         using Access = detail::ModelRowsAccess;
+         KeyedDiffStats stats;
+
+         std::map<Key, int> newPos;
+         bool uniqueKeys = true;
+         for (int i = 0; i < static_cast<int>(newRows.size()); ++i) {
+            uniqueKeys &= newPos.emplace(keyOf(newRows[i]), i).second;
+         }
+         std::vector<bool> isKept(newRows.size(), false);
+         std::vector<int> keptPos;    // for each row: its position in newRows or -1
+         keptPos.reserve(rows.size());
+         for (const auto &row : rows) {
+            const auto it = newPos.find(keyOf(row));
+            if (it == newPos.end()) {
+               keptPos.push_back(-1);
+               continue;
+            }
+            uniqueKeys &= !isKept[it->second];
+            isKept[it->second] = true;
+            keptPos.push_back(it->second);
+         }
+
+         if (!uniqueKeys) {
+            (model->*(&Access::beginResetModel))();
+            rows = std::move(newRows);
+            (model->*(&Access::endResetModel))();
+            stats.reset = true;
+            return stats;
+         }
+
+         // Removals, bottom-up by contiguous ranges
+         for (int last = static_cast<int>(rows.size()) - 1; last >= 0; --last) {
+            if (keptPos[last] >= 0) {
+               continue;
+            }
+            int first = last;
+            while ((first > 0) && (keptPos[first - 1] < 0)) {
+               --first;
+            }
+            (model->*(&Access::beginRemoveRows))(QModelIndex(), first, last);
+            rows.erase(rows.begin() + first, rows.begin() + last + 1);
+            keptPos.erase(keptPos.begin() + first, keptPos.begin() + last + 1);
+            (model->*(&Access::endRemoveRows))();
+            stats.removed += last - first + 1;
+            last = first;
+         }
+
+         // Moves: rows of the longest increasing run stay, every other row is
+         // moved right after its predecessor in newRows order
+         const auto lis = detail::longestIncreasingSubsequence(keptPos);
+         std::vector<bool> inPlace(newRows.size(), false);
+         for (const auto pos : lis) {
+            inPlace[pos] = true;
+         }
+         int prevKept = -1;
+         for (int pos = 0; pos < static_cast<int>(newRows.size()); ++pos) {
+            if (!isKept[pos]) {
+               continue;
+            }
+            if (!inPlace[pos]) {
+               const int from = static_cast<int>(std::find(keptPos.begin(), keptPos.end(), pos) - keptPos.begin());
+               const int dest = (prevKept < 0) ? 0
+                  : static_cast<int>(std::find(keptPos.begin(), keptPos.end(), prevKept) - keptPos.begin()) + 1;
+               if ((dest != from) && (model->*(&Access::beginMoveRows))(QModelIndex(), from, from, QModelIndex(), dest)) {
+                  if (dest > from) {
+                     std::rotate(rows.begin() + from, rows.begin() + from + 1, rows.begin() + dest);
+                     std::rotate(keptPos.begin() + from, keptPos.begin() + from + 1, keptPos.begin() + dest);
+                  }
+                  else {
+                     std::rotate(rows.begin() + dest, rows.begin() + from, rows.begin() + from + 1);
+                     std::rotate(keptPos.begin() + dest, keptPos.begin() + from, keptPos.begin() + from + 1);
+                  }
+                  (model->*(&Access::endMoveRows))();
+                  ++stats.moved;
+               }
+            }
+            prevKept = pos;
+         }
+
+         // Insertions by contiguous ranges - rows before each range are already in place
+         for (int first = 0; first < static_cast<int>(newRows.size()); ++first) {
+            if (isKept[first]) {
+               continue;
+            }
+            int last = first;
+            while ((last + 1 < static_cast<int>(newRows.size())) && !isKept[last + 1]) {
+               ++last;
+            }
+            (model->*(&Access::beginInsertRows))(QModelIndex(), first, last);
+            rows.insert(rows.begin() + first, std::make_move_iterator(newRows.begin() + first)
+               , std::make_move_iterator(newRows.begin() + last + 1));
+            (model->*(&Access::endInsertRows))();
+            stats.inserted += last - first + 1;
+            first = last;
+         }
+
+         // Data of kept rows
+         const int lastColumn = model->columnCount() - 1;
+         int changedFirst = -1;
+         const auto flushChanged = [model, lastColumn, &changedFirst](int last) {
+            if (changedFirst >= 0) {
+               emit model->dataChanged(model->index(changedFirst, 0), model->index(last, lastColumn));
+               changedFirst = -1;
+            }
+         };
+         for (int i = 0; i < static_cast<int>(newRows.size()); ++i) {
+            if (!isKept[i] || isEqual(rows[i], newRows[i])) {
+               if (isKept[i]) {
+                  rows[i] = std::move(newRows[i]);
+               }
+               flushChanged(i - 1);
+               continue;
+            }
+            rows[i] = std::move(newRows[i]);
+            ++stats.changed;
+            if (changedFirst < 0) {
+               changedFirst = i;
+            }
+         }
+         flushChanged(static_cast<int>(newRows.size()) - 1);
+         return stats;
+      }
+
+   }  // namespace ui
+}  // namespace bs
+
+#endif // __KEYED_DIFF_H__
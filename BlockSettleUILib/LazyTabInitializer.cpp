@@ -0,0 +1,58 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "LazyTabInitializer.h"
+
+#include <QTabWidget>
+
+LazyTabInitializer::LazyTabInitializer(QTabWidget *tabWidget, QObject *parent)
+   : QObject(parent)
+   , tabWidget_(tabWidget)
+{
+   connect(tabWidget_, &QTabWidget::currentChanged, this, &LazyTabInitializer::onCurrentChanged);
+}
+
+void LazyTabInitializer::add(QWidget *tab, const InitFunc &init)
+{
+   pending_[tab] = init;
+   if (tabWidget_->currentWidget() == tab) {
+      initTab(tab);
+   }
+}
+
+bool LazyTabInitializer::isInitialized(QWidget *tab) const
+{
+   return (initialized_.find(tab) != initialized_.end());
+}
+
+bool LazyTabInitializer::isPending(QWidget *tab) const
+{
+   return (pending_.find(tab) != pending_.end());
+}
+
+void LazyTabInitializer::onCurrentChanged(int index)
+{
+   initTab(tabWidget_->widget(index));
+}
+
+void LazyTabInitializer::initTab(QWidget *tab)
+{
+   const auto it = pending_.find(tab);
+   if (it == pending_.end()) {
+      return;
+   }
+   // remove before calling - init may switch tabs
+   const auto init = it->second;
+   pending_.erase(it);
+   initialized_.insert(tab);
+   if (init) {
+      init();
+   }
+}
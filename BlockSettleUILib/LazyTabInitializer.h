@@ -0,0 +1,51 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __LAZY_TAB_INITIALIZER_H__
+#define __LAZY_TAB_INITIALIZER_H__
+
+#include <functional>
+#include <map>
+#include <set>
+#include <QObject>
+
+class QTabWidget;
+class QWidget;
+
+// Runs tab initialization when the tab is shown for the first time, so that
+// tabs the user never opens cost nothing at startup.
+class LazyTabInitializer : public QObject
+{
+   Q_OBJECT
+public:
+   using InitFunc = std::function<void()>;
+
+   LazyTabInitializer(QTabWidget *tabWidget, QObject *parent = nullptr);
+   ~LazyTabInitializer() override = default;
+
+   // Runs init immediately if the tab is current already
+   void add(QWidget *tab, const InitFunc &);
+
+   bool isInitialized(QWidget *tab) const;
+   bool isPending(QWidget *tab) const;
+
+private slots:
+   void onCurrentChanged(int index);
+
+private:
+   void initTab(QWidget *tab);
+
+private:
+   QTabWidget  *tabWidget_;
+   std::map<QWidget *, InitFunc> pending_;
+   std::set<QWidget *>           initialized_;
+};
+
+#endif // __LAZY_TAB_INITIALIZER_H__
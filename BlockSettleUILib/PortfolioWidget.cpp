@@ -204,6 +204,10 @@ void PortfolioWidget::onCreateRBFDialog()
    }
 
    const auto &cbDialog = [this](const TransactionPtr &txItem) {
+      if (!txItem) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load TX");
+         return;
+      }
       try {
          auto dlg = CreateTransactionDialogAdvanced::CreateForRBF(armory_
             , walletsManager_, utxoReservationManager_, signContainer_, logger_, appSettings_, txItem->tx
@@ -216,12 +220,13 @@ void PortfolioWidget::onCreateRBFDialog()
       }
    };
 
-   if (txItem->initialized) {
-      cbDialog(txItem);
-   }
-   else {
-      TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_, cbDialog);
-   }
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_
+      , [this, cbDialog](const TransactionPtr &item) {
+      QMetaObject::invokeMethod(this, [cbDialog, item] {
+         cbDialog(item);
+      });
+   });
 }
 
 void PortfolioWidget::onCreateCPFPDialog()
@@ -233,6 +238,10 @@ void PortfolioWidget::onCreateCPFPDialog()
    }
 
    const auto &cbDialog = [this](const TransactionPtr &txItem) {
+      if (!txItem) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load TX");
+         return;
+      }
       try {
          std::shared_ptr<bs::sync::Wallet> wallet;
          for (const auto &w : txItem->wallets) {
@@ -252,12 +261,13 @@ void PortfolioWidget::onCreateCPFPDialog()
       }
    };
 
-   if (txItem->initialized) {
-      cbDialog(txItem);
-   }
-   else {
-      TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_, cbDialog);
-   }
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_
+      , [this, cbDialog](const TransactionPtr &item) {
+      QMetaObject::invokeMethod(this, [cbDialog, item] {
+         cbDialog(item);
+      });
+   });
 }
 
 
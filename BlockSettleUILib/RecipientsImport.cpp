@@ -0,0 +1,130 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "RecipientsImport.h"
+
+#include <QLocale>
+#include <QObject>
+#include <QRegularExpression>
+#include <tuple>
+#include "TransactionData.h"
+#include "TransactionOutputsModel.h"
+
+namespace {
+
+   bool parseAddress(const QString &str, bs::Address &addr)
+   {
+      try {
+         addr = bs::Address::fromAddressString(str.toStdString());
+      }
+      catch (...) {
+         return false;
+      }
+      // P2WSH unprefixed address can resemble TX hash, so hex format is not accepted
+      return (addr.isValid() && (addr.format() != bs::Address::Format::Hex));
+   }
+
+} // namespace
+
+std::vector<bs::ui::ImportedRecipient> bs::ui::parseRecipientsCsv(const QByteArray &data
+   , QStringList *errors)
+{
+   const QRegularExpression separators(QLatin1String("[,;\\t]"));
+   const auto locale = QLocale::c();
+   const auto lines = data.split('\n');
+
+   std::vector<ImportedRecipient> result;
+   result.reserve(lines.size());
+   bool firstLine = true;
+   for (int i = 0; i < lines.size(); ++i) {
+      const auto line = QString::fromUtf8(lines[i]).trimmed();
+      if (line.isEmpty() || line.startsWith(QLatin1Char('#'))) {
+         continue;
+      }
+      const bool isFirstLine = firstLine;
+      firstLine = false;
+      const auto reportError = [errors, i](const QString &error) {
+         if (errors) {
+            errors->append(QObject::tr("line %1: %2").arg(i + 1).arg(error));
+         }
+      };
+
+      const auto fields = line.split(separators);
+      if (fields.size() < 2) {
+         reportError(QObject::tr("address and amount expected"));
+         continue;
+      }
+
+      ImportedRecipient recipient;
+      const bool addrValid = parseAddress(fields[0].trimmed(), recipient.address);
+      bool amountValid = false;
+      recipient.amount = locale.toDouble(fields[1].trimmed(), &amountValid);
+      if (isFirstLine && !addrValid && !amountValid) {
+         continue;   // header
+      }
+      if (!addrValid) {
+         reportError(QObject::tr("invalid address %1").arg(fields[0].trimmed()));
+         continue;
+      }
+      if (!amountValid || (recipient.amount <= 0)) {
+         reportError(QObject::tr("invalid amount %1").arg(fields[1].trimmed()));
+         continue;
+      }
+      result.emplace_back(std::move(recipient));
+   }
+   return result;
+}
+
+
+bs::ui::TransactionDataBatch::TransactionDataBatch(const std::shared_ptr<TransactionData> &txData
+   , const std::function<void()> &cbChanged)
+   : txData_(txData)
+   , cbChanged_(cbChanged)
+{
+   txData_->SetCallback([] {});
+}
+
+bs::ui::TransactionDataBatch::~TransactionDataBatch()
+{
+   txData_->SetCallback(cbChanged_);
+   if (cbChanged_) {
+      cbChanged_();
+   }
+}
+
+
+std::vector<unsigned int> bs::ui::addRecipients(const std::shared_ptr<TransactionData> &txData
+   , TransactionOutputsModel *model, const std::vector<ImportedRecipient> &recipients
+   , const std::function<void()> &cbChanged)
+{
+   std::vector<unsigned int> result;
+   result.reserve(recipients.size());
+   std::vector<std::tuple<unsigned int, QString, double>> modelRecips;
+   if (model) {
+      modelRecips.reserve(recipients.size());
+   }
+   {
+      const TransactionDataBatch batch(txData, cbChanged);
+      for (const auto &recip : recipients) {
+         const auto recipientId = txData->RegisterNewRecipient();
+         txData->UpdateRecipientAddress(recipientId, recip.address);
+         txData->UpdateRecipientAmount(recipientId, recip.amount, false);
+         result.push_back(recipientId);
+         if (model) {
+            modelRecips.emplace_back(recipientId, QString::fromStdString(recip.address.display())
+               , recip.amount);
+         }
+      }
+   }
+   if (model) {
+      model->AddRecipients(modelRecips);
+   }
+   return result;
+}
@@ -0,0 +1,66 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __RECIPIENTS_IMPORT_H__
+#define __RECIPIENTS_IMPORT_H__
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QByteArray>
+#include <QStringList>
+#include "Address.h"
+
+class TransactionData;
+class TransactionOutputsModel;
+
+namespace bs {
+   namespace ui {
+
+      struct ImportedRecipient
+      {
+         bs::Address address;
+         double      amount;
+      };
+
+      // Parses "address,amount" lines (amount in XBT, ';' and tab separators
+      // are accepted too). Empty lines, lines starting with '#' and header line
+      // are skipped. Invalid lines are reported to errors (if set) and skipped.
+      std::vector<ImportedRecipient> parseRecipientsCsv(const QByteArray &, QStringList *errors = nullptr);
+
+      // TransactionData notifies about each change and the dialog recalculates
+      // whole transaction (inputs selection, fee, max amount) on each
+      // notification. Batch suppresses notifications in its scope and invokes
+      // callback once on destruction. Callback is also set back to TransactionData.
+      class TransactionDataBatch
+      {
+      public:
+         TransactionDataBatch(const std::shared_ptr<TransactionData> &
+            , const std::function<void()> &cbChanged);
+         ~TransactionDataBatch();
+
+         TransactionDataBatch(const TransactionDataBatch &) = delete;
+         TransactionDataBatch &operator=(const TransactionDataBatch &) = delete;
+
+      private:
+         std::shared_ptr<TransactionData> txData_;
+         std::function<void()>   cbChanged_;
+      };
+
+      // Registers all recipients in TransactionData as a single batch and adds
+      // them to the model (if set) with one rows insertion. Returns recipient ids.
+      std::vector<unsigned int> addRecipients(const std::shared_ptr<TransactionData> &
+         , TransactionOutputsModel *, const std::vector<ImportedRecipient> &
+         , const std::function<void()> &cbChanged);
+
+   }  // namespace ui
+}  // namespace bs
+
+#endif // __RECIPIENTS_IMPORT_H__
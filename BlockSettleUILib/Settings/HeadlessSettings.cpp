@@ -82,6 +82,12 @@ bool HeadlessSettings::loadSettings(int argc, char **argv)
          , cxxopts::value<double>(autoSignSpendLimit))
       ("g,guimode", "GUI run mode"
          , cxxopts::value<std::string>(guiMode)->default_value("fullgui"))
+#ifndef WIN32
+      ("ui_unix_socket", "Use Unix domain socket instead of ZMQ for signer UI connection"
+         , cxxopts::value<bool>(interfaceUnixSocket_))
+      ("terminal_unix_socket", "Unix domain socket path to serve local terminal instead of ZMQ"
+         , cxxopts::value<std::string>(terminalSocketPath_))
+#endif
       ;
 
    try {
@@ -57,6 +57,14 @@ public:
    int interfacePort() const { return interfacePort_; }
    void setInterfacePort(int port) { interfacePort_ = port; }
 
+   // UI connection uses Unix domain socket instead of ZMQ/BIP15X if set
+   bool interfaceUnixSocket() const { return interfaceUnixSocket_; }
+   std::string interfaceSocketPath() const { return interfaceSocketPath_; }
+   void setInterfaceSocketPath(const std::string &path) { interfaceSocketPath_ = path; }
+
+   // Terminal connection uses Unix domain socket at this path instead of ZMQ/BIP15X if set
+   std::string terminalSocketPath() const { return terminalSocketPath_; }
+
    void update(const Settings&);
 
    static bool loadSettings(Settings *settings, const std::string &fileName);
@@ -72,6 +80,9 @@ private:
    std::unique_ptr<Settings> d_;
    BinaryData  serverIdKey_;
    int interfacePort_{};
+   bool interfaceUnixSocket_{};
+   std::string interfaceSocketPath_;
+   std::string terminalSocketPath_;
 
    SettableField<bool> overrideTestNet_;
    SettableField<std::string> overrideListenAddress_;
@@ -196,6 +196,7 @@ bool SignerSettings::loadSettings(const std::shared_ptr<HeadlessSettings> &mainS
    runMode_ = static_cast<bs::signer::ui::RunMode>(mainSettings->runMode());
    srvIDKey_ = mainSettings->serverIdKey().toHexStr();
    signerPort_ = mainSettings->interfacePort();
+   signerSocketPath_ = mainSettings->interfaceSocketPath();
    d_->set_test_net(mainSettings->testNet());
 
    if (d_->test_net()) {
@@ -109,6 +109,7 @@ public:
    static int intervalStrToSeconds(const QString &);
 
    int signerPort() { return signerPort_; }
+   std::string signerSocketPath() const { return signerSocketPath_; }
 
 signals:
    void offlineChanged();
@@ -138,6 +139,7 @@ private:
    std::string fileName_;
    std::string srvIDKey_;
    int signerPort_{};
+   std::string signerSocketPath_;
    bs::signer::ui::RunMode runMode_{};
    std::unique_ptr<Settings> d_;
 
@@ -0,0 +1,189 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "StartupPipeline.h"
+
+#include <sstream>
+#include <spdlog/spdlog.h>
+
+namespace {
+   const size_t kInvalidIndex = static_cast<size_t>(-1);
+
+   std::chrono::milliseconds toMs(std::chrono::steady_clock::duration d)
+   {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(d);
+   }
+}
+
+StartupPipeline::StartupPipeline(const std::shared_ptr<spdlog::logger> &logger)
+   : logger_(logger)
+{}
+
+bool StartupPipeline::addStage(const std::string &name, const std::vector<std::string> &deps
+   , const Action &action)
+{
+   if (running_ || (indexOf(name) != kInvalidIndex)) {
+      SPDLOG_LOGGER_ERROR(logger_, "can't add startup stage {}", name);
+      return false;
+   }
+   Stage stage;
+   stage.name = name;
+   stage.action = action;
+   for (const auto &dep : deps) {
+      const auto depIdx = indexOf(dep);
+      if (depIdx == kInvalidIndex) {
+         SPDLOG_LOGGER_ERROR(logger_, "unknown dependency {} of startup stage {}", dep, name);
+         return false;
+      }
+      stage.deps.push_back(depIdx);
+   }
+   stages_.push_back(std::move(stage));
+   return true;
+}
+
+void StartupPipeline::start()
+{
+   if (running_) {
+      return;
+   }
+   running_ = true;
+   startTime_ = Clock::now();
+   startReadyStages();
+   checkFinished();
+}
+
+void StartupPipeline::stageCompleted(const std::string &name)
+{
+   const auto idx = indexOf(name);
+   if (idx == kInvalidIndex) {
+      return;
+   }
+   auto &stage = stages_[idx];
+   if (!stage.started || stage.completed) {
+      return;
+   }
+   stage.completed = true;
+   stage.endTime = Clock::now();
+   logger_->debug("[StartupPipeline] stage {} completed in {} ms", name
+      , toMs(stage.endTime - stage.startTime).count());
+   startReadyStages();
+   checkFinished();
+}
+
+bool StartupPipeline::isCompleted(const std::string &name) const
+{
+   const auto idx = indexOf(name);
+   return (idx != kInvalidIndex) && stages_[idx].completed;
+}
+
+bool StartupPipeline::isFinished() const
+{
+   return finished_;
+}
+
+std::vector<StartupPipeline::StageTiming> StartupPipeline::timings() const
+{
+   std::vector<StageTiming> result;
+   result.reserve(stages_.size());
+   const auto now = Clock::now();
+   for (const auto &stage : stages_) {
+      StageTiming timing;
+      timing.name = stage.name;
+      timing.started = stage.started;
+      timing.completed = stage.completed;
+      if (stage.started) {
+         timing.startedAt = toMs(stage.startTime - startTime_);
+         timing.duration = toMs((stage.completed ? stage.endTime : now) - stage.startTime);
+      }
+      result.push_back(timing);
+   }
+   return result;
+}
+
+std::chrono::milliseconds StartupPipeline::elapsed() const
+{
+   if (!running_) {
+      return {};
+   }
+   return toMs((finished_ ? endTime_ : Clock::now()) - startTime_);
+}
+
+std::string StartupPipeline::report() const
+{
+   std::ostringstream ss;
+   ss << "startup " << (finished_ ? "finished" : "in progress") << " in " << elapsed().count() << " ms:";
+   for (const auto &timing : timings()) {
+      ss << "\n   " << timing.name << ": ";
+      if (!timing.started) {
+         ss << "pending";
+         continue;
+      }
+      ss << "+" << timing.startedAt.count() << " ms, " << timing.duration.count() << " ms";
+      if (!timing.completed) {
+         ss << " (running)";
+      }
+   }
+   return ss.str();
+}
+
+size_t StartupPipeline::indexOf(const std::string &name) const
+{
+   for (size_t i = 0; i < stages_.size(); ++i) {
+      if (stages_[i].name == name) {
+         return i;
+      }
+   }
+   return kInvalidIndex;
+}
+
+void StartupPipeline::startReadyStages()
+{
+   // actions may complete stages synchronously and re-enter here,
+   // so every stage state is re-checked by index after each action
+   for (size_t i = 0; i < stages_.size(); ++i) {
+      if (stages_[i].started) {
+         continue;
+      }
+      bool depsCompleted = true;
+      for (const auto dep : stages_[i].deps) {
+         if (!stages_[dep].completed) {
+            depsCompleted = false;
+            break;
+         }
+      }
+      if (!depsCompleted) {
+         continue;
+      }
+      stages_[i].started = true;
+      stages_[i].startTime = Clock::now();
+      const auto action = stages_[i].action;
+      if (action) {
+         action();
+      }
+   }
+}
+
+void StartupPipeline::checkFinished()
+{
+   if (finished_) {
+      return;
+   }
+   for (const auto &stage : stages_) {
+      if (!stage.completed) {
+         return;
+      }
+   }
+   finished_ = true;
+   endTime_ = Clock::now();
+   logger_->info("[StartupPipeline] {}", report());
+   if (cbFinished_) {
+      cbFinished_();
+   }
+}
@@ -0,0 +1,95 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __STARTUP_PIPELINE_H__
+#define __STARTUP_PIPELINE_H__
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spdlog {
+   class logger;
+}
+
+// Dependency-driven startup sequence. Each stage is started as soon as all
+// stages it depends on are completed, so independent stages overlap.
+// Stage action only kicks off the work - completion is reported with
+// stageCompleted() (possibly from inside the action for synchronous stages).
+// Stage without action is an observed milestone: it starts when its
+// dependencies are done and completes when reported.
+// Not thread-safe: must be used from one (GUI) thread only.
+class StartupPipeline
+{
+public:
+   using Action = std::function<void()>;
+
+   struct StageTiming
+   {
+      std::string name;
+      std::chrono::milliseconds  startedAt{};   // since pipeline start
+      std::chrono::milliseconds  duration{};
+      bool  started = false;
+      bool  completed = false;
+   };
+
+   StartupPipeline(const std::shared_ptr<spdlog::logger> &);
+   ~StartupPipeline() noexcept = default;
+
+   StartupPipeline(const StartupPipeline&) = delete;
+   StartupPipeline& operator = (const StartupPipeline&) = delete;
+
+   // Returns false if stage already exists or depends on unknown stage
+   bool addStage(const std::string &name, const std::vector<std::string> &deps
+      , const Action &action = {});
+   void setFinishedCallback(const std::function<void()> &cb) { cbFinished_ = cb; }
+
+   void start();
+   // Ignored for unknown, not yet started or already completed stages
+   void stageCompleted(const std::string &name);
+
+   bool isCompleted(const std::string &name) const;
+   bool isFinished() const;
+
+   std::vector<StageTiming> timings() const;
+   std::chrono::milliseconds elapsed() const;
+   std::string report() const;
+
+private:
+   using Clock = std::chrono::steady_clock;
+
+   struct Stage
+   {
+      std::string name;
+      std::vector<size_t>  deps;
+      Action   action;
+      bool     started = false;
+      bool     completed = false;
+      Clock::time_point startTime;
+      Clock::time_point endTime;
+   };
+
+   size_t indexOf(const std::string &name) const;
+   void startReadyStages();
+   void checkFinished();
+
+private:
+   std::shared_ptr<spdlog::logger>  logger_;
+   std::vector<Stage>   stages_;
+   Clock::time_point    startTime_;
+   Clock::time_point    endTime_;
+   bool  running_ = false;
+   bool  finished_ = false;
+   std::function<void()>   cbFinished_;
+};
+
+#endif // __STARTUP_PIPELINE_H__
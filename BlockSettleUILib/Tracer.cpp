@@ -0,0 +1,289 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "Tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#ifdef WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace bs::trace;
+
+std::atomic_bool bs::trace::detail::enabled{ false };
+
+namespace {
+
+   const char *kTraceFileEnv = "BS_TRACE_FILE";
+
+   // Terminal and signer processes share environment, so PID is added to file name
+   std::string tracePath()
+   {
+      const char *env = std::getenv(kTraceFileEnv);
+      if (!env || !*env) {
+         return {};
+      }
+      std::string path(env);
+      const auto pid = std::to_string(getpid());
+      const auto dotPos = path.find_last_of('.');
+      const auto sepPos = path.find_last_of("/\\");
+      if ((dotPos == std::string::npos) || ((sepPos != std::string::npos) && (dotPos < sepPos))) {
+         return path + "." + pid;
+      }
+      return path.substr(0, dotPos) + "." + pid + path.substr(dotPos);
+   }
+
+   struct Event
+   {
+      std::atomic_bool  ready{ false };
+      char        phase;
+      const char  *category;
+      const char  *name;
+      const char  *argName;
+      int64_t     argValue;
+      uint32_t    tid;
+      uint64_t    ts;
+      uint64_t    dur;
+      uint64_t    id;
+   };
+
+   struct Buffer
+   {
+      explicit Buffer(size_t capacity)
+         : events(new Event[capacity]), capacity(capacity) {}
+
+      std::unique_ptr<Event[]>   events;
+      const size_t         capacity;
+      std::atomic<size_t>  next{ 0 };
+      std::atomic<size_t>  dropped{ 0 };
+   };
+
+   // Buffer is published with release/acquire, so writers which loaded it
+   // see it fully constructed. Replaced buffers are kept until exit as other
+   // threads may still be recording into them.
+   std::atomic<Buffer *>   gBuffer{ nullptr };
+   std::mutex  gBuffersMutex;
+   std::vector<std::unique_ptr<Buffer>>   gBuffers;
+
+   const auto gEpoch = std::chrono::steady_clock::now();
+
+   uint32_t currentThreadId()
+   {
+      static std::atomic<uint32_t> nextId{ 1 };
+      thread_local const uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+      return id;
+   }
+
+   Event *claim()
+   {
+      const auto buffer = gBuffer.load(std::memory_order_acquire);
+      if (!buffer) {
+         return nullptr;
+      }
+      const auto idx = buffer->next.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= buffer->capacity) {
+         buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+         return nullptr;
+      }
+      return &buffer->events[idx];
+   }
+
+   void record(char phase, const char *category, const char *name, uint64_t ts
+      , uint64_t dur = 0, uint64_t id = 0, const char *argName = nullptr, int64_t argValue = 0)
+   {
+      if (!isEnabled()) {
+         return;
+      }
+      auto evt = claim();
+      if (!evt) {
+         return;
+      }
+      evt->phase = phase;
+      evt->category = category;
+      evt->name = name;
+      evt->argName = argName;
+      evt->argValue = argValue;
+      evt->tid = currentThreadId();
+      evt->ts = ts;
+      evt->dur = dur;
+      evt->id = id;
+      evt->ready.store(true, std::memory_order_release);
+   }
+
+   void writeEscaped(std::ostream &out, const char *str)
+   {
+      for (const char *p = str; *p; ++p) {
+         switch (*p) {
+         case '"':   out << "\\\"";  break;
+         case '\\':  out << "\\\\";  break;
+         default:
+            if (static_cast<unsigned char>(*p) >= 0x20) {
+               out << *p;
+            }
+            break;
+         }
+      }
+   }
+
+   void writeJson(std::ostream &out)
+   {
+      const auto pid = getpid();
+      const auto buffer = gBuffer.load(std::memory_order_acquire);
+      const auto count = buffer ? std::min(buffer->next.load(std::memory_order_acquire)
+         , buffer->capacity) : 0;
+      out << "{\"traceEvents\":[";
+      bool first = true;
+      for (size_t i = 0; i < count; ++i) {
+         const auto &evt = buffer->events[i];
+         if (!evt.ready.load(std::memory_order_acquire)) {
+            continue;   // still being written
+         }
+         if (!first) {
+            out << ",\n";
+         }
+         first = false;
+         out << "{\"ph\":\"" << evt.phase << "\",\"cat\":\"";
+         writeEscaped(out, evt.category);
+         out << "\",\"name\":\"";
+         writeEscaped(out, evt.name);
+         out << "\",\"pid\":" << pid << ",\"tid\":" << evt.tid << ",\"ts\":" << evt.ts;
+         if (evt.phase == 'X') {
+            out << ",\"dur\":" << evt.dur;
+         }
+         else if ((evt.phase == 'b') || (evt.phase == 'e')) {
+            out << ",\"id\":\"0x" << std::hex << evt.id << std::dec << "\"";
+         }
+         else if (evt.phase == 'i') {
+            out << ",\"s\":\"t\"";
+         }
+         if (evt.argName) {
+            out << ",\"args\":{\"";
+            writeEscaped(out, evt.argName);
+            out << "\":" << evt.argValue << "}";
+         }
+         out << "}";
+      }
+      out << "],\"displayTimeUnit\":\"ms\"}\n";
+   }
+
+}  // namespace
+
+
+void bs::trace::enable(size_t capacity)
+{
+   std::lock_guard<std::mutex> lock(gBuffersMutex);
+   gBuffers.emplace_back(new Buffer(capacity));
+   gBuffer.store(gBuffers.back().get(), std::memory_order_release);
+   detail::enabled.store(true);
+}
+
+void bs::trace::disable()
+{
+   detail::enabled.store(false);
+}
+
+void bs::trace::initFromEnv(const std::shared_ptr<spdlog::logger> &logger)
+{
+   const auto path = tracePath();
+   if (path.empty()) {
+      return;
+   }
+   enable();
+   logger->info("[bs::trace] tracing enabled, trace will be written to {}", path);
+}
+
+bool bs::trace::dump(const std::shared_ptr<spdlog::logger> &logger)
+{
+   const auto path = tracePath();
+   if (path.empty() || !gBuffer.load(std::memory_order_acquire)) {
+      return false;
+   }
+   if (!writeChromeTrace(path)) {
+      logger->error("[bs::trace] failed to write trace to {}", path);
+      return false;
+   }
+   logger->info("[bs::trace] {} events written to {} ({} dropped)", eventsCount(), path
+      , droppedCount());
+   return true;
+}
+
+uint64_t bs::trace::nowUs()
+{
+   return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - gEpoch).count());
+}
+
+uint64_t bs::trace::idFromString(const std::string &str)
+{
+   return static_cast<uint64_t>(std::hash<std::string>{}(str));
+}
+
+void bs::trace::complete(const char *category, const char *name, uint64_t startUs
+   , const char *argName, int64_t argValue)
+{
+   const auto now = nowUs();
+   record('X', category, name, startUs, now - startUs, 0, argName, argValue);
+}
+
+void bs::trace::instant(const char *category, const char *name)
+{
+   record('i', category, name, nowUs());
+}
+
+void bs::trace::asyncBegin(const char *category, const char *name, uint64_t id)
+{
+   record('b', category, name, nowUs(), 0, id);
+}
+
+void bs::trace::asyncEnd(const char *category, const char *name, uint64_t id)
+{
+   record('e', category, name, nowUs(), 0, id);
+}
+
+size_t bs::trace::eventsCount()
+{
+   const auto buffer = gBuffer.load(std::memory_order_acquire);
+   return buffer ? std::min(buffer->next.load(), buffer->capacity) : 0;
+}
+
+size_t bs::trace::droppedCount()
+{
+   const auto buffer = gBuffer.load(std::memory_order_acquire);
+   return buffer ? buffer->dropped.load() : 0;
+}
+
+std::string bs::trace::chromeTraceJson()
+{
+   std::ostringstream ss;
+   writeJson(ss);
+   return ss.str();
+}
+
+bool bs::trace::writeChromeTrace(const std::string &path)
+{
+   std::ofstream out(path, std::ios::trunc);
+   if (!out) {
+      return false;
+   }
+   writeJson(out);
+   return static_cast<bool>(out);
+}
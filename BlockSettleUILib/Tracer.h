@@ -0,0 +1,111 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __BS_TRACER_H__
+#define __BS_TRACER_H__
+
+// Lightweight in-process span recorder exported in Chrome trace JSON format
+// (loadable in chrome://tracing or ui.perfetto.dev).
+// Events are stored in a preallocated buffer: writers only do an atomic
+// increment to claim a slot, so recording never blocks or allocates.
+// When buffer is full new events are dropped (and counted).
+// Category, name and arg name must be string literals (pointers are stored).
+// When tracing is disabled a span costs a single relaxed atomic load.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace spdlog {
+   class logger;
+}
+
+namespace bs {
+   namespace trace {
+
+      namespace detail {
+         extern std::atomic_bool enabled;
+      }
+
+      inline bool isEnabled()
+      {
+         return detail::enabled.load(std::memory_order_relaxed);
+      }
+
+      // Starts recording into a newly allocated buffer. Safe to call while
+      // other threads are recording - they finish into the previous buffer.
+      void enable(size_t capacity = 256 * 1024);
+      void disable();
+
+      // Enables tracing if BS_TRACE_FILE environment variable is set
+      void initFromEnv(const std::shared_ptr<spdlog::logger> &);
+      // Writes collected events to BS_TRACE_FILE (with process ID added to
+      // file name), does nothing if tracing was not initialized from env
+      bool dump(const std::shared_ptr<spdlog::logger> &);
+
+      uint64_t nowUs();
+      uint64_t idFromString(const std::string &);
+
+      void complete(const char *category, const char *name, uint64_t startUs
+         , const char *argName = nullptr, int64_t argValue = 0);
+      void instant(const char *category, const char *name);
+      // Async spans may begin and end on different threads, id links them
+      void asyncBegin(const char *category, const char *name, uint64_t id);
+      void asyncEnd(const char *category, const char *name, uint64_t id);
+
+      size_t eventsCount();
+      size_t droppedCount();
+
+      std::string chromeTraceJson();
+      bool writeChromeTrace(const std::string &path);
+
+
+      class Span
+      {
+      public:
+         Span(const char *category, const char *name
+            , const char *argName = nullptr, int64_t argValue = 0)
+         {
+            if (isEnabled()) {
+               category_ = category;
+               name_ = name;
+               argName_ = argName;
+               argValue_ = argValue;
+               startUs_ = nowUs();
+            }
+         }
+
+         ~Span()
+         {
+            if (category_) {
+               complete(category_, name_, startUs_, argName_, argValue_);
+            }
+         }
+
+         Span(const Span&) = delete;
+         Span& operator = (const Span&) = delete;
+
+      private:
+         const char *category_ = nullptr;
+         const char *name_ = nullptr;
+         const char *argName_ = nullptr;
+         int64_t  argValue_ = 0;
+         uint64_t startUs_ = 0;
+      };
+
+   }  // namespace trace
+}  // namespace bs
+
+#define BS_TRACE_CONCAT_IMPL(a, b) a##b
+#define BS_TRACE_CONCAT(a, b) BS_TRACE_CONCAT_IMPL(a, b)
+#define BS_TRACE_SPAN(...) bs::trace::Span BS_TRACE_CONCAT(bsTraceSpan_, __LINE__)(__VA_ARGS__)
+
+#endif // __BS_TRACER_H__
@@ -16,6 +16,7 @@
 #include "CheckRecipSigner.h"
 #include "SignContainer.h"
 #include "SignerDefs.h"
+#include "Tracer.h"
 #include "UiUtils.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWallet.h"
@@ -105,6 +106,7 @@ bs::sync::PasswordDialogData DealerCCSettlementContainer::toPasswordDialogData(Q
 
 bool DealerCCSettlementContainer::startSigning(QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "DealerCCSettlementContainer::startSigning");
    if (!ccWallet_ || !xbtWallet_) {
       logger_->error("[DealerCCSettlementContainer::accept] failed to validate counterparty's TX - aborting");
       sendFailed();
@@ -158,6 +160,7 @@ bool DealerCCSettlementContainer::startSigning(QDateTime timestamp)
 
 void DealerCCSettlementContainer::activate()
 {
+   BS_TRACE_SPAN("settlement", "DealerCCSettlementContainer::activate");
    try {
       signer_.deserializeState(txReqData_);
       foundRecipAddr_ = signer_.findRecipAddress(ownRecvAddr_, [this](uint64_t value, uint64_t valReturn, uint64_t valInput) {
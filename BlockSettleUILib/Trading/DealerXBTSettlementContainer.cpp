@@ -15,6 +15,7 @@
 #include "CurrencyPair.h"
 #include "QuoteProvider.h"
 #include "TradesUtils.h"
+#include "Tracer.h"
 #include "UiUtils.h"
 #include "UtxoReservationManager.h"
 #include "WalletSignerContainer.h"
@@ -158,6 +159,7 @@ bs::sync::PasswordDialogData DealerXBTSettlementContainer::toPasswordDialogData(
 
 void DealerXBTSettlementContainer::activate()
 {
+   BS_TRACE_SPAN("settlement", "DealerXBTSettlementContainer::activate");
    startTimer(kWaitTimeoutInSec);
 
    addrVerificator_ = std::make_shared<AddressVerificator>(logger_, armory_
@@ -202,6 +204,7 @@ void DealerXBTSettlementContainer::deactivate()
 void DealerXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
    , bs::error::ErrorCode errCode, std::string errMsg)
 {
+   BS_TRACE_SPAN("settlement", "DealerXBTSettlementContainer::onTXSigned");
    if (payoutSignId_ && (payoutSignId_ == id)) {
       payoutSignId_ = 0;
 
@@ -276,6 +279,7 @@ void DealerXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signed
 
 void DealerXBTSettlementContainer::onUnsignedPayinRequested(const std::string& settlementId)
 {
+   BS_TRACE_SPAN("settlement", "DealerXBTSettlementContainer::onUnsignedPayinRequested");
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
@@ -330,6 +334,7 @@ void DealerXBTSettlementContainer::onUnsignedPayinRequested(const std::string& s
 void DealerXBTSettlementContainer::onSignedPayoutRequested(const std::string& settlementId
    , const BinaryData& payinHash, QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "DealerXBTSettlementContainer::onSignedPayoutRequested");
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
@@ -385,6 +390,7 @@ void DealerXBTSettlementContainer::onSignedPayoutRequested(const std::string& se
 void DealerXBTSettlementContainer::onSignedPayinRequested(const std::string& settlementId
    , const BinaryData& unsignedPayin, QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "DealerXBTSettlementContainer::onSignedPayinRequested");
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
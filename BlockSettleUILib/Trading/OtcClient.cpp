@@ -10,6 +10,8 @@
 */
 #include "OtcClient.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QFile>
 #include <QTimer>
@@ -294,6 +296,7 @@ bool OtcClient::sendQuoteRequest(const QuoteRequest &request)
    ownRequest_->request.timestamp = QDateTime::currentDateTime();
    ownRequest_->isOwnRequest = true;
    scheduleCloseAfterTimeout(otc::publicRequestTimeout(), ownRequest_.get());
+   addPublicRequest(ownRequest_.get());
 
    Otc::PublicMessage msg;
    auto d = msg.mutable_request();
@@ -410,6 +413,7 @@ bool OtcClient::pullOrReject(Peer *peer)
       assert(peer == ownRequest_.get());
 
       SPDLOG_LOGGER_DEBUG(logger_, "pull own quote request");
+      removePublicRequest(ownRequest_.get());
       ownRequest_.reset();
 
       // This will remove everything when we pull public request.
@@ -442,6 +446,7 @@ bool OtcClient::pullOrReject(Peer *peer)
                // Keep public request even if we reject it
                resetPeerStateToIdle(peer);
                // Need to call this as peer would be removed from "sent requests" list
+               emit publicRequestUpdated(peer);
                updatePublicLists();
                break;
             case PeerType::Response:
@@ -464,6 +469,7 @@ bool OtcClient::pullOrReject(Peer *peer)
 
          switch (peer->type) {
          case PeerType::Request:
+            removePublicRequest(peer);
             requestMap_.erase(peer->contactId);
             updatePublicLists();
             break;
@@ -1165,7 +1171,12 @@ void OtcClient::processPublicRequest(QDateTime timestamp, const std::string &con
       return;
    }
 
-   requestMap_.erase(contactId);
+   // position in requests_ must be found before old peer is destroyed
+   const auto oldPeer = request(contactId);
+   const auto oldIndex = oldPeer ? publicRequestIndex(oldPeer) : requests_.size();
+   if (oldPeer) {
+      requestMap_.erase(contactId);
+   }
    auto result = requestMap_.emplace(contactId, Peer(contactId, PeerType::Request));
    auto peer = &result.first->second;
 
@@ -1173,11 +1184,23 @@ void OtcClient::processPublicRequest(QDateTime timestamp, const std::string &con
    peer->request.rangeType = range;
    peer->request.timestamp = timestamp;
 
+   if (oldIndex < requests_.size()) {
+      replacePublicRequest(oldIndex, peer);
+   }
+   else {
+      addPublicRequest(peer);
+   }
+
    updatePublicLists();
 }
 
 void OtcClient::processPublicClose(QDateTime timestamp, const std::string &contactId, const PublicMessage_Close &msg)
 {
+   const auto peer = request(contactId);
+   if (!peer) {
+      return;
+   }
+   removePublicRequest(peer);
    requestMap_.erase(contactId);
 
    updatePublicLists();
@@ -1368,6 +1391,7 @@ void OtcClient::processPbUpdateOtcState(const ProxyTerminalPb::Response_UpdateOt
             resetPeerStateToIdle(peer);
             break;
          case PeerType::Request:
+            removePublicRequest(peer);
             requestMap_.erase(peer->contactId);
             updatePublicLists();
             break;
@@ -1750,15 +1774,6 @@ void OtcClient::updatePublicLists()
       contacts_.push_back(&item.second);
    }
 
-   requests_.clear();
-   requests_.reserve(requestMap_.size() + (ownRequest_ ? 1 : 0));
-   if (ownRequest_) {
-      requests_.push_back(ownRequest_.get());
-   }
-   for (auto &item : requestMap_) {
-      requests_.push_back(&item.second);
-   }
-
    responses_.clear();
    responses_.reserve(responseMap_.size());
    for (auto &item : responseMap_) {
@@ -1768,6 +1783,37 @@ void OtcClient::updatePublicLists()
    emit publicUpdated();
 }
 
+void OtcClient::addPublicRequest(Peer *peer)
+{
+   if (peer->isOwnRequest) {
+      requests_.insert(requests_.begin(), peer);
+   }
+   else {
+      requests_.push_back(peer);
+   }
+   emit publicRequestAdded(peer);
+}
+
+size_t OtcClient::publicRequestIndex(const Peer *peer) const
+{
+   return static_cast<size_t>(std::find(requests_.begin(), requests_.end(), peer) - requests_.begin());
+}
+
+void OtcClient::replacePublicRequest(size_t index, Peer *newPeer)
+{
+   requests_[index] = newPeer;
+   emit publicRequestUpdated(newPeer);
+}
+
+void OtcClient::removePublicRequest(const Peer *peer)
+{
+   auto it = std::find(requests_.begin(), requests_.end(), peer);
+   if (it != requests_.end()) {
+      requests_.erase(it);
+   }
+   emit publicRequestRemoved(peer->contactId);
+}
+
 void OtcClient::initTradesArgs(bs::tradeutils::Args &args, Peer *peer, const std::string &settlementId)
 {
    args.amount = bs::XBTAmount(static_cast<uint64_t>(peer->offer.amount));
@@ -140,6 +140,12 @@ signals:
 
    void publicUpdated();
 
+   // Row-level changes of requests() list, keyed by contact id (own request uses own contact id).
+   // Emitted before publicUpdated.
+   void publicRequestAdded(const bs::network::otc::Peer *peer);
+   void publicRequestUpdated(const bs::network::otc::Peer *peer);
+   void publicRequestRemoved(const std::string &contactId);
+
 private slots:
    void onTxSigned(unsigned reqId, BinaryData signedTX, bs::error::ErrorCode result, const std::string &errorReason);
 
@@ -189,6 +195,10 @@ private:
    void setComments(OtcClientDeal *deal);
 
    void updatePublicLists();
+   void addPublicRequest(bs::network::otc::Peer *peer);
+   size_t publicRequestIndex(const bs::network::otc::Peer *peer) const;   // requests_.size() if not found
+   void replacePublicRequest(size_t index, bs::network::otc::Peer *newPeer);
+   void removePublicRequest(const bs::network::otc::Peer *peer);
 
    void initTradesArgs(bs::tradeutils::Args &args, bs::network::otc::Peer *peer, const std::string &settlementId);
 
@@ -219,7 +229,8 @@ private:
    std::unordered_map<std::string, bs::network::otc::Peer> requestMap_;
    std::unordered_map<std::string, bs::network::otc::Peer> responseMap_;
 
-   // Cached pointer lists from the above
+   // Cached pointer lists from the above.
+   // requests_ is maintained incrementally (own request is always first), others are rebuilt by updatePublicLists.
    bs::network::otc::Peers contacts_;
    bs::network::otc::Peers requests_;
    bs::network::otc::Peers responses_;
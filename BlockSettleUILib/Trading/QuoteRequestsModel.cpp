@@ -20,6 +20,7 @@
 #include "DealerCCSettlementContainer.h"
 #include "QuoteRequestsWidget.h"
 #include "SettlementContainer.h"
+#include "Tracer.h"
 #include "UiUtils.h"
 
 #include <chrono>
@@ -589,6 +590,7 @@ void QuoteRequestsModel::SetAssetManager(const std::shared_ptr<AssetManager>& as
 }
 
 void QuoteRequestsModel::ticker() {
+   BS_TRACE_SPAN("rfq", "QuoteRequestsModel::ticker");
    std::unordered_set<std::string>  deletedRows;
    const auto timeNow = QDateTime::currentDateTime();
 
@@ -648,7 +650,9 @@ void QuoteRequestsModel::ticker() {
    }
 
    for (auto delRow : deletedRows) {
-      notifications_.erase(delRow);
+      if (notifications_.erase(delRow)) {
+         bs::trace::asyncEnd("rfq", "rfq", bs::trace::idFromString(delRow));
+      }
    }
 
    for (const auto &settlContainer : settlContainers_) {
@@ -781,6 +785,7 @@ void QuoteRequestsModel::onBestQuotePrice(const QString reqId, double price, boo
 
 void QuoteRequestsModel::onQuoteReqNotifReplied(const bs::network::QuoteNotification &qn)
 {
+   BS_TRACE_SPAN("rfq", "QuoteRequestsModel::onQuoteReqNotifReplied");
    int row = -1;
    Group *g = nullptr;
    bool withdrawn = false;
@@ -834,6 +839,7 @@ QBrush QuoteRequestsModel::colorForQuotedPrice(double quotedPrice, double bestQP
 
 void QuoteRequestsModel::onQuoteReqNotifReceived(const bs::network::QuoteReqNotification &qrn)
 {
+   BS_TRACE_SPAN("rfq", "QuoteRequestsModel::onQuoteReqNotifReceived");
    QString marketName = tr(bs::network::Asset::toString(qrn.assetType));
    auto *market = findMarket(marketName);
 
@@ -906,6 +912,7 @@ void QuoteRequestsModel::insertRfq(Group *group, const bs::network::QuoteReqNoti
       endInsertRows();
 
       notifications_[qrn.quoteRequestId] = qrn;
+      bs::trace::asyncBegin("rfq", "rfq", bs::trace::idFromString(qrn.quoteRequestId));
 
       if (group->limit_ > 0 && group->limit_ > group->visibleCount_) {
          group->rfqs_.back()->visible_ = true;
@@ -936,8 +943,10 @@ bool QuoteRequestsModel::StartCCSignOnOrder(const QString& orderId, QDateTime ti
 
 void QuoteRequestsModel::addSettlementContainer(const std::shared_ptr<bs::SettlementContainer> &container)
 {
+   BS_TRACE_SPAN("settlement", "QuoteRequestsModel::addSettlementContainer");
    const auto &id = container->id();
    settlContainers_[id] = container;
+   bs::trace::asyncBegin("settlement", "settlement", bs::trace::idFromString(id));
 
    // Use queued connections to not destroy SettlementContainer inside callbacks
    connect(container.get(), &bs::SettlementContainer::failed, this, [this, id] {
@@ -1019,6 +1028,7 @@ void QuoteRequestsModel::onDeferredUpdate(const QPersistentModelIndex &index)
 
 void QuoteRequestsModel::onPriceUpdateTimer()
 {
+   BS_TRACE_SPAN("rfq", "QuoteRequestsModel::onPriceUpdateTimer");
    std::vector<std::pair<QModelIndex, QModelIndex>> idxs;
 
    for (auto it = prices_.cbegin(), last = prices_.cend(); it != last; ++it) {
@@ -1083,6 +1093,7 @@ void QuoteRequestsModel::deleteSettlement(const std::string &id)
       pendingDeleteIds_.insert(id);
       it->second->deactivate();
       settlContainers_.erase(it);
+      bs::trace::asyncEnd("settlement", "settlement", bs::trace::idFromString(id));
    }
 }
 
@@ -1355,6 +1366,7 @@ void QuoteRequestsModel::clearVisibleFlag(Group *g)
 
 void QuoteRequestsModel::onSecurityMDUpdated(const QString &security, const bs::network::MDFields &mdFields)
 {
+   BS_TRACE_SPAN("rfq", "QuoteRequestsModel::onSecurityMDUpdated");
    const auto pxBid = bs::network::MDField::get(mdFields, bs::network::MDField::PriceBid);
    const auto pxOffer = bs::network::MDField::get(mdFields, bs::network::MDField::PriceOffer);
    if (pxBid.type != bs::network::MDField::Unknown) {
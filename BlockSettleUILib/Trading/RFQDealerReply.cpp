@@ -22,6 +22,7 @@
 #include "ApplicationSettings.h"
 #include "AssetManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "AutoSignQuoteProvider.h"
 #include "BSErrorCodeStrings.h"
 #include "BSMessageBox.h"
@@ -150,11 +151,19 @@ void RFQDealerReply::setWalletsManager(const std::shared_ptr<bs::sync::WalletsMa
    }
 
    auto updateAuthAddresses = [this] {
-      UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, authAddressManager_);
+      UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, authAddressManager_, authAddrCache_);
       onAuthAddrChanged(ui_->authenticationAddressComboBox->currentIndex());
    };
    updateAuthAddresses();
    connect(authAddressManager_.get(), &AuthAddressManager::VerifiedAddressListUpdated, this, updateAuthAddresses);
+   if (authAddrCache_) {
+      connect(authAddrCache_.get(), &AuthAddressVerificationCache::updated, this, updateAuthAddresses);
+   }
+}
+
+void RFQDealerReply::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   authAddrCache_ = cache;
 }
 
 CustomDoubleSpinBox* RFQDealerReply::bidSpinBox() const
@@ -398,7 +407,9 @@ void RFQDealerReply::priceChanged()
 
 void RFQDealerReply::onAuthAddrChanged(int index)
 {
-   authAddr_ = authAddressManager_->GetAddress(authAddressManager_->FromVerifiedIndex(index));
+   // combo box may list cached addresses not yet in manager's verified list
+   authAddr_ = (index >= 0) ? bs::Address::fromAddressString(
+      ui_->authenticationAddressComboBox->itemText(index).toStdString()) : bs::Address{};
    authKey_.clear();
 
    if (authAddr_.empty()) {
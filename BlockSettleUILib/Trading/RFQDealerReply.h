@@ -46,6 +46,7 @@ class ApplicationSettings;
 class ArmoryConnection;
 class AssetManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class AutoSignQuoteProvider;
 class QuoteProvider;
 class SelectedTransactionInputs;
@@ -99,6 +100,7 @@ namespace bs {
             , const std::shared_ptr<bs::UTXOReservationManager>& utxoReservationManager);
 
          void setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &);
+         void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
 
          CustomDoubleSpinBox* bidSpinBox() const;
          CustomDoubleSpinBox* offerSpinBox() const;
@@ -153,6 +155,7 @@ namespace bs {
          std::shared_ptr<spdlog::logger>        logger_;
          std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
          std::shared_ptr<AuthAddressManager>    authAddressManager_;
+         std::shared_ptr<AuthAddressVerificationCache>   authAddrCache_;
          std::shared_ptr<AssetManager>          assetManager_;
          std::shared_ptr<QuoteProvider>         quoteProvider_;
          std::shared_ptr<ApplicationSettings>   appSettings_;
@@ -13,6 +13,7 @@
 
 #include "AssetManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "BSMessageBox.h"
 #include "CelerClient.h"
 #include "CelerSubmitQuoteNotifSequence.h"
@@ -65,6 +66,12 @@ RFQReplyWidget::RFQReplyWidget(QWidget* parent)
 
 RFQReplyWidget::~RFQReplyWidget() = default;
 
+void RFQReplyWidget::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   ui_->pageRFQReply->setAuthAddressCache(cache);
+   ui_->shieldPage->setAuthAddressCache(cache);
+}
+
 void RFQReplyWidget::setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &walletsManager)
 {
    if (!walletsManager_ && walletsManager) {
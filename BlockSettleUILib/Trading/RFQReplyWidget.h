@@ -45,6 +45,7 @@ class ApplicationSettings;
 class ArmoryConnection;
 class AssetManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class BaseCelerClient;
 class ConnectionManager;
 class DialogManager;
@@ -91,6 +92,7 @@ public:
       , OrderListModel *orderListModel);
 
    void setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &);
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
 
    void shortcutActivated(ShortcutType s) override;
 
@@ -15,6 +15,7 @@
 
 #include "ApplicationSettings.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "CelerClient.h"
 #include "CurrencyPair.h"
 #include "DialogManager.h"
@@ -63,6 +64,15 @@ RFQRequestWidget::RFQRequestWidget(QWidget* parent)
 
 RFQRequestWidget::~RFQRequestWidget() = default;
 
+void RFQRequestWidget::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   ui_->pageRFQTicket->setAuthAddressCache(cache);
+   ui_->shieldPage->setAuthAddressCache(cache);
+   if (cache) {
+      connect(cache.get(), &AuthAddressVerificationCache::updated, this, &RFQRequestWidget::forceCheckCondition);
+   }
+}
+
 void RFQRequestWidget::setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &walletsManager)
 {
    if (walletsManager_ == nullptr) {
@@ -45,6 +45,7 @@ class ApplicationSettings;
 class ArmoryConnection;
 class AssetManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class BaseCelerClient;
 class ConnectionManager;
 class DialogManager;
@@ -80,6 +81,8 @@ public:
          , OrderListModel *orderListModel);
 
    void setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &);
+   // Must be set before init
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
 
    void shortcutActivated(ShortcutType s) override;
 
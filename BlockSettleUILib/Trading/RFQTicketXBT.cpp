@@ -18,6 +18,7 @@
 
 #include "AssetManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "BSErrorCodeStrings.h"
 #include "BSMessageBox.h"
 #include "CCAmountValidator.h"
@@ -272,11 +273,14 @@ void RFQTicketXBT::setWalletsManager(const std::shared_ptr<bs::sync::WalletsMana
    walletsLoaded();
 
    auto updateAuthAddresses = [this] {
-      UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, authAddressManager_);
+      UiUtils::fillAuthAddressesComboBox(ui_->authenticationAddressComboBox, authAddressManager_, authAddrCache_);
       onAuthAddrChanged(ui_->authenticationAddressComboBox->currentIndex());
    };
    updateAuthAddresses();
    connect(authAddressManager_.get(), &AuthAddressManager::VerifiedAddressListUpdated, this, updateAuthAddresses);
+   if (authAddrCache_) {
+      connect(authAddrCache_.get(), &AuthAddressVerificationCache::updated, this, updateAuthAddresses);
+   }
 
    connect(walletsManager_.get(), &bs::sync::WalletsManager::walletBalanceUpdated, this, [this] {
       // This will update balance after receiving ZC
@@ -489,9 +493,16 @@ bs::network::Side::Type RFQTicketXBT::getSelectedSide() const
    return bs::network::Side::Buy;
 }
 
+void RFQTicketXBT::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   authAddrCache_ = cache;
+}
+
 void RFQTicketXBT::onAuthAddrChanged(int index)
 {
-   authAddr_ = authAddressManager_->GetAddress(authAddressManager_->FromVerifiedIndex(index));
+   // combo box may list cached addresses not yet in manager's verified list
+   authAddr_ = (index >= 0) ? bs::Address::fromAddressString(
+      ui_->authenticationAddressComboBox->itemText(index).toStdString()) : bs::Address{};
    authKey_.clear();
    if (authAddr_.empty()) {
       return;
@@ -1005,7 +1016,7 @@ void RFQTicketXBT::onMaxClicked()
                updateSubmitButton();
                });
          };
-         armory_->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
+         utxoReservationManager_->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
 
          return;
       }
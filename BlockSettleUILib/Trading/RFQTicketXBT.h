@@ -49,6 +49,7 @@ namespace bs {
 class ArmoryConnection;
 class AssetManager;
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class CCAmountValidator;
 class FXAmountValidator;
 class QuoteProvider;
@@ -73,6 +74,7 @@ public:
       , const std::shared_ptr<ArmoryConnection> &
       , const std::shared_ptr<bs::UTXOReservationManager> &);
    void setWalletsManager(const std::shared_ptr<bs::sync::WalletsManager> &);
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
 
    void resetTicket();
 
@@ -213,6 +215,7 @@ private:
    std::shared_ptr<spdlog::logger>     logger_;
    std::shared_ptr<AssetManager>       assetManager_;
    std::shared_ptr<AuthAddressManager> authAddressManager_;
+   std::shared_ptr<AuthAddressVerificationCache>   authAddrCache_;
 
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
    std::shared_ptr<SignContainer>      signingContainer_;
@@ -18,6 +18,7 @@
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWalletsManager.h"
 #include "BSErrorCodeStrings.h"
+#include "Tracer.h"
 #include "UiUtils.h"
 #include "XBTAmount.h"
 #include "UtxoReservationManager.h"
@@ -130,6 +131,7 @@ bs::sync::PasswordDialogData ReqCCSettlementContainer::toPasswordDialogData(QDat
 
 void ReqCCSettlementContainer::activate()
 {
+   BS_TRACE_SPAN("settlement", "ReqCCSettlementContainer::activate");
    if (side() == bs::network::Side::Buy) {
       double balance = 0;
       for (const auto &leaf : xbtWallet_->getGroup(xbtWallet_->getXBTGroupType())->getLeaves()) {
@@ -294,6 +296,7 @@ void ReqCCSettlementContainer::AcceptQuote()
 
 bool ReqCCSettlementContainer::startSigning(QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "ReqCCSettlementContainer::startSigning");
    const auto &cbTx = [this, handle = validityFlag_.handle(), logger=logger_](bs::error::ErrorCode result, const BinaryData &signedTX) {
       if (!handle.isValid()) {
          logger->warn("[ReqCCSettlementContainer::onTXSigned] failed to sign TX half, already destroyed");
@@ -21,6 +21,7 @@
 #include "QuoteProvider.h"
 #include "WalletSignerContainer.h"
 #include "TradesUtils.h"
+#include "Tracer.h"
 #include "UiUtils.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWalletsManager.h"
@@ -108,6 +109,7 @@ void ReqXBTSettlementContainer::onTimerExpired()
 
 void ReqXBTSettlementContainer::activate()
 {
+   BS_TRACE_SPAN("settlement", "ReqXBTSettlementContainer::activate");
    startTimer(kWaitTimeoutInSec);
 
    settlementIdHex_ = quote_.settlementId;
@@ -216,6 +218,7 @@ void ReqXBTSettlementContainer::cancelWithError(const QString& errorMessage, bs:
 void ReqXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
    , bs::error::ErrorCode errCode, std::string errTxt)
 {
+   BS_TRACE_SPAN("settlement", "ReqXBTSettlementContainer::onTXSigned");
    if ((payoutSignId_ != 0) && (payoutSignId_ == id)) {
       payoutSignId_ = 0;
 
@@ -295,6 +298,7 @@ void ReqXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
 
 void ReqXBTSettlementContainer::onUnsignedPayinRequested(const std::string& settlementId)
 {
+   BS_TRACE_SPAN("settlement", "ReqXBTSettlementContainer::onUnsignedPayinRequested");
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
@@ -368,6 +372,7 @@ void ReqXBTSettlementContainer::onUnsignedPayinRequested(const std::string& sett
 
 void ReqXBTSettlementContainer::onSignedPayoutRequested(const std::string& settlementId, const BinaryData& payinHash, QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "ReqXBTSettlementContainer::onSignedPayoutRequested");
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
@@ -419,6 +424,7 @@ void ReqXBTSettlementContainer::onSignedPayoutRequested(const std::string& settl
 
 void ReqXBTSettlementContainer::onSignedPayinRequested(const std::string& settlementId, const BinaryData& unsignedPayin, QDateTime timestamp)
 {
+   BS_TRACE_SPAN("settlement", "ReqXBTSettlementContainer::onSignedPayinRequested");
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
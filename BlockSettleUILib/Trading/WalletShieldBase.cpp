@@ -13,6 +13,7 @@
 #include <QStackedWidget>
 
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWalletsManager.h"
 
@@ -68,6 +69,11 @@ void WalletShieldBase::init(const std::shared_ptr<bs::sync::WalletsManager> &wal
    authMgr_ = authMgr;
 }
 
+void WalletShieldBase::setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &cache)
+{
+   authAddrCache_ = cache;
+}
+
 void WalletShieldBase::setTabType(QString&& tabType)
 {
    tabType_ = std::move(tabType);
@@ -105,7 +111,9 @@ bool WalletShieldBase::checkWalletSettings(WalletShieldBase::ProductType product
 
    if (productType == ProductType::SpotXBT) {
       if (walletsManager_->getAuthWallet()) {
-         const bool isNoVerifiedAddresses = authMgr_->GetVerifiedAddressList().empty();
+         // cached Verified state is enough until AuthAddressManager validates addresses
+         const bool isNoVerifiedAddresses = authAddrCache_ ? authAddrCache_->verifiedAddresses(authMgr_).empty()
+            : authMgr_->GetVerifiedAddressList().empty();
          if (isNoVerifiedAddresses && authMgr_->isAtLeastOneAwaitingVerification())
          {
             showShieldAuthValidationProcess();
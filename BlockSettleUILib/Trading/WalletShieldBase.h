@@ -20,6 +20,7 @@ namespace Ui {
    class WalletShieldPage;
 }
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 namespace bs {
    namespace sync {
       class WalletsManager;
@@ -38,6 +39,7 @@ public:
 
    void init(const std::shared_ptr<bs::sync::WalletsManager> &walletsManager
       , const std::shared_ptr<AuthAddressManager> &authMgr);
+   void setAuthAddressCache(const std::shared_ptr<AuthAddressVerificationCache> &);
 
    using ProductType = bs::network::Asset::Type;
    bool checkWalletSettings(ProductType productType, const QString &product);
@@ -70,6 +72,7 @@ protected:
    std::unique_ptr<Ui::WalletShieldPage> ui_;
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
    std::shared_ptr<AuthAddressManager>       authMgr_;
+   std::shared_ptr<AuthAddressVerificationCache>   authAddrCache_;
 
    QString tabType_;
 };
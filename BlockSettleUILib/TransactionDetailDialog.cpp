@@ -211,13 +211,24 @@ TransactionDetailDialog::TransactionDetailDialog(const TransactionPtr &tvi
 
       ui_->labelConfirmations->setText(QString::number(item->confirmations));
    };
-   TransactionsViewItem::initialize(tvi, armory.get(), walletsManager, cbInit);
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(tvi, armory.get(), walletsManager
+      , [this, cbInit, handle = validityFlag_.handle()](const TransactionPtr &item) mutable {
+      ValidityGuard guard(handle);
+      if (!handle.isValid() || !item) {
+         return;
+      }
+      QMetaObject::invokeMethod(this, [cbInit, item]() mutable {
+         cbInit(item);
+      });
+   });
 
    bool bigEndianHash = true;
    ui_->labelHash->setText(QString::fromStdString(tvi->txEntry.txHash.toHexStr(bigEndianHash)));
    ui_->labelTime->setText(UiUtils::displayDateTime(QDateTime::fromTime_t(tvi->txEntry.txTime)));
 
-   ui_->labelWalletName->setText(tvi->walletName.isEmpty() ? tr("Unknown") : tvi->walletName);
+   const auto walletName = tvi->walletName();
+   ui_->labelWalletName->setText(walletName.isEmpty() ? tr("Unknown") : walletName);
 
    /* disabled the context menu for copy to clipboard functionality, it can be removed later
    ui_->treeAddresses->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -12,6 +12,7 @@
 #include <QSize>
 #include <QIcon>
 #include "TransactionOutputsModel.h"
+#include "KeyedDiff.h"
 #include "UiUtils.h"
 
 TransactionOutputsModel::TransactionOutputsModel(QObject* parent)
@@ -38,9 +39,11 @@ int TransactionOutputsModel::columnCount(const QModelIndex & parent) const
 
 void TransactionOutputsModel::clear()
 {
-   beginResetModel();
-   outputs_.clear();
-   endResetModel();
+   // Rows are removed rather than reset to keep delete buttons of the view in sync
+   rowById_.clear();
+   bs::ui::applyKeyedDiff(this, outputs_, {}
+      , [](const OutputRow &row) { return row.recipientId; }
+      , [](const OutputRow &, const OutputRow &) { return true; });
 }
 
 void TransactionOutputsModel::enableRows(bool flag)
@@ -84,14 +87,21 @@ QVariant TransactionOutputsModel::data(const QModelIndex & index, int role) cons
 void TransactionOutputsModel::AddRecipient(unsigned int recipientId, const QString& address, double amount)
 {
    beginInsertRows(QModelIndex{}, (int)outputs_.size(), (int)outputs_.size());
+   rowById_[recipientId] = (int)outputs_.size();
    outputs_.emplace_back(OutputRow{recipientId, address, amount});
    endInsertRows();
 }
 
 void TransactionOutputsModel::AddRecipients(const std::vector<std::tuple<unsigned int, QString, double>> &recipients)
 {
-   beginInsertRows(QModelIndex{}, (int)outputs_.size(), (int)outputs_.size());
+   if (recipients.empty()) {
+      return;
+   }
+   beginInsertRows(QModelIndex{}, (int)outputs_.size(), (int)(outputs_.size() + recipients.size() - 1));
+   outputs_.reserve(outputs_.size() + recipients.size());
+   rowById_.reserve(rowById_.size() + recipients.size());
    for (const auto &recip : recipients) {
+      rowById_[std::get<0>(recip)] = (int)outputs_.size();
       outputs_.emplace_back(OutputRow{ std::get<0>(recip), std::get<1>(recip), std::get<2>(recip) });
    }
    endInsertRows();
@@ -99,14 +109,11 @@ void TransactionOutputsModel::AddRecipients(const std::vector<std::tuple<unsigne
 
 void TransactionOutputsModel::UpdateRecipientAmount(unsigned int recipientId, double amount)
 {
-   int row = -1;
-   for (int i = 0; i < outputs_.size(); ++i) {
-      if (outputs_[i].recipientId == recipientId) {
-         row = i;
-         outputs_[i].amount = amount;
-         break;
-      }
+   const int row = GetRowById(recipientId);
+   if (row < 0) {
+      return;
    }
+   outputs_[row].amount = amount;
    emit dataChanged(index(row, ColumnAmount), index(row, ColumnAmount), { Qt::DisplayRole });
 }
 
@@ -114,7 +121,9 @@ void TransactionOutputsModel::RemoveRecipient(int row)
 {
    beginRemoveRows(QModelIndex{}, row, row);
 
+   rowById_.erase(outputs_[row].recipientId);
    outputs_.erase(outputs_.begin() + row);
+   reindexFrom(row);
 
    endRemoveRows();
 }
@@ -131,12 +140,18 @@ unsigned int TransactionOutputsModel::GetOutputId(int row)
 
 int TransactionOutputsModel::GetRowById(unsigned int id)
 {
-   for (int i=0; i < outputs_.size(); i++) {
-      if (outputs_[i].recipientId == id) {
-         return i;
-      }
+   const auto it = rowById_.find(id);
+   if (it == rowById_.end()) {
+      return -1;
+   }
+   return it->second;
+}
+
+void TransactionOutputsModel::reindexFrom(int row)
+{
+   for (int i = row; i < (int)outputs_.size(); ++i) {
+      rowById_[outputs_[i].recipientId] = i;
    }
-   return -1;
 }
 
 QVariant TransactionOutputsModel::getRowData(int column, const OutputRow& outputRow) const
@@ -13,6 +13,7 @@
 
 #include <QAbstractTableModel>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 class TransactionOutputsModel : public QAbstractTableModel
@@ -60,9 +61,11 @@ private:
 private:
    QVariant getRowData(int column, const OutputRow& outputRow) const;
    QVariant getImageData(const int column) const;
+   void reindexFrom(int row);
 
 private:
    std::vector<OutputRow> outputs_;
+   std::unordered_map<unsigned int, int>  rowById_;
    bool rowsEnabled_ = true;
    QIcon removeIcon_;
 };
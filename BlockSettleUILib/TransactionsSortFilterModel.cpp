@@ -0,0 +1,150 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "TransactionsSortFilterModel.h"
+
+#include <QDateTime>
+
+#include "ApplicationSettings.h"
+#include "TransactionsViewModel.h"
+
+
+bool TransactionsFilter::accepts(const TransactionsViewItem &item) const
+{
+   if (!walletIds.isEmpty() && !walletIds.contains(item.walletID)) {
+      return false;
+   }
+
+   if (direction != bs::sync::Transaction::Unknown) {
+      if (!walletIds.isEmpty() && item.isCCWallet) {
+         switch (direction) {
+         case bs::sync::Transaction::Received:
+            if (item.amount < 0) {
+               return false;
+            }
+            break;
+
+         case bs::sync::Transaction::Sent:
+            if (item.amount > 0) {
+               return false;
+            }
+            break;
+
+         default:
+            return false;
+         }
+      }
+      else if (item.direction != direction) {
+         return false;
+      }
+   }
+
+   if ((startDate > 0) && (endDate > 0)) {
+      const auto txDate = item.txEntry.txTime;
+      if ((txDate < startDate) || (txDate >= endDate)) {
+         return false;
+      }
+   }
+
+   if (!searchLower.isEmpty()) {
+      return item.filterText.contains(searchLower);
+   }
+   return true;
+}
+
+
+TransactionsSortFilterModel::TransactionsSortFilterModel(std::shared_ptr<ApplicationSettings> &appSettings
+   , QObject* parent)
+   : QSortFilterProxyModel(parent)
+   , appSettings_(appSettings)
+{
+   setSortRole(TransactionsViewModel::SortRole);
+}
+
+int TransactionsSortFilterModel::totalRowCount() const
+{
+   return QSortFilterProxyModel::rowCount();
+}
+
+void TransactionsSortFilterModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+   txModel_ = qobject_cast<TransactionsViewModel *>(sourceModel);
+   QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+bool TransactionsSortFilterModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
+{
+   if (!txModel_) {
+      return false;
+   }
+   const auto node = txModel_->getNode(source_parent)->child(source_row);
+   if (!node || !node->item()) {
+      return false;
+   }
+   return filter_.accepts(*node->item());
+}
+
+bool TransactionsSortFilterModel::filterAcceptsColumn(int source_column, const QModelIndex &source_parent) const
+{
+   Q_UNUSED(source_parent);
+/*      const auto col = static_cast<TransactionsViewModel::Columns>(source_column);
+   return (col != TransactionsViewModel::Columns::MissedBlocks);*/
+   return true;   // strange, but it works properly only this way
+}
+
+bool TransactionsSortFilterModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+   if (left.column() == static_cast<int>(TransactionsViewModel::Columns::Status)) {
+      QVariant leftData = sourceModel()->data(left, TransactionsViewModel::SortRole);
+      QVariant rightData = sourceModel()->data(right, TransactionsViewModel::SortRole);
+
+      if (leftData == rightData) {
+         // if sorting by confirmations, and values are equal, perform sorting by date in descending order
+         const QModelIndex leftDateIdx = sourceModel()->index(left.row(), static_cast<int>(TransactionsViewModel::Columns::Date));
+         const QModelIndex rightDateIdx = sourceModel()->index(right.row(), static_cast<int>(TransactionsViewModel::Columns::Date));
+         const auto lDate = sourceModel()->data(leftDateIdx, TransactionsViewModel::SortRole);
+         const auto rDate = sourceModel()->data(rightDateIdx, TransactionsViewModel::SortRole);
+
+         return lDate > rDate;
+      }
+   }
+
+   return QSortFilterProxyModel::lessThan(left, right);
+}
+
+void TransactionsSortFilterModel::updateFilters(const QStringList &walletIds, const QString &searchString
+   , bs::sync::Transaction::Direction direction)
+{
+   this->walletIds = walletIds;
+   this->searchString = searchString;
+   this->transactionDirection = direction;
+
+   filter_.walletIds = QSet<QString>::fromList(walletIds);
+   filter_.searchLower = searchString.toLower();
+   filter_.direction = direction;
+
+   appSettings_->set(ApplicationSettings::TransactionFilter,
+      QVariantList() << (this->walletIds.isEmpty() ?
+         QStringList() << c_allWalletsId : this->walletIds) <<
+      static_cast<int>(direction));
+
+   invalidateFilter();
+}
+
+void TransactionsSortFilterModel::updateDates(const QDate& start, const QDate& end)
+{
+   this->startDate = start.isValid() ? QDateTime(start, QTime(), Qt::LocalTime).toTime_t() : 0;
+   this->endDate = end.isValid() ? QDateTime(end, QTime(), Qt::LocalTime).addDays(1).toTime_t() : 0;
+
+   filter_.startDate = startDate;
+   filter_.endDate = endDate;
+
+   invalidateFilter();
+}
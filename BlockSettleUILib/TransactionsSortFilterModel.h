@@ -0,0 +1,69 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __TRANSACTIONS_SORT_FILTER_MODEL_H__
+#define __TRANSACTIONS_SORT_FILTER_MODEL_H__
+
+#include <memory>
+#include <QDate>
+#include <QSet>
+#include <QSortFilterProxyModel>
+#include <QStringList>
+#include "Wallets/SyncWallet.h"
+
+class ApplicationSettings;
+class TransactionsViewModel;
+struct TransactionsViewItem;
+
+static const QString c_allWalletsId = QLatin1String("all");
+
+// Filter settings converted to the form matching TransactionsViewItem filter keys,
+// so that row check doesn't need to go through QVariant or case-insensitive compare
+struct TransactionsFilter
+{
+   QSet<QString>  walletIds;
+   bs::sync::Transaction::Direction direction = bs::sync::Transaction::Unknown;
+   uint32_t startDate = 0;
+   uint32_t endDate = 0;
+   QString  searchLower;
+
+   bool accepts(const TransactionsViewItem &) const;
+};
+
+
+class TransactionsSortFilterModel : public QSortFilterProxyModel
+{
+public:
+   TransactionsSortFilterModel(std::shared_ptr<ApplicationSettings> &appSettings, QObject* parent);
+
+   int totalRowCount() const;
+
+   void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+   bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
+   bool filterAcceptsColumn(int source_column, const QModelIndex &source_parent) const override;
+   bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+   void updateFilters(const QStringList &walletIds, const QString &searchString, bs::sync::Transaction::Direction direction);
+   void updateDates(const QDate& start, const QDate& end);
+
+   std::shared_ptr<ApplicationSettings> appSettings_;
+   QStringList walletIds;
+   QString searchString;
+   bs::sync::Transaction::Direction transactionDirection = bs::sync::Transaction::Unknown;
+   uint32_t startDate = 0;
+   uint32_t endDate = 0;
+
+private:
+   TransactionsViewModel   *  txModel_{};
+   TransactionsFilter   filter_;
+};
+
+#endif // __TRANSACTIONS_SORT_FILTER_MODEL_H__
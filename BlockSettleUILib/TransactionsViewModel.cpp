@@ -16,32 +16,66 @@
 #include "Wallets/SyncWalletsManager.h"
 
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
+#include <QFile>
 #include <QMutexLocker>
 #include <QFutureWatcher>
+#include <QSaveFile>
+
+namespace {
+
+   // Shared by all nodes - only the model's data() needs them
+   struct NodeStyle
+   {
+      NodeStyle()
+      {
+         fontBold.setBold(true);
+      }
+
+      QFont    fontBold;
+      QColor   colorGray{ Qt::darkGray };
+      QColor   colorRed{ Qt::red };
+      QColor   colorYellow{ Qt::darkYellow };
+      QColor   colorGreen{ Qt::darkGreen };
+      QColor   colorInvalid{ Qt::red };
+   };
+
+   const NodeStyle &nodeStyle()
+   {
+      static const NodeStyle style;
+      return style;
+   }
+
+   const quint32 kSnapshotMagic = 0x42534c53;   // "BSLS"
+   const quint32 kSnapshotVersion = 1;
+
+   // Snapshot rows within this many blocks below its top block are
+   // requested again, so that shallow reorgs are reconciled, too
+   const unsigned int kSnapshotReorgDepth = 6;
+
+   void writeBinary(QDataStream &out, const BinaryData &data)
+   {
+      out << QByteArray(reinterpret_cast<const char *>(data.getPtr()), int(data.getSize()));
+   }
+
+   BinaryData readBinary(QDataStream &in)
+   {
+      QByteArray data;
+      in >> data;
+      return BinaryData(reinterpret_cast<const uint8_t *>(data.constData()), size_t(data.size()));
+   }
+
+}  // namespace
 
 
 TXNode::TXNode()
-{
-   init();
-}
+{}
 
 TXNode::TXNode(const std::shared_ptr<TransactionsViewItem> &item, TXNode *parent)
    : item_(item), parent_(parent)
-{
-   init();
-}
-
-void TXNode::init()
-{
-   fontBold_.setBold(true);
-
-   colorGray_ = Qt::darkGray;
-   colorRed_ = Qt::red;
-   colorYellow_ = Qt::darkYellow;
-   colorGreen_ = Qt::darkGreen;
-   colorInvalid_ = Qt::red;
-}
+{}
 
 void TXNode::clear(bool del)
 {
@@ -66,13 +100,13 @@ QVariant TXNode::data(int column, int role) const
    if (role == Qt::DisplayRole) {
       switch (col) {
       case TransactionsViewModel::Columns::Date:
-         return item_->displayDateTime;
+         return item_->displayDateTime();
       case TransactionsViewModel::Columns::Status:
          return QObject::tr("   %1").arg(item_->confirmations);
       case TransactionsViewModel::Columns::Wallet:
-         return item_->walletName;
+         return item_->walletName();
       case TransactionsViewModel::Columns::SendReceive:
-         return item_->dirStr;
+         return item_->dirStr();
       case TransactionsViewModel::Columns::Comment:
          return item_->comment;
       case TransactionsViewModel::Columns::Amount:
@@ -101,7 +135,7 @@ QVariant TXNode::data(int column, int role) const
       switch (col) {
       case TransactionsViewModel::Columns::Date:        return item_->txEntry.txTime;
       case TransactionsViewModel::Columns::Status:      return item_->confirmations;
-      case TransactionsViewModel::Columns::Wallet:      return item_->walletName;
+      case TransactionsViewModel::Columns::Wallet:      return item_->walletName();
       case TransactionsViewModel::Columns::SendReceive: return (int)item_->direction;
       case TransactionsViewModel::Columns::Comment:     return item_->comment;
       case TransactionsViewModel::Columns::Amount:      return QVariant::fromValue<double>(qAbs(item_->amount));
@@ -109,25 +143,26 @@ QVariant TXNode::data(int column, int role) const
       default:    return QVariant();
       }
    } else if (role == Qt::TextColorRole) {
+      const auto &style = nodeStyle();
       switch (col) {
       case TransactionsViewModel::Columns::Address:
       case TransactionsViewModel::Columns::Wallet:
-         return colorGray_;
+         return style.colorGray;
 
       case TransactionsViewModel::Columns::Status:
       {
          if (item_->confirmations == 0) {
-            return colorRed_;
+            return style.colorRed;
          } else if (item_->confirmations < 6) {
-            return colorYellow_;
+            return style.colorYellow;
          } else {
-            return colorGreen_;
+            return style.colorGreen;
          }
       }
 
       default:
          if (!item_->isValid) {
-            return colorInvalid_;
+            return style.colorInvalid;
          } else {
             return QVariant();
          }
@@ -140,7 +175,7 @@ QVariant TXNode::data(int column, int role) const
          boldFont = true;
       }
       if (boldFont) {
-         return fontBold_;
+         return nodeStyle().fontBold;
       }
    } else if (role == TransactionsViewModel::FilterRole) {
       switch (col)
@@ -328,6 +363,135 @@ void TransactionsViewModel::loadAllWallets(bool onNewBlock)
    }
 }
 
+QByteArray TransactionsViewModel::walletSetKey() const
+{
+   std::set<std::string> walletIds;
+   for (const auto &wallet : walletsManager_->getAllWallets()) {
+      walletIds.insert(wallet->walletId());
+   }
+   QCryptographicHash hash(QCryptographicHash::Sha256);
+   for (const auto &walletId : walletIds) {
+      hash.addData(walletId.data(), int(walletId.size()));
+      hash.addData("\n", 1);
+   }
+   return hash.result();
+}
+
+bool TransactionsViewModel::loadSnapshot(const QString &fileName)
+{
+   if (!allWallets_ || !initialLoadCompleted_ || rootNode_->hasChildren()) {
+      return false;
+   }
+   QFile file(fileName);
+   if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+   }
+   QDataStream in(&file);
+   in.setVersion(QDataStream::Qt_5_6);
+
+   quint32 magic = 0, version = 0, topBlock = 0, nbRows = 0;
+   QByteArray key;
+   in >> magic >> version;
+   if ((magic != kSnapshotMagic) || (version != kSnapshotVersion)) {
+      logger_->info("[TransactionsViewModel::loadSnapshot] unsupported snapshot format in {}"
+         , fileName.toStdString());
+      return false;
+   }
+   in >> key >> topBlock >> nbRows;
+   if (key != walletSetKey()) {
+      logger_->debug("[TransactionsViewModel::loadSnapshot] wallet set has changed - snapshot ignored");
+      return false;
+   }
+
+   std::vector<TXNode *> nodes;
+   TransactionPtr oldestItem;
+   for (quint32 i = 0; i < nbRows; ++i) {
+      auto item = std::make_shared<TransactionsViewItem>();
+      item->readSnapshot(in);
+      if (in.status() != QDataStream::Ok) {
+         break;
+      }
+      for (const auto &walletId : item->txEntry.walletIds) {
+         const auto wallet = walletsManager_->getWalletById(walletId);
+         if (wallet) {
+            item->wallets.push_back(wallet);
+         }
+      }
+      if (item->wallets.empty()) {
+         continue;
+      }
+      item->updateFilterKeys();
+      if (!oldestItem || (oldestItem->txEntry.txTime >= item->txEntry.txTime)) {
+         oldestItem = item;
+      }
+      nodes.push_back(new TXNode(item));
+   }
+   if (in.status() != QDataStream::Ok) {
+      logger_->warn("[TransactionsViewModel::loadSnapshot] {} is corrupted", fileName.toStdString());
+      qDeleteAll(nodes);
+      return false;
+   }
+
+   if (!nodes.empty()) {
+      QMutexLocker locker(&updateMutex_);
+      beginInsertRows(QModelIndex(), 0, int(nodes.size()) - 1);
+      for (const auto &node : nodes) {
+         rootNode_->add(node);
+      }
+      oldestItem_ = oldestItem;
+      endInsertRows();
+   }
+   snapshotTopBlock_ = topBlock;
+   logger_->debug("[TransactionsViewModel::loadSnapshot] {} rows at block {} loaded"
+      , nodes.size(), topBlock);
+   return true;
+}
+
+bool TransactionsViewModel::saveSnapshot(const QString &fileName) const
+{
+   if (!allWallets_) {
+      return false;
+   }
+   // Rows still being loaded or initialized would be missing from the next
+   // start as only entries above snapshot's top block are requested then
+   if (!initialLoadCompleted_) {
+      logger_->debug("[TransactionsViewModel::saveSnapshot] loading is not complete - skipped");
+      return false;
+   }
+   const unsigned int topBlock = snapshotTopBlock_ ? snapshotTopBlock_.load() : armory_->topBlock();
+   if (!topBlock) {
+      return false;
+   }
+
+   QMutexLocker locker(&updateMutex_);
+   for (const auto &node : rootNode_->children()) {
+      if (!node->item() || !node->item()->initialized) {
+         logger_->debug("[TransactionsViewModel::saveSnapshot] not all rows are initialized - skipped");
+         return false;
+      }
+   }
+
+   QSaveFile file(fileName);
+   if (!file.open(QIODevice::WriteOnly)) {
+      logger_->error("[TransactionsViewModel::saveSnapshot] failed to open {}", fileName.toStdString());
+      return false;
+   }
+   QDataStream out(&file);
+   out.setVersion(QDataStream::Qt_5_6);
+   out << kSnapshotMagic << kSnapshotVersion << walletSetKey() << quint32(topBlock)
+      << quint32(rootNode_->nbChildren());
+   for (const auto &node : rootNode_->children()) {
+      node->item()->writeSnapshot(out);
+   }
+   if ((out.status() != QDataStream::Ok) || !file.commit()) {
+      logger_->error("[TransactionsViewModel::saveSnapshot] failed to write {}", fileName.toStdString());
+      return false;
+   }
+   logger_->debug("[TransactionsViewModel::saveSnapshot] {} rows at block {} saved"
+      , rootNode_->nbChildren(), topBlock);
+   return true;
+}
+
 int TransactionsViewModel::columnCount(const QModelIndex &) const
 {
    return static_cast<int>(Columns::last) + 1;
@@ -461,6 +625,7 @@ void TransactionsViewModel::clear()
       oldestItem_ = {};
    }
    endResetModel();
+   snapshotTopBlock_ = 0;
    *stopped_ = false;
 }
 
@@ -469,8 +634,10 @@ void TransactionsViewModel::onStateChanged(ArmoryState state)
    QMetaObject::invokeMethod(this, [this, state] {
       if (state == ArmoryState::Offline) {
          ledgerDelegate_.reset();
-         clear();
-      } else if ((state == ArmoryState::Ready) && !rootNode_->hasChildren()) {
+         if (!snapshotTopBlock_) {  // keep showing snapshot until Armory gets ready
+            clear();
+         }
+      } else if ((state == ArmoryState::Ready) && (!rootNode_->hasChildren() || snapshotTopBlock_)) {
          loadAllWallets();
       }
    });
@@ -480,7 +647,6 @@ std::shared_ptr<TransactionsViewItem> TransactionsViewModel::itemFromTransaction
 {
    auto item = std::make_shared<TransactionsViewItem>();
    item->txEntry = entry;
-   item->displayDateTime = UiUtils::displayDateTime(entry.txTime);
    for (const auto &walletId : entry.walletIds) {
       const auto wallet = walletsManager_->getWalletById(walletId);
       if (wallet) {
@@ -499,9 +665,6 @@ std::shared_ptr<TransactionsViewItem> TransactionsViewModel::itemFromTransaction
    }
 
    item->confirmations = armory_->getConfirmationsNumber(entry.blockNum);
-   if (!item->wallets.empty()) {
-      item->walletName = QString::fromStdString(item->wallets[0]->name());
-   }
    const auto validWallet = item->wallets.empty() ? nullptr : item->wallets[0];
    item->isValid = validWallet ? validWallet->isTxValid(entry.txHash) : false;
    return item;
@@ -658,6 +821,7 @@ std::pair<size_t, size_t> TransactionsViewModel::updateTransactionsPage(const st
          logger_->error("item is not inited");
          return;
       }
+      itemPtr->releaseTx();
       if (newTxKeys->empty()) {
          logger_->warn("TX keys already empty");
          return;
@@ -773,8 +937,22 @@ void TransactionsViewModel::updateBlockHeight(const std::vector<std::shared_ptr<
          item->wallets = updItem->wallets;
          item->walletID = updItem->walletID;
          item->txEntry = updItem->txEntry;
-         item->amountStr.clear();
-         item->calcAmount(walletsManager_);
+         // Tx is released after initialization, so amount is calculated
+         // again by loading it (and its inputs)
+         item->resetAmount();
+         updateTransactionDetails(item, [this](const TransactionPtr &updated) {
+            if (!updated) {
+               return;
+            }
+            updated->releaseTx();
+            QMetaObject::invokeMethod(this, [this] {
+               if (!rootNode_->hasChildren()) {
+                  return;
+               }
+               emit dataChanged(index(0, static_cast<int>(Columns::Amount))
+                  , index(rootNode_->nbChildren() - 1, static_cast<int>(Columns::Amount)));
+            });
+         });
       }
       const auto newBlockNum = updItem->txEntry.blockNum;
       if (newBlockNum != UINT32_MAX) {
@@ -828,6 +1006,10 @@ void TransactionsViewModel::loadLedgerEntries(bool onNewBlock)
       return;
    }
    initialLoadCompleted_ = false;
+   if (snapshotTopBlock_) {
+      QMetaObject::invokeMethod(this, [this] { reconcileLedgerEntries(); });
+      return;
+   }
 
    QPointer<TransactionsViewModel> thisPtr = this;
    auto rawData = std::make_shared<std::map<int, std::vector<bs::TXEntry>>>();
@@ -908,6 +1090,141 @@ void TransactionsViewModel::ledgerToTxData(const std::map<int, std::vector<bs::T
    initialLoadCompleted_ = true;
 }
 
+void TransactionsViewModel::reconcileLedgerEntries()
+{
+   if (armory_->topBlock() + kSnapshotReorgDepth < snapshotTopBlock_) {
+      logger_->info("[TransactionsViewModel::reconcileLedgerEntries] snapshot block {} is above"
+         " current top {} - reloading", snapshotTopBlock_.load(), armory_->topBlock());
+      clear();
+      initialLoadCompleted_ = true;
+      loadLedgerEntries();
+      return;
+   }
+
+   QPointer<TransactionsViewModel> thisPtr = this;
+   const auto &cbPageCount = [thisPtr, logger = logger_](ReturnMessage<uint64_t> pageCnt)
+   {
+      uint32_t inPageCnt = 0;
+      try {
+         inPageCnt = uint32_t(pageCnt.get());
+      }
+      catch (const std::exception &e) {
+         logger->error("[TransactionsViewModel::reconcileLedgerEntries::cbPageCount] return " \
+            "data error: {}", e.what());
+         QMetaObject::invokeMethod(qApp, [thisPtr] {
+            if (thisPtr) {
+               thisPtr->initialLoadCompleted_ = true;   // retried on next Ready state
+            }
+         });
+         return;
+      }
+      QMetaObject::invokeMethod(qApp, [thisPtr, inPageCnt] {
+         if (thisPtr) {
+            thisPtr->loadReconcilePage(0, inPageCnt, std::make_shared<std::vector<bs::TXEntry>>());
+         }
+      });
+   };
+   ledgerDelegate_->getPageCount(cbPageCount);
+}
+
+// Pages are sorted by block height in descending order (ZC first), so they're
+// requested one by one until an entry below reconciliation range is met
+void TransactionsViewModel::loadReconcilePage(uint32_t pageId, uint32_t pageCnt
+   , const std::shared_ptr<std::vector<bs::TXEntry>> &entries)
+{
+   if (pageId >= pageCnt) {
+      reconcileSnapshot(*entries);
+      return;
+   }
+   if (!ledgerDelegate_ || *stopped_) {
+      initialLoadCompleted_ = true;
+      return;
+   }
+   const unsigned int fromBlock = (snapshotTopBlock_ > kSnapshotReorgDepth)
+      ? snapshotTopBlock_ - kSnapshotReorgDepth : 0;
+
+   QPointer<TransactionsViewModel> thisPtr = this;
+   const auto &cbLedger = [thisPtr, pageId, pageCnt, entries, fromBlock, logger = logger_]
+      (ReturnMessage<std::vector<ClientClasses::LedgerEntry>> msg)
+   {
+      std::vector<bs::TXEntry> page;
+      try {
+         auto le = msg.get();
+         page = bs::TXEntry::fromLedgerEntries(le);
+      }
+      catch (const std::exception &e) {
+         logger->error("[TransactionsViewModel::loadReconcilePage::cbLedger] " \
+            "return data error: {}", e.what());
+         QMetaObject::invokeMethod(qApp, [thisPtr] {
+            if (thisPtr) {
+               thisPtr->initialLoadCompleted_ = true;   // retried on next Ready state
+            }
+         });
+         return;
+      }
+      QMetaObject::invokeMethod(qApp, [thisPtr, pageId, pageCnt, entries, fromBlock, page] {
+         if (!thisPtr) {
+            return;
+         }
+         bool reachedSnapshot = false;
+         for (const auto &entry : page) {
+            if (entry.blockNum < fromBlock) {
+               reachedSnapshot = true;
+               continue;
+            }
+            entries->push_back(entry);
+         }
+         if (reachedSnapshot) {
+            thisPtr->reconcileSnapshot(*entries);
+         }
+         else {
+            thisPtr->loadReconcilePage(pageId + 1, pageCnt, entries);
+         }
+      });
+   };
+   ledgerDelegate_->getHistoryPage(pageId, cbLedger);
+}
+
+void TransactionsViewModel::reconcileSnapshot(const std::vector<bs::TXEntry> &entries)
+{
+   const unsigned int fromBlock = (snapshotTopBlock_ > kSnapshotReorgDepth)
+      ? snapshotTopBlock_ - kSnapshotReorgDepth : 0;
+   std::set<BinaryData> txHashes;
+   for (const auto &entry : entries) {
+      txHashes.insert(entry.txHash);
+   }
+
+   // Snapshot rows in reconciled range which are not reported anymore were
+   // either reorged out or ZC was dropped. Others only get confirmations updated.
+   std::vector<int> delRows;
+   {
+      QMutexLocker locker(&updateMutex_);
+      for (const auto &node : rootNode_->children()) {
+         const auto &item = node->item();
+         if ((item->txEntry.blockNum >= fromBlock)
+            && (txHashes.find(item->txEntry.txHash) == txHashes.end())) {
+            delRows.push_back(node->row());
+            continue;
+         }
+         item->confirmations = armory_->getConfirmationsNumber(item->txEntry.blockNum);
+      }
+   }
+   if (!delRows.empty()) {
+      onDelRows(delRows);
+   }
+   if (rootNode_->hasChildren()) {
+      emit dataChanged(index(0, static_cast<int>(Columns::Status))
+         , index(rootNode_->nbChildren() - 1, static_cast<int>(Columns::Status)));
+   }
+   logger_->debug("[TransactionsViewModel::reconcileSnapshot] {} entries from block {}, {} rows removed"
+      , entries.size(), fromBlock, delRows.size());
+
+   snapshotTopBlock_ = 0;
+   signalOnEndLoading_ = true;
+   updateTransactionsPage(entries);
+   initialLoadCompleted_ = true;
+}
+
 void TransactionsViewModel::onNewItems(const std::vector<TXNode *> &newItems)
 {
    const int curLastIdx = rootNode_->nbChildren();
@@ -995,7 +1312,8 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
       if (item->initialized) {
          return;
       }
-      if (!item->dirStr.isEmpty() && !item->mainAddress.isEmpty() && !item->amountStr.isEmpty()) {
+      if (item->dirReceived && !item->mainAddress.isEmpty() && !item->amountStr.isEmpty()) {
+         item->updateFilterKeys();
          item->initialized = true;
          userCB(item);
       }
@@ -1034,7 +1352,7 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
    };
    const auto &cbDir = [item, cbInit](bs::sync::Transaction::Direction dir, std::vector<bs::Address> inAddrs) {
       item->direction = dir;
-      item->dirStr = QObject::tr(bs::sync::Transaction::toStringDir(dir));
+      item->dirReceived = true;
       if (dir == bs::sync::Transaction::Direction::Received) {
          if (inAddrs.size() == 1) {    // likely a settlement address
             switch (inAddrs[0].getType()) {
@@ -1105,6 +1423,10 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
 
       if (!item->tx.isInitialized()) {
          item->tx = std::move(newTx);
+         for (int i = 0; i < item->tx.getNumTxOut(); ++i) {
+            const auto &addr = bs::Address::fromTxOut(item->tx.getTxOutCopy(i));
+            item->hasSettlementOut |= (addr.getType() == AddressEntryType_P2WSH);
+         }
          std::set<BinaryData> txHashSet;
          for (size_t i = 0; i < item->tx.getNumTxIn(); i++) {
             TxIn in = item->tx.getTxInCopy(i);
@@ -1126,7 +1448,7 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
          item->txHashesReceived = true;
       }
 
-      if (item->dirStr.isEmpty()) {
+      if (!item->dirReceived) {
          if (!walletsMgr->getTransactionDirection(item->tx, item->walletID.toStdString(), cbDir)) {
             userCB(nullptr);
          }
@@ -1139,7 +1461,22 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
    };
 
    if (item->initialized) {
-      userCB(item);
+      if (item->tx.isInitialized()) {
+         userCB(item);
+         return;
+      }
+      // Tx was released after initialization
+      const auto cbReloadTX = [item, userCB](const Tx &tx) {
+         if (!tx.isInitialized()) {
+            userCB(nullptr);
+            return;
+         }
+         item->tx = tx;
+         userCB(item);
+      };
+      if (!armory->getTxByHash(item->txEntry.txHash, cbReloadTX, true)) {
+         userCB(nullptr);
+      }
    } else {
       if (item->tx.isInitialized()) {
          cbTX(item->tx);
@@ -1246,21 +1583,89 @@ void TransactionsViewItem::calcAmount(const std::shared_ptr<bs::sync::WalletsMan
    }
 }
 
-bool TransactionsViewItem::containsInputsFrom(const Tx &inTx) const
+void TransactionsViewItem::updateFilterKeys()
 {
-   const bs::TxChecker checker(tx);
+   filterText = mainAddress.toLower() + QLatin1Char('\n') + comment.toLower();
+   isCCWallet = !wallets.empty() && (wallets[0]->type() == bs::core::wallet::Type::ColorCoin);
+}
 
-   for (size_t i = 0; i < inTx.getNumTxIn(); i++) {
-      TxIn in = inTx.getTxInCopy((int)i);
-      if (!in.isInitialized()) {
-         continue;
-      }
-      OutPoint op = in.getOutPoint();
-      if (checker.hasInput(op.getTxHash())) {
-         return true;
-      }
+void TransactionsViewItem::resetAmount()
+{
+   amount = 0;
+   amountStr.clear();
+   isCPFP = false;
+   txHashesReceived = false;
+   initialized = false;
+}
+
+void TransactionsViewItem::releaseTx()
+{
+#ifndef TX_MODEL_NESTED_NODES // nested nodes grouping compares TX inputs
+   tx = Tx();
+   txIns.clear();
+   txHashesReceived = false;
+#endif
+}
+
+void TransactionsViewItem::writeSnapshot(QDataStream &out) const
+{
+   writeBinary(out, txEntry.txHash);
+   out << quint32(txEntry.walletIds.size());
+   for (const auto &walletId : txEntry.walletIds) {
+      out << QString::fromStdString(walletId);
    }
-   return false;
+   out << qint64(txEntry.value) << quint32(txEntry.blockNum) << quint32(txEntry.txTime)
+      << txEntry.isRBF << txEntry.isChainedZC;
+   out << mainAddress << qint32(addressCount) << qint32(direction) << walletID
+      << comment << amountStr << amount << isValid << isCPFP << qint32(confirmations)
+      << hasSettlementOut;
+   writeBinary(out, parentId);
+   writeBinary(out, groupId);
+}
+
+void TransactionsViewItem::readSnapshot(QDataStream &in)
+{
+   txEntry.txHash = readBinary(in);
+   quint32 nbWalletIds = 0;
+   in >> nbWalletIds;
+   for (quint32 i = 0; (i < nbWalletIds) && (in.status() == QDataStream::Ok); ++i) {
+      QString walletId;
+      in >> walletId;
+      txEntry.walletIds.insert(walletId.toStdString());
+   }
+   qint64 value = 0;
+   quint32 blockNum = 0, txTime = 0;
+   in >> value >> blockNum >> txTime >> txEntry.isRBF >> txEntry.isChainedZC;
+   txEntry.value = value;
+   txEntry.blockNum = blockNum;
+   txEntry.txTime = txTime;
+
+   qint32 addrCount = 0, dir = 0, confCount = 0;
+   in >> mainAddress >> addrCount >> dir >> walletID >> comment >> amountStr
+      >> amount >> isValid >> isCPFP >> confCount >> hasSettlementOut;
+   addressCount = addrCount;
+   direction = static_cast<bs::sync::Transaction::Direction>(dir);
+   confirmations = confCount;
+   parentId = readBinary(in);
+   groupId = readBinary(in);
+
+   dirReceived = true;
+   initialized = true;
+}
+
+QString TransactionsViewItem::displayDateTime() const
+{
+   return UiUtils::displayDateTime(txEntry.txTime);
+}
+
+QString TransactionsViewItem::dirStr() const
+{
+   return QObject::tr(bs::sync::Transaction::toStringDir(direction));
+}
+
+QString TransactionsViewItem::walletName() const
+{
+   return wallets.empty() ? QString() : QString::fromStdString(wallets[0]->name());
 }
 
 bool TransactionsViewItem::isRBFeligible() const
@@ -1280,11 +1685,5 @@ bool TransactionsViewItem::isCPFPeligible() const
 
 bool TransactionsViewItem::isPayin() const
 {
-   bool hasSettlOut = false;
-   for (int i = 0; i < tx.getNumTxOut(); ++i) {
-      const auto &txOut = tx.getTxOutCopy(i);
-      const auto &addr = bs::Address::fromTxOut(txOut);
-      hasSettlOut |= addr.getType() == AddressEntryType_P2WSH;
-   }
-   return hasSettlOut && (direction == bs::sync::Transaction::Direction::Sent);
+   return hasSettlementOut && (direction == bs::sync::Transaction::Direction::Sent);
 }
@@ -34,30 +34,34 @@ namespace bs {
    }
 }
 class SafeLedgerDelegate;
+class QDataStream;
 
 struct TransactionsViewItem;
 using TransactionPtr = std::shared_ptr<TransactionsViewItem>;
 
+// Display strings which can be derived from other fields (date, direction,
+// wallet name) are formatted on request only, to keep per-row memory low
 struct TransactionsViewItem
 {
    bs::TXEntry txEntry;
-   Tx tx;
+   Tx tx;   // released by model after initialization, see releaseTx()
    bool initialized = false;
    QString mainAddress;
    int addressCount;
    bs::sync::Transaction::Direction direction = bs::sync::Transaction::Unknown;
    std::vector<std::shared_ptr<bs::sync::Wallet>> wallets;
-   QString dirStr;
-   QString walletName;
    QString walletID;
    QString comment;
-   QString displayDateTime;
    QString amountStr;
    BTCNumericTypes::balance_type amount = 0;
    bool     isValid = true;
    bool     isCPFP = false;
    int confirmations = 0;
 
+   // Filter keys, updated by updateFilterKeys()
+   QString  filterText;    // lower-cased main address and comment
+   bool     isCCWallet = false;
+
    BinaryData  parentId;   // universal grouping support
    BinaryData  groupId;
 
@@ -66,7 +70,20 @@ struct TransactionsViewItem
       , const std::shared_ptr<bs::sync::WalletsManager> &
       , std::function<void(const TransactionPtr &)>);
    void calcAmount(const std::shared_ptr<bs::sync::WalletsManager> &);
-   bool containsInputsFrom(const Tx &tx) const;
+   // Amount will be recalculated on next initialize()
+   void resetAmount();
+   void updateFilterKeys();
+   // Drops parsed Tx and previous TXs once derived fields are set,
+   // initialize() loads Tx again if it's needed later
+   void releaseTx();
+   // Snapshot keeps derived fields only - wallets are resolved from
+   // txEntry.walletIds and Tx is loaded on demand as after releaseTx()
+   void writeSnapshot(QDataStream &) const;
+   void readSnapshot(QDataStream &);
+
+   QString displayDateTime() const;
+   QString dirStr() const;
+   QString walletName() const;
 
    bool isRBFeligible() const;
    bool isCPFPeligible() const;
@@ -76,6 +93,8 @@ struct TransactionsViewItem
 
 private:
    bool     txHashesReceived{ false };
+   bool     dirReceived{ false };
+   bool     hasSettlementOut{ false };
    AsyncClient::TxBatchResult txIns;
 };
 typedef std::vector<TransactionsViewItem>    TransactionItems;
@@ -106,16 +125,11 @@ public:
 
    void forEach(const std::function<void(const TransactionPtr &)> &);
 
-private:
-   void init();
-
 private:
    std::shared_ptr<TransactionsViewItem>  item_;
    QList<TXNode *>   children_;
    int      row_ = 0;
    TXNode*  parent_ = nullptr;
-   QFont    fontBold_;
-   QColor   colorGray_, colorRed_, colorYellow_, colorGreen_, colorInvalid_;
 };
 
 Q_DECLARE_METATYPE(TransactionsViewItem)
@@ -147,6 +161,12 @@ public:
    void loadAllWallets(bool onNewBlock=false);
    size_t itemsCount() const { return rootNode_->nbChildren(); }
 
+   // Rows from ledger snapshot are shown before Armory gets ready. On the next
+   // load only entries above snapshot's top block (minus reorg margin) are
+   // requested and reconciled with them. All-wallets model only.
+   bool loadSnapshot(const QString &fileName);
+   bool saveSnapshot(const QString &fileName) const;
+
 public:
    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -179,6 +199,11 @@ private:
    void init();
    void clear();
    void loadLedgerEntries(bool onNewBlock=false);
+   void reconcileLedgerEntries();
+   void loadReconcilePage(uint32_t pageId, uint32_t pageCnt
+      , const std::shared_ptr<std::vector<bs::TXEntry>> &);
+   void reconcileSnapshot(const std::vector<bs::TXEntry> &);
+   QByteArray walletSetKey() const;
    void ledgerToTxData(const std::map<int, std::vector<bs::TXEntry>> &rawData
       , bool onNewBlock=false);
    std::pair<size_t, size_t> updateTransactionsPage(const std::vector<bs::TXEntry> &);
@@ -227,6 +252,8 @@ private:
    const bool        allWallets_;
    std::shared_ptr<std::atomic_bool>  stopped_;
    std::atomic_bool  initialLoadCompleted_{ true };
+   // Top block of loaded snapshot, reset after reconciliation with Armory
+   std::atomic<unsigned int>  snapshotTopBlock_{ 0 };
 
    // If set, amount field will show only related address balance changes
    // (without fees because fees are related to transaction, not address).
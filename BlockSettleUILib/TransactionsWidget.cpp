@@ -11,7 +11,6 @@
 #include "ui_TransactionsWidget.h"
 #include "TransactionsWidget.h"
 
-#include <QSortFilterProxyModel>
 #include <QMenu>
 #include <QClipboard>
 #include <QDateTime>
@@ -21,6 +20,7 @@
 #include "CreateTransactionDialogAdvanced.h"
 #include "PasswordDialogDataWrapper.h"
 #include "TradesUtils.h"
+#include "TransactionsSortFilterModel.h"
 #include "TransactionsViewModel.h"
 #include "TransactionDetailDialog.h"
 #include "Wallets/SyncHDWallet.h"
@@ -28,164 +28,9 @@
 #include "UiUtils.h"
 #include "UtxoReservationManager.h"
 
-static const QString c_allWalletsId = QLatin1String("all");
 using namespace bs::sync;
 
 
-class TransactionsSortFilterModel : public QSortFilterProxyModel
-{
-public:
-   TransactionsSortFilterModel(std::shared_ptr<ApplicationSettings> &appSettings, QObject* parent)
-      : QSortFilterProxyModel(parent)
-      , appSettings_(appSettings)
-   {
-      setSortRole(TransactionsViewModel::SortRole);
-   }
-
-/*   int rowCount(const QModelIndex & parent = QModelIndex()) const override
-   {     //! causes assert(last < rowCount()) to invoke when filtering by wallet
-      return qMin(QSortFilterProxyModel::rowCount(parent), 500);
-   }*/
-
-   int totalRowCount() const
-   {
-      return QSortFilterProxyModel::rowCount();
-   }
-
-   bool filterAcceptsRow(int source_row, const QModelIndex &) const override
-   {
-      auto src = sourceModel();
-      if (!src) {
-         return false;
-      }
-      QModelIndex directionIndex = src->index(source_row, static_cast<int>(TransactionsViewModel::Columns::SendReceive));
-      int direction = src->data(directionIndex, TransactionsViewModel::FilterRole).toInt();
-
-      bool walletMatched = false;
-      if (!walletIds.isEmpty()) {
-         const QModelIndex index = src->index(source_row,
-            static_cast<int>(TransactionsViewModel::Columns::Wallet));
-         for (const auto &walletId : walletIds) {
-            if (src->data(index, TransactionsViewModel::FilterRole).toString() == walletId) {
-               walletMatched = true;
-            }
-         }
-         if (!walletMatched) {
-            return false;
-         }
-      }
-
-      if (transactionDirection != bs::sync::Transaction::Unknown) {
-         const auto aIdx = src->index(source_row,
-            static_cast<int>(TransactionsViewModel::Columns::Amount));
-         const auto wallet = static_cast<bs::sync::Wallet*>(aIdx.data(
-            TransactionsViewModel::WalletRole).value<void*>());
-
-         if (!walletIds.isEmpty() && wallet->type() == bs::core::wallet::Type::ColorCoin) {
-            const auto a = aIdx.data(Qt::DisplayRole).toDouble();
-
-            switch (transactionDirection) {
-            case bs::sync::Transaction::Received : {
-               if (a < 0.0) {
-                  return false;
-               }
-            }
-               break;
-
-            case bs::sync::Transaction::Sent : {
-               if (a > 0.0) {
-                  return false;
-               }
-            }
-               break;
-
-            default :
-               return false;
-            }
-         } else if (direction != transactionDirection) {
-            return false;
-         }
-      }
-
-      bool result = true;
-
-      if ((startDate > 0) && (endDate > 0)) {
-         QModelIndex index = src->index(source_row, static_cast<int>(TransactionsViewModel::Columns::Date));
-         uint32_t txDate = src->data(index, TransactionsViewModel::FilterRole).toUInt();
-         result = (startDate <= txDate) && (txDate < endDate);
-      }
-
-      if (result && !searchString.isEmpty()) {     // more columns can be added later
-         for (const auto &col : { TransactionsViewModel::Columns::Comment, TransactionsViewModel::Columns::Address }) {
-            QModelIndex index = src->index(source_row, static_cast<int>(col));
-            if (src->data(index, TransactionsViewModel::FilterRole).toString().contains(searchString, Qt::CaseInsensitive)) {
-               return true;
-            }
-         }
-         return false;
-      }
-
-      return result;
-   }
-
-   bool filterAcceptsColumn(int source_column, const QModelIndex &source_parent) const override
-   {
-      Q_UNUSED(source_parent);
-/*      const auto col = static_cast<TransactionsViewModel::Columns>(source_column);
-      return (col != TransactionsViewModel::Columns::MissedBlocks);*/
-      return true;   // strange, but it works properly only this way
-   }
-
-   bool lessThan(const QModelIndex &left, const QModelIndex &right) const override
-   {
-      if (left.column() == static_cast<int>(TransactionsViewModel::Columns::Status)) {
-         QVariant leftData = sourceModel()->data(left, TransactionsViewModel::SortRole);
-         QVariant rightData = sourceModel()->data(right, TransactionsViewModel::SortRole);
-
-         if (leftData == rightData) {
-            // if sorting by confirmations, and values are equal, perform sorting by date in descending order
-            const QModelIndex leftDateIdx = sourceModel()->index(left.row(), static_cast<int>(TransactionsViewModel::Columns::Date));
-            const QModelIndex rightDateIdx = sourceModel()->index(right.row(), static_cast<int>(TransactionsViewModel::Columns::Date));
-            const auto lDate = sourceModel()->data(leftDateIdx, TransactionsViewModel::SortRole);
-            const auto rDate = sourceModel()->data(rightDateIdx, TransactionsViewModel::SortRole);
-
-            return lDate > rDate;
-         }
-      }
-
-      return QSortFilterProxyModel::lessThan(left, right);
-   }
-
-   void updateFilters(const QStringList &walletIds, const QString &searchString, bs::sync::Transaction::Direction direction)
-   {
-      this->walletIds = walletIds;
-      this->searchString = searchString;
-      this->transactionDirection = direction;
-
-      appSettings_->set(ApplicationSettings::TransactionFilter,
-         QVariantList() << (this->walletIds.isEmpty() ?
-            QStringList() << c_allWalletsId : this->walletIds) <<
-         static_cast<int>(direction));
-
-      invalidateFilter();
-   }
-
-   void updateDates(const QDate& start, const QDate& end)
-   {
-      this->startDate = start.isValid() ? QDateTime(start, QTime(), Qt::LocalTime).toTime_t() : 0;
-      this->endDate = end.isValid() ? QDateTime(end, QTime(), Qt::LocalTime).addDays(1).toTime_t() : 0;
-      invalidateFilter();
-   }
-
-   std::shared_ptr<ApplicationSettings> appSettings_;
-   QStringList walletIds;
-   QString searchString;
-   bs::sync::Transaction::Direction transactionDirection = bs::sync::Transaction::Unknown;
-   uint32_t startDate = 0;
-   uint32_t endDate = 0;
-};
-
-
 TransactionsWidget::TransactionsWidget(QWidget* parent)
    : TabWithShortcut(parent)
    , ui_(new Ui::TransactionsWidget())
@@ -544,6 +389,10 @@ void TransactionsWidget::onCreateRBFDialog()
    }
 
    const auto &cbDialog = [this](const TransactionPtr &txItem) {
+      if (!txItem) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load TX");
+         return;
+      }
       try {
          auto dlg = CreateTransactionDialogAdvanced::CreateForRBF(armory_
             , walletsManager_, utxoReservationManager_, signContainer_, logger_, appSettings_, txItem->tx
@@ -556,12 +405,13 @@ void TransactionsWidget::onCreateRBFDialog()
       }
    };
 
-   if (txItem->initialized) {
-      cbDialog(txItem);
-   }
-   else {
-      TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_, cbDialog);
-   }
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_
+      , [this, cbDialog](const TransactionPtr &item) {
+      QMetaObject::invokeMethod(this, [cbDialog, item] {
+         cbDialog(item);
+      });
+   });
 }
 
 void TransactionsWidget::onCreateCPFPDialog()
@@ -573,6 +423,10 @@ void TransactionsWidget::onCreateCPFPDialog()
    }
 
    const auto &cbDialog = [this](const TransactionPtr &txItem) {
+      if (!txItem) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load TX");
+         return;
+      }
       try {
          std::shared_ptr<bs::sync::Wallet> wallet;
          for (const auto &w : txItem->wallets) {
@@ -592,12 +446,13 @@ void TransactionsWidget::onCreateCPFPDialog()
       }
    };
 
-   if (txItem->initialized) {
-      cbDialog(txItem);
-   }
-   else {
-      TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_, cbDialog);
-   }
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_
+      , [this, cbDialog](const TransactionPtr &item) {
+      QMetaObject::invokeMethod(this, [cbDialog, item] {
+         cbDialog(item);
+      });
+   });
 }
 
 void TransactionsWidget::onRevokeSettlement()
@@ -693,6 +548,10 @@ void TransactionsWidget::onRevokeSettlement()
    const auto &cbDialog = [this, args, cbSettlCP]
       (const TransactionPtr &txItem)
    {
+      if (!txItem) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load TX");
+         return;
+      }
       for (int i = 0; i < txItem->tx.getNumTxOut(); ++i) {
          const auto &txOut = txItem->tx.getTxOutCopy(i);
          const auto &addr = bs::Address::fromTxOut(txOut);
@@ -714,11 +573,13 @@ void TransactionsWidget::onRevokeSettlement()
          , args->payinTxId, cbSettlCP);
    };
 
-   if (txItem->initialized) {
-      cbDialog(txItem);
-   } else {
-      TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_, cbDialog);
-   }
+   // Tx could be released by the model and then it's loaded in background
+   TransactionsViewItem::initialize(txItem, armory_.get(), walletsManager_
+      , [this, cbDialog](const TransactionPtr &item) {
+      QMetaObject::invokeMethod(this, [cbDialog, item] {
+         cbDialog(item);
+      });
+   });
 }
 
 void TransactionsWidget::onTXSigned(unsigned int id, BinaryData signedTX
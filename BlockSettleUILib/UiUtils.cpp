@@ -12,6 +12,7 @@
 
 #include "ApplicationSettings.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "BinaryData.h"
 #include "BlockDataManagerConfig.h"
 #include "BTCNumericTypes.h"
@@ -31,6 +32,8 @@
 #include <QAbstractItemModel>
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 #include <qrencode.h>
 
@@ -42,6 +45,189 @@ template <typename T> bool contains(const std::vector<T>& v, const T& value)
    return std::find(v.begin(), v.end(), value) != v.end();
 }
 
+namespace {
+   const uint64_t kPow10[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL
+      , 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL };
+   const int kMaxFastPrecision = 9;
+
+   // Fixed-point values below this bound survive conversion to double and back
+   // to the same number of decimals exactly
+   const int64_t kMaxFastFixedPoint = (1LL << 52) - 1;
+
+   // Number settings of default locale, as they appear after UnifyValueString.
+   // Updated in SetupLocale() before any formatting starts.
+   struct NumberFormat
+   {
+      bool  fast = false;
+      bool  grouping = false;
+      QChar decimalPoint;
+   };
+
+   NumberFormat currentNumberFormat()
+   {
+      const QLocale locale;
+      NumberFormat result;
+      // Other locales may use own digits and grouping - they go through QLocale
+      result.fast = (locale.language() == QLocale::C) && (locale.zeroDigit() == QLatin1Char('0'))
+         && (locale.negativeSign() == QLatin1Char('-'));
+      result.grouping = !(locale.numberOptions() & QLocale::OmitGroupSeparator);
+      result.decimalPoint = locale.decimalPoint();
+      return result;
+   }
+
+   NumberFormat &numberFormat()
+   {
+      static NumberFormat format = currentNumberFormat();
+      return format;
+   }
+
+   // 128-bit unsigned value, enough for 53-bit mantissa multiplied by 10^9
+   struct UInt128
+   {
+      uint64_t hi;
+      uint64_t lo;
+
+      bool bit(int i) const
+      {
+         if (i < 64) {
+            return (lo >> i) & 1;
+         }
+         if (i < 128) {
+            return (hi >> (i - 64)) & 1;
+         }
+         return false;
+      }
+
+      // true if all bits below i are zero
+      bool zeroBelow(int i) const
+      {
+         if (i <= 0) {
+            return true;
+         }
+         if (i < 64) {
+            return (lo & ((1ULL << i) - 1)) == 0;
+         }
+         if (lo != 0) {
+            return false;
+         }
+         if (i == 64) {
+            return true;
+         }
+         if (i < 128) {
+            return (hi & ((1ULL << (i - 64)) - 1)) == 0;
+         }
+         return hi == 0;
+      }
+
+      bool shiftRight(int n, uint64_t &result) const
+      {
+         if (n >= 128) {
+            result = 0;
+         }
+         else if (n >= 64) {
+            result = (n == 64) ? hi : (hi >> (n - 64));
+         }
+         else if (n == 0) {
+            if (hi != 0) {
+               return false;
+            }
+            result = lo;
+         }
+         else {
+            if ((hi >> n) != 0) {
+               return false;
+            }
+            result = (lo >> n) | (hi << (64 - n));
+         }
+         return true;
+      }
+   };
+
+   UInt128 multiply(uint64_t mantissa, uint32_t factor)
+   {
+      const uint64_t low = (mantissa & 0xFFFFFFFFULL) * factor;
+      const uint64_t high = (mantissa >> 32) * factor;
+      UInt128 result{ high >> 32, high << 32 };
+      result.lo += low;
+      if (result.lo < low) {
+         ++result.hi;
+      }
+      return result;
+   }
+
+   // Rounds |value| * 10^precision to the nearest integer using exact binary
+   // value of the double, as QLocale does. Fails for exact ties (rounding rule
+   // is left to QLocale), negative values rounded to zero, big values, NaN and inf.
+   bool scaleToInteger(double value, int precision, uint64_t &units, bool &negative)
+   {
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      negative = (bits >> 63) != 0;
+      const int biasedExp = static_cast<int>((bits >> 52) & 0x7FF);
+      uint64_t mantissa = bits & ((1ULL << 52) - 1);
+      if (biasedExp == 0x7FF) {
+         return false;
+      }
+      int exponent = -1074;
+      if (biasedExp != 0) {
+         mantissa |= (1ULL << 52);
+         exponent = biasedExp - 1075;
+      }
+      if (mantissa == 0) {
+         units = 0;
+         return !negative;
+      }
+      if (exponent >= 0) {
+         return false;
+      }
+      const auto scaled = multiply(mantissa, static_cast<uint32_t>(kPow10[precision]));
+      const int shift = -exponent;
+      if (!scaled.shiftRight(shift, units)) {
+         return false;
+      }
+      if (scaled.bit(shift - 1)) {
+         if (scaled.zeroBelow(shift - 1)) {
+            return false;
+         }
+         ++units;
+      }
+      return !(negative && (units == 0)) && (units <= static_cast<uint64_t>(INT64_MAX));
+   }
+
+   // Formats units / 10^decimals in a single allocation of the resulting string
+   QString formatUnits(uint64_t units, bool negative, int decimals, const NumberFormat &format)
+   {
+      QChar digits[32];
+      int nbDigits = 0;
+      do {
+         digits[nbDigits++] = QLatin1Char('0' + static_cast<char>(units % 10));
+         units /= 10;
+      } while (units != 0);
+      while (nbDigits <= decimals) {
+         digits[nbDigits++] = QLatin1Char('0');
+      }
+
+      QChar out[48];
+      int len = 0;
+      if (negative) {
+         out[len++] = QLatin1Char('-');
+      }
+      for (int i = nbDigits - decimals; i > 0; --i) {
+         out[len++] = digits[decimals + i - 1];
+         if (format.grouping && (i > 1) && ((i - 1) % 3 == 0)) {
+            out[len++] = defaultGroupSeparatorChar;
+         }
+      }
+      if (decimals > 0) {
+         out[len++] = format.decimalPoint;
+         for (int i = decimals; i > 0; --i) {
+            out[len++] = digits[i - 1];
+         }
+      }
+      return QString(out, len);
+   }
+}
+
 const QLatin1String UiUtils::XbtCurrency = QLatin1String("XBT");
 
 void UiUtils::SetupLocale()
@@ -55,6 +241,33 @@ void UiUtils::SetupLocale()
    locale.setNumberOptions(options);
 
    QLocale::setDefault(locale);
+   numberFormat() = currentNumberFormat();
+}
+
+QString UiUtils::formatDecimal(double value, int precision)
+{
+   const auto &format = numberFormat();
+   uint64_t units = 0;
+   bool negative = false;
+   if (format.fast && (precision >= 0) && (precision <= kMaxFastPrecision)
+      && scaleToInteger(value, precision, units, negative)) {
+      return formatUnits(units, negative, precision, format);
+   }
+   return UnifyValueString(QLocale().toString(value, 'f', precision));
+}
+
+QString UiUtils::formatFixedPoint(int64_t value, int decimals)
+{
+   const auto &format = numberFormat();
+   if (format.fast && (decimals >= 0) && (decimals <= kMaxFastPrecision)
+      && (value <= kMaxFastFixedPoint) && (value >= -kMaxFastFixedPoint)) {
+      const bool negative = (value < 0);
+      return formatUnits(negative ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value)
+         , negative, decimals, format);
+   }
+   const double divider = (decimals >= 0) && (decimals <= kMaxFastPrecision)
+      ? static_cast<double>(kPow10[decimals]) : std::pow(10.0, decimals);
+   return UnifyValueString(QLocale().toString(static_cast<double>(value) / divider, 'f', decimals));
 }
 
 QString UiUtils::displayDateTime(const QDateTime& datetime)
@@ -102,7 +315,7 @@ namespace UiUtils {
       if (std::isinf(value)) {
          return CommonUiUtilsText::tr("Loading...");
       }
-      return UnifyValueString(QLocale().toString(value, 'f', GetAmountPrecisionXBT()));
+      return formatDecimal(value, GetAmountPrecisionXBT());
    }
 
    template <> QString displayAmount(uint64_t value)
@@ -110,6 +323,9 @@ namespace UiUtils {
       if (value == UINT64_MAX) {
          return CommonUiUtilsText::tr("Loading...");
       }
+      if (value <= static_cast<uint64_t>(kMaxFastFixedPoint)) {
+         return formatFixedPoint(static_cast<int64_t>(value), GetAmountPrecisionXBT());
+      }
       return UnifyValueString(QLocale().toString(amountToBtc(value), 'f', GetAmountPrecisionXBT()));
    }
 
@@ -118,7 +334,7 @@ namespace UiUtils {
       if (value == INT64_MAX) {
          return CommonUiUtilsText::tr("Loading...");
       }
-      return UnifyValueString(QLocale().toString(amountToBtc(value), 'f', GetAmountPrecisionXBT()));
+      return formatFixedPoint(value, GetAmountPrecisionXBT());
 }
 
 double actualXbtPrice(bs::XBTAmount amount, double price)
@@ -204,17 +420,30 @@ int UiUtils::fillHDWalletsComboBox(QComboBox* comboBox, const std::shared_ptr<bs
    return selected;
 }
 
-void UiUtils::fillAuthAddressesComboBox(QComboBox* comboBox, const std::shared_ptr<AuthAddressManager> &authAddressManager)
+void UiUtils::fillAuthAddressesComboBox(QComboBox* comboBox, const std::shared_ptr<AuthAddressManager> &authAddressManager
+   , const std::shared_ptr<AuthAddressVerificationCache> &cache)
 {
    comboBox->clear();
-   const auto &addrList = authAddressManager->GetVerifiedAddressList();
+   std::vector<bs::Address> addrList;
+   if (cache) {
+      addrList = cache->verifiedAddresses(authAddressManager);
+   }
+   else {
+      const auto &verifiedList = authAddressManager->GetVerifiedAddressList();
+      addrList.assign(verifiedList.begin(), verifiedList.end());
+   }
    if (!addrList.empty()) {
       const auto b = comboBox->blockSignals(true);
+      int defaultIndex = 0;
+      const auto defaultAddr = authAddressManager->getDefault();
       for (const auto &address : addrList) {
+         if (address == defaultAddr) {
+            defaultIndex = comboBox->count();
+         }
          comboBox->addItem(QString::fromStdString(address.display()));
       }
       comboBox->blockSignals(b);
-      QMetaObject::invokeMethod(comboBox, "setCurrentIndex", Q_ARG(int, authAddressManager->getDefaultIndex()));
+      QMetaObject::invokeMethod(comboBox, "setCurrentIndex", Q_ARG(int, defaultIndex));
       comboBox->setEnabled(true);
    }
    else {
@@ -302,12 +531,12 @@ double UiUtils::parseAmountBtc(const QString& text)
 
 QString UiUtils::displayCurrencyAmount(double amount)
 {
-   return UnifyValueString(QLocale().toString(amount, 'f', GetAmountPrecisionFX()));
+   return formatDecimal(amount, GetAmountPrecisionFX());
 }
 
 QString UiUtils::displayCCAmount(double amount)
 {
-   return UnifyValueString(QLocale().toString(amount, 'f', GetAmountPrecisionCC()));
+   return formatDecimal(amount, GetAmountPrecisionCC());
 }
 
 QString UiUtils::displayQuantity(double quantity, const QString& currency)
@@ -372,17 +601,17 @@ QString UiUtils::displayPriceForAssetType(double price, bs::network::Asset::Type
 
 QString UiUtils::displayPriceFX(double price)
 {
-   return UnifyValueString(QLocale().toString(price, 'f', GetPricePrecisionFX()));
+   return formatDecimal(price, GetPricePrecisionFX());
 }
 
 QString UiUtils::displayPriceXBT(double price)
 {
-   return UnifyValueString(QLocale().toString(price, 'f', GetPricePrecisionXBT()));
+   return formatDecimal(price, GetPricePrecisionXBT());
 }
 
 QString UiUtils::displayPriceCC(double price)
 {
-   return UnifyValueString(QLocale().toString(price, 'f', GetPricePrecisionCC()));
+   return formatDecimal(price, GetPricePrecisionCC());
 }
 
 int UiUtils::GetPricePrecisionForAssetType(const bs::network::Asset::Type& assetType)
@@ -439,14 +668,14 @@ QString UiUtils::displayQty(double qty, const std::string &security, const std::
 {
    int qtyPrec = -1, valuePrec = -1;
    getPrecsFor(security, product, at, qtyPrec, valuePrec);
-   return UnifyValueString(QLocale().toString(qty, 'f', qtyPrec));
+   return formatDecimal(qty, qtyPrec);
 }
 
 QString UiUtils::displayValue(double value, const std::string &security, const std::string &product, bs::network::Asset::Type at)
 {
    int qtyPrec = -1, valuePrec = -1;
    getPrecsFor(security, product, at, qtyPrec, valuePrec);
-   return UnifyValueString(QLocale().toString(value, 'f', valuePrec));
+   return formatDecimal(value, valuePrec);
 }
 
 QString UiUtils::displayAddress(const QString &addr)
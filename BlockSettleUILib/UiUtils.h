@@ -36,6 +36,7 @@ namespace bs {
    }
 }
 class AuthAddressManager;
+class AuthAddressVerificationCache;
 class BinaryData;
 class PyBlockDataManager;
 class QComboBox;
@@ -71,6 +72,12 @@ namespace UiUtils
    constexpr int GetPricePrecisionCC();
 
    QString UnifyValueString(const QString& value);
+
+   // Produce the same strings as UnifyValueString(QLocale().toString(value, 'f', precision))
+   // but format digits directly with locale settings cached by SetupLocale()
+   QString formatDecimal(double value, int precision);
+   // Fixed-point value with given number of decimals (e.g. satoshis with 8 decimals)
+   QString formatFixedPoint(int64_t value, int decimals);
    QString NormalizeString(const QString& value);
 
    QValidator::State ValidateDoubleString(QString &input, int &pos, const int decimals);
@@ -128,7 +135,9 @@ namespace UiUtils
    };
    int fillHDWalletsComboBox(QComboBox* comboBox, const std::shared_ptr<bs::sync::WalletsManager>& walletsManager
       , int walletTypes);
-   void fillAuthAddressesComboBox(QComboBox* comboBox, const std::shared_ptr<AuthAddressManager>& authAddressManager);
+   // Addresses cached as Verified are listed too, until AuthAddressManager validates them
+   void fillAuthAddressesComboBox(QComboBox* comboBox, const std::shared_ptr<AuthAddressManager>& authAddressManager
+      , const std::shared_ptr<AuthAddressVerificationCache> &cache = nullptr);
    void fillRecvAddressesComboBox(QComboBox* comboBox, const std::shared_ptr<bs::sync::Wallet>& targetWallet);
    void fillRecvAddressesComboBoxHDWallet(QComboBox* comboBox
       , const std::shared_ptr<bs::sync::hd::Wallet>& targetHDWallet, bool showRegularWalletsOnly);
@@ -0,0 +1,650 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "UnixSocketConnection.h"
+
+#ifndef WIN32
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+   const size_t kHeaderSize = sizeof(uint32_t);
+   const size_t kMaxFrameSize = 64 * 1024 * 1024;
+   const size_t kReadChunkSize = 64 * 1024;
+   // client which doesn't read replies is disconnected when its queue exceeds this
+   const size_t kMaxQueuedSize = 4 * kMaxFrameSize;
+
+#ifdef MSG_NOSIGNAL
+   const int kSendFlags = MSG_NOSIGNAL;
+#else
+   const int kSendFlags = 0;
+#endif
+
+   void setNoSigPipe(int fd)
+   {
+#ifdef SO_NOSIGPIPE
+      int on = 1;
+      setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+      (void)fd;
+#endif
+   }
+
+   bool setNonBlocking(int fd)
+   {
+      const int flags = fcntl(fd, F_GETFL, 0);
+      return (flags >= 0) && (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+   }
+
+   bool makeAddress(const std::string &path, sockaddr_un &addr)
+   {
+      memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      if (path.empty() || (path.size() >= sizeof(addr.sun_path))) {
+         return false;
+      }
+      memcpy(addr.sun_path, path.data(), path.size());
+      return true;
+   }
+
+   bool peerUid(int fd, uid_t &uid)
+   {
+#ifdef SO_PEERCRED
+      struct ucred cred;
+      socklen_t len = sizeof(cred);
+      if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+         return false;
+      }
+      uid = cred.uid;
+      return true;
+#else
+      gid_t gid;
+      return (getpeereid(fd, &uid, &gid) == 0);
+#endif
+   }
+
+   bool isTrustedPeer(int fd, const std::shared_ptr<spdlog::logger> &logger)
+   {
+      uid_t uid;
+      if (!peerUid(fd, uid)) {
+         SPDLOG_LOGGER_ERROR(logger, "failed to get peer credentials: {}", strerror(errno));
+         return false;
+      }
+      if (uid != geteuid()) {
+         SPDLOG_LOGGER_ERROR(logger, "peer UID {} doesn't match own UID {}", uid, geteuid());
+         return false;
+      }
+      return true;
+   }
+
+   // Checks if some server accepts connections on the socket file
+   bool isSocketInUse(const sockaddr_un &addr)
+   {
+      const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (fd < 0) {
+         return false;
+      }
+      const bool result = (connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0);
+      close(fd);
+      return result;
+   }
+
+   std::string makeFrame(const std::string &data)
+   {
+      const uint32_t len = static_cast<uint32_t>(data.size());
+      std::string frame;
+      frame.reserve(kHeaderSize + data.size());
+      frame.append(reinterpret_cast<const char *>(&len), kHeaderSize);
+      frame.append(data);
+      return frame;
+   }
+
+   bool writeAll(int fd, const char *data, size_t size)
+   {
+      while (size > 0) {
+         const auto rc = ::send(fd, data, size, kSendFlags);
+         if (rc < 0) {
+            if (errno == EINTR) {
+               continue;
+            }
+            return false;
+         }
+         data += rc;
+         size -= static_cast<size_t>(rc);
+      }
+      return true;
+   }
+
+   bool writeFrame(int fd, const std::string &data)
+   {
+      if (data.size() > kMaxFrameSize) {
+         return false;
+      }
+      // Single write for small frames to avoid extra syscall
+      if (data.size() <= kReadChunkSize) {
+         const auto frame = makeFrame(data);
+         return writeAll(fd, frame.data(), frame.size());
+      }
+      const uint32_t len = static_cast<uint32_t>(data.size());
+      return writeAll(fd, reinterpret_cast<const char *>(&len), kHeaderSize)
+         && writeAll(fd, data.data(), data.size());
+   }
+
+   // Extracts all complete frames from buf, returns false on protocol violation
+   bool extractFrames(std::string &buf, std::vector<std::string> &frames)
+   {
+      size_t offset = 0;
+      while (buf.size() - offset >= kHeaderSize) {
+         uint32_t len = 0;
+         memcpy(&len, buf.data() + offset, kHeaderSize);
+         if (len > kMaxFrameSize) {
+            return false;
+         }
+         if (buf.size() - offset - kHeaderSize < len) {
+            break;
+         }
+         frames.emplace_back(buf, offset + kHeaderSize, len);
+         offset += kHeaderSize + len;
+      }
+      buf.erase(0, offset);
+      return true;
+   }
+
+}  // namespace
+
+
+UnixSocketServerConnection::UnixSocketServerConnection(const std::shared_ptr<spdlog::logger> &logger)
+   : logger_(logger)
+{}
+
+UnixSocketServerConnection::~UnixSocketServerConnection() noexcept
+{
+   stopServer();
+}
+
+bool UnixSocketServerConnection::BindConnection(const std::string &host, const std::string &
+   , ServerConnectionListener *listener)
+{
+   if (!listener) {
+      SPDLOG_LOGGER_ERROR(logger_, "listener is not set");
+      return false;
+   }
+   if (listenFd_ >= 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "already bound to {}", socketPath_);
+      return false;
+   }
+
+   sockaddr_un addr;
+   if (!makeAddress(host, addr)) {
+      SPDLOG_LOGGER_ERROR(logger_, "invalid socket path: {}", host);
+      return false;
+   }
+
+   struct stat st;
+   if (lstat(host.c_str(), &st) == 0) {
+      if (!S_ISSOCK(st.st_mode)) {
+         SPDLOG_LOGGER_ERROR(logger_, "{} exists and is not a socket", host);
+         return false;
+      }
+      if (isSocketInUse(addr)) {
+         SPDLOG_LOGGER_ERROR(logger_, "another server is listening on {}", host);
+         return false;
+      }
+      // remove stale socket file left after crash
+      unlink(host.c_str());
+   }
+
+   listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (listenFd_ < 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "socket failed: {}", strerror(errno));
+      return false;
+   }
+
+   if (bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to bind {}: {}", host, strerror(errno));
+      close(listenFd_);
+      listenFd_ = -1;
+      return false;
+   }
+   // restrict socket file to the owner before listen() - nobody can connect yet
+   if ((chmod(host.c_str(), S_IRUSR | S_IWUSR) != 0) || (listen(listenFd_, 16) != 0)
+      || (lstat(host.c_str(), &st) != 0)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to listen on {}: {}", host, strerror(errno));
+      close(listenFd_);
+      listenFd_ = -1;
+      unlink(host.c_str());
+      return false;
+   }
+   if ((pipe(wakeupFds_) != 0) || !setNonBlocking(wakeupFds_[0]) || !setNonBlocking(wakeupFds_[1])) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to create wakeup pipe: {}", strerror(errno));
+      close(listenFd_);
+      listenFd_ = -1;
+      unlink(host.c_str());
+      return false;
+   }
+
+   socketPath_ = host;
+   socketDev_ = st.st_dev;
+   socketIno_ = st.st_ino;
+   listener_ = listener;
+   stopped_ = false;
+   listenThread_ = std::thread(&UnixSocketServerConnection::listenFunction, this);
+   SPDLOG_LOGGER_DEBUG(logger_, "listening on {}", socketPath_);
+   return true;
+}
+
+void UnixSocketServerConnection::stopServer()
+{
+   if (listenFd_ < 0) {
+      return;
+   }
+   stopped_ = true;
+   wakeUp();
+   if (listenThread_.joinable()) {
+      listenThread_.join();
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      for (const auto &client : clients_) {
+         std::lock_guard<std::mutex> clientLock(client.second->mutex);
+         close(client.second->fd);
+         client.second->fd = -1;
+      }
+      clients_.clear();
+   }
+
+   close(listenFd_);
+   close(wakeupFds_[0]);
+   close(wakeupFds_[1]);
+   listenFd_ = -1;
+   wakeupFds_[0] = wakeupFds_[1] = -1;
+
+   // don't remove socket file if it was replaced by another server meanwhile
+   struct stat st;
+   if ((lstat(socketPath_.c_str(), &st) == 0) && (st.st_dev == socketDev_)
+      && (st.st_ino == socketIno_)) {
+      unlink(socketPath_.c_str());
+   }
+}
+
+void UnixSocketServerConnection::wakeUp()
+{
+   const char c = 0;
+   // pipe may be full if listen thread is already about to wake up
+   if ((write(wakeupFds_[1], &c, 1) < 0) && (errno != EAGAIN)) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to wake up listen thread: {}", strerror(errno));
+   }
+}
+
+void UnixSocketServerConnection::listenFunction()
+{
+   std::vector<pollfd> fds;
+   std::vector<std::pair<std::string, std::shared_ptr<Client>>> polledClients;
+
+   while (!stopped_) {
+      fds.clear();
+      polledClients.clear();
+      fds.push_back({ wakeupFds_[0], POLLIN, 0 });
+      fds.push_back({ listenFd_, POLLIN, 0 });
+      {
+         std::lock_guard<std::mutex> lock(clientsMutex_);
+         for (const auto &client : clients_) {
+            std::lock_guard<std::mutex> clientLock(client.second->mutex);
+            const short events = client.second->sendQueue.empty() ? POLLIN : (POLLIN | POLLOUT);
+            fds.push_back({ client.second->fd, events, 0 });
+            polledClients.push_back(client);
+         }
+      }
+
+      const auto rc = poll(fds.data(), fds.size(), -1);
+      if (rc < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         SPDLOG_LOGGER_ERROR(logger_, "poll failed: {}", strerror(errno));
+         break;
+      }
+      if (fds[0].revents) {
+         char buf[64];
+         while (read(wakeupFds_[0], buf, sizeof(buf)) > 0) {}
+      }
+      if (stopped_) {
+         break;
+      }
+      if (fds[1].revents & POLLIN) {
+         acceptClient();
+      }
+      for (size_t i = 0; i < polledClients.size(); ++i) {
+         const auto revents = fds[i + 2].revents;
+         if (!revents) {
+            continue;
+         }
+         const auto &client = polledClients[i].second;
+         bool connected = true;
+         if (revents & POLLOUT) {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            connected = flushClient(*client);
+         }
+         if (connected && (revents & ~POLLOUT)) {
+            connected = readFromClient(polledClients[i].first, client);
+         }
+         if (!connected) {
+            removeClient(polledClients[i].first);
+         }
+      }
+   }
+}
+
+void UnixSocketServerConnection::acceptClient()
+{
+   const int fd = accept(listenFd_, nullptr, nullptr);
+   if (fd < 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "accept failed: {}", strerror(errno));
+      return;
+   }
+   if (!isTrustedPeer(fd, logger_) || !setNonBlocking(fd)) {
+      close(fd);
+      return;
+   }
+   setNoSigPipe(fd);
+
+   auto client = std::make_shared<Client>();
+   client->fd = fd;
+   std::string clientId;
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      clientId = "uds_" + std::to_string(nextClientId_++);
+      clients_[clientId] = client;
+   }
+   listener_->OnClientConnected(clientId);
+}
+
+bool UnixSocketServerConnection::readFromClient(const std::string &clientId
+   , const std::shared_ptr<Client> &client)
+{
+   char chunk[kReadChunkSize];
+   const auto rc = recv(client->fd, chunk, sizeof(chunk), 0);
+   if (rc == 0) {
+      return false;
+   }
+   if (rc < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+         return true;
+      }
+      listener_->onClientError(clientId, strerror(errno));
+      return false;
+   }
+   client->readBuf.append(chunk, static_cast<size_t>(rc));
+
+   std::vector<std::string> frames;
+   if (!extractFrames(client->readBuf, frames)) {
+      listener_->onClientError(clientId, "invalid frame size");
+      return false;
+   }
+   for (const auto &frame : frames) {
+      listener_->OnDataFromClient(clientId, frame);
+   }
+   return true;
+}
+
+void UnixSocketServerConnection::removeClient(const std::string &clientId)
+{
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      const auto it = clients_.find(clientId);
+      if (it == clients_.end()) {
+         return;
+      }
+      {
+         std::lock_guard<std::mutex> clientLock(it->second->mutex);
+         close(it->second->fd);
+         it->second->fd = -1;
+         it->second->sendQueue.clear();
+      }
+      clients_.erase(it);
+   }
+   listener_->OnClientDisconnected(clientId);
+}
+
+bool UnixSocketServerConnection::SendDataToClient(const std::string &clientId, const std::string &data)
+{
+   std::shared_ptr<Client> client;
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      const auto it = clients_.find(clientId);
+      if (it == clients_.end()) {
+         return false;
+      }
+      client = it->second;
+   }
+   return queueFrame(client, data);
+}
+
+bool UnixSocketServerConnection::SendDataToAllClients(const std::string &data)
+{
+   std::vector<std::shared_ptr<Client>> clients;
+   {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      for (const auto &client : clients_) {
+         clients.push_back(client.second);
+      }
+   }
+   bool result = true;
+   for (const auto &client : clients) {
+      if (!queueFrame(client, data)) {
+         result = false;
+      }
+   }
+   return result;
+}
+
+bool UnixSocketServerConnection::queueFrame(const std::shared_ptr<Client> &client, const std::string &data)
+{
+   if (data.size() > kMaxFrameSize) {
+      return false;
+   }
+   {
+      std::lock_guard<std::mutex> lock(client->mutex);
+      if (client->fd < 0) {
+         return false;
+      }
+      if (client->queuedSize + data.size() > kMaxQueuedSize) {
+         SPDLOG_LOGGER_WARN(logger_, "client doesn't read data - disconnecting");
+         // listen thread removes the client on hangup
+         shutdown(client->fd, SHUT_RDWR);
+         return false;
+      }
+      const bool wasEmpty = client->sendQueue.empty();
+      client->sendQueue.push_back(makeFrame(data));
+      client->queuedSize += client->sendQueue.back().size();
+      if (!wasEmpty) {
+         return true;   // listen thread waits for the socket to become writable
+      }
+      if (!flushClient(*client)) {
+         shutdown(client->fd, SHUT_RDWR);
+         return false;
+      }
+      if (client->sendQueue.empty()) {
+         return true;
+      }
+   }
+   wakeUp();   // to poll for POLLOUT
+   return true;
+}
+
+bool UnixSocketServerConnection::flushClient(Client &client)
+{
+   while (!client.sendQueue.empty()) {
+      const auto &frame = client.sendQueue.front();
+      const auto rc = ::send(client.fd, frame.data() + client.sendOffset
+         , frame.size() - client.sendOffset, kSendFlags);
+      if (rc < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+      }
+      client.sendOffset += static_cast<size_t>(rc);
+      if (client.sendOffset == frame.size()) {
+         client.queuedSize -= frame.size();
+         client.sendOffset = 0;
+         client.sendQueue.pop_front();
+      }
+   }
+   return true;
+}
+
+
+UnixSocketDataConnection::UnixSocketDataConnection(const std::shared_ptr<spdlog::logger> &logger)
+   : logger_(logger)
+{}
+
+UnixSocketDataConnection::~UnixSocketDataConnection() noexcept
+{
+   closeConnection();
+}
+
+bool UnixSocketDataConnection::openConnection(const std::string &host, const std::string &
+   , DataConnectionListener *listener)
+{
+   if (!listener) {
+      SPDLOG_LOGGER_ERROR(logger_, "listener is not set");
+      return false;
+   }
+   if (isActive()) {
+      SPDLOG_LOGGER_ERROR(logger_, "connection is already opened");
+      return false;
+   }
+   if (readThread_.joinable()) {
+      readThread_.join();
+   }
+
+   sockaddr_un addr;
+   if (!makeAddress(host, addr)) {
+      SPDLOG_LOGGER_ERROR(logger_, "invalid socket path: {}", host);
+      return false;
+   }
+
+   const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "socket failed: {}", strerror(errno));
+      return false;
+   }
+   if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+      SPDLOG_LOGGER_ERROR(logger_, "failed to connect to {}: {}", host, strerror(errno));
+      close(fd);
+      return false;
+   }
+   // server must belong to the same user too
+   if (!isTrustedPeer(fd, logger_)) {
+      close(fd);
+      return false;
+   }
+   setNoSigPipe(fd);
+
+   listener_ = listener;
+   disconnectNotified_ = false;
+   fd_ = fd;
+   readThread_ = std::thread(&UnixSocketDataConnection::readFunction, this);
+   listener_->OnConnected();
+   return true;
+}
+
+bool UnixSocketDataConnection::closeConnection()
+{
+   const int fd = fd_.exchange(-1);
+   if (fd >= 0) {
+      std::lock_guard<std::mutex> lock(writeMutex_);
+      shutdown(fd, SHUT_RDWR);
+   }
+   // read thread is still joinable if connection was closed by server side
+   if (readThread_.joinable()) {
+      if (readThread_.get_id() == std::this_thread::get_id()) {
+         readThread_.detach();
+      }
+      else {
+         readThread_.join();
+      }
+   }
+   if (fd < 0) {
+      return false;
+   }
+   close(fd);
+   notifyDisconnected();
+   return true;
+}
+
+bool UnixSocketDataConnection::send(const std::string &data)
+{
+   std::lock_guard<std::mutex> lock(writeMutex_);
+   const int fd = fd_;
+   if (fd < 0) {
+      return false;
+   }
+   return writeFrame(fd, data);
+}
+
+void UnixSocketDataConnection::notifyDisconnected()
+{
+   if (!disconnectNotified_.exchange(true) && listener_) {
+      listener_->OnDisconnected();
+   }
+}
+
+void UnixSocketDataConnection::readFunction()
+{
+   const int fd = fd_;
+   std::string readBuf;
+   std::vector<std::string> frames;
+   char chunk[kReadChunkSize];
+
+   while (true) {
+      const auto rc = recv(fd, chunk, sizeof(chunk), 0);
+      if (rc < 0 && errno == EINTR) {
+         continue;
+      }
+      if (rc <= 0) {
+         break;
+      }
+      readBuf.append(chunk, static_cast<size_t>(rc));
+      frames.clear();
+      if (!extractFrames(readBuf, frames)) {
+         SPDLOG_LOGGER_ERROR(logger_, "invalid frame received");
+         listener_->OnError(DataConnectionListener::UndefinedSocketError);
+         break;
+      }
+      for (const auto &frame : frames) {
+         listener_->OnDataReceived(frame);
+      }
+   }
+
+   // closed by server side - release the socket unless closeConnection() took it
+   int expected = fd;
+   if (fd_.compare_exchange_strong(expected, -1)) {
+      {
+         std::lock_guard<std::mutex> lock(writeMutex_);
+         close(fd);
+      }
+      notifyDisconnected();
+   }
+}
+
+#endif   // WIN32
@@ -0,0 +1,132 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2016 - , BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __UNIX_SOCKET_CONNECTION_H__
+#define __UNIX_SOCKET_CONNECTION_H__
+
+// Same-host transport over Unix domain sockets. Peers are authenticated by the
+// kernel-provided credentials of the other end (effective UID must match),
+// so no BIP15X handshake or per-message encryption is needed.
+// Messages are framed as 4-byte length (host byte order) followed by payload.
+// Server sockets are non-blocking: outgoing frames are queued per client and
+// flushed from the listen thread, so a client which doesn't read its socket
+// can't stall the others.
+
+#ifndef WIN32
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/types.h>
+
+#include "DataConnection.h"
+#include "DataConnectionListener.h"
+#include "ServerConnection.h"
+#include "ServerConnectionListener.h"
+
+namespace spdlog {
+   class logger;
+}
+
+class UnixSocketServerConnection : public ServerConnection
+{
+public:
+   UnixSocketServerConnection(const std::shared_ptr<spdlog::logger> &);
+   ~UnixSocketServerConnection() noexcept override;
+
+   UnixSocketServerConnection(const UnixSocketServerConnection&) = delete;
+   UnixSocketServerConnection& operator = (const UnixSocketServerConnection&) = delete;
+
+   // host is the socket file path, port is not used
+   bool BindConnection(const std::string &host, const std::string &port
+      , ServerConnectionListener *) override;
+
+   bool SendDataToClient(const std::string &clientId, const std::string &data) override;
+   bool SendDataToAllClients(const std::string &data) override;
+
+   const std::string &socketPath() const { return socketPath_; }
+
+private:
+   struct Client
+   {
+      std::mutex  mutex;                     // guards fd and send queue
+      int         fd;
+      std::deque<std::string> sendQueue;     // framed messages
+      size_t      sendOffset = 0;            // sent part of sendQueue.front()
+      size_t      queuedSize = 0;
+      std::string readBuf;                   // used in listen thread only
+   };
+
+   void listenFunction();
+   void acceptClient();
+   bool readFromClient(const std::string &clientId, const std::shared_ptr<Client> &);
+   void removeClient(const std::string &clientId);
+   bool queueFrame(const std::shared_ptr<Client> &, const std::string &data);
+   bool flushClient(Client &);   // must be called with Client::mutex locked
+   void wakeUp();
+   void stopServer();
+
+private:
+   std::shared_ptr<spdlog::logger>  logger_;
+   ServerConnectionListener         *listener_{};
+
+   std::string socketPath_;
+   dev_t       socketDev_ = 0;
+   ino_t       socketIno_ = 0;
+   int         listenFd_ = -1;
+   int         wakeupFds_[2] = { -1, -1 };
+   std::thread listenThread_;
+   std::atomic_bool stopped_{ false };
+
+   std::mutex  clientsMutex_;
+   std::map<std::string, std::shared_ptr<Client>>  clients_;
+   uint64_t    nextClientId_ = 1;
+};
+
+
+class UnixSocketDataConnection : public DataConnection
+{
+public:
+   UnixSocketDataConnection(const std::shared_ptr<spdlog::logger> &);
+   ~UnixSocketDataConnection() noexcept override;
+
+   UnixSocketDataConnection(const UnixSocketDataConnection&) = delete;
+   UnixSocketDataConnection& operator = (const UnixSocketDataConnection&) = delete;
+
+   // host is the socket file path, port is not used
+   bool openConnection(const std::string &host, const std::string &port
+      , DataConnectionListener *) override;
+   bool closeConnection() override;
+
+   bool send(const std::string &data) override;
+
+   bool isActive() const { return (fd_ >= 0); }
+
+private:
+   void readFunction();
+   void notifyDisconnected();
+
+private:
+   std::shared_ptr<spdlog::logger>  logger_;
+   DataConnectionListener           *listener_{};
+
+   std::atomic_int   fd_{ -1 };
+   std::mutex        writeMutex_;
+   std::thread       readThread_;
+   std::atomic_bool  disconnectNotified_{ false };
+};
+
+#endif   // WIN32
+
+#endif // __UNIX_SOCKET_CONNECTION_H__
@@ -11,6 +11,7 @@
 #include "UsedInputsModel.h"
 
 #include "BtcUtils.h"
+#include "KeyedDiff.h"
 #include "TxClasses.h"
 #include "UiUtils.h"
 
@@ -37,9 +38,7 @@ int UsedInputsModel::columnCount(const QModelIndex & parent) const
 
 void UsedInputsModel::clear()
 {
-   beginResetModel();
-   inputs_.clear();
-   endResetModel();
+   applyInputs({});
 }
 
 QVariant UsedInputsModel::data(const QModelIndex & index, int role) const
@@ -95,15 +94,21 @@ void UsedInputsModel::updateInputs(const std::vector<UTXO>& usedInputs)
       }
    }
 
-   beginResetModel();
-
-   inputs_.clear();
-   inputs_.reserve(loadedInputs.size());
+   std::vector<InputData> newInputs;
+   newInputs.reserve(loadedInputs.size());
    for (const auto& i : loadedInputs) {
-      inputs_.emplace_back( i.second );
+      newInputs.emplace_back( i.second );
    }
+   applyInputs(std::move(newInputs));
+}
 
-   endResetModel();
+void UsedInputsModel::applyInputs(std::vector<InputData> newInputs)
+{
+   bs::ui::applyKeyedDiff(this, inputs_, std::move(newInputs)
+      , [](const InputData &input) { return input.address; }
+      , [](const InputData &lhs, const InputData &rhs) {
+         return (lhs.txCount == rhs.txCount) && (lhs.balance == rhs.balance);
+      });
 }
 
 QVariant UsedInputsModel::getRowData(const int column, const InputData& data) const
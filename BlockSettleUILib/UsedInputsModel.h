@@ -52,6 +52,8 @@ private:
    };
 private:
    QVariant getRowData(const int column, const InputData& data) const;
+   // Selected inputs change on each recalculation, diff keeps view selection and scroll
+   void applyInputs(std::vector<InputData>);
 
 private:
    std::vector<InputData> inputs_;
@@ -10,6 +10,7 @@
 */
 #include "UserScript.h"
 #include <spdlog/logger.h>
+#include <QMetaMethod>
 #include <QQmlComponent>
 #include <QQmlContext>
 #include "AssetManager.h"
@@ -224,19 +225,33 @@ AutoQuoter::AutoQuoter(const std::shared_ptr<spdlog::logger> &logger
    script_.load(filename);
 }
 
+AutoQuoter::~AutoQuoter()
+{
+   for (auto qrr : pool_) {
+      delete qrr;
+   }
+}
+
 QObject *AutoQuoter::instantiate(const bs::network::QuoteReqNotification &qrn)
 {
-   QObject *rv = script_.instantiate();
-   if (rv) {
-      BSQuoteReqReply *qrr = qobject_cast<BSQuoteReqReply *>(rv);
+   BSQuoteReqReply *qrr = nullptr;
+   if (!pool_.empty()) {
+      qrr = pool_.back();
+      pool_.pop_back();
+   }
+   else {
+      QObject *rv = script_.instantiate();
+      if (!rv) {
+         return nullptr;
+      }
+      qrr = qobject_cast<BSQuoteReqReply *>(rv);
+      if (!qrr) {
+         logger_->error("[AutoQuoter::instantiate] script root object is not BSQuoteReqReply");
+         delete rv;
+         return nullptr;
+      }
       qrr->init(logger_, assetManager_);
-
-      BSQuoteRequest *qr = new BSQuoteRequest(rv);
-      qr->init(QString::fromStdString(qrn.quoteRequestId), QString::fromStdString(qrn.product)
-         , (qrn.side == bs::network::Side::Buy), qrn.quantity, static_cast<int>(qrn.assetType));
-
-      qrr->setQuoteReq(qr);
-      qrr->setSecurity(QString::fromStdString(qrn.security));
+      qrr->setQuoteReq(new BSQuoteRequest(qrr));
 
       connect(qrr, &BSQuoteReqReply::sendingQuoteReply, [this](const QString &reqId, double price) {
          emit sendingQuoteReply(reqId, price);
@@ -244,15 +259,25 @@ QObject *AutoQuoter::instantiate(const bs::network::QuoteReqNotification &qrn)
       connect(qrr, &BSQuoteReqReply::pullingQuoteReply, [this](const QString &reqId) {
          emit pullingQuoteReply(reqId);
       });
-
-      qrr->start();
    }
-   return rv;
+
+   qrr->quoteReq()->init(QString::fromStdString(qrn.quoteRequestId), QString::fromStdString(qrn.product)
+      , (qrn.side == bs::network::Side::Buy), qrn.quantity, static_cast<int>(qrn.assetType));
+   qrr->setSecurity(QString::fromStdString(qrn.security));
+   qrr->start();
+   return qrr;
 }
 
 void AutoQuoter::destroy(QObject *o)
 {
-   delete o;
+   // only scripts which reset own state on recycled() can be safely reused
+   auto qrr = qobject_cast<BSQuoteReqReply *>(o);
+   if (!qrr || (pool_.size() >= kMaxPoolSize) || !qrr->isRecyclable()) {
+      delete o;
+      return;
+   }
+   qrr->recycle();
+   pool_.push_back(qrr);
 }
 
 void AutoQuoter::setWalletsManager(std::shared_ptr<bs::sync::WalletsManager> walletsManager)
@@ -276,6 +301,31 @@ void BSQuoteReqReply::init(const std::shared_ptr<spdlog::logger> &logger, const
    assetManager_ = assetManager;
 }
 
+void BSQuoteReqReply::recycle()
+{
+   started_ = false;
+   if (quoteReq_) {
+      quoteReq_->init({}, {}, false, 0, 0);
+   }
+   // Fields are reset without change notifications: script handlers of them
+   // would react (e.g. send a quote) for the request that no longer exists.
+   // Values set for the next request are notified by setters as usual.
+   security_.clear();
+   expirationInSec_ = 0;
+   indicBid_ = 0;
+   indicAsk_ = 0;
+   lastPrice_ = 0;
+   bestPrice_ = 0;
+   isOwnBestPrice_ = false;
+   emit recycled();
+}
+
+bool BSQuoteReqReply::isRecyclable() const
+{
+   static const auto recycledSignal = QMetaMethod::fromSignal(&BSQuoteReqReply::recycled);
+   return isSignalConnected(recycledSignal);
+}
+
 void BSQuoteReqReply::log(const QString &s)
 {
    logger_->info("[BSQuoteReply] {}", s.toStdString());
@@ -16,6 +16,7 @@
 #include "CommonTypes.h"
 
 #include <map>
+#include <vector>
 
 namespace spdlog {
    class logger;
@@ -26,6 +27,7 @@ namespace bs {
    }
 }
 class QQmlComponent;
+class BSQuoteReqReply;
 class AssetManager;
 class MDCallbacksQt;
 
@@ -149,9 +151,11 @@ public:
       , const std::shared_ptr<AssetManager> &
       , const std::shared_ptr<MDCallbacksQt> &
       , QObject* parent = nullptr);
-   ~AutoQuoter() override = default;
+   ~AutoQuoter() override;
 
+   //! Returns a pooled BSQuoteReqReply if available, creates a new one otherwise
    QObject *instantiate(const bs::network::QuoteReqNotification &qrn);
+   //! Recycles object into pool (up to kMaxPoolSize) if script supports it, deletes it otherwise
    void destroy(QObject *);
 
    void setWalletsManager(std::shared_ptr<bs::sync::WalletsManager> walletsManager);
@@ -163,9 +167,12 @@ signals:
    void pullingQuoteReply(const QString &reqId);
 
 private:
+   static const size_t kMaxPoolSize = 64;
+
    UserScript  script_;
    std::shared_ptr<spdlog::logger> logger_;
    std::shared_ptr<AssetManager> assetManager_;
+   std::vector<BSQuoteReqReply *>   pool_;
 };
 
 
@@ -292,6 +299,11 @@ public:
       }
    }
 
+   // Clears per-request state before the object is returned to AutoQuoter pool.
+   // Only scripts handling recycled() (to reset their own properties) are pooled.
+   void recycle();
+   bool isRecyclable() const;
+
 signals:
    void expirationInSecChanged();
    void indicBidChanged();
@@ -301,10 +313,11 @@ signals:
    void sendingQuoteReply(const QString &reqId, double price);
    void pullingQuoteReply(const QString &reqId);
    void started();
+   void recycled();
 
 private:
-   BSQuoteRequest *quoteReq_;
-   double   expirationInSec_;
+   BSQuoteRequest *quoteReq_ = nullptr;
+   double   expirationInSec_ = 0;
    QString  security_;
    double   indicBid_ = 0;
    double   indicAsk_ = 0;
@@ -87,7 +87,10 @@ void UserScriptHandler::onQuoteReqNotification(const bs::network::QuoteReqNotifi
       }
       if (aqEnabled_ && aq_ && (itAQObj == aqObjs_.end())) {
          QObject *obj = aq_->instantiate(qrn);
-         aqObjs_[qrn.quoteRequestId] = obj;
+         if (!obj) {
+            return;
+         }
+         addAqObject(qrn.quoteRequestId, obj);
 
          const auto &mdIt = mdInfo_.find(qrn.security);
          if (mdIt != mdInfo_.end()) {
@@ -108,15 +111,39 @@ void UserScriptHandler::onQuoteReqNotification(const bs::network::QuoteReqNotifi
    else {
       aqQuoteReqs_.erase(qrn.quoteRequestId);
       if (itAQObj != aqObjs_.end()) {
-         if (aq_) {
-            aq_->destroy(itAQObj->second);
-         }
-         aqObjs_.erase(qrn.quoteRequestId);
+         removeAqObject(qrn.quoteRequestId);
          bestQPrices_.erase(qrn.quoteRequestId);
       }
    }
 }
 
+void UserScriptHandler::addAqObject(const std::string &reqId, QObject *obj)
+{
+   aqObjs_[reqId] = obj;
+   auto *reqReply = qobject_cast<BSQuoteReqReply *>(obj);
+   aqObjsBySecurity_[reqReply->security().toStdString()].insert(reqReply);
+}
+
+void UserScriptHandler::removeAqObject(const std::string &reqId)
+{
+   const auto itAQObj = aqObjs_.find(reqId);
+   if (itAQObj == aqObjs_.end()) {
+      return;
+   }
+   auto *reqReply = qobject_cast<BSQuoteReqReply *>(itAQObj->second);
+   const auto itSec = aqObjsBySecurity_.find(reqReply->security().toStdString());
+   if (itSec != aqObjsBySecurity_.end()) {
+      itSec->second.erase(reqReply);
+      if (itSec->second.empty()) {
+         aqObjsBySecurity_.erase(itSec);
+      }
+   }
+   if (aq_) {
+      aq_->destroy(itAQObj->second);
+   }
+   aqObjs_.erase(itAQObj);
+}
+
 void UserScriptHandler::onQuoteReqCancelled(const QString &reqId, bool userCancelled)
 {
    const auto itQR = aqQuoteReqs_.find(reqId.toStdString());
@@ -180,6 +207,7 @@ void UserScriptHandler::deinitAQ(bool deleteAq)
       aq_->destroy(aqObj.second);
    }
    aqObjs_.clear();
+   aqObjsBySecurity_.clear();
    aqEnabled_ = false;
 
    if (deleteAq) {
@@ -228,24 +256,39 @@ void UserScriptHandler::onMDUpdate(bs::network::Asset::Type, const QString &secu
       mdInfo.lastPrice = last;
    }
 
-   for (auto aqObj : aqObjs_) {
-      QString sec = aqObj.second->property("security").toString();
-      if (sec.isEmpty() || (security != sec)) {
-         continue;
-      }
+   if (aqObjsBySecurity_.find(security.toStdString()) == aqObjsBySecurity_.end()) {
+      return;
+   }
+   mdDirty_.insert(security.toStdString());
+   if (!mdFlushPending_) {
+      mdFlushPending_ = true;
+      QMetaObject::invokeMethod(this, [this] { flushMD(); }, Qt::QueuedConnection);
+   }
+}
 
-      auto *reqReply = qobject_cast<BSQuoteReqReply *>(aqObj.second);
-      if (bid > 0) {
-         reqReply->setIndicBid(bid);
-      }
-      if (ask > 0) {
-         reqReply->setIndicAsk(ask);
+void UserScriptHandler::flushMD()
+{
+   mdFlushPending_ = false;
+   for (const auto &security : mdDirty_) {
+      const auto itSec = aqObjsBySecurity_.find(security);
+      if (itSec == aqObjsBySecurity_.end()) {
+         continue;
       }
-      if (last > 0) {
-         reqReply->setLastPrice(last);
+      const auto &mdInfo = mdInfo_[security];
+      for (auto *reqReply : itSec->second) {
+         if (mdInfo.bidPrice > 0) {
+            reqReply->setIndicBid(mdInfo.bidPrice);
+         }
+         if (mdInfo.askPrice > 0) {
+            reqReply->setIndicAsk(mdInfo.askPrice);
+         }
+         if (mdInfo.lastPrice > 0) {
+            reqReply->setLastPrice(mdInfo.lastPrice);
+         }
+         reqReply->start();
       }
-      reqReply->start();
    }
+   mdDirty_.clear();
 }
 
 void UserScriptHandler::onBestQuotePrice(const QString reqId, double price, bool own)
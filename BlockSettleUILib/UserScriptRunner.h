@@ -16,6 +16,7 @@
 #include <QTimer>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <string>
 #include <mutex>
@@ -77,6 +78,11 @@ private slots:
    void onAQPull(const QString &reqId);
    void aqTick();
 
+private:
+   void addAqObject(const std::string &reqId, QObject *);
+   void removeAqObject(const std::string &reqId);
+   void flushMD();
+
 private:
    AutoQuoter *aq_ = nullptr;
    std::shared_ptr<SignContainer>            signingContainer_;
@@ -86,6 +92,7 @@ private:
    std::shared_ptr<spdlog::logger> logger_;
 
    std::unordered_map<std::string, QObject*> aqObjs_;
+   std::unordered_map<std::string, std::unordered_set<BSQuoteReqReply *>>  aqObjsBySecurity_;
    std::unordered_map<std::string, bs::network::QuoteReqNotification> aqQuoteReqs_;
    std::unordered_map<std::string, double>   bestQPrices_;
 
@@ -96,6 +103,11 @@ private:
    };
    std::unordered_map<std::string, MDInfo>  mdInfo_;
 
+   // MD updates are conflated per security and delivered to AQ objects once
+   // all already queued updates are processed
+   std::unordered_set<std::string>  mdDirty_;
+   bool mdFlushPending_ = false;
+
    bool aqEnabled_;
    QTimer *aqTimer_;
 }; // class UserScriptHandler
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <spdlog/spdlog.h>
 
+#include "FeeEstimateCache.h"
 #include "UtxoReservation.h"
 #include "UtxoReservationToken.h"
 #include "Wallets/SyncHDWallet.h"
@@ -28,6 +29,7 @@ UTXOReservationManager::UTXOReservationManager(const std::shared_ptr<bs::sync::W
    : walletsManager_(walletsManager)
    , armory_(armory)
    , logger_(logger)
+   , feeEstimates_(FeeEstimateCache::instance(logger, armory))
 {
    connect(walletsManager_.get(), &bs::sync::WalletsManager::walletsSynchronized,
       this, &UTXOReservationManager::refreshAvailableUTXO, Qt::QueuedConnection);
@@ -65,12 +67,20 @@ bs::UtxoReservationToken bs::UTXOReservationManager::makeNewReservation(const st
 void UTXOReservationManager::reserveBestXbtUtxoSet(const HDWalletId& walletId, BTCNumericTypes::satoshi_type quantity, bool partial,
    std::function<void(FixedXbtInputs&&)>&& cb, bool checkPbFeeFloor)
 {
-   auto bestUtxoSetCb = [mgr = QPointer<bs::UTXOReservationManager>(this), walletId, partial
-         , cbFixedXBT = std::move(cb)](std::vector<UTXO>&& utxos) {
+   auto bestUtxoSetCb = [mgr = QPointer<bs::UTXOReservationManager>(this), walletId, quantity, partial
+         , cbFixedXBT = std::move(cb), checkPbFeeFloor](std::vector<UTXO>&& utxos) mutable {
       if (!mgr) {
          return;
       }
 
+      // UTXOs are selected before fee estimation completes, so concurrent
+      // requests could pick the same set - select again from what is left
+      if (UtxoReservation::instance()->containsReservedUTXO(utxos)) {
+         SPDLOG_LOGGER_DEBUG(mgr->logger_, "selected UTXOs were reserved meanwhile - reselecting");
+         mgr->reserveBestXbtUtxoSet(walletId, quantity, partial, std::move(cbFixedXBT), checkPbFeeFloor);
+         return;
+      }
+
       FixedXbtInputs fixedXbtInputs;
       if (partial) {
          fixedXbtInputs = std::move(mgr->convertUtxoToPartialFixedInput(walletId, utxos));
@@ -145,7 +155,7 @@ void bs::UTXOReservationManager::getBestXbtUtxoSet(const HDWalletId& walletId,
          }
       });
    };
-   armory_->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
+   feeEstimates_->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
 }
 
 BTCNumericTypes::balance_type bs::UTXOReservationManager::getAvailableCCUtxoSum(const CCProductName& CCProduct) const
@@ -212,6 +222,11 @@ float UTXOReservationManager::feeRatePb() const
    return feeRatePb_.load();
 }
 
+bool UTXOReservationManager::estimateFee(unsigned int nbBlocks, const std::function<void(float)> &cb)
+{
+   return feeEstimates_->estimateFee(nbBlocks, cb);
+}
+
 void bs::UTXOReservationManager::refreshAvailableUTXO()
 {
    availableXbtUTXOs_.clear();
@@ -32,6 +32,7 @@ namespace bs {
 class ArmoryObject;
 
 namespace bs {
+   class FeeEstimateCache;
 
    class UTXOReservationManager : public QObject
    {
@@ -75,6 +76,9 @@ namespace bs {
       void setFeeRatePb(float feeRate);
       float feeRatePb() const;
 
+      // Armory fee estimate shared by all trading widgets (see FeeEstimateCache)
+      bool estimateFee(unsigned int nbBlocks, const std::function<void(float)> &cb);
+
    signals:
       void availableUtxoChanged(const std::string& walledId);
 
@@ -102,6 +106,7 @@ namespace bs {
       std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
       std::shared_ptr<ArmoryObject> armory_;
       std::shared_ptr<spdlog::logger> logger_;
+      std::shared_ptr<FeeEstimateCache>   feeEstimates_;
 
       std::atomic<float> feeRatePb_{};
    };
@@ -92,4 +92,8 @@ BSQuoteReqReply {		// Class name for Dealer replies. Don't change it!
     onSendFailed: {	// Invoked when sending of reply has failed
         log("Sending failed: " + reason)
     }
+
+    onRecycled: {	// Object will be reused for another quote request - reset own state here
+        prevSendPrice = 0
+    }
 }
@@ -72,6 +72,11 @@ BSQuoteReqReply {
     onSendFailed: {
 
     }
+    onRecycled: {
+        initialPrice = 0.0;
+        isContraCur.value = undefined;
+        direction.value = undefined;
+    }
 
     function checkPrice(price) {
         if (initialPrice){
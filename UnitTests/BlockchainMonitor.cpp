@@ -50,6 +50,21 @@ std::vector<bs::TXEntry> BlockchainMonitor::waitForZC()
    }
 }
 
+std::vector<bs::TXEntry> BlockchainMonitor::waitForZC(const std::chrono::milliseconds timeout)
+{
+   const auto napTime = std::chrono::milliseconds{10};
+   for (auto elapsed = std::chrono::milliseconds{0}; elapsed < timeout; elapsed += napTime) {
+      try {
+         return zcQueue_.pop_front();
+      }
+      catch (ArmoryThreading::IsEmpty&)
+      {}
+
+      std::this_thread::sleep_for(napTime);
+   }
+   return {};
+}
+
 std::vector<bs::TXEntry> BlockchainMonitor::waitForZCs(int count)
 {
    std::vector<bs::TXEntry> result;
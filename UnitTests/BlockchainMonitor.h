@@ -27,6 +27,8 @@ public:
 
    uint32_t waitForNewBlocks(uint32_t targetHeight = 0);
    std::vector<bs::TXEntry> waitForZC(void);
+   // Returns empty vector if no ZC arrived within timeout
+   std::vector<bs::TXEntry> waitForZC(const std::chrono::milliseconds timeout);
    std::vector<bs::TXEntry> waitForZCs(int count);
 
    static bool waitForFlag(std::atomic_bool &
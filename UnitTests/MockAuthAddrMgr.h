@@ -31,6 +31,8 @@ public:
    std::vector<bs::Address> GetVerifiedAddressList() const override { return addresses_; }
 
    void OnDisconnectedFromCeler() override {}
+
+   void setState(const bs::Address &addr, AddressVerificationState state) { states_[addr] = state; }
 };
 
 #endif // __MOCK_AUTH_ADDR_MGR_H__
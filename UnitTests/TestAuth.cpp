@@ -43,8 +43,11 @@ check unflagged return
       if outpoint is bs auth address -> valid
 */
 
+#include <QApplication>
 #include <spdlog/spdlog.h>
 #include "ApplicationSettings.h"
+#include "AuthAddressVerificationCache.h"
+#include "AuthAddressViewModel.h"
 #include "CheckRecipSigner.h"
 #include "CoreHDWallet.h"
 #include "CoreWalletsManager.h"
@@ -54,6 +57,7 @@ check unflagged return
 #include "Wallets/SyncWalletsManager.h"
 #include "AddressVerificator.h"
 
+#include "MockAuthAddrMgr.h"
 #include "TestAuth.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -405,6 +409,206 @@ TEST_F(TestAuth, ValidateUserAddress)
    ASSERT_TRUE(AuthAddressLogic::isValid(vam, userAddr));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+TEST_F(TestAuth, VerificationCache)
+{
+   //sync wallets
+   auto promSync = std::make_shared<std::promise<bool>>();
+   auto futSync = promSync->get_future();
+   const auto &cbSync = [this, promSync](int cur, int total) {
+      if (cur == total) {
+         promSync->set_value(true);
+      }
+   };
+   syncMgr_->syncWallets(cbSync);
+   futSync.wait();
+
+   authWallet_ = syncMgr_->getWalletById(authSignWallet_->walletId());
+   ASSERT_NE(authWallet_, nullptr);
+
+   ValidationAddressManager vam(envPtr_->armoryConnection());
+   vam.setCustomACT(actPtr_);
+   vam.addValidationAddress(validationAddr_);
+   ASSERT_EQ(vam.goOnline(), 2);
+
+   auto promPtr = std::make_shared<std::promise<bs::Address>>();
+   auto fut = promPtr->get_future();
+   authWallet_->getNewExtAddress([promPtr](const bs::Address& addr) {
+      promPtr->set_value(addr);
+   });
+   const auto userAddr = fut.get();
+
+   try {
+      actPtr_->waitOnZC(vam.vetUserAddress(userAddr, validationFeed_));
+   }
+   catch (AuthLogicException&) {
+      ASSERT_TRUE(false);
+   }
+   mineBlocks(6);
+   vam.update();
+   ASSERT_TRUE(AuthAddressLogic::isValid(vam, userAddr));
+
+   const auto cacheFile = QString::fromStdString(envPtr_->armoryInstance()->homedir_)
+      + QLatin1String("/authaddr_cache.dat");
+   const auto waitForUpdate = [](const std::atomic<int> &nbUpdates, int expected) {
+      const auto start = std::chrono::steady_clock::now();
+      while ((nbUpdates < expected)
+         && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+         QApplication::processEvents();
+      }
+      return (nbUpdates >= expected);
+   };
+
+   //store verification result, as AuthAddressManager would do
+   {
+      std::atomic<int> nbUpdates{ 0 };
+      AuthAddressVerificationCache cache(envPtr_->logger(), envPtr_->armoryConnection(), cacheFile);
+      QObject::connect(&cache, &AuthAddressVerificationCache::updated, [&nbUpdates] { ++nbUpdates; });
+      cache.put(userAddr, AddressVerificationState::Verified);
+      ASSERT_TRUE(waitForUpdate(nbUpdates, 1));
+   }
+
+   //restart - state is available without any Armory request
+   std::atomic<int> nbUpdates{ 0 };
+   auto cache = std::make_shared<AuthAddressVerificationCache>(envPtr_->logger()
+      , envPtr_->armoryConnection(), cacheFile);
+   QObject::connect(cache.get(), &AuthAddressVerificationCache::updated, [&nbUpdates] { ++nbUpdates; });
+   const auto loadStart = std::chrono::steady_clock::now();
+   ASSERT_TRUE(cache->load());
+   AddressVerificationState state = AddressVerificationState::InProgress;
+   ASSERT_TRUE(cache->get(userAddr, state));
+   const auto loadUs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - loadStart).count();
+   EXPECT_EQ(state, AddressVerificationState::Verified);
+   RecordProperty("cache_load_us", std::to_string(loadUs));
+
+   //model shows cached state while address is still being verified
+   const auto authAddrMgr = envPtr_->authAddrMgr();
+   const auto mockAddr = authAddrMgr->GetVerifiedAddressList().front();
+   cache->put(mockAddr, AddressVerificationState::Verified);
+   ASSERT_TRUE(waitForUpdate(nbUpdates, 2));
+   authAddrMgr->setState(mockAddr, AddressVerificationState::InProgress);
+   AuthAddressViewModel model(authAddrMgr, cache);
+   emit authAddrMgr->AddressListUpdated();
+   const auto start = std::chrono::steady_clock::now();
+   while ((model.rowCount() == 0)
+      && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+      QApplication::processEvents();
+   }
+   ASSERT_GT(model.rowCount(), 0);
+   EXPECT_EQ(model.data(model.index(0, 1)).toString(), QLatin1String("Verified"));
+   authAddrMgr->setState(mockAddr, AddressVerificationState::Verified);
+
+   //block not touching user address keeps the entry
+   mineBlocks(1);
+   std::this_thread::sleep_for(std::chrono::seconds(1));
+   QApplication::processEvents();
+   ASSERT_TRUE(cache->get(userAddr, state));
+   EXPECT_EQ(state, AddressVerificationState::Verified);
+
+   //user revoke spends auth address output and invalidates the entry once mined
+   try {
+      const bs::core::WalletPasswordScoped lockPass(priWallet_, passphrase_);
+      const auto lock = authSignWallet_->lockDecryptedContainer();
+      AuthAddressLogic::revoke(vam, userAddr, authSignWallet_->getResolver());
+   }
+   catch (const std::exception &) {
+      ASSERT_TRUE(false);
+   }
+   //no ZC notification for auth addresses - see Revoke test
+   std::this_thread::sleep_for(std::chrono::seconds(2));
+   ASSERT_TRUE(cache->get(userAddr, state));
+
+   const auto updatesBefore = nbUpdates.load();
+   mineBlocks(1);
+   ASSERT_TRUE(waitForUpdate(nbUpdates, updatesBefore + 1));
+   EXPECT_FALSE(cache->get(userAddr, state));
+   EXPECT_TRUE(cache->get(mockAddr, state));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_F(TestAuth, VerificationCacheValidationRevoke)
+{
+   //sync wallets
+   auto promSync = std::make_shared<std::promise<bool>>();
+   auto futSync = promSync->get_future();
+   const auto &cbSync = [this, promSync](int cur, int total) {
+      if (cur == total) {
+         promSync->set_value(true);
+      }
+   };
+   syncMgr_->syncWallets(cbSync);
+   futSync.wait();
+
+   authWallet_ = syncMgr_->getWalletById(authSignWallet_->walletId());
+   ASSERT_NE(authWallet_, nullptr);
+
+   ValidationAddressManager vam(envPtr_->armoryConnection());
+   vam.setCustomACT(actPtr_);
+   vam.addValidationAddress(validationAddr_);
+   ASSERT_EQ(vam.goOnline(), 2);
+
+   auto promPtr = std::make_shared<std::promise<bs::Address>>();
+   auto fut = promPtr->get_future();
+   authWallet_->getNewExtAddress([promPtr](const bs::Address& addr) {
+      promPtr->set_value(addr);
+   });
+   const auto userAddr = fut.get();
+
+   try {
+      actPtr_->waitOnZC(vam.vetUserAddress(userAddr, validationFeed_));
+   }
+   catch (AuthLogicException&) {
+      ASSERT_TRUE(false);
+   }
+   mineBlocks(6);
+   vam.update();
+   ASSERT_TRUE(AuthAddressLogic::isValid(vam, userAddr));
+
+   const auto cacheFile = QString::fromStdString(envPtr_->armoryInstance()->homedir_)
+      + QLatin1String("/authaddr_cache_revoke.dat");
+   std::atomic<int> nbUpdates{ 0 };
+   const auto waitForUpdate = [&nbUpdates](int expected) {
+      const auto start = std::chrono::steady_clock::now();
+      while ((nbUpdates < expected)
+         && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+         QApplication::processEvents();
+      }
+      return (nbUpdates >= expected);
+   };
+
+   //validation outpoint is stored with the entry and survives restart
+   {
+      AuthAddressVerificationCache cache(envPtr_->logger(), envPtr_->armoryConnection(), cacheFile);
+      QObject::connect(&cache, &AuthAddressVerificationCache::updated, [&nbUpdates] { ++nbUpdates; });
+      cache.put(userAddr, AddressVerificationState::Verified);
+      ASSERT_TRUE(waitForUpdate(1));
+   }
+   nbUpdates = 0;
+   AuthAddressVerificationCache cache(envPtr_->logger(), envPtr_->armoryConnection(), cacheFile);
+   QObject::connect(&cache, &AuthAddressVerificationCache::updated, [&nbUpdates] { ++nbUpdates; });
+   ASSERT_TRUE(cache.load());
+   ASSERT_TRUE(waitForUpdate(1));
+
+   //user address is not touched by the revocation, only validation address is
+   try {
+      actPtr_->waitOnZC(vam.revokeValidationAddress(validationAddr_, validationFeed_));
+   }
+   catch (AuthLogicException&) {
+      ASSERT_TRUE(false);
+   }
+   AddressVerificationState state = AddressVerificationState::InProgress;
+   ASSERT_TRUE(cache.get(userAddr, state));
+   EXPECT_EQ(state, AddressVerificationState::Verified);
+
+   const auto updatesBefore = nbUpdates.load();
+   mineBlocks(1);
+   vam.update();
+   EXPECT_FALSE(AuthAddressLogic::isValid(vam, userAddr));
+   ASSERT_TRUE(waitForUpdate(updatesBefore + 1));
+   EXPECT_FALSE(cache.get(userAddr, state));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 TEST_F(TestAuth, BadUserAddress)
 {  // This test crashes in Armory code:
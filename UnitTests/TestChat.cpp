@@ -2,3 +2,284 @@
 #include <QString>
 #include "TestEnv.h"
 
+
+#include <chrono>
+#include <QAbstractItemModelTester>
+#include "ChatProtocol/ClientPartyModel.h"
+#include "ChatUI/ChatPartiesSortProxyModel.h"
+#include "ChatUI/ChatPartiesTreeModel.h"
+#include "ChatUI/UserSearchRequester.h"
+#include "Trading/OtcClient.h"
+
+namespace {
+
+   std::string partyName(int i)
+   {
+      return "party_" + std::to_string(i);
+   }
+
+   void addPrivateParty(const Chat::ClientPartyModelPtr &partyModel, int i, Chat::PartyState state)
+   {
+      auto party = std::make_shared<Chat::ClientParty>(partyName(i), Chat::PartyType::PRIVATE_DIRECT_MESSAGE
+         , Chat::PartySubType::STANDARD, state);
+      party->setDisplayName(partyName(i));
+      partyModel->insertParty(party);
+   }
+
+   // Collects searches and replies (with all users containing searched text)
+   // only when asked to
+   class FakeChatSearchClient
+   {
+   public:
+      explicit FakeChatSearchClient(const std::vector<std::string> &users)
+         : users_(users)
+      {}
+
+      void setRequester(UserSearchRequester *requester) { requester_ = requester; }
+
+      void searchUser(const std::string &text, const std::string &searchId)
+      {
+         requests_.push_back(text);
+         UserSearchRequester::Results result;
+         for (const auto &user : users_) {
+            if (user.find(text) != std::string::npos) {
+               result.push_back(user);
+            }
+         }
+         pending_.push_back({ searchId, result });
+      }
+
+      void replyAll()
+      {
+         const auto pending = std::move(pending_);
+         pending_.clear();
+         for (const auto &reply : pending) {
+            requester_->onSearchReply(reply.second, reply.first);
+         }
+      }
+
+      const std::vector<std::string> &requests() const { return requests_; }
+
+   private:
+      std::vector<std::string> users_;
+      UserSearchRequester *requester_{};
+      std::vector<std::string> requests_;
+      std::vector<std::pair<std::string, UserSearchRequester::Results>> pending_;
+   };
+
+} // namespace
+
+TEST(TestChat, UserSearchDebounceAndCache)
+{
+   FakeChatSearchClient client({ "alice", "alice_smith", "alina", "bob", "bobby", "carol" });
+   UserSearchRequester requester([&client](const std::string &text, const std::string &searchId) {
+      client.searchUser(text, searchId);
+   });
+   // debounce timer never fires during the test, pending search is sent by flush()
+   requester.setDebounceInterval(std::chrono::hours(1));
+   client.setRequester(&requester);
+
+   std::vector<std::pair<std::string, UserSearchRequester::Results>> results;
+   QObject::connect(&requester, &UserSearchRequester::resultsReady
+      , [&results](const std::string &text, const UserSearchRequester::Results &users) {
+      results.push_back({ text, users });
+   });
+
+   const auto type = [&requester](const std::string &from, const std::string &to) {
+      for (size_t len = from.size() + 1; len <= to.size(); ++len) {
+         requester.search(to.substr(0, len));
+      }
+   };
+
+   // Fast typing - single request for the final text
+   type("al", "alic");
+   EXPECT_TRUE(client.requests().empty());
+   requester.flush();
+   ASSERT_EQ(client.requests().size(), 1);
+   EXPECT_EQ(client.requests().back(), "alic");
+   EXPECT_TRUE(results.empty());
+   client.replyAll();
+   ASSERT_EQ(results.size(), 1);
+   EXPECT_EQ(results.back().first, "alic");
+   EXPECT_EQ(results.back().second, UserSearchRequester::Results({ "alice", "alice_smith" }));
+
+   // Longer text is not derived from cached reply
+   type("alic", "alice_s");
+   requester.flush();
+   ASSERT_EQ(client.requests().size(), 2);
+   EXPECT_EQ(client.requests().back(), "alice_s");
+   client.replyAll();
+   ASSERT_EQ(results.back().first, "alice_s");
+   EXPECT_EQ(results.back().second, UserSearchRequester::Results({ "alice_smith" }));
+
+   // Exact repeat is answered from cache without debounce
+   requester.search("alic");
+   EXPECT_EQ(client.requests().size(), 2);
+   EXPECT_EQ(results.back().first, "alic");
+   EXPECT_EQ(results.back().second, UserSearchRequester::Results({ "alice", "alice_smith" }));
+
+   // Reply for outdated text is cached but not reported
+   const auto resultsCount = results.size();
+   requester.searchNow("bob");
+   requester.search("car");
+   requester.flush();
+   EXPECT_EQ(client.requests().size(), 4);
+   client.replyAll();
+   ASSERT_EQ(results.size(), resultsCount + 1);
+   EXPECT_EQ(results.back().first, "car");
+   requester.searchNow("bob");
+   EXPECT_EQ(client.requests().size(), 4);
+   EXPECT_EQ(results.back().first, "bob");
+
+   // Same text in flight is not requested again
+   requester.searchNow("dan");
+   requester.search("dan");
+   requester.flush();
+   EXPECT_EQ(client.requests().size(), 5);
+   client.replyAll();
+   EXPECT_EQ(results.back().first, "dan");
+   EXPECT_TRUE(results.back().second.empty());
+
+   // Cancelled search is not reported
+   const auto countBeforeCancel = results.size();
+   requester.searchNow("dave");
+   requester.cancel();
+   client.replyAll();
+   EXPECT_EQ(results.size(), countBeforeCancel);
+   RecordProperty("requests_sent", static_cast<int>(requester.requestsSent()));
+}
+
+TEST(TestChat, PartiesTreeModelIncremental)
+{
+   const int kParties = 10000;
+   const int kChanged = 1000;
+
+   auto partyModel = std::make_shared<Chat::ClientPartyModel>(StaticLogger::loggerPtr);
+   OtcClientParams params;
+   OtcClient otc(StaticLogger::loggerPtr, nullptr, nullptr, nullptr, nullptr, nullptr, params);
+   ChatPartiesTreeModel model(partyModel, &otc);
+   QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+
+   int resetCount = 0;
+   QObject::connect(&model, &QAbstractItemModel::modelReset, [&resetCount] { ++resetCount; });
+
+   partyModel->insertParty(std::make_shared<Chat::ClientParty>("global_room", Chat::PartyType::GLOBAL
+      , Chat::PartySubType::STANDARD, Chat::PartyState::INITIALIZED));
+   partyModel->insertParty(std::make_shared<Chat::ClientParty>("otc_room", Chat::PartyType::GLOBAL
+      , Chat::PartySubType::OTC, Chat::PartyState::INITIALIZED));
+   // Even parties are accepted contacts, odd ones are contact requests
+   for (int i = 0; i < kParties; ++i) {
+      addPrivateParty(partyModel, i, (i % 2) ? Chat::PartyState::REQUESTED : Chat::PartyState::INITIALIZED);
+   }
+   model.onPartyModelChanged();
+   ASSERT_EQ(resetCount, 1);
+
+   const auto privateIndex = model.getPartyIndexById(ChatModelNames::ContainerTabPrivate.toStdString());
+   const auto requestIndex = model.getPartyIndexById(ChatModelNames::ContainerTabContactRequest.toStdString());
+   ASSERT_TRUE(privateIndex.isValid());
+   ASSERT_TRUE(requestIndex.isValid());
+   EXPECT_EQ(model.rowCount(privateIndex), kParties / 2);
+   EXPECT_EQ(model.rowCount(requestIndex), kParties / 2);
+   ASSERT_TRUE(model.getOTCGlobalRoot().isValid());
+
+   for (int i = 0; i < kParties; ++i) {
+      const auto index = model.getPartyIndexById(partyName(i));
+      ASSERT_TRUE(index.isValid());
+      ASSERT_EQ(index.parent(), (i % 2) ? requestIndex : privateIndex);
+   }
+
+   const QPersistentModelIndex keptIndex = model.getPartyIndexById(partyName(kParties - 2));
+
+   // Remove first kChanged parties, accept next kChanged requests and add kChanged new parties
+   for (int i = 0; i < kChanged; ++i) {
+      partyModel->removePartyById(partyName(i));
+   }
+   int accepted = 0;
+   for (int i = kChanged; i < 2 * kChanged; ++i) {
+      if (i % 2) {
+         partyModel->getClientPartyById(partyName(i))->setPartyState(Chat::PartyState::INITIALIZED);
+         ++accepted;
+      }
+   }
+   for (int i = kParties; i < kParties + kChanged; ++i) {
+      addPrivateParty(partyModel, i, Chat::PartyState::INITIALIZED);
+   }
+   model.onIncreaseUnseenCounter(partyName(kChanged + 1), 5);
+
+   const auto startTime = std::chrono::steady_clock::now();
+   model.onPartyModelChanged();
+   const auto updateMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime).count();
+   RecordProperty("incremental_update_ms", static_cast<int>(updateMs));
+
+   EXPECT_EQ(resetCount, 1);
+   EXPECT_EQ(model.rowCount(privateIndex), kParties / 2 - kChanged / 2 + accepted + kChanged);
+   EXPECT_EQ(model.rowCount(requestIndex), kParties / 2 - kChanged / 2 - accepted);
+
+   ASSERT_TRUE(keptIndex.isValid());
+   EXPECT_EQ(model.getPartyIndexById(partyName(kParties - 2)), QModelIndex(keptIndex));
+
+   for (int i = 0; i < kParties + kChanged; ++i) {
+      const auto index = model.getPartyIndexById(partyName(i));
+      if (i < kChanged) {
+         ASSERT_FALSE(index.isValid());
+         continue;
+      }
+      ASSERT_TRUE(index.isValid());
+      const bool isRequest = (i % 2) && (i >= 2 * kChanged) && (i < kParties);
+      ASSERT_EQ(index.parent(), isRequest ? requestIndex : privateIndex);
+      ASSERT_EQ(model.data(index).toString().toStdString(), partyName(i));
+   }
+
+   // Unseen counter is kept when party moves to the other section
+   const auto movedIndex = model.getPartyIndexById(partyName(kChanged + 1));
+   EXPECT_EQ(static_cast<PartyTreeItem*>(movedIndex.internalPointer())->unseenCount(), 5);
+
+   // Nothing changed - nothing should be emitted
+   int rowsChanged = 0;
+   QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&rowsChanged] { ++rowsChanged; });
+   QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&rowsChanged] { ++rowsChanged; });
+   model.onPartyModelChanged();
+   EXPECT_EQ(resetCount, 1);
+   // Only global OTC sub-sections are re-created
+   EXPECT_EQ(rowsChanged, 2);
+}
+
+TEST(TestChat, PartiesSortByCachedName)
+{
+   auto partyModel = std::make_shared<Chat::ClientPartyModel>(StaticLogger::loggerPtr);
+   OtcClientParams params;
+   OtcClient otc(StaticLogger::loggerPtr, nullptr, nullptr, nullptr, nullptr, nullptr, params);
+   auto model = std::make_shared<ChatPartiesTreeModel>(partyModel, &otc);
+   ChatPartiesSortProxyModel proxy(model);
+   proxy.sort(0);
+
+   for (int i = 0; i < 3; ++i) {
+      addPrivateParty(partyModel, i, Chat::PartyState::INITIALIZED);
+   }
+   model->onPartyModelChanged();
+
+   const auto privateIndex = proxy.mapFromSource(model->getPartyIndexById(
+      ChatModelNames::ContainerTabPrivate.toStdString()));
+   ASSERT_TRUE(privateIndex.isValid());
+   ASSERT_EQ(proxy.rowCount(privateIndex), 3);
+   // Empty sections are filtered out
+   EXPECT_FALSE(proxy.mapFromSource(model->getPartyIndexById(
+      ChatModelNames::ContainerTabContactRequest.toStdString())).isValid());
+
+   const auto partyAt = [&proxy, &privateIndex](int row) {
+      return proxy.getInternalData(proxy.index(row, 0, privateIndex))->data().value<Chat::ClientPartyPtr>()->id();
+   };
+   EXPECT_EQ(partyAt(0), partyName(0));
+   EXPECT_EQ(partyAt(2), partyName(2));
+
+   // Sort key is not refreshed until the model is notified
+   const auto party = partyModel->getClientPartyById(partyName(0));
+   party->setDisplayName("zzz");
+   EXPECT_EQ(proxy.getInternalData(proxy.index(0, 0, privateIndex))->sortKey(), partyName(0));
+
+   model->onPartyDisplayNameChanged(partyName(0));
+   EXPECT_EQ(partyAt(0), partyName(1));
+   EXPECT_EQ(partyAt(2), partyName(0));
+   EXPECT_EQ(proxy.getInternalData(proxy.index(2, 0, privateIndex))->sortKey(), "zzz");
+}
@@ -9,19 +9,29 @@
 #include <QApplication>
 #include <QDebug>
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLocale>
 #include <QString>
 #include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 #include "Address.h"
 #include "AssetManager.h"
 #include "CacheFile.h"
 #include "CurrencyPair.h"
 #include "EasyCoDec.h"
+#include "FeeEstimateCache.h"
 #include "InprocSigner.h"
 #include "MarketDataProvider.h"
 #include "MDCallbacksQt.h"
 #include "TestEnv.h"
+#include "Tracer.h"
 #include "WalletUtils.h"
 #include "Wallets/SyncWalletsManager.h"
 
@@ -167,6 +177,153 @@ TEST(TestCommon, UtxoReservation)
    EXPECT_EQ(filtered.size(), nbUtxos);
 }
 
+namespace {
+   // Collects fee estimate requests and replies to them on demand from another thread
+   class FeeStubArmory : public ArmoryObject
+   {
+   public:
+      FeeStubArmory()
+         : ArmoryObject(StaticLogger::loggerPtr, "", false)
+      {}
+
+      bool estimateFee(unsigned int nbBlocks, const FloatCb &cb) override
+      {
+         if (onRequest_ && !onRequest_()) {
+            return false;
+         }
+         std::lock_guard<std::mutex> lock(mutex_);
+         queries_[nbBlocks]++;
+         pending_.push_back(cb);
+         return true;
+      }
+
+      size_t queries(unsigned int nbBlocks) const
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         const auto it = queries_.find(nbBlocks);
+         return (it == queries_.end()) ? 0 : it->second;
+      }
+
+      void reply(float fee)
+      {
+         std::vector<FloatCb> callbacks;
+         {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callbacks.swap(pending_);
+         }
+         std::thread([callbacks, fee] {
+            for (const auto &cb : callbacks) {
+               cb(fee);
+            }
+         }).join();
+      }
+
+      // Called before request is accepted, returning false fails the request
+      void setOnRequest(const std::function<bool()> &onRequest)
+      {
+         onRequest_ = onRequest;
+      }
+
+   private:
+      std::function<bool()>   onRequest_;
+      mutable std::mutex   mutex_;
+      std::map<unsigned int, size_t>   queries_;
+      std::vector<FloatCb> pending_;
+   };
+}
+
+TEST(TestCommon, FeeEstimateCache)
+{
+   const auto armory = std::make_shared<FeeStubArmory>();
+   bs::FeeEstimateCache cache(StaticLogger::loggerPtr, armory, std::chrono::minutes(1));
+   const float feeValue = 0.0002f;
+   const int nbCallers = 16;
+
+   // concurrent callers share one query
+   std::atomic<int> nbReplies{ 0 };
+   std::atomic<int> nbCorrect{ 0 };
+   const auto &cbFee = [&nbReplies, &nbCorrect, feeValue](float fee) {
+      if (fee == feeValue) {
+         nbCorrect++;
+      }
+      nbReplies++;
+   };
+   std::vector<std::thread> callers;
+   for (int i = 0; i < nbCallers; ++i) {
+      callers.emplace_back([&cache, cbFee] {
+         EXPECT_TRUE(cache.estimateFee(2, cbFee));
+      });
+   }
+   for (auto &caller : callers) {
+      caller.join();
+   }
+   EXPECT_EQ(armory->queries(2), 1u);
+   EXPECT_EQ(cache.queriesSent(), 1u);
+   EXPECT_EQ(nbReplies, 0);
+   armory->reply(feeValue);
+   EXPECT_EQ(nbReplies, nbCallers);
+   EXPECT_EQ(nbCorrect, nbCallers);
+
+   // cached value is returned immediately
+   float cachedFee = 0;
+   EXPECT_TRUE(cache.estimateFee(2, [&cachedFee](float fee) { cachedFee = fee; }));
+   EXPECT_EQ(cachedFee, feeValue);
+   EXPECT_EQ(armory->queries(2), 1u);
+
+   // other targets are queried separately
+   cache.estimateFee(6, cbFee);
+   EXPECT_EQ(armory->queries(6), 1u);
+   armory->reply(feeValue);
+
+   // reply for query sent before new block is delivered but not cached
+   cache.onNewBlock(100, 0);
+   cache.estimateFee(2, cbFee);
+   EXPECT_EQ(armory->queries(2), 2u);
+   cache.onNewBlock(101, 0);
+   armory->reply(feeValue);
+   cache.estimateFee(2, cbFee);
+   EXPECT_EQ(armory->queries(2), 3u);
+   armory->reply(feeValue);
+   cache.estimateFee(2, cbFee);
+   EXPECT_EQ(armory->queries(2), 3u);
+
+   // failed estimates are not cached
+   cache.estimateFee(12, cbFee);
+   armory->reply(std::numeric_limits<float>::infinity());
+   cache.estimateFee(12, cbFee);
+   EXPECT_EQ(armory->queries(12), 2u);
+   armory->reply(feeValue);
+
+   // expired values are queried again
+   cache.setTtl(std::chrono::milliseconds(50));
+   cache.estimateFee(6, cbFee);
+   EXPECT_EQ(armory->queries(6), 2u);
+   armory->reply(feeValue);
+   cache.estimateFee(6, cbFee);
+   EXPECT_EQ(armory->queries(6), 2u);
+   std::this_thread::sleep_for(std::chrono::milliseconds(100));
+   cache.estimateFee(6, cbFee);
+   EXPECT_EQ(armory->queries(6), 3u);
+   armory->reply(feeValue);
+   EXPECT_EQ(cache.queriesSent(), 8u);
+
+   // callers joined a request that failed to be sent get failure value
+   float joinedFee = 0;
+   armory->setOnRequest([&cache, &joinedFee] {
+      EXPECT_TRUE(cache.estimateFee(24, [&joinedFee](float fee) { joinedFee = fee; }));
+      return false;
+   });
+   EXPECT_FALSE(cache.estimateFee(24, cbFee));
+   EXPECT_EQ(joinedFee, std::numeric_limits<float>::infinity());
+   armory->setOnRequest({});
+
+   // all users of the same connection share one cache
+   const auto shared = bs::FeeEstimateCache::instance(StaticLogger::loggerPtr, armory);
+   EXPECT_EQ(bs::FeeEstimateCache::instance(StaticLogger::loggerPtr, armory), shared);
+   EXPECT_NE(bs::FeeEstimateCache::instance(StaticLogger::loggerPtr
+      , std::make_shared<FeeStubArmory>()), shared);
+}
+
 TEST(TestCommon, EasyCoDec)
 {
    EasyCoDec codec;
@@ -375,3 +532,54 @@ TEST(TestCommon, SelectUtxoForAmount)
 
    test({1, 1, 1}, 3, 3, 3);
 }
+
+TEST(TestCommon, TracerOverhead)
+{
+   const int nbIter = 1000000;
+   bs::trace::disable();
+
+   const auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < nbIter; ++i) {
+      BS_TRACE_SPAN("test", "disabled");
+   }
+   const auto disabledNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count() / static_cast<double>(nbIter);
+   RecordProperty("disabled_span_ns", std::to_string(disabledNs));
+   EXPECT_EQ(bs::trace::eventsCount(), 0u);
+
+   const int nbThreads = 4;
+   const int nbSpans = 10000;
+   bs::trace::enable(nbThreads * nbSpans);
+   const auto enabledStart = std::chrono::steady_clock::now();
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nbThreads; ++t) {
+      threads.emplace_back([] {
+         for (int i = 0; i < nbSpans; ++i) {
+            BS_TRACE_SPAN("test", "enabled", "i", i);
+         }
+      });
+   }
+   for (auto &thread : threads) {
+      thread.join();
+   }
+   const auto enabledNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - enabledStart).count() / static_cast<double>(nbThreads * nbSpans);
+   RecordProperty("enabled_span_ns", std::to_string(enabledNs));
+   EXPECT_EQ(bs::trace::eventsCount(), static_cast<size_t>(nbThreads * nbSpans));
+   EXPECT_EQ(bs::trace::droppedCount(), 0u);
+
+   // buffer is full - new events are dropped, not overwritten
+   bs::trace::asyncBegin("test", "async", bs::trace::idFromString("id"));
+   EXPECT_EQ(bs::trace::droppedCount(), 1u);
+   bs::trace::disable();
+
+   const auto doc = QJsonDocument::fromJson(QByteArray::fromStdString(bs::trace::chromeTraceJson()));
+   ASSERT_TRUE(doc.isObject());
+   const auto events = doc.object().value(QLatin1String("traceEvents")).toArray();
+   ASSERT_EQ(events.size(), nbThreads * nbSpans);
+   const auto evt = events.first().toObject();
+   EXPECT_EQ(evt.value(QLatin1String("ph")).toString(), QLatin1String("X"));
+   EXPECT_EQ(evt.value(QLatin1String("name")).toString(), QLatin1String("enabled"));
+   EXPECT_TRUE(evt.contains(QLatin1String("dur")));
+   EXPECT_TRUE(evt.value(QLatin1String("args")).toObject().contains(QLatin1String("i")));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+#include "TestEnv.h"
+#include "ledger/ledgerClient.h"
+#include "ledger/ledgerDeviceWatcher.h"
+#include "ledger/ledgerHidBackend.h"
+
+namespace {
+   // Devices are "plugged" and "unplugged" by test thread while watcher enumerates them
+   class MockHidBackend : public LedgerHidBackend
+   {
+   public:
+      QVector<HidDeviceInfo> enumerate() override
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         nbEnumerations_++;
+         return devices_;
+      }
+
+      void plug(const QString &path)
+      {
+         HidDeviceInfo info{};
+         info.path_ = path;
+         info.vendorId_ = Ledger::HID_VENDOR_ID;
+         info.manufacturerString_ = QLatin1String("Ledger");
+         info.productString_ = QLatin1String("Nano S");
+         info.usagePage_ = Ledger::HID_USAGE_PAGE;
+
+         std::lock_guard<std::mutex> lock(mutex_);
+         devices_.push_back(info);
+      }
+
+      void unplug(const QString &path)
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         for (int i = 0; i < devices_.size(); ++i) {
+            if (devices_[i].path_ == path) {
+               devices_.remove(i);
+               break;
+            }
+         }
+      }
+
+      int nbEnumerations() const
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         return nbEnumerations_;
+      }
+
+   private:
+      mutable std::mutex      mutex_;
+      QVector<HidDeviceInfo>  devices_;
+      int nbEnumerations_{};
+   };
+
+   // Processes events until condition is met
+   bool waitFor(const std::function<bool()> &condition, int timeoutMs = 3000)
+   {
+      QEventLoop loop;
+      QTimer checkTimer;
+      QObject::connect(&checkTimer, &QTimer::timeout, [&loop, &condition] {
+         if (condition()) {
+            loop.quit();
+         }
+      });
+      checkTimer.start(5);
+      QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+      if (!condition()) {
+         loop.exec();
+      }
+      return condition();
+   }
+}
+
+TEST(TestHw, LedgerDeviceWatcher)
+{
+   const auto backend = std::make_shared<MockHidBackend>();
+   LedgerDeviceWatcher watcher(backend, std::chrono::milliseconds(20));
+   int nbChanges = 0;
+   QObject::connect(&watcher, &LedgerDeviceWatcher::devicesChanged, [&nbChanges] {
+      nbChanges++;
+   });
+
+   // explicit scan starts watcher and replies in the owner thread
+   backend->plug(QLatin1String("dev1"));
+   bool scanned = false;
+   QVector<HidDeviceInfo> scanResult;
+   watcher.scan([&scanned, &scanResult](const QVector<HidDeviceInfo> &devices) {
+      EXPECT_EQ(QThread::currentThread(), QCoreApplication::instance()->thread());
+      scanResult = devices;
+      scanned = true;
+   });
+   ASSERT_TRUE(waitFor([&scanned] { return scanned; }));
+   ASSERT_EQ(scanResult.size(), 1);
+   EXPECT_EQ(scanResult[0].path_, QLatin1String("dev1"));
+   EXPECT_EQ(nbChanges, 1);
+
+   // polling without plug/unplug doesn't notify
+   const auto nbEnumerations = backend->nbEnumerations();
+   ASSERT_TRUE(waitFor([backend, nbEnumerations] { return backend->nbEnumerations() >= nbEnumerations + 3; }));
+   waitFor([] { return false; }, 50);
+   EXPECT_EQ(nbChanges, 1);
+
+   backend->plug(QLatin1String("dev2"));
+   ASSERT_TRUE(waitFor([&nbChanges] { return nbChanges == 2; }));
+   EXPECT_EQ(watcher.devices().size(), 2);
+
+   backend->unplug(QLatin1String("dev1"));
+   ASSERT_TRUE(waitFor([&nbChanges] { return nbChanges == 3; }));
+   ASSERT_EQ(watcher.devices().size(), 1);
+   EXPECT_EQ(watcher.devices()[0].path_, QLatin1String("dev2"));
+
+   watcher.stop();
+   const auto nbStopped = backend->nbEnumerations();
+   std::this_thread::sleep_for(std::chrono::milliseconds(100));
+   EXPECT_EQ(backend->nbEnumerations(), nbStopped);
+}
+
+TEST(TestHw, LedgerClientHotplug)
+{
+   const auto backend = std::make_shared<MockHidBackend>();
+   LedgerClient client(StaticLogger::loggerPtr, nullptr, true, nullptr, backend);
+   int nbChanges = 0;
+   QObject::connect(&client, &LedgerClient::devicesChanged, [&nbChanges] {
+      nbChanges++;
+   });
+
+   // scan doesn't block caller and reports no devices
+   bool scanned = false;
+   client.scanDevices([&scanned] { scanned = true; });
+   EXPECT_FALSE(scanned);
+   ASSERT_TRUE(waitFor([&scanned] { return scanned; }));
+   EXPECT_TRUE(client.deviceKeys().isEmpty());
+   const int nbInitialChanges = nbChanges;
+
+   // plugged device is picked up by polling, but it's not initialized until scan
+   backend->plug(QLatin1String("dev1"));
+   ASSERT_TRUE(waitFor([&nbChanges, nbInitialChanges] { return nbChanges > nbInitialChanges; }, 5000));
+   EXPECT_TRUE(client.deviceKeys().isEmpty());
+
+   backend->unplug(QLatin1String("dev1"));
+   ASSERT_TRUE(waitFor([&nbChanges, nbInitialChanges] { return nbChanges > nbInitialChanges + 1; }, 5000));
+   EXPECT_TRUE(client.getDevice(QLatin1String("Ledger")).isNull());
+}
@@ -1,13 +1,21 @@
 #include <gtest/gtest.h>
+#include <condition_variable>
 #include <random>
+#ifndef WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 #include "CelerMessageMapper.h"
 #include "CommonTypes.h"
 #include "IdStringGenerator.h"
 #include "QuoteProvider.h"
 #include "TestEnv.h"
+#include "UnixSocketConnection.h"
 #include "ZmqContext.h"
 #include "ZMQ_BIP15X_DataConnection.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
+#include "ZmqBIP15XLoadGen.h"
 #include "zmq.h"
 
 using namespace std::chrono_literals;
@@ -854,41 +862,20 @@ TEST(TestNetwork, ZMQ_BIP15X_ConnectionTimeout)
 // Disabled because it's not really a unit test
 TEST(TestNetwork, DISABLED_ZMQ_BIP15X_StressTest)
 {
-   const auto srvLsn = std::make_shared<TstServerListener>(StaticLogger::loggerPtr);
-   const auto clientLsn = std::make_shared<TstClientListener>(StaticLogger::loggerPtr);
-
-   const auto clientConn = std::make_shared<ZmqBIP15XDataConnection>(
-            StaticLogger::loggerPtr, getTestParams());
-   const auto zmqContext = std::make_shared<ZmqContext>(StaticLogger::loggerPtr);
-   std::vector<std::string> trustedClients = {
-      std::string("test:") + clientConn->getOwnPubKey().toHexStr() };
-   auto serverConn = std::make_shared<ZmqBIP15XServerConnection>(
-            StaticLogger::loggerPtr, zmqContext, getEmptyPeersCallback());
-   const auto serverKey = serverConn->getOwnPubKey();
-
-   const std::string host = "127.0.0.1";
-   std::string port;
-   do {
-      port = std::to_string((rand() % 50000) + 10000);
-   } while (!serverConn->BindConnection(host, port, srvLsn.get()));
-
-   serverConn->addAuthPeer(getPeerKey("client", clientConn.get()));
-   clientConn->addAuthPeer(getPeerKey(host, port, serverConn.get()));
-
-   ASSERT_TRUE(clientConn->openConnection(host, port, clientLsn.get()));
-
-   std::this_thread::sleep_for(1000ms);
-
-   int sendCount = 0;
-   while (true) {
-      while (sendCount - srvLsn->dataRecv_.load() - clientLsn->dataRecv_.load() < 20) {
-         int pktSize = (rand() % 1000) + 1000;
-         clientConn->send(CryptoPRNG::generateRandom(pktSize).toBinStr());
-         serverConn->SendDataToAllClients(CryptoPRNG::generateRandom(pktSize).toBinStr());
-         sendCount += 2;
-      }
-      std::this_thread::sleep_for(1ns);
-   }
+   bs::bench::ZmqLoadGenParams params;
+   params.msgSizes = { 1000, 1500, 2000 };
+   params.clients = 4;
+   params.duration = std::chrono::seconds(10);
+   params.rekeyInterval = 500;
+
+   bs::bench::ZmqBIP15XLoadGen loadGen(StaticLogger::loggerPtr, params);
+   bs::bench::ZmqLoadGenResult result;
+   ASSERT_TRUE(loadGen.run(result));
+   StaticLogger::loggerPtr->info("[{}] {}", __func__, result.toJson(params));
+
+   EXPECT_EQ(result.errors, 0);
+   EXPECT_GT(result.messages, 0);
+   EXPECT_GT(result.rekeys, 0);
 }
 
 TEST(TestNetwork, ZMQ_BIP15X_MalformedData)
@@ -1051,3 +1038,229 @@ TEST(TestNetwork, ZMQ_BIP15X_ClientKey)
    ASSERT_TRUE(clientConn->getOwnPubKey().getSize() == 33);
    EXPECT_TRUE(srvLsn->lastConnectedKey_->pubKey() == clientConn->getOwnPubKey());
 }
+
+#ifndef WIN32
+static std::string getTestSocketPath(const std::string &name)
+{
+   return "/tmp/bs_ut_" + name + "_" + std::to_string(getpid()) + ".sock";
+}
+
+TEST(TestNetwork, UnixSocket)
+{
+   const auto srvLsn = std::make_shared<TstServerListener>(StaticLogger::loggerPtr);
+   const auto clientLsn = std::make_shared<TstClientListener>(StaticLogger::loggerPtr);
+
+   const auto socketPath = getTestSocketPath("basic");
+   auto serverConn = std::make_shared<UnixSocketServerConnection>(StaticLogger::loggerPtr);
+   ASSERT_TRUE(serverConn->BindConnection(socketPath, {}, srvLsn.get()));
+
+   const auto clientConn = std::make_shared<UnixSocketDataConnection>(StaticLogger::loggerPtr);
+   ASSERT_TRUE(clientConn->openConnection(socketPath, {}, clientLsn.get()));
+   ASSERT_TRUE(await(clientLsn->connected_));
+   ASSERT_TRUE(await(srvLsn->connected_));
+
+   // big packet must be split between several reads
+   const auto bigPacket = CryptoPRNG::generateRandom(1024 * 1024).toBinStr();
+   ASSERT_TRUE(clientConn->send("test"));
+   ASSERT_TRUE(clientConn->send(bigPacket));
+   ASSERT_TRUE(clientConn->send(""));
+   const auto napTime = 1ms;
+   for (auto elapsed = 0ms; (srvLsn->dataRecv_ < 3) && (elapsed < 1000ms); elapsed += napTime) {
+      std::this_thread::sleep_for(napTime);
+   }
+   EXPECT_EQ(srvLsn->dataRecv_.load(), 3);
+
+   ASSERT_TRUE(serverConn->SendDataToClient(srvLsn->lastConnectedClient_, "reply"));
+   ASSERT_TRUE(await(clientLsn->dataRecv_));
+   clientLsn->dataRecv_ = 0;
+   ASSERT_TRUE(serverConn->SendDataToAllClients("broadcast"));
+   ASSERT_TRUE(await(clientLsn->dataRecv_));
+
+   ASSERT_TRUE(clientConn->closeConnection());
+   ASSERT_TRUE(await(clientLsn->disconnected_));
+   ASSERT_TRUE(await(srvLsn->disconnected_));
+   EXPECT_EQ(srvLsn->lastDisconnectedClient_, srvLsn->lastConnectedClient_);
+   EXPECT_FALSE(serverConn->SendDataToClient(srvLsn->lastConnectedClient_, "late"));
+   EXPECT_FALSE(clientLsn->error_.load());
+   EXPECT_FALSE(srvLsn->error_.load());
+}
+
+namespace {
+   class EchoServerListener : public ServerConnectionListener
+   {
+   public:
+      void OnDataFromClient(const std::string &clientId, const std::string &data) override {
+         server_->SendDataToClient(clientId, data);
+      }
+      void onClientError(const std::string &, const std::string &) override {}
+      void OnClientConnected(const std::string &) override {}
+      void OnClientDisconnected(const std::string &) override {}
+
+      ServerConnection *server_{};
+   };
+
+   class PingClientListener : public DataConnectionListener
+   {
+   public:
+      void OnDataReceived(const std::string &) override {
+         std::unique_lock<std::mutex> lock(mutex_);
+         ++dataRecv_;
+         cv_.notify_all();
+      }
+      void OnConnected() override {
+         std::unique_lock<std::mutex> lock(mutex_);
+         connected_ = true;
+         cv_.notify_all();
+      }
+      void OnDisconnected() override {}
+      void OnError(DataConnectionError) override {}
+
+      bool waitConnected() {
+         std::unique_lock<std::mutex> lock(mutex_);
+         return cv_.wait_for(lock, 10s, [this] { return connected_; });
+      }
+      bool waitFor(uint64_t count) {
+         std::unique_lock<std::mutex> lock(mutex_);
+         return cv_.wait_for(lock, 30s, [this, count] { return dataRecv_ >= count; });
+      }
+
+   private:
+      std::mutex              mutex_;
+      std::condition_variable cv_;
+      uint64_t                dataRecv_ = 0;
+      bool                    connected_ = false;
+   };
+
+   struct TransportStats
+   {
+      double   rttUs = 0;
+      double   msgPerSec = 0;
+   };
+
+   // Measures echo round-trip time with one message in flight and then
+   // pipelined throughput with all messages sent at once
+   bool measureTransport(DataConnection *conn, PingClientListener *lsn, TransportStats &stats)
+   {
+      const auto payload = CryptoPRNG::generateRandom(1024).toBinStr();
+      const int rttCount = 500;
+      const int batchCount = 5000;
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 1; i <= rttCount; ++i) {
+         if (!conn->send(payload) || !lsn->waitFor(i)) {
+            return false;
+         }
+      }
+      stats.rttUs = std::chrono::duration<double, std::micro>(
+         std::chrono::steady_clock::now() - start).count() / rttCount;
+
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < batchCount; ++i) {
+         if (!conn->send(payload)) {
+            return false;
+         }
+      }
+      if (!lsn->waitFor(rttCount + batchCount)) {
+         return false;
+      }
+      stats.msgPerSec = batchCount / std::chrono::duration<double>(
+         std::chrono::steady_clock::now() - start).count();
+      return true;
+   }
+}  // namespace
+
+TEST(TestNetwork, UnixSocket_StuckClient)
+{
+   const auto socketPath = getTestSocketPath("stuck");
+   EchoServerListener srvLsn;
+   UnixSocketServerConnection serverConn(StaticLogger::loggerPtr);
+   srvLsn.server_ = &serverConn;
+   ASSERT_TRUE(serverConn.BindConnection(socketPath, {}, &srvLsn));
+
+   // socket of a live server must not be taken over
+   EchoServerListener otherLsn;
+   UnixSocketServerConnection otherConn(StaticLogger::loggerPtr);
+   EXPECT_FALSE(otherConn.BindConnection(socketPath, {}, &otherLsn));
+
+   // client which never reads its socket
+   sockaddr_un addr = {};
+   addr.sun_family = AF_UNIX;
+   strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+   const int stuckFd = socket(AF_UNIX, SOCK_STREAM, 0);
+   ASSERT_GE(stuckFd, 0);
+   ASSERT_EQ(connect(stuckFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)), 0);
+   const uint32_t len = 1024 * 1024;
+   const auto payload = std::string(reinterpret_cast<const char *>(&len), sizeof(len))
+      + std::string(len, 'x');
+   // echoes of these can't be delivered as a whole
+   for (int i = 0; i < 16; ++i) {
+      ASSERT_EQ(send(stuckFd, payload.data(), payload.size(), 0), static_cast<ssize_t>(payload.size()));
+   }
+
+   PingClientListener clientLsn;
+   UnixSocketDataConnection clientConn(StaticLogger::loggerPtr);
+   ASSERT_TRUE(clientConn.openConnection(socketPath, {}, &clientLsn));
+   ASSERT_TRUE(clientLsn.waitConnected());
+   for (int i = 1; i <= 100; ++i) {
+      ASSERT_TRUE(clientConn.send("ping"));
+      ASSERT_TRUE(clientLsn.waitFor(i));
+   }
+
+   close(stuckFd);
+   EXPECT_TRUE(clientConn.closeConnection());
+}
+
+TEST(TestNetwork, UnixSocket_vs_ZMQ_BIP15X)
+{
+   TransportStats udsStats;
+   {
+      EchoServerListener srvLsn;
+      PingClientListener clientLsn;
+      const auto socketPath = getTestSocketPath("compare");
+      UnixSocketServerConnection serverConn(StaticLogger::loggerPtr);
+      srvLsn.server_ = &serverConn;
+      ASSERT_TRUE(serverConn.BindConnection(socketPath, {}, &srvLsn));
+
+      UnixSocketDataConnection clientConn(StaticLogger::loggerPtr);
+      ASSERT_TRUE(clientConn.openConnection(socketPath, {}, &clientLsn));
+      ASSERT_TRUE(clientLsn.waitConnected());
+      ASSERT_TRUE(measureTransport(&clientConn, &clientLsn, udsStats));
+      clientConn.closeConnection();
+   }
+
+   TransportStats zmqStats;
+   {
+      EchoServerListener srvLsn;
+      PingClientListener clientLsn;
+      ZmqBIP15XDataConnection clientConn(StaticLogger::loggerPtr, getTestParams());
+      const auto zmqContext = std::make_shared<ZmqContext>(StaticLogger::loggerPtr);
+      ZmqBIP15XServerConnection serverConn(StaticLogger::loggerPtr, zmqContext
+         , getEmptyPeersCallback());
+      srvLsn.server_ = &serverConn;
+
+      const std::string host = "127.0.0.1";
+      std::string port;
+      do {
+         port = std::to_string((rand() % 50000) + 10000);
+      } while (!serverConn.BindConnection(host, port, &srvLsn));
+
+      serverConn.addAuthPeer(getPeerKey("client", &clientConn));
+      clientConn.addAuthPeer(getPeerKey(host, port, &serverConn));
+      ASSERT_TRUE(clientConn.openConnection(host, port, &clientLsn));
+      ASSERT_TRUE(clientLsn.waitConnected());
+      ASSERT_TRUE(measureTransport(&clientConn, &clientLsn, zmqStats));
+      clientConn.closeConnection();
+   }
+
+   StaticLogger::loggerPtr->info("[{}] round trip: UDS {:.1f} us, ZMQ/BIP15X {:.1f} us"
+      "; throughput: UDS {:.0f} msg/s, ZMQ/BIP15X {:.0f} msg/s", __func__
+      , udsStats.rttUs, zmqStats.rttUs, udsStats.msgPerSec, zmqStats.msgPerSec);
+   RecordProperty("uds_rtt_us", std::to_string(udsStats.rttUs));
+   RecordProperty("zmq_rtt_us", std::to_string(zmqStats.rttUs));
+   RecordProperty("uds_msg_per_sec", std::to_string(udsStats.msgPerSec));
+   RecordProperty("zmq_msg_per_sec", std::to_string(zmqStats.msgPerSec));
+
+   EXPECT_GT(udsStats.msgPerSec, 0);
+   EXPECT_GT(zmqStats.msgPerSec, 0);
+}
+#endif   // WIN32
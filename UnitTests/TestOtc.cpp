@@ -1,5 +1,7 @@
 #include <QApplication>
+#include <random>
 
+#include "ChatUI/OTCRequestViewModel.h"
 #include "CoreHDWallet.h"
 #include "CoreWalletsManager.h"
 #include "InprocSigner.h"
@@ -13,6 +15,7 @@
 #include "Wallets/SyncWalletsManager.h"
 
 #include "bs_proxy_terminal_pb.pb.h"
+#include "otc.pb.h"
 
 using namespace bs::network;
 using namespace Blocksettle::Communication;
@@ -407,3 +410,100 @@ TEST_F(TestOtc, Basic12) { doOtcTest(12); }
 TEST_F(TestOtc, Basic13) { doOtcTest(13); }
 TEST_F(TestOtc, Basic14) { doOtcTest(14); }
 TEST_F(TestOtc, Basic15) { doOtcTest(15); }
+
+// Replays a stream of public OTC requests and checks that OTCRequestViewModel
+// follows OtcClient::requests() with row-level updates only
+TEST(TestOtcPublic, RequestsReplay)
+{
+   const int kContacts = 1000;
+   const int kMessages = 5000;
+
+   OtcClientParams params;
+   auto otc = std::make_shared<OtcClient>(StaticLogger::loggerPtr, nullptr, nullptr, nullptr, nullptr, nullptr, params);
+   otc->setOwnContactId("own");
+   OTCRequestViewModel model(otc.get());
+
+   int resetCount = 0;
+   int insertedCount = 0;
+   int removedCount = 0;
+   int changedCount = 0;
+   QObject::connect(&model, &QAbstractItemModel::modelAboutToBeReset, [&resetCount] { ++resetCount; });
+   QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&insertedCount](const QModelIndex &, int first, int last) {
+      insertedCount += last - first + 1;
+   });
+   QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&removedCount](const QModelIndex &, int first, int last) {
+      removedCount += last - first + 1;
+   });
+   QObject::connect(&model, &QAbstractItemModel::dataChanged, [&changedCount] { ++changedCount; });
+
+   const auto checkConsistency = [&] {
+      const auto &requests = otc->requests();
+      ASSERT_EQ(model.rowCount(), int(requests.size()));
+      for (int row = 0; row < model.rowCount(); ++row) {
+         const auto index = model.index(row, 0);
+         ASSERT_EQ(model.peer(index), requests[size_t(row)]);
+         ASSERT_EQ(model.getIndexByTimestamp(requests[size_t(row)]->request.timestamp), index);
+      }
+   };
+
+   const auto firstRange = int(otc::firstRangeValue(params.env));
+   const auto rangeCount = int(otc::lastRangeValue(params.env)) - firstRange + 1;
+   const auto makeRequest = [&](int n) {
+      Otc::PublicMessage msg;
+      auto d = msg.mutable_request();
+      d->set_sender_side(Otc::Side(n % 2 ? otc::Side::Buy : otc::Side::Sell));
+      d->set_range(Otc::RangeType(firstRange + n % rangeCount));
+      return BinaryData::fromString(msg.SerializeAsString());
+   };
+   Otc::PublicMessage closeMsg;
+   closeMsg.mutable_close();
+   const auto closeData = BinaryData::fromString(closeMsg.SerializeAsString());
+
+   otc::QuoteRequest ownRequest;
+   ownRequest.ourSide = otc::Side::Buy;
+   ownRequest.rangeType = otc::firstRangeValue(params.env);
+
+   std::mt19937 gen(42);
+   std::uniform_int_distribution<int> contactDist(0, kContacts - 1);
+   std::uniform_int_distribution<int> actionDist(0, 1);
+   // Unique timestamps (in the future, so duration timer would not expire them)
+   auto timestamp = QDateTime::currentDateTime().addSecs(60);
+   int added = 0;
+   int updated = 0;
+   int closed = 0;
+
+   for (int i = 0; i < kMessages; ++i) {
+      timestamp = timestamp.addMSecs(1);
+      const auto contactId = "contact_" + std::to_string(contactDist(gen));
+      if (!otc->request(contactId)) {
+         otc->processPublicMessage(timestamp, contactId, makeRequest(i));
+         ++added;
+      }
+      else if (actionDist(gen) == 0) {
+         otc->processPublicMessage(timestamp, contactId, makeRequest(i));
+         ++updated;
+      }
+      else {
+         otc->processPublicMessage(timestamp, contactId, closeData);
+         ++closed;
+      }
+
+      if (i == kMessages / 2) {
+         ASSERT_TRUE(otc->sendQuoteRequest(ownRequest));
+         ASSERT_TRUE(model.data(model.index(0, 0), int(CustomRoles::OwnQuote)).toBool());
+      }
+      if (i % 500 == 0) {
+         checkConsistency();
+      }
+   }
+   checkConsistency();
+
+   ASSERT_TRUE(otc->pullOrReject(otc->ownRequest()));
+   checkConsistency();
+
+   EXPECT_EQ(resetCount, 0);
+   EXPECT_EQ(insertedCount, added + 1);
+   EXPECT_EQ(removedCount, closed + 1);
+   EXPECT_EQ(changedCount, updated);
+   EXPECT_EQ(model.rowCount(), added - closed);
+}
@@ -6,11 +6,15 @@
 #include <QThread>
 #include <spdlog/spdlog.h>
 #include "ApplicationSettings.h"
+#include "BenchStats.h"
 #include "CoreHDWallet.h"
 #include "CoreWalletsManager.h"
 #include "InprocSigner.h"
 #include "TestEnv.h"
+#include "TradesUtils.h"
 #include "TransactionData.h"
+#include "UtxoReservation.h"
+#include "UtxoReservationManager.h"
 #include "Wallets/SyncWalletsManager.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncPlainWallet.h"
@@ -29,6 +33,11 @@ void TestSettlement::mineBlocks(unsigned count)
 }
 
 void TestSettlement::sendTo(uint64_t value, bs::Address& addr)
+{
+   sendTo(value, std::vector<bs::Address>{ addr });
+}
+
+void TestSettlement::sendTo(uint64_t value, const std::vector<bs::Address> &addrs)
 {
    //create spender
    auto iter = coinbaseHashes_.begin();
@@ -48,7 +57,9 @@ void TestSettlement::sendTo(uint64_t value, bs::Address& addr)
 
    signer.addSpender(spendPtr);
 
-   signer.addRecipient(addr.getRecipient(bs::XBTAmount{ value }));
+   for (const auto &addr : addrs) {
+      signer.addRecipient(addr.getRecipient(bs::XBTAmount{ value }));
+   }
    signer.setFeed(coinbaseFeed_);
 
    //sign & send
@@ -86,15 +97,18 @@ void TestSettlement::SetUp()
          , envPtr_->armoryInstance()->homedir_, logger);
 
       std::shared_ptr<bs::core::hd::Leaf> leaf;
-      bs::Address addr;
+      std::vector<bs::Address> addrs;
       auto grp = hdWallet->createGroup(hdWallet->getXBTGroupType());
       {
          const bs::core::WalletPasswordScoped lock(hdWallet, passphrase_);
          leaf = grp->createLeaf(AddressEntryType_P2SH, 0);
-         addr = leaf->getNewExtAddress();
+         for (size_t j = 0; j < nbFundingUtxos_; ++j) {
+            addrs.push_back(leaf->getNewExtAddress());
+         }
       }
+      const auto &addr = addrs.front();
 
-      sendTo(amount, addr);
+      sendTo(amount / nbFundingUtxos_, addrs);
 
       std::shared_ptr<bs::core::hd::Leaf> authLeaf, settlLeaf;
       bs::Address authAddr;
@@ -127,12 +141,12 @@ void TestSettlement::SetUp()
       hdWallet_.push_back(hdWallet);
    }
 
-   auto inprocSigner = std::make_shared<InprocSigner>(
+   signer_ = std::make_shared<InprocSigner>(
       walletsMgr_, logger, "", NetworkType::TestNet);
-   inprocSigner->Start();
+   signer_->Start();
    syncMgr_ = std::make_shared<bs::sync::WalletsManager>(logger
       , envPtr_->appSettings(), envPtr_->armoryConnection());
-   syncMgr_->setSignContainer(inprocSigner);
+   syncMgr_->setSignContainer(signer_);
    auto promSync = std::make_shared<std::promise<bool>>();
    auto futSync = promSync->get_future();
    syncMgr_->syncWallets([promSync](int cur, int total) {
@@ -184,6 +198,7 @@ void TestSettlement::TearDown()
    hdWallet_.clear();
    userId_.clear();
    syncMgr_.reset();
+   signer_.reset();
 }
 
 TestSettlement::~TestSettlement()
@@ -516,3 +531,276 @@ TEST_F(TestSettlement, SpotXBT_buy)
    std::this_thread::sleep_for(150ms); // have no idea yet, why it's required
 }
 #endif
+
+namespace {
+
+   const size_t kMaxConcurrentSettlements = 48;
+
+   // One XBT trade: dealer sells XBT (creates and signs pay-in), requester
+   // buys (signs pay-out) - the same steps DealerXBTSettlementContainer and
+   // ReqXBTSettlementContainer go through with the dealer's UTXOs reserved
+   // when quote is submitted, as RFQDealerReply does
+   struct ConcurrentSettlement
+   {
+      SecureBinaryData     settlementId;
+      bs::FixedXbtInputs   payinInputs;
+      bs::Address          settlAddr;
+      bs::core::wallet::TXSignRequest  unsignedPayin;
+      BinaryData           payinHash;
+      BinaryData           signedPayin;
+      BinaryData           signedPayout;
+      std::chrono::steady_clock::time_point  started;
+      std::chrono::steady_clock::duration    elapsed{};
+      std::string          error;
+      bool                 done = false;
+   };
+
+}  // namespace
+
+class TestSettlementConcurrent : public TestSettlement
+{
+protected:
+   TestSettlementConcurrent()
+   {
+      nbFundingUtxos_ = kMaxConcurrentSettlements;
+   }
+
+   void doConcurrentSettlements(size_t count);
+};
+
+void TestSettlementConcurrent::doConcurrentSettlements(size_t count)
+{
+   ASSERT_LE(count, kMaxConcurrentSettlements);
+   const auto logger = envPtr_->logger();
+   if (!bs::UtxoReservation::instance()) {
+      bs::UtxoReservation::init(logger);
+   }
+
+   const auto dealerWallet = syncMgr_->getHDRootForLeaf(xbtWallet_[1]->walletId());
+   const auto reqWallet = syncMgr_->getHDRootForLeaf(xbtWallet_[0]->walletId());
+   ASSERT_NE(dealerWallet, nullptr);
+   ASSERT_NE(reqWallet, nullptr);
+   const auto dealerLeaves = dealerWallet->getGroup(dealerWallet->getXBTGroupType())->getLeaves();
+   const auto reqLeaves = reqWallet->getGroup(reqWallet->getXBTGroupType())->getLeaves();
+   ASSERT_FALSE(dealerLeaves.empty());
+   ASSERT_FALSE(reqLeaves.empty());
+
+   const auto waitFor = [](const std::function<bool()> &pred, std::chrono::seconds timeout) {
+      const auto deadline = std::chrono::steady_clock::now() + timeout;
+      while (!pred() && (std::chrono::steady_clock::now() < deadline)) {
+         QApplication::processEvents();
+      }
+      return pred();
+   };
+
+   auto utxoReservationMgr = std::make_shared<bs::UTXOReservationManager>(syncMgr_
+      , envPtr_->armoryConnection(), logger);
+   QMetaObject::invokeMethod(utxoReservationMgr.get(), "refreshAvailableUTXO");
+   ASSERT_TRUE(waitFor([&] {
+      return utxoReservationMgr->getAvailableXbtUTXOs(dealerWallet->walletId()).size() >= count;
+   }, 10s));
+
+   const bs::core::WalletPasswordScoped lockReq(hdWallet_[0], passphrase_);
+   const bs::core::WalletPasswordScoped lockDealer(hdWallet_[1], passphrase_);
+
+   const auto amount = bs::XBTAmount(0.01);
+   std::vector<ConcurrentSettlement> settlements(count);
+   std::map<bs::signer::RequestId, std::pair<size_t, bool>> signRequests;   // index, isPayout
+   size_t nbFinished = 0;
+
+   const auto finish = [&settlements, &nbFinished, logger](size_t i, const std::string &error) {
+      auto &settl = settlements[i];
+      if (settl.done || !settl.error.empty()) {
+         return;
+      }
+      settl.elapsed = std::chrono::steady_clock::now() - settl.started;
+      if (error.empty()) {
+         settl.done = true;
+      }
+      else {
+         settl.error = error;
+         SPDLOG_LOGGER_ERROR(logger, "settlement #{} failed: {}", i, error);
+      }
+      ++nbFinished;
+   };
+
+   const auto initArgs = [this, &settlements, amount, &utxoReservationMgr](bs::tradeutils::Args &args
+      , size_t i, size_t ourIdx) {
+      args.amount = amount;
+      args.settlementId = settlements[i].settlementId;
+      args.ourAuthAddress = authAddrs_[ourIdx];
+      args.cpAuthPubKey = authKeys_[1 - ourIdx];
+      args.walletsMgr = syncMgr_;
+      args.armory = envPtr_->armoryConnection();
+      args.signContainer = signer_;
+      args.feeRatePb_ = utxoReservationMgr->feeRatePb();
+   };
+
+   // Requester: pay-out for the unsigned pay-in received from dealer
+   const auto createPayout = [&](size_t i) {
+      bs::tradeutils::PayoutArgs args;
+      initArgs(args, i, 0);
+      args.payinTxId = settlements[i].payinHash;
+      args.outputXbtWallet = reqLeaves.front();
+
+      bs::tradeutils::createPayout(std::move(args), [&, i](bs::tradeutils::PayoutResult result) {
+         QMetaObject::invokeMethod(qApp, [&, i, result = std::move(result)] {
+            if (!result.success) {
+               finish(i, "creating payout failed: " + result.errorMsg);
+               return;
+            }
+            const auto reqId = signer_->signSettlementPayoutTXRequest(result.signRequest
+               , { settlements[i].settlementId, authKeys_[1], true }, {});
+            signRequests[reqId] = { i, true };
+         });
+      });
+   };
+
+   // Dealer: unsigned pay-in from the reserved UTXOs
+   const auto createPayin = [&](size_t i) {
+      bs::tradeutils::PayinArgs args;
+      initArgs(args, i, 1);
+      for (const auto &input : settlements[i].payinInputs.inputs) {
+         args.fixedInputs.push_back(input.first);
+      }
+      args.inputXbtWallets.assign(dealerLeaves.begin(), dealerLeaves.end());
+      args.utxoReservation = bs::UtxoReservation::instance();
+
+      bs::tradeutils::createPayin(std::move(args), [&, i](bs::tradeutils::PayinResult result) {
+         QMetaObject::invokeMethod(qApp, [&, i, result = std::move(result)] {
+            if (!result.success) {
+               finish(i, "creating payin failed: " + result.errorMsg);
+               return;
+            }
+            settlements[i].settlAddr = result.settlementAddr;
+            settlements[i].unsignedPayin = result.signRequest;
+            settlements[i].payinHash = result.payinHash;
+            createPayout(i);
+         });
+      });
+   };
+
+   // Signed pay-out goes first, pay-in is signed only after it is verified
+   const auto connTXSigned = QObject::connect(signer_.get(), &SignContainer::TXSigned, qApp, [&](unsigned int id, BinaryData signedTX
+      , bs::error::ErrorCode errCode, std::string errMsg) {
+      const auto it = signRequests.find(id);
+      if (it == signRequests.end()) {
+         return;
+      }
+      const auto i = it->second.first;
+      const bool isPayout = it->second.second;
+      signRequests.erase(it);
+      auto &settl = settlements[i];
+
+      if ((errCode != bs::error::ErrorCode::NoError) || signedTX.empty()) {
+         finish(i, fmt::format("signing {} failed: {} ({})", isPayout ? "payout" : "payin", int(errCode), errMsg));
+         return;
+      }
+
+      if (isPayout) {
+         bs::tradeutils::PayoutVerifyArgs verifyArgs;
+         verifyArgs.signedTx = signedTX;
+         verifyArgs.settlAddr = settl.settlAddr;
+         verifyArgs.usedPayinHash = settl.payinHash;
+         verifyArgs.amount = amount;
+         const auto verifyResult = bs::tradeutils::verifySignedPayout(verifyArgs);
+         if (!verifyResult.success) {
+            finish(i, "payout verification failed: " + verifyResult.errorMsg);
+            return;
+         }
+         settl.signedPayout = signedTX;
+         const auto reqId = signer_->signSettlementTXRequest(settl.unsignedPayin, {}
+            , SignContainer::TXSignMode::Full);
+         signRequests[reqId] = { i, false };
+         return;
+      }
+
+      settl.signedPayin = signedTX;
+      finish(i, {});
+   }, Qt::QueuedConnection);
+
+   UnitTestWalletACT::clear();
+   for (size_t i = 0; i < count; ++i) {
+      settlements[i].settlementId = CryptoPRNG::generateRandom(32);
+      settlements[i].started = std::chrono::steady_clock::now();
+      utxoReservationMgr->reserveBestXbtUtxoSet(dealerWallet->walletId(), amount.GetValue(), false
+         , [&, i](bs::FixedXbtInputs &&fixedInputs) {
+         if (fixedInputs.inputs.empty()) {
+            finish(i, "no UTXOs left to reserve");
+            return;
+         }
+         settlements[i].payinInputs = std::move(fixedInputs);
+         createPayin(i);
+      }, false);
+   }
+
+   const bool allFinished = waitFor([&nbFinished, count] { return nbFinished == count; }
+      , std::chrono::seconds(30 + count));
+   QObject::disconnect(connTXSigned);
+   ASSERT_TRUE(allFinished) << nbFinished << " of " << count << " settlements finished";
+
+   // Every pay-in should spend only its own reservation
+   std::map<UTXO, size_t> reservedBy;
+   for (size_t i = 0; i < count; ++i) {
+      const auto &settl = settlements[i];
+      EXPECT_TRUE(settl.done) << "settlement #" << i << ": " << settl.error;
+      EXPECT_TRUE(settl.payinInputs.utxoRes.isValid());
+      for (const auto &input : settl.payinInputs.inputs) {
+         const auto itRes = reservedBy.emplace(input.first, i);
+         EXPECT_TRUE(itRes.second) << "UTXO " << input.first.getTxHash().toHexStr(true) << ":"
+            << input.first.getTxOutIndex() << " reserved by settlements #" << itRes.first->second
+            << " and #" << i;
+      }
+      for (const auto &input : settl.unsignedPayin.inputs) {
+         EXPECT_EQ(settl.payinInputs.inputs.count(input), 1u) << "settlement #" << i
+            << " spends UTXO it didn't reserve";
+      }
+   }
+   ASSERT_FALSE(HasFailure());
+
+   // Pay-out is broadcast only after its pay-in ZC is seen, as the requester does
+   std::map<BinaryData, size_t> pendingPayins;
+   std::set<BinaryData> pendingPayouts;
+   for (size_t i = 0; i < count; ++i) {
+      pendingPayins[Tx(settlements[i].signedPayin).getThisHash()] = i;
+      envPtr_->armoryInstance()->pushZC(settlements[i].signedPayin);
+   }
+   const auto zcDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(30 + count);
+   while ((!pendingPayins.empty() || !pendingPayouts.empty())
+      && (std::chrono::steady_clock::now() < zcDeadline)) {
+      const auto timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(
+         zcDeadline - std::chrono::steady_clock::now());
+      for (const auto &zc : envPtr_->blockMonitor()->waitForZC(timeLeft)) {
+         const auto itPayin = pendingPayins.find(zc.txHash);
+         if (itPayin != pendingPayins.end()) {
+            const auto &signedPayout = settlements[itPayin->second].signedPayout;
+            pendingPayouts.insert(Tx(signedPayout).getThisHash());
+            envPtr_->armoryInstance()->pushZC(signedPayout);
+            pendingPayins.erase(itPayin);
+            continue;
+         }
+         pendingPayouts.erase(zc.txHash);
+      }
+   }
+   ASSERT_TRUE(pendingPayins.empty()) << pendingPayins.size() << " pay-in ZCs not received";
+   ASSERT_TRUE(pendingPayouts.empty()) << pendingPayouts.size() << " pay-out ZCs not received";
+
+   std::vector<uint64_t> completionUs;
+   for (const auto &settl : settlements) {
+      completionUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(settl.elapsed).count());
+   }
+   std::sort(completionUs.begin(), completionUs.end());
+   const auto p50Ms = bs::bench::percentile(completionUs, 50) / 1000;
+   const auto p90Ms = bs::bench::percentile(completionUs, 90) / 1000;
+   const auto maxMs = completionUs.back() / 1000.0;
+   logger->info("[{}] {} settlements: p50={:.1f} ms, p90={:.1f} ms, max={:.1f} ms", __func__
+      , count, p50Ms, p90Ms, maxMs);
+   RecordProperty("settlements", static_cast<int>(count));
+   RecordProperty("completion_p50_ms", static_cast<int>(p50Ms));
+   RecordProperty("completion_p90_ms", static_cast<int>(p90Ms));
+   RecordProperty("completion_max_ms", static_cast<int>(maxMs));
+}
+
+TEST_F(TestSettlementConcurrent, XBT_8) { doConcurrentSettlements(8); }
+TEST_F(TestSettlementConcurrent, XBT_24) { doConcurrentSettlements(24); }
+TEST_F(TestSettlementConcurrent, XBT_48) { doConcurrentSettlements(48); }
@@ -12,6 +12,8 @@
 #include "TestEnv.h"
 
 
+class InprocSigner;
+
 namespace bs {
    enum class PayoutSignatureType : int;
    namespace core {
@@ -47,6 +49,8 @@ protected:
    
    void mineBlocks(unsigned count);
    void sendTo(uint64_t value, bs::Address& addr);
+   // Sends value to each address in a single TX
+   void sendTo(uint64_t value, const std::vector<bs::Address> &addrs);
 
 public:
    std::shared_ptr<TestEnv> envPtr_;
@@ -55,10 +59,12 @@ public:
 protected:
    const size_t   nbParties_ = 2;
    const double   initialTransferAmount_ = 1.23;
+   size_t         nbFundingUtxos_ = 1;    // initial amount is split into that many UTXOs
    std::vector<std::shared_ptr<bs::core::hd::Wallet>> hdWallet_;
    std::vector<std::shared_ptr<bs::core::hd::Leaf>>   authWallet_;
    std::shared_ptr<bs::core::WalletsManager>          walletsMgr_;
    std::shared_ptr<bs::sync::WalletsManager>          syncMgr_;
+   std::shared_ptr<InprocSigner>                      signer_;
    std::vector<std::shared_ptr<bs::core::Wallet>>     xbtWallet_;
    std::vector<bs::Address>      authAddrs_;
    std::vector<SecureBinaryData> authKeys_;
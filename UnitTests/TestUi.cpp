@@ -1,9 +1,24 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <QAbstractItemModelTester>
+#include <QAbstractListModel>
 #include <QApplication>
 #include <QDebug>
+#include <QEventLoop>
 #include <QLocale>
 #include <QString>
+#include <QTabWidget>
+#include <QTimer>
+#include <QTreeWidget>
+#include "AddressDetailsWidget.h"
 #include "ApplicationSettings.h"
 #include "CommonTypes.h"
 #include "CoreHDWallet.h"
@@ -11,13 +26,24 @@
 #include "CustomControls/CustomDoubleSpinBox.h"
 #include "CustomControls/CustomDoubleValidator.h"
 #include "InprocSigner.h"
+#include "KeyedDiff.h"
+#include "LazyTabInitializer.h"
+#include "RecipientsImport.h"
+#include "StartupPipeline.h"
 #include "Trading/RequestingQuoteWidget.h"
 #include "Trading/RFQTicketXBT.h"
 #include "TestEnv.h"
+#include "TransactionData.h"
+#include "TransactionOutputsModel.h"
+#include "TransactionsViewModel.h"
 #include "UiUtils.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWalletsManager.h"
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 TEST(TestUi, ValidateString)
 {
    int pos = 0;
@@ -82,6 +108,620 @@ TEST(TestUi, Display)
    EXPECT_EQ(UiUtils::displayValue(12.01, "BLK/XBT", "BLK", bs::network::Asset::PrivateMarket), QLocale().toString(12.01, 'f', 6));
 }
 
+// Fast formatters must give exactly the same strings as QLocale-based formatting
+TEST(TestUi, FormatEquivalence)
+{
+   UiUtils::SetupLocale();
+   const auto &reference = [](double value, int precision) {
+      return UiUtils::UnifyValueString(QLocale().toString(value, 'f', precision));
+   };
+   const int precisions[] = { 0, 2, 4, 6, 8 };
+
+   const double edgeValues[] = { 0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.375, 12.345, 999.995
+      , 9.9999999999, -9.9999999999, 1e-10, -1e-10, 1e-300, -5e-324, 999999.995, 1234567.891
+      , 4503599627370495.5, 4503599627370496.0, 1e15, -1e18, 1e300
+      , std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::max() };
+   for (const auto value : edgeValues) {
+      for (const auto precision : precisions) {
+         EXPECT_EQ(UiUtils::formatDecimal(value, precision), reference(value, precision))
+            << value << " with precision " << precision;
+      }
+   }
+   EXPECT_EQ(UiUtils::formatDecimal(1234567.891, 2), QString::fromUtf8("1\xc2\xa0" "234\xc2\xa0" "567.89"));
+   EXPECT_EQ(UiUtils::formatDecimal(-0.004, 2), reference(-0.004, 2));
+
+   std::mt19937_64 rng(42);
+   for (const auto precision : precisions) {
+      for (int i = 0; i < 100000; ++i) {
+         // random mantissa across magnitudes
+         const double magnitude = std::pow(10.0, static_cast<int>(rng() % 24) - 12);
+         double value = static_cast<double>(rng() >> 11) / (1ULL << 53) * magnitude;
+         if (rng() & 1) {
+            value = -value;
+         }
+         ASSERT_EQ(UiUtils::formatDecimal(value, precision), reference(value, precision))
+            << value << " with precision " << precision;
+
+         // values typed by user or received from market data
+         const double decimal = static_cast<double>(rng() % 100000000000ULL) / std::pow(10.0, rng() % 10);
+         ASSERT_EQ(UiUtils::formatDecimal(decimal, precision), reference(decimal, precision))
+            << decimal << " with precision " << precision;
+         ASSERT_EQ(UiUtils::formatDecimal(-decimal, precision), reference(-decimal, precision))
+            << -decimal << " with precision " << precision;
+      }
+   }
+
+   for (int64_t value = -1000000; value <= 1000000; ++value) {
+      ASSERT_EQ(UiUtils::displayAmount(value), reference(UiUtils::amountToBtc(value), 8)) << value;
+   }
+   const int64_t edgeAmounts[] = { 2100000000000000LL, -2100000000000000LL, (1LL << 52) - 1, 1LL << 52
+      , -(1LL << 52), (1LL << 53) + 1, INT64_MAX - 1, INT64_MIN };
+   for (const auto value : edgeAmounts) {
+      EXPECT_EQ(UiUtils::displayAmount(value), reference(UiUtils::amountToBtc(value), 8)) << value;
+   }
+   for (int i = 0; i < 1000000; ++i) {
+      const auto value = static_cast<int64_t>(rng() % 4200000000000000ULL) - 2100000000000000LL;
+      ASSERT_EQ(UiUtils::displayAmount(value), reference(UiUtils::amountToBtc(value), 8)) << value;
+      ASSERT_EQ(UiUtils::displayAmount(static_cast<uint64_t>(std::abs(value)))
+         , reference(UiUtils::amountToBtc(static_cast<uint64_t>(std::abs(value))), 8)) << value;
+      ASSERT_EQ(UiUtils::formatFixedPoint(value, 2), reference(static_cast<double>(value) / 100, 2)) << value;
+   }
+}
+
+// Simulates terminal startup stages with delays and reports per-stage wall time
+TEST(TestUi, StartupPipeline)
+{
+   const int armoryDelay = 300;
+   const int signerDelay = 200;
+   const int walletsDelay = 150;
+
+   StartupPipeline pipeline(StaticLogger::loggerPtr);
+   QEventLoop loop;
+   std::vector<std::string> order;
+
+   const auto &delayedStage = [&pipeline, &order](const std::string &name, int delay) {
+      return [&pipeline, &order, name, delay] {
+         order.push_back(name);
+         QTimer::singleShot(delay, [&pipeline, name] { pipeline.stageCompleted(name); });
+      };
+   };
+   ASSERT_TRUE(pipeline.addStage("armory", {}, delayedStage("armory", armoryDelay)));
+   ASSERT_TRUE(pipeline.addStage("signer", {}, delayedStage("signer", signerDelay)));
+   ASSERT_TRUE(pipeline.addStage("charts", {}, [&pipeline, &order] {
+      order.push_back("charts");
+      pipeline.stageCompleted("charts");
+   }));
+   ASSERT_TRUE(pipeline.addStage("wallets", { "signer" }, delayedStage("wallets", walletsDelay)));
+   ASSERT_TRUE(pipeline.addStage("registration", { "wallets", "armory" }, [&pipeline, &order] {
+      order.push_back("registration");
+      pipeline.stageCompleted("registration");
+   }));
+   EXPECT_FALSE(pipeline.addStage("armory", {}));
+   EXPECT_FALSE(pipeline.addStage("unknown_dep", { "nonexistent" }));
+
+   pipeline.setFinishedCallback([&loop] { loop.quit(); });
+   QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+   pipeline.start();
+
+   // independent stages are started immediately
+   ASSERT_GE(order.size(), 3u);
+   EXPECT_EQ(order[0], "armory");
+   EXPECT_EQ(order[1], "signer");
+   EXPECT_EQ(order[2], "charts");
+   EXPECT_TRUE(pipeline.isCompleted("charts"));
+   EXPECT_FALSE(pipeline.isCompleted("wallets"));
+
+   loop.exec();
+   ASSERT_TRUE(pipeline.isFinished());
+   ASSERT_EQ(order.size(), 5u);
+   EXPECT_EQ(order[3], "wallets");
+   EXPECT_EQ(order[4], "registration");
+
+   const auto timings = pipeline.timings();
+   ASSERT_EQ(timings.size(), 5u);
+   for (const auto &timing : timings) {
+      EXPECT_TRUE(timing.completed);
+      RecordProperty(timing.name + "_ms", static_cast<int>(timing.duration.count()));
+   }
+   // wallets stage waits for signer only, not for Armory
+   EXPECT_GE(timings[3].startedAt.count(), signerDelay);
+   EXPECT_LT(timings[3].startedAt.count(), armoryDelay);
+   EXPECT_GE(timings[4].startedAt.count(), armoryDelay);
+
+   // sequential startup would take the sum of all delays
+   const auto total = pipeline.elapsed().count();
+   RecordProperty("total_ms", static_cast<int>(total));
+   EXPECT_LT(total, armoryDelay + signerDelay + walletsDelay);
+   StaticLogger::loggerPtr->info("{}", pipeline.report());
+}
+
+TEST(TestUi, LazyTabInitializer)
+{
+   QTabWidget tabWidget;
+   auto portfolio = new QWidget;
+   auto chart = new QWidget;
+   auto explorer = new QWidget;
+   tabWidget.addTab(portfolio, QLatin1String("Portfolio"));
+   tabWidget.addTab(chart, QLatin1String("Chart"));
+   tabWidget.addTab(explorer, QLatin1String("Explorer"));
+   tabWidget.setCurrentWidget(explorer);
+
+   LazyTabInitializer lazyTabs(&tabWidget);
+   int chartInits = 0;
+   int explorerInits = 0;
+   lazyTabs.add(chart, [&chartInits] { ++chartInits; });
+   lazyTabs.add(explorer, [&explorerInits] { ++explorerInits; });
+
+   // current tab is initialized right away, others wait for the first show
+   EXPECT_EQ(explorerInits, 1);
+   EXPECT_TRUE(lazyTabs.isInitialized(explorer));
+   EXPECT_EQ(chartInits, 0);
+   EXPECT_TRUE(lazyTabs.isPending(chart));
+   EXPECT_FALSE(lazyTabs.isInitialized(portfolio));
+
+   tabWidget.setCurrentWidget(portfolio);
+   EXPECT_EQ(chartInits, 0);
+
+   tabWidget.setCurrentWidget(chart);
+   EXPECT_EQ(chartInits, 1);
+   EXPECT_FALSE(lazyTabs.isPending(chart));
+
+   // init runs only once
+   tabWidget.setCurrentWidget(explorer);
+   tabWidget.setCurrentWidget(chart);
+   EXPECT_EQ(chartInits, 1);
+   EXPECT_EQ(explorerInits, 1);
+}
+
+namespace {
+   class NoCCResolver : public bs::sync::CCDataResolver
+   {
+   public:
+      std::string nameByWalletIndex(const bs::hd::Path::Elem) const override { return {}; }
+      uint64_t lotSizeFor(const std::string &) const override { return 0; }
+      bs::Address genesisAddrFor(const std::string &) const override { return {}; }
+      std::string descriptionFor(const std::string &) const override { return {}; }
+      std::vector<std::string> securities() const override { return {}; }
+   };
+}
+
+TEST(TestUi, AddressDetailsPaged)
+{
+   TestEnv env(StaticLogger::loggerPtr);
+   env.requireArmory();
+
+   const auto &newAddress = [] {
+      const auto privKey = CryptoPRNG::generateRandom(32);
+      const auto pubKey = CryptoECDSA().ComputePublicKey(privKey, true);
+      return bs::Address::fromPubKey(pubKey, AddressEntryType_P2WPKH);
+   };
+   const auto busyAddr = newAddress();
+   const auto quietAddr = newAddress();
+   const int nbBusyTxs = 600;
+   const int nbQuietTxs = 3;
+   const size_t txCacheCapacity = 20;
+
+   const auto curHeight = env.armoryConnection()->topBlock();
+   auto recipient = busyAddr.getRecipient(bs::XBTAmount{ uint64_t(50 * COIN) });
+   env.armoryInstance()->mineNewBlock(recipient.get(), nbBusyTxs);
+   recipient = quietAddr.getRecipient(bs::XBTAmount{ uint64_t(50 * COIN) });
+   env.armoryInstance()->mineNewBlock(recipient.get(), nbQuietTxs);
+   env.blockMonitor()->waitForNewBlocks(curHeight + nbBusyTxs + nbQuietTxs);
+
+   AddressDetailsWidget widget;
+   widget.init(env.armoryConnection(), StaticLogger::loggerPtr
+      , std::make_shared<NoCCResolver>(), nullptr);
+   widget.setTxCacheCapacity(txCacheCapacity);
+   widget.resize(1000, 600);
+   widget.show();
+   const auto tree = widget.findChild<QTreeWidget *>();
+   ASSERT_NE(tree, nullptr);
+
+   QEventLoop loop;
+   std::function<void(int, int)> onPageLoaded;
+   QObject::connect(&widget, &AddressDetailsWidget::pageLoaded, [&onPageLoaded](int loaded, int total) {
+      onPageLoaded(loaded, total);
+   });
+   const auto &waitMs = [](int ms) {
+      QEventLoop waitLoop;
+      QTimer::singleShot(ms, &waitLoop, &QEventLoop::quit);
+      waitLoop.exec();
+   };
+
+   // Rows are displayed page by page
+   std::vector<int> rowsPerPage;
+   std::vector<size_t> finishedAfterPages;
+   QObject::connect(&widget, &AddressDetailsWidget::finished, [&rowsPerPage, &finishedAfterPages] {
+      finishedAfterPages.push_back(rowsPerPage.size());
+   });
+   onPageLoaded = [&](int loaded, int total) {
+      rowsPerPage.push_back(tree->topLevelItemCount());
+      if (loaded == total) {
+         loop.quit();
+      }
+   };
+   QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+   widget.setQueryAddr(busyAddr);
+   loop.exec();
+   ASSERT_GE(rowsPerPage.size(), 2u);
+   EXPECT_GT(rowsPerPage.front(), 0);
+   EXPECT_LT(rowsPerPage.front(), nbBusyTxs);
+   EXPECT_EQ(rowsPerPage.back(), nbBusyTxs);
+   // finished is emitted once, after the last page
+   ASSERT_EQ(finishedAfterPages.size(), 1u);
+   EXPECT_EQ(finishedAfterPages.front(), rowsPerPage.size());
+
+   // TX details are loaded for visible rows only and TX cache stays bounded
+   waitMs(1000);
+   int detailedRows = 0;
+   for (int i = 0; i < tree->topLevelItemCount(); ++i) {
+      if (!tree->topLevelItem(i)->text(AddressDetailsWidget::colInputsNum).isEmpty()) {
+         detailedRows++;
+      }
+   }
+   EXPECT_GT(detailedRows, 0);
+   EXPECT_LT(detailedRows, nbBusyTxs);
+   EXPECT_LE(widget.txCacheSize(), txCacheCapacity);
+
+   // Searching for another address cancels loading of the previous one
+   bool switched = false;
+   onPageLoaded = [&](int loaded, int total) {
+      if (!switched) {
+         switched = true;
+         EXPECT_LT(loaded, total);
+         widget.setQueryAddr(quietAddr);
+         return;
+      }
+      if (loaded == total) {
+         loop.quit();
+      }
+   };
+   finishedAfterPages.clear();
+   QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+   widget.setQueryAddr(busyAddr);
+   loop.exec();
+   ASSERT_TRUE(switched);
+   EXPECT_EQ(tree->topLevelItemCount(), nbQuietTxs);
+   // cancelled query is not reported as finished
+   EXPECT_EQ(finishedAfterPages.size(), 1u);
+
+   // No late pages or TXs of the first address arrive
+   onPageLoaded = [](int, int) {};
+   waitMs(1000);
+   EXPECT_EQ(tree->topLevelItemCount(), nbQuietTxs);
+   for (int i = 0; i < tree->topLevelItemCount(); ++i) {
+      EXPECT_EQ(tree->topLevelItem(i)->text(AddressDetailsWidget::colInputsNum), QLatin1String("1"));
+   }
+   EXPECT_LE(widget.txCacheSize(), static_cast<size_t>(nbQuietTxs));
+}
+
+namespace {
+   // Returns 0 where it's not supported
+   size_t residentMemory()
+   {
+#ifdef __linux__
+      std::ifstream statm("/proc/self/statm");
+      size_t size = 0, resident = 0;
+      statm >> size >> resident;
+      return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+      return 0;
+#endif
+   }
+}
+
+TEST(TestUi, TransactionsModelMemoryFootprint)
+{
+   const size_t nbRows = 200000;
+   const uint32_t startTime = 1500000000;
+
+   // Styles are shared, so node holds only item pointer and tree links
+   EXPECT_LE(sizeof(TXNode), 6 * sizeof(void *));
+
+   const auto memBefore = residentMemory();
+   TXNode root;
+   for (size_t i = 0; i < nbRows; ++i) {
+      auto item = std::make_shared<TransactionsViewItem>();
+      item->txEntry.txHash = CryptoPRNG::generateRandom(32);
+      item->txEntry.walletIds = { "synthetic_wallet" };
+      item->txEntry.value = ((i % 3) ? 1 : -1) * static_cast<int64_t>(1000 + i);
+      item->txEntry.blockNum = static_cast<uint32_t>(i / 4 + 1);
+      item->txEntry.txTime = startTime + static_cast<uint32_t>(i * 600);
+      item->walletID = QLatin1String("synthetic_wallet");
+      item->direction = (item->txEntry.value > 0) ? bs::sync::Transaction::Received
+         : bs::sync::Transaction::Sent;
+      item->amount = item->txEntry.value / BTCNumericTypes::BalanceDivider;
+      item->amountStr = UiUtils::displayAmount(item->amount);
+      item->mainAddress = QString::fromStdString(CryptoPRNG::generateRandom(20).toHexStr());
+      item->confirmations = 6;
+      item->updateFilterKeys();
+      item->initialized = true;
+      root.add(new TXNode(item));
+   }
+   const auto memAfter = residentMemory();
+
+   // Display strings are formatted on request
+   const auto node = root.child(1);
+   ASSERT_NE(node, nullptr);
+   EXPECT_EQ(node->data(static_cast<int>(TransactionsViewModel::Columns::Date), Qt::DisplayRole).toString()
+      , UiUtils::displayDateTime(startTime + 600));
+   EXPECT_EQ(node->data(static_cast<int>(TransactionsViewModel::Columns::SendReceive), Qt::DisplayRole).toString()
+      , QObject::tr(bs::sync::Transaction::toStringDir(bs::sync::Transaction::Received)));
+   EXPECT_TRUE(node->data(static_cast<int>(TransactionsViewModel::Columns::Wallet), Qt::DisplayRole).toString().isEmpty());
+   EXPECT_TRUE(node->data(static_cast<int>(TransactionsViewModel::Columns::Amount), Qt::FontRole).value<QFont>().bold());
+   EXPECT_EQ(node->data(static_cast<int>(TransactionsViewModel::Columns::Status), Qt::TextColorRole).value<QColor>()
+      , QColor(Qt::darkGreen));
+
+   RecordProperty("node_size", static_cast<int>(sizeof(TXNode)));
+   RecordProperty("item_size", static_cast<int>(sizeof(TransactionsViewItem)));
+   if (memBefore && (memAfter > memBefore)) {
+      const auto bytesPerRow = (memAfter - memBefore) / nbRows;
+      RecordProperty("bytes_per_row", static_cast<int>(bytesPerRow));
+      StaticLogger::loggerPtr->info("[TransactionsModelMemoryFootprint] {} rows take {} bytes per row"
+         , nbRows, bytesPerRow);
+   }
+}
+
+TEST(TestUi, BulkRecipientsImport)
+{
+   TestEnv env(StaticLogger::loggerPtr);
+   env.requireArmory();
+
+   const auto passphrase = SecureBinaryData::fromString("pass");
+   bs::core::wallet::Seed seed{ CryptoPRNG::generateRandom(32), NetworkType::TestNet };
+   const bs::wallet::PasswordData pd{ passphrase, { bs::wallet::EncryptionType::Password } };
+   const auto coreWallet = std::make_shared<bs::core::hd::Wallet>(
+      "test", "", seed, pd, env.armoryInstance()->homedir_);
+   std::shared_ptr<bs::core::hd::Leaf> coreLeaf;
+   {
+      const bs::core::WalletPasswordScoped lock(coreWallet, passphrase);
+      coreLeaf = coreWallet->createGroup(coreWallet->getXBTGroupType())
+         ->createLeaf(AddressEntryType_Default, 0, 10);
+   }
+   ASSERT_NE(coreLeaf, nullptr);
+   const auto fundingAddr = coreLeaf->getNewExtAddress();
+
+   auto inprocSigner = std::make_shared<InprocSigner>(coreWallet, StaticLogger::loggerPtr);
+   inprocSigner->Start();
+   auto syncMgr = std::make_shared<bs::sync::WalletsManager>(StaticLogger::loggerPtr
+      , env.appSettings(), env.armoryConnection());
+   syncMgr->setSignContainer(inprocSigner);
+   auto promSync = std::make_shared<std::promise<bool>>();
+   syncMgr->syncWallets([promSync](int cur, int total) {
+      if (cur == total) {
+         promSync->set_value(true);
+      }
+   });
+   ASSERT_TRUE(promSync->get_future().get());
+
+   const auto syncWallet = syncMgr->getHDWalletById(coreWallet->walletId());
+   const auto syncLeaf = syncMgr->getWalletById(coreLeaf->walletId());
+   ASSERT_NE(syncLeaf, nullptr);
+   syncWallet->setCustomACT<UnitTestWalletACT>(env.armoryConnection());
+   UnitTestWalletACT::waitOnRefresh(syncWallet->registerWallet(env.armoryConnection()));
+
+   // Several UTXOs, so that coin selection has something to choose from
+   const unsigned int nbBlocks = 6;
+   const auto curHeight = env.armoryConnection()->topBlock();
+   const auto fundingRecipient = fundingAddr.getRecipient(bs::XBTAmount{ uint64_t(50 * COIN) });
+   env.armoryInstance()->mineNewBlock(fundingRecipient.get(), nbBlocks);
+   ASSERT_EQ(UnitTestWalletACT::waitOnNewBlock(), curHeight + nbBlocks);
+
+   const int nbRecipients = 5000;
+   std::vector<bs::Address> addresses;
+   QByteArray csv("address,amount\n");
+   for (int i = 0; i < nbRecipients; ++i) {
+      BinaryData prefixed;
+      prefixed.append(SCRIPT_PREFIX_P2WPKH);
+      prefixed.append(CryptoPRNG::generateRandom(20));
+      addresses.push_back(bs::Address::fromHash(prefixed));
+      csv.append(QByteArray::fromStdString(addresses.back().display()));
+      csv.append(',');
+      csv.append(QByteArray::number(0.00001 * (i + 1), 'f', 8));
+      csv.append('\n');
+   }
+   csv.append("# comment\n\ninvalid_address,1\n");
+   csv.append(QByteArray::fromStdString(addresses.front().display()) + ";-1\n");
+
+   QStringList errors;
+   const auto recipients = bs::ui::parseRecipientsCsv(csv, &errors);
+   ASSERT_EQ(recipients.size(), static_cast<size_t>(nbRecipients));
+   EXPECT_EQ(errors.size(), 2);
+   EXPECT_EQ(recipients[10].address, addresses[10]);
+   EXPECT_DOUBLE_EQ(recipients[10].amount, 0.00011);
+
+   // Callback does what CreateTransactionDialog does on each change notification:
+   // recalculates transaction summary (inputs selection, fee) and max amount
+   int nbRecalcs = 0;
+   std::chrono::steady_clock::duration recalcTime{};
+   size_t usedInputs = 0;
+   uint64_t totalFee = 0;
+   double maxAmount = 0;
+   std::shared_ptr<TransactionData> txData;
+   const auto cbChanged = [&nbRecalcs, &recalcTime, &usedInputs, &totalFee, &maxAmount, &txData] {
+      ++nbRecalcs;
+      const auto start = std::chrono::steady_clock::now();
+      const auto &summary = txData->GetTransactionSummary();
+      usedInputs = static_cast<size_t>(summary.usedTransactions);
+      totalFee = static_cast<uint64_t>(summary.totalFee);
+      maxAmount = txData->CalculateMaxAmount({});
+      recalcTime += std::chrono::steady_clock::now() - start;
+   };
+   txData = std::make_shared<TransactionData>(cbChanged, StaticLogger::loggerPtr);
+   txData->setFeePerByte(5);
+
+   auto promInputs = std::make_shared<std::promise<bool>>();
+   txData->setWallet(syncLeaf, env.armoryConnection()->topBlock(), true, [promInputs] {
+      promInputs->set_value(true);
+   });
+   ASSERT_TRUE(promInputs->get_future().get());
+   cbChanged();
+   const auto maxAmountBefore = maxAmount;
+   EXPECT_GT(maxAmountBefore, 0);
+   nbRecalcs = 0;
+   recalcTime = {};
+
+   TransactionOutputsModel model(nullptr);
+   const auto start = std::chrono::steady_clock::now();
+   const auto ids = bs::ui::addRecipients(txData, &model, recipients, cbChanged);
+   const auto importTime = std::chrono::steady_clock::now() - start;
+
+   ASSERT_EQ(ids.size(), static_cast<size_t>(nbRecipients));
+   EXPECT_EQ(nbRecalcs, 1);
+   EXPECT_EQ(txData->allRecipientIds().size(), static_cast<size_t>(nbRecipients));
+   EXPECT_EQ(model.rowCount({}), nbRecipients);
+
+   // The only recalculation selected inputs and fee for all recipients
+   EXPECT_GT(usedInputs, 0u);
+   EXPECT_GT(totalFee, 0u);
+   EXPECT_GT(maxAmount, 0);
+   EXPECT_LT(maxAmount, maxAmountBefore - txData->GetTotalRecipientsAmount() + 0.00000001);
+   EXPECT_TRUE(txData->IsTransactionValid());
+
+   for (int i = 0; i < nbRecipients; i += 499) {
+      EXPECT_EQ(model.GetRowById(ids[i]), i);
+      EXPECT_EQ(model.GetOutputId(i), ids[i]);
+   }
+   model.UpdateRecipientAmount(ids.back(), 1.5);
+   EXPECT_EQ(model.data(model.index(nbRecipients - 1, 1)).toString(), UiUtils::displayAmount(1.5));
+
+   model.RemoveRecipient(0);
+   EXPECT_EQ(model.GetRowById(ids[0]), -1);
+   EXPECT_EQ(model.GetRowById(ids[1]), 0);
+   EXPECT_EQ(model.GetRowById(ids.back()), nbRecipients - 2);
+
+   // Timings depend on the machine, so they're reported but not asserted
+   RecordProperty("recalc_us", static_cast<int>(
+      std::chrono::duration_cast<std::chrono::microseconds>(recalcTime).count()));
+   RecordProperty("import_ms", static_cast<int>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count()));
+   RecordProperty("inputs_used", static_cast<int>(usedInputs));
+}
+
+namespace {
+   struct DiffRow
+   {
+      int key;
+      int value;
+   };
+
+   class DiffTestModel : public QAbstractListModel
+   {
+   public:
+      int rowCount(const QModelIndex &parent = QModelIndex()) const override
+      {
+         return parent.isValid() ? 0 : static_cast<int>(rows_.size());
+      }
+
+      QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+      {
+         if (!index.isValid() || (index.row() >= rowCount()) || (role != Qt::DisplayRole)) {
+            return {};
+         }
+         return rows_[index.row()].key;
+      }
+
+      bs::ui::KeyedDiffStats update(std::vector<DiffRow> newRows)
+      {
+         return bs::ui::applyKeyedDiff(this, rows_, std::move(newRows)
+            , [](const DiffRow &row) { return row.key; }
+            , [](const DiffRow &lhs, const DiffRow &rhs) { return lhs.value == rhs.value; });
+      }
+
+      const std::vector<DiffRow> &rows() const { return rows_; }
+
+   private:
+      std::vector<DiffRow> rows_;
+   };
+}
+
+TEST(TestUi, KeyedDiff)
+{
+   DiffTestModel model;
+   QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+   int nbResets = 0, nbRemoved = 0, nbInserted = 0, nbMoved = 0, nbChanged = 0;
+   QObject::connect(&model, &QAbstractItemModel::modelReset, [&nbResets] { ++nbResets; });
+   QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&nbRemoved](const QModelIndex &, int first, int last) {
+      nbRemoved += last - first + 1;
+   });
+   QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&nbInserted](const QModelIndex &, int first, int last) {
+      nbInserted += last - first + 1;
+   });
+   QObject::connect(&model, &QAbstractItemModel::rowsMoved, [&nbMoved] { ++nbMoved; });
+   QObject::connect(&model, &QAbstractItemModel::dataChanged, [&nbChanged](const QModelIndex &topLeft
+      , const QModelIndex &bottomRight) {
+      nbChanged += bottomRight.row() - topLeft.row() + 1;
+   });
+
+   std::mt19937 rng(42);
+   std::vector<int> keyPool(40);
+   std::iota(keyPool.begin(), keyPool.end(), 0);
+   for (int iter = 0; iter < 500; ++iter) {
+      std::shuffle(keyPool.begin(), keyPool.end(), rng);
+      const int nbRows = static_cast<int>(rng() % 30);
+      std::vector<DiffRow> newRows;
+      for (int i = 0; i < nbRows; ++i) {
+         newRows.push_back({ keyPool[i], static_cast<int>(rng() % 3) });
+      }
+
+      std::vector<std::pair<int, QPersistentModelIndex>> persistent;
+      for (int i = 0; i < model.rowCount(); ++i) {
+         persistent.emplace_back(model.rows()[i].key, model.index(i));
+      }
+      std::vector<int> commonOldOrder;    // new positions of kept rows in old order
+      int expRemoved = 0, expChanged = 0;
+      for (const auto &row : model.rows()) {
+         const auto it = std::find_if(newRows.cbegin(), newRows.cend(), [&row](const DiffRow &newRow) {
+            return newRow.key == row.key;
+         });
+         if (it == newRows.cend()) {
+            ++expRemoved;
+            continue;
+         }
+         commonOldOrder.push_back(static_cast<int>(it - newRows.cbegin()));
+         expChanged += (it->value != row.value) ? 1 : 0;
+      }
+      const int expInserted = nbRows - static_cast<int>(commonOldOrder.size());
+      const int expMoved = static_cast<int>(commonOldOrder.size())
+         - static_cast<int>(bs::ui::detail::longestIncreasingSubsequence(commonOldOrder).size());
+
+      nbRemoved = nbInserted = nbMoved = nbChanged = 0;
+      const auto stats = model.update(newRows);
+
+      ASSERT_EQ(model.rows().size(), newRows.size());
+      for (int i = 0; i < nbRows; ++i) {
+         EXPECT_EQ(model.rows()[i].key, newRows[i].key);
+         EXPECT_EQ(model.rows()[i].value, newRows[i].value);
+      }
+      EXPECT_FALSE(stats.reset);
+      EXPECT_EQ(nbRemoved, expRemoved);
+      EXPECT_EQ(nbInserted, expInserted);
+      EXPECT_EQ(nbMoved, expMoved);
+      EXPECT_EQ(nbChanged, expChanged);
+      EXPECT_EQ(stats.removed, expRemoved);
+      EXPECT_EQ(stats.inserted, expInserted);
+      EXPECT_EQ(stats.moved, expMoved);
+      EXPECT_EQ(stats.changed, expChanged);
+
+      // Kept rows are followed by persistent indices, removed ones are invalidated
+      for (const auto &index : persistent) {
+         const bool isKept = std::find_if(newRows.cbegin(), newRows.cend(), [&index](const DiffRow &row) {
+            return row.key == index.first; }) != newRows.cend();
+         ASSERT_EQ(index.second.isValid(), isKept);
+         if (isKept) {
+            EXPECT_EQ(model.rows()[index.second.row()].key, index.first);
+         }
+      }
+   }
+   EXPECT_EQ(nbResets, 0);
+
+   // Duplicate keys can't be matched - falls back to reset
+   const auto stats = model.update({ { 1, 0 }, { 1, 1 } });
+   EXPECT_TRUE(stats.reset);
+   EXPECT_EQ(nbResets, 1);
+   EXPECT_EQ(model.rowCount(), 2);
+}
+
 #if 0    // it now doesn't compile
 TEST(TestUi, DISABLED_RFQ_entry_CC_sell)
 {
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include <QComboBox>
+#include <QEventLoop>
 #include <QLocale>
 #include <QString>
+#include <QTimer>
 
+#include "AddressOwnershipIndex.h"
 #include "ApplicationSettings.h"
 #include "BIP32_Node.h"
 #include "CoreHDLeaf.h"
@@ -836,6 +839,120 @@ TEST_F(TestWallet, CreateDestroyLoad_SyncWallet)
    }
 }
 
+TEST_F(TestWallet, AddressOwnershipIndex)
+{
+   const bs::core::wallet::Seed seed{ SecureBinaryData::fromString("test seed"), NetworkType::TestNet };
+   const bs::wallet::PasswordData pd{ passphrase_, { bs::wallet::EncryptionType::Password } };
+   auto walletPtr = std::make_shared<bs::core::hd::Wallet>(
+      "test", "", seed, pd, walletFolder_, envPtr_->logger());
+   const bs::hd::Path xbtPath({ bs::hd::Purpose::Native, bs::hd::Bitcoin_test, 0 });
+
+   std::shared_ptr<bs::core::hd::Leaf> leafXbt, leafCC;
+   std::vector<bs::Address> xbtAddresses, ccAddresses;
+   {
+      const bs::core::WalletPasswordScoped lock(walletPtr, passphrase_);
+      walletPtr->createStructure(10);
+      leafXbt = walletPtr->getGroup(bs::hd::Bitcoin_test)->getLeafByPath(xbtPath);
+      ASSERT_NE(leafXbt, nullptr);
+      leafCC = walletPtr->createGroup(bs::hd::CoinType::BlockSettle_CC)->createLeaf(
+         AddressEntryType_P2WPKH, 7568, 10);
+      ASSERT_NE(leafCC, nullptr);
+
+      for (int i = 0; i < 5; ++i) {
+         xbtAddresses.push_back(leafXbt->getNewExtAddress());
+         ccAddresses.push_back(leafCC->getNewExtAddress());
+      }
+      xbtAddresses.push_back(leafXbt->getNewChangeAddress());
+   }
+
+   auto inprocSigner = std::make_shared<InprocSigner>(walletPtr, envPtr_->logger());
+   inprocSigner->Start();
+   auto syncMgr = std::make_shared<bs::sync::WalletsManager>(envPtr_->logger()
+      , envPtr_->appSettings(), envPtr_->armoryConnection());
+   syncMgr->setSignContainer(inprocSigner);
+   auto promSync = std::make_shared<std::promise<bool>>();
+   auto futSync = promSync->get_future();
+   const auto &cbSync = [promSync](int cur, int total) {
+      if ((cur < 0) || (total < 0)) {
+         promSync->set_value(false);
+         return;
+      }
+      if (cur == total) {
+         promSync->set_value(true);
+      }
+   };
+   syncMgr->syncWallets(cbSync);
+   ASSERT_TRUE(futSync.get());
+
+   bs::sync::AddressOwnershipIndex index(syncMgr);
+   EXPECT_EQ(index.size(), xbtAddresses.size() + ccAddresses.size());
+
+   for (const auto &addr : xbtAddresses) {
+      const auto owner = index.find(addr);
+      ASSERT_NE(owner, nullptr);
+      EXPECT_EQ(owner->walletId, leafXbt->walletId());
+      EXPECT_EQ(owner->rootId, walletPtr->walletId());
+      EXPECT_TRUE(index.contains(addr, bs::core::wallet::Type::Bitcoin));
+      EXPECT_FALSE(index.contains(addr, bs::core::wallet::Type::ColorCoin));
+   }
+   for (const auto &addr : ccAddresses) {
+      const auto owner = index.find(addr);
+      ASSERT_NE(owner, nullptr);
+      EXPECT_EQ(owner->walletId, leafCC->walletId());
+      EXPECT_TRUE(index.contains(addr, bs::core::wallet::Type::ColorCoin));
+      EXPECT_FALSE(index.contains(addr, bs::core::wallet::Type::Bitcoin));
+   }
+
+   BinaryData prefixed;
+   prefixed.append(AddressEntry::getPrefixByte(AddressEntryType_P2WPKH));
+   prefixed.append(CryptoPRNG::generateRandom(20));
+   const auto otherAddr = bs::Address::fromHash(prefixed);
+   EXPECT_FALSE(index.contains(otherAddr));
+
+   // address generated after index was built is picked up on wallet change
+   const auto syncLeaf = syncMgr->getWalletById(leafXbt->walletId());
+   ASSERT_NE(syncLeaf, nullptr);
+   auto promAddr = std::make_shared<std::promise<bs::Address>>();
+   auto futAddr = promAddr->get_future();
+   syncLeaf->getNewExtAddress([promAddr](const bs::Address &addr) {
+      promAddr->set_value(addr);
+   });
+   const auto newAddr = futAddr.get();
+   emit syncMgr->walletChanged(syncLeaf->walletId());
+   EXPECT_TRUE(index.contains(newAddr, bs::core::wallet::Type::Bitcoin));
+   EXPECT_EQ(index.size(), xbtAddresses.size() + ccAddresses.size() + 1);
+
+   // address generated on signer side is picked up when wallet is re-synchronized
+   // (signer UI path: SignerAdapter::updateWallet), no walletChanged is emitted
+   bs::Address signerAddr;
+   {
+      const bs::core::WalletPasswordScoped lock(walletPtr, passphrase_);
+      signerAddr = leafXbt->getNewExtAddress();
+   }
+   EXPECT_FALSE(index.contains(signerAddr));
+   QEventLoop loop;
+   bool synchronized = false;
+   QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+   ASSERT_TRUE(index.synchronizeWallet(leafXbt->walletId(), [&loop, &synchronized] {
+      synchronized = true;
+      loop.quit();
+   }));
+   loop.exec();
+   ASSERT_TRUE(synchronized);
+   EXPECT_TRUE(index.contains(signerAddr, bs::core::wallet::Type::Bitcoin));
+   EXPECT_EQ(index.size(), xbtAddresses.size() + ccAddresses.size() + 2);
+   EXPECT_FALSE(index.synchronizeWallet("unknown_wallet"));
+
+   // HD wallet id removes all its leaves
+   index.removeWallet(walletPtr->walletId());
+   EXPECT_EQ(index.size(), 0u);
+   EXPECT_EQ(index.walletsCount(), 0u);
+   EXPECT_FALSE(index.contains(xbtAddresses.front()));
+
+   index.rebuild();
+   EXPECT_EQ(index.size(), xbtAddresses.size() + ccAddresses.size() + 2);
+}
+
 TEST_F(TestWallet, CreateDestroyLoad_AuthLeaf)
 {
    //setup bip32 node
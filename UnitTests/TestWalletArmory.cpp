@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <QApplication>
 #include <QComboBox>
 #include <QLocale>
 #include <QString>
@@ -12,6 +13,7 @@
 #include "InprocSigner.h"
 #include "SystemFileUtils.h"
 #include "TestEnv.h"
+#include "TransactionsViewModel.h"
 #include "UiUtils.h"
 #include "WalletEncryption.h"
 #include "Wallets/SyncHDWallet.h"
@@ -1365,3 +1367,123 @@ TEST_F(TestWalletWithArmory, CallbackReturnTxCrash)
    }, true);
    futSync.wait();
 }
+
+TEST_F(TestWalletWithArmory, TransactionsLedgerSnapshot)
+{
+   auto addr = leafPtr_->getNewExtAddress();
+   ASSERT_FALSE(addr.empty());
+
+   auto inprocSigner = std::make_shared<InprocSigner>(walletPtr_, envPtr_->logger());
+   inprocSigner->Start();
+   auto syncMgr = std::make_shared<bs::sync::WalletsManager>(envPtr_->logger()
+      , envPtr_->appSettings(), envPtr_->armoryConnection());
+   syncMgr->setSignContainer(inprocSigner);
+
+   auto promSync = std::make_shared<std::promise<bool>>();
+   auto futSync = promSync->get_future();
+   const auto &cbSync = [promSync](int cur, int total) {
+      if (cur == total) {
+         promSync->set_value(true);
+      }
+   };
+   syncMgr->syncWallets(cbSync);
+   EXPECT_TRUE(futSync.get());
+
+   auto syncHdWallet = syncMgr->getHDWalletById(walletPtr_->walletId());
+   ASSERT_NE(syncHdWallet, nullptr);
+   syncHdWallet->setCustomACT<UnitTestWalletACT>(envPtr_->armoryConnection());
+   auto regIDs = syncHdWallet->registerWallet(envPtr_->armoryConnection());
+   UnitTestWalletACT::waitOnRefresh(regIDs);
+
+   const auto armoryInstance = envPtr_->armoryInstance();
+   const auto recipient = addr.getRecipient(bs::XBTAmount{ (uint64_t)(5 * COIN) });
+   armoryInstance->mineNewBlock(recipient.get(), 12);
+   UnitTestWalletACT::waitOnNewBlock();
+
+   // Waits until dataLoaded is emitted and all rows are initialized
+   const auto &lbdWaitLoaded = [](TransactionsViewModel &model, bool &loaded) -> bool {
+      const auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+         QApplication::processEvents();
+         if (!loaded) {
+            continue;
+         }
+         bool allInited = true;
+         for (int i = 0; i < model.rowCount(); ++i) {
+            const auto item = model.getItem(model.index(i, 0));
+            if (!item || !item->initialized) {
+               allInited = false;
+               break;
+            }
+         }
+         if (allInited) {
+            return true;
+         }
+      }
+      return false;
+   };
+
+   const auto &lbdRows = [](const TransactionsViewModel &model) {
+      std::vector<std::string> result;
+      for (int i = 0; i < model.rowCount(); ++i) {
+         const auto item = model.getItem(model.index(i, 0));
+         result.push_back(item->txEntry.txHash.toHexStr() + "|" + item->walletID.toStdString()
+            + "|" + item->amountStr.toStdString() + "|" + item->dirStr().toStdString()
+            + "|" + item->mainAddress.toStdString() + "|" + std::to_string(item->txEntry.blockNum)
+            + "|" + std::to_string(item->confirmations));
+      }
+      std::sort(result.begin(), result.end());
+      return result;
+   };
+
+   const auto snapshotFile = QString::fromStdString(armoryInstance->homedir_ + "/transactions.snapshot");
+   size_t nbSnapshotRows = 0;
+   {
+      TransactionsViewModel model(envPtr_->armoryConnection(), syncMgr, envPtr_->logger());
+      bool loaded = false;
+      QObject::connect(&model, &TransactionsViewModel::dataLoaded, [&loaded](int) { loaded = true; });
+      model.loadAllWallets();
+      ASSERT_TRUE(lbdWaitLoaded(model, loaded));
+      nbSnapshotRows = model.itemsCount();
+      EXPECT_GE(nbSnapshotRows, 12);
+      ASSERT_TRUE(model.saveSnapshot(snapshotFile));
+   }
+
+   armoryInstance->mineNewBlock(recipient.get(), 3);
+   UnitTestWalletACT::waitOnNewBlock();
+
+   TransactionsViewModel warmModel(envPtr_->armoryConnection(), syncMgr, envPtr_->logger());
+   const auto warmStart = std::chrono::steady_clock::now();
+   ASSERT_TRUE(warmModel.loadSnapshot(snapshotFile));
+   const auto snapshotLoadTime = std::chrono::steady_clock::now() - warmStart;
+   EXPECT_EQ(warmModel.itemsCount(), nbSnapshotRows);
+   bool warmLoaded = false;
+   QObject::connect(&warmModel, &TransactionsViewModel::dataLoaded, [&warmLoaded](int) { warmLoaded = true; });
+   warmModel.loadAllWallets();
+   ASSERT_TRUE(lbdWaitLoaded(warmModel, warmLoaded));
+   const auto warmLoadTime = std::chrono::steady_clock::now() - warmStart;
+
+   TransactionsViewModel coldModel(envPtr_->armoryConnection(), syncMgr, envPtr_->logger());
+   const auto coldStart = std::chrono::steady_clock::now();
+   bool coldLoaded = false;
+   QObject::connect(&coldModel, &TransactionsViewModel::dataLoaded, [&coldLoaded](int) { coldLoaded = true; });
+   coldModel.loadAllWallets();
+   ASSERT_TRUE(lbdWaitLoaded(coldModel, coldLoaded));
+   const auto coldLoadTime = std::chrono::steady_clock::now() - coldStart;
+
+   EXPECT_EQ(coldModel.itemsCount(), nbSnapshotRows + 3);
+   EXPECT_EQ(lbdRows(warmModel), lbdRows(coldModel));
+
+   // Snapshot of another wallet set is not loaded
+   auto otherSyncMgr = std::make_shared<bs::sync::WalletsManager>(envPtr_->logger()
+      , envPtr_->appSettings(), envPtr_->armoryConnection());
+   TransactionsViewModel otherModel(envPtr_->armoryConnection(), otherSyncMgr, envPtr_->logger());
+   EXPECT_FALSE(otherModel.loadSnapshot(snapshotFile));
+
+   const auto toMs = [](std::chrono::steady_clock::duration d) {
+      return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(d).count());
+   };
+   RecordProperty("snapshot_load_ms", toMs(snapshotLoadTime));
+   RecordProperty("warm_load_ms", toMs(warmLoadTime));
+   RecordProperty("cold_load_ms", toMs(coldLoadTime));
+}
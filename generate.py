@@ -11,6 +11,7 @@ if sys.platform == "darwin":
 
 sys.path.insert(0, os.path.join('common'))
 sys.path.insert(0, os.path.join('common', 'build_scripts'))
+sys.path.insert(0, os.path.join('Benchmarks'))
 
 from build_scripts.settings               import Settings
 from build_scripts.protobuf_settings      import ProtobufSettings
@@ -29,8 +30,9 @@ from build_scripts.botan_settings         import BotanSettings
 from build_scripts.hidapi_settings        import HidapiSettings
 from build_scripts.libusb_settings        import LibusbSettings
 from build_scripts.trezor_common_settings import TrezorCommonSettings
+from gbenchmark_settings                  import GBenchmarkSettings
 
-def generate_project(build_mode, link_mode, build_production, hide_warnings, cmake_flags, build_tests, build_tracker):
+def generate_project(build_mode, link_mode, build_production, hide_warnings, cmake_flags, build_tests, build_tracker, build_benchmarks):
    project_settings = Settings(build_mode, link_mode)
 
    print('Build mode        : {} ( {} )'.format(project_settings.get_build_mode(), ('Production' if build_production else 'Development')))
@@ -64,6 +66,9 @@ def generate_project(build_mode, link_mode, build_production, hide_warnings, cma
    if build_tests:
       required_3rdparty.append(GtestSettings(project_settings))
 
+   if build_benchmarks:
+      required_3rdparty.append(GBenchmarkSettings(project_settings))
+
    for component in required_3rdparty:
       if not component.config_component():
          print('FAILED to build ' + component.get_package_name() + '. Cancel project generation')
@@ -126,6 +131,9 @@ def generate_project(build_mode, link_mode, build_production, hide_warnings, cma
    if build_tracker:
       command.append('-DBUILD_TRACKER=1')
 
+   if build_benchmarks:
+      command.append('-DBUILD_BENCHMARKS=1')
+
    if cmake_flags != None:
       for flag in cmake_flags.split():
          command.append(flag)
@@ -173,7 +181,10 @@ if __name__ == '__main__':
    input_parser.add_argument('--tracker',
                              help='Select to also build tracker',
                              action='store_true')
+   input_parser.add_argument('--benchmark',
+                             help='Select to also build benchmarks',
+                             action='store_true')
 
    args = input_parser.parse_args()
 
-   sys.exit(generate_project(args.build_mode, args.link_mode, args.build_production, args.hide_warnings, args.cmake_flags, args.test, args.tracker))
+   sys.exit(generate_project(args.build_mode, args.link_mode, args.build_production, args.hide_warnings, args.cmake_flags, args.test, args.tracker, args.benchmark))